@@ -221,6 +221,36 @@ int64_t Compression::decompress(uint8_t *p_dst, int64_t p_dst_max_size, const ui
 	ERR_FAIL_V(-1);
 }
 
+int64_t Compression::compress_zstd(uint8_t *p_dst, int64_t p_dst_max_size, const uint8_t *p_src, int64_t p_src_size, Span<uint8_t> p_dictionary) {
+	ZSTD_CCtx *cctx = ZSTD_createCCtx();
+	ERR_FAIL_NULL_V(cctx, -1);
+	ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, zstd_level);
+	if (!p_dictionary.is_empty()) {
+		// Referenced as a prefix, which is raw content and isn't copied.
+		ZSTD_CCtx_refPrefix(cctx, p_dictionary.ptr(), p_dictionary.size());
+	}
+	const size_t ret = ZSTD_compress2(cctx, p_dst, p_dst_max_size, p_src, p_src_size);
+	ZSTD_freeCCtx(cctx);
+	return ZSTD_isError(ret) ? -1 : (int64_t)ret;
+}
+
+int64_t Compression::decompress_zstd(uint8_t *p_dst, int64_t p_dst_max_size, const uint8_t *p_src, int64_t p_src_size, Span<uint8_t> p_dictionary) {
+	// One context per thread, so parallel decompression doesn't contend on the cache above.
+	struct ThreadContext {
+		ZSTD_DCtx *dctx = ZSTD_createDCtx();
+		~ThreadContext() { ZSTD_freeDCtx(dctx); }
+	};
+	static thread_local ThreadContext context;
+	ERR_FAIL_NULL_V(context.dctx, -1);
+
+	ZSTD_DCtx_reset(context.dctx, ZSTD_reset_session_and_parameters);
+	if (!p_dictionary.is_empty()) {
+		ZSTD_DCtx_refPrefix(context.dctx, p_dictionary.ptr(), p_dictionary.size());
+	}
+	const size_t ret = ZSTD_decompressDCtx(context.dctx, p_dst, p_dst_max_size, p_src, p_src_size);
+	return ZSTD_isError(ret) ? -1 : (int64_t)ret;
+}
+
 /**
 	This will handle both Gzip and Deflate streams. It will automatically allocate the output buffer into the provided p_dst_vect Vector.
 	This is required for compressed data whose final uncompressed size is unknown, as is the case for HTTP response bodies.
@@ -56,4 +56,9 @@ public:
 	static int64_t get_max_compressed_buffer_size(int64_t p_src_size, Mode p_mode = MODE_ZSTD);
 	static int64_t decompress(uint8_t *p_dst, int64_t p_dst_max_size, const uint8_t *p_src, int64_t p_src_size, Mode p_mode = MODE_ZSTD);
 	static int decompress_dynamic(Vector<uint8_t> *p_dst_vect, int64_t p_max_dst_size, const uint8_t *p_src, int64_t p_src_size, Mode p_mode);
+
+	// Zstd with an optional raw content dictionary, for many small inputs sharing similar content.
+	// Unlike decompress(), concurrent decompression doesn't serialize on a shared context.
+	static int64_t compress_zstd(uint8_t *p_dst, int64_t p_dst_max_size, const uint8_t *p_src, int64_t p_src_size, Span<uint8_t> p_dictionary = Span<uint8_t>());
+	static int64_t decompress_zstd(uint8_t *p_dst, int64_t p_dst_max_size, const uint8_t *p_src, int64_t p_src_size, Span<uint8_t> p_dictionary = Span<uint8_t>());
 };
@@ -192,6 +192,9 @@ public:
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const = 0; ///< get an array of bytes, needs to be overwritten by children.
 	Vector<uint8_t> get_buffer(int64_t p_length) const;
+	virtual Span<uint8_t> get_buffer_view(uint64_t p_length) const { return Span<uint8_t>(); } ///< get the next bytes without copying them, valid while the file is open; empty and not advancing when unsupported or when fewer bytes are left, use get_buffer() then.
+	virtual Span<uint8_t> map_read_only() { return Span<uint8_t>(); } ///< map the whole file in memory, valid until the file is closed; empty when unsupported.
+	virtual void read_ahead(uint64_t p_offset, uint64_t p_length) const {} ///< hint that a range will be read soon, so the OS can start loading it; doesn't move the position.
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
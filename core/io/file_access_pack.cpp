@@ -30,9 +30,12 @@
 
 #include "file_access_pack.h"
 
+#include "core/io/compression.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_patched.h"
+#include "core/io/marshalls.h"
 #include "core/object/script_language.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "core/version.h"
 
@@ -46,7 +49,7 @@ Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t
 	return ERR_FILE_UNRECOGNIZED;
 }
 
-void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_bundle, bool p_delta, const String &p_salt) {
+void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_bundle, bool p_delta, const String &p_salt, bool p_compressed, uint64_t p_decompressed_size) {
 	String simplified_path = p_path.simplify_path().trim_prefix("res://");
 	PathMD5 pmd5(simplified_path.md5_buffer());
 
@@ -56,6 +59,8 @@ void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64
 	pf.encrypted = p_encrypted;
 	pf.bundle = p_bundle;
 	pf.delta = p_delta;
+	pf.compressed = p_compressed;
+	pf.decompressed_size = p_decompressed_size;
 	pf.pack = p_pkg_path;
 	pf.salt = p_salt;
 	pf.offset = p_ofs;
@@ -186,6 +191,83 @@ void PackedData::clear() {
 	delta_patches.clear();
 	_free_packed_dirs(root);
 	root = memnew(PackedDir);
+
+	for (PackSource *source : sources) {
+		source->clear();
+	}
+
+	if (read_ahead) {
+		MutexLock lock(read_ahead->mutex);
+		read_ahead->order.clear();
+		read_ahead->indices.clear();
+		read_ahead->queue.clear();
+		read_ahead->queued_until = 0;
+	}
+}
+
+void PackedData::set_load_order(const Vector<String> &p_paths) {
+#ifdef THREADS_ENABLED
+	if (!read_ahead) {
+		read_ahead = memnew(ReadAhead);
+		read_ahead->thread.start(&PackedData::_read_ahead_thread, read_ahead);
+	}
+
+	MutexLock lock(read_ahead->mutex);
+	read_ahead->order.clear();
+	read_ahead->indices.clear();
+	read_ahead->queue.clear();
+	read_ahead->queued_until = 0;
+	for (const String &path : p_paths) {
+		PathMD5 pmd5(path.simplify_path().trim_prefix("res://").md5_buffer());
+		if (!read_ahead->indices.has(pmd5)) {
+			read_ahead->indices.insert(pmd5, read_ahead->order.size());
+			read_ahead->order.push_back(pmd5);
+		}
+	}
+#endif
+}
+
+void PackedData::_read_ahead_from(const PathMD5 &p_path) {
+	MutexLock lock(read_ahead->mutex);
+	const uint32_t *index = read_ahead->indices.getptr(p_path);
+	if (!index) {
+		return;
+	}
+
+	// Loads that got past files already queued don't need them anymore.
+	const uint32_t from = MAX(*index + 1, read_ahead->queued_until);
+	const uint32_t to = MIN(*index + 1 + READ_AHEAD_FILES, read_ahead->order.size());
+	if (from >= to) {
+		return;
+	}
+	for (uint32_t i = from; i < to; i++) {
+		HashMap<PathMD5, PackedFile, PathMD5>::ConstIterator E = files.find(read_ahead->order[i]);
+		if (E && E->value.offset != 0) {
+			read_ahead->queue.push_back(E->value);
+		}
+	}
+	read_ahead->queued_until = to;
+	read_ahead->semaphore.post();
+}
+
+void PackedData::_read_ahead_thread(void *p_read_ahead) {
+	ReadAhead *ra = static_cast<ReadAhead *>(p_read_ahead);
+	LocalVector<PackedFile> queue;
+	while (true) {
+		ra->semaphore.wait();
+		if (ra->exit.is_set()) {
+			break;
+		}
+
+		{
+			MutexLock lock(ra->mutex);
+			SWAP(queue, ra->queue);
+		}
+		for (const PackedFile &pf : queue) {
+			pf.src->read_ahead(pf);
+		}
+		queue.clear();
+	}
 }
 
 PackedData::PackedData() {
@@ -207,6 +289,13 @@ PackedData::~PackedData() {
 		singleton = nullptr;
 	}
 
+	if (read_ahead) {
+		read_ahead->exit.set();
+		read_ahead->semaphore.post();
+		read_ahead->thread.wait_to_finish();
+		memdelete(read_ahead);
+	}
+
 	for (int i = 0; i < sources.size(); i++) {
 		memdelete(sources[i]);
 	}
@@ -285,6 +374,7 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 	}
 
 	int64_t pck_start_pos = f->get_position() - 4;
+	Ref<FileAccess> pack_file = f;
 
 	// Read header.
 	uint32_t version = f->get_32();
@@ -292,7 +382,7 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 	uint32_t ver_minor = f->get_32();
 	uint32_t ver_patch = f->get_32(); // Not used for validation.
 
-	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION_V4 && version != PACK_FORMAT_VERSION_V3 && version != PACK_FORMAT_VERSION_V2, false, vformat("Pack version unsupported: %d.", version));
+	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION_V5 && version != PACK_FORMAT_VERSION_V4 && version != PACK_FORMAT_VERSION_V3 && version != PACK_FORMAT_VERSION_V2, false, vformat("Pack version unsupported: %d.", version));
 	ERR_FAIL_COND_V_MSG(ver_major > GODOT_VERSION_MAJOR || (ver_major == GODOT_VERSION_MAJOR && ver_minor > GODOT_VERSION_MINOR), false, vformat("Pack created with a newer version of the engine: %d.%d.%d.", ver_major, ver_minor, ver_patch));
 
 	uint32_t pack_flags = f->get_32();
@@ -302,15 +392,15 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 	String salt;
 
 	uint64_t file_base = f->get_64();
-	if ((version == PACK_FORMAT_VERSION_V4) || (version == PACK_FORMAT_VERSION_V3) || (version == PACK_FORMAT_VERSION_V2 && rel_filebase)) {
+	if ((version == PACK_FORMAT_VERSION_V5) || (version == PACK_FORMAT_VERSION_V4) || (version == PACK_FORMAT_VERSION_V3) || (version == PACK_FORMAT_VERSION_V2 && rel_filebase)) {
 		file_base += pck_start_pos;
 	}
 
-	if (version == PACK_FORMAT_VERSION_V3 || version == PACK_FORMAT_VERSION_V4) {
-		// V3/V4: Read directory offset and skip reserved part of the header.
+	if (version == PACK_FORMAT_VERSION_V3 || version == PACK_FORMAT_VERSION_V4 || version == PACK_FORMAT_VERSION_V5) {
+		// V3/V4/V5: Read directory offset and skip reserved part of the header.
 		uint64_t dir_offset = f->get_64() + pck_start_pos;
-		if (sparse_bundle && enc_directory && version == PACK_FORMAT_VERSION_V4) {
-			// V4: Read encrypted directory salt.
+		if (sparse_bundle && enc_directory && version >= PACK_FORMAT_VERSION_V4) {
+			// V4/V5: Read encrypted directory salt.
 			Vector<uint8_t> salt_data = f->get_buffer(32);
 			salt.append_latin1(Span((const char *)salt_data.ptr(), salt_data.size()));
 		}
@@ -340,6 +430,10 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		f = fae;
 	}
 
+	uint64_t dictionary_ofs = 0;
+	uint64_t dictionary_size = 0;
+	bool has_load_order = false;
+
 	for (int i = 0; i < file_count; i++) {
 		uint32_t sl = f->get_32();
 		CharString cs;
@@ -354,18 +448,120 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		f->get_buffer(md5, 16);
 		uint32_t flags = f->get_32();
 
-		if (flags & PACK_FILE_REMOVAL) { // The file was removed.
+		uint64_t decompressed_size = 0;
+		if (flags & (PACK_FILE_COMPRESSED | PACK_FILE_DICTIONARY)) {
+			ERR_FAIL_COND_V_MSG(version < PACK_FORMAT_VERSION_COMPRESSED, false, vformat("Pack version %d can't have compressed files, the pack is corrupted.", version));
+			if (flags & PACK_FILE_COMPRESSED) {
+				// V5: Compressed files also store their decompressed size.
+				decompressed_size = f->get_64();
+			}
+		}
+
+		if (flags & PACK_FILE_DICTIONARY) {
+			dictionary_ofs = file_base + ofs;
+			dictionary_size = size;
+		} else if (flags & PACK_FILE_REMOVAL) { // The file was removed.
 			PackedData::get_singleton()->remove_path(path);
 		} else {
-			PackedData::get_singleton()->add_path(p_path, path, file_base + ofs, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), sparse_bundle, (flags & PACK_FILE_DELTA), salt);
+			PackedData::get_singleton()->add_path(p_path, path, file_base + ofs, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), sparse_bundle, (flags & PACK_FILE_DELTA), salt, (flags & PACK_FILE_COMPRESSED), decompressed_size);
+			has_load_order = has_load_order || path == PACK_LOAD_ORDER_PATH;
+		}
+	}
+
+	if (dictionary_size > 0) {
+		ERR_FAIL_COND_V_MSG(sparse_bundle, false, "Compression dictionaries are not supported in sparse packs.");
+		Vector<uint8_t> dictionary;
+		dictionary.resize(dictionary_size);
+		pack_file->seek(dictionary_ofs);
+		ERR_FAIL_COND_V_MSG(pack_file->get_buffer(dictionary.ptrw(), dictionary_size) != dictionary_size, false, "Can't read the compression dictionary of the pack.");
+		MutexLock lock(mutex);
+		dictionaries[p_path] = dictionary;
+	}
+
+	// Map the pack, so its files are read with a copy from memory instead of a seek and read on their own handle.
+	// Only done on 64-bit platforms, as packs can be larger than the address space otherwise.
+	if (sizeof(void *) == 8 && !sparse_bundle && !pack_file->map_read_only().is_empty()) {
+		MutexLock lock(mutex);
+		mapped_packs[p_path] = pack_file;
+	}
+
+	if (has_load_order) {
+		Ref<FileAccess> load_order = PackedData::get_singleton()->try_open_path(PACK_LOAD_ORDER_PATH);
+		if (load_order.is_valid()) {
+			PackedData::get_singleton()->set_load_order(load_order->get_as_utf8_string().split("\n", false));
 		}
 	}
 
 	return true;
 }
 
+void PackedSourcePCK::read_ahead(const PackedData::PackedFile &p_file) {
+	if (p_file.bundle) {
+		return;
+	}
+
+	Ref<FileAccess> pack;
+	{
+		MutexLock lock(mutex);
+		const Ref<FileAccess> *mapped_pack = mapped_packs.getptr(p_file.pack);
+		if (mapped_pack) {
+			pack = *mapped_pack;
+		} else {
+			Ref<FileAccess> *read_ahead_pack = read_ahead_packs.getptr(p_file.pack);
+			if (!read_ahead_pack) {
+				read_ahead_pack = &read_ahead_packs.insert(p_file.pack, FileAccess::open(p_file.pack, FileAccess::READ))->value;
+			}
+			pack = *read_ahead_pack;
+		}
+	}
+
+	if (pack.is_valid()) {
+		pack->read_ahead(p_file.offset, p_file.size);
+	}
+}
+
+void PackedSourcePCK::clear() {
+	MutexLock lock(mutex);
+	mapped_packs.clear();
+	dictionaries.clear();
+	read_ahead_packs.clear();
+}
+
 Ref<FileAccess> PackedSourcePCK::get_file(const String &p_path, PackedData::PackedFile *p_file) {
-	Ref<FileAccess> file(memnew(FileAccessPack(p_path, *p_file)));
+	Ref<FileAccess> mapped_pack;
+	Span<uint8_t> mapping;
+	if (!p_file->bundle && !p_file->encrypted) {
+		MutexLock lock(mutex);
+		const Ref<FileAccess> *pack = mapped_packs.getptr(p_file->pack);
+		if (pack) {
+			mapped_pack = *pack;
+			mapping = mapped_pack->map_read_only();
+		}
+	}
+
+	Ref<FileAccess> file;
+	if (p_file->offset <= mapping.size() && p_file->size <= mapping.size() - p_file->offset) {
+		file = memnew(FileAccessPack(p_path, *p_file, mapped_pack, mapping.ptr() + p_file->offset));
+	} else {
+		file = memnew(FileAccessPack(p_path, *p_file));
+	}
+
+	if (p_file->compressed) {
+		Vector<uint8_t> dictionary;
+		{
+			MutexLock lock(mutex);
+			const Vector<uint8_t> *pack_dictionary = dictionaries.getptr(p_file->pack);
+			if (pack_dictionary) {
+				dictionary = *pack_dictionary;
+			}
+		}
+
+		Ref<FileAccessPackCompressed> file_compressed;
+		file_compressed.instantiate();
+		Error err = file_compressed->open_entry(file, dictionary);
+		ERR_FAIL_COND_V_MSG(err != OK, Ref<FileAccess>(), vformat(R"(Can't open compressed pack-referenced file "%s" from pack "%s".)", p_path, p_file->pack));
+		file = file_compressed;
+	}
 
 	if (PackedData::get_singleton()->has_delta_patches(p_path)) {
 		Ref<FileAccessPatched> file_patched;
@@ -424,7 +620,9 @@ Error FileAccessPack::open_internal(const String &p_path, int p_mode_flags) {
 }
 
 bool FileAccessPack::is_open() const {
-	if (f.is_valid()) {
+	if (mapped) {
+		return true;
+	} else if (f.is_valid()) {
 		return f->is_open();
 	} else {
 		return false;
@@ -432,7 +630,7 @@ bool FileAccessPack::is_open() const {
 }
 
 void FileAccessPack::seek(uint64_t p_position) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(f.is_null() && !mapped, "File must be opened before use.");
 
 	if (p_position > pf.size) {
 		eof = true;
@@ -440,7 +638,9 @@ void FileAccessPack::seek(uint64_t p_position) {
 		eof = false;
 	}
 
-	f->seek(off + p_position);
+	if (!mapped) {
+		f->seek(off + p_position);
+	}
 	pos = p_position;
 }
 
@@ -461,7 +661,7 @@ bool FileAccessPack::eof_reached() const {
 }
 
 uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
-	ERR_FAIL_COND_V_MSG(f.is_null(), -1, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(f.is_null() && !mapped, -1, "File must be opened before use.");
 	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
 
 	if (eof) {
@@ -479,16 +679,38 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	if (to_read <= 0) {
 		return 0;
 	}
-	f->get_buffer(p_dst, to_read);
+	if (mapped) {
+		memcpy(p_dst, mapped + pos - to_read, to_read);
+	} else {
+		f->get_buffer(p_dst, to_read);
+	}
 
 	return to_read;
 }
 
+Span<uint8_t> FileAccessPack::get_buffer_view(uint64_t p_length) const {
+	if (!mapped) {
+		return Span<uint8_t>();
+	}
+
+	// Short reads are left to get_buffer(), which reports them.
+	if (eof || pos > pf.size || p_length > pf.size - pos) {
+		return Span<uint8_t>();
+	}
+
+	Span<uint8_t> view(mapped + pos, p_length);
+	pos += p_length;
+
+	return view;
+}
+
 void FileAccessPack::set_big_endian(bool p_big_endian) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(f.is_null() && !mapped, "File must be opened before use.");
 
 	FileAccess::set_big_endian(p_big_endian);
-	f->set_big_endian(p_big_endian);
+	if (f.is_valid()) {
+		f->set_big_endian(p_big_endian);
+	}
 }
 
 Error FileAccessPack::get_error() const {
@@ -512,6 +734,8 @@ bool FileAccessPack::file_exists(const String &p_name) {
 
 void FileAccessPack::close() {
 	f = Ref<FileAccess>();
+	mapped_pack = Ref<FileAccess>();
+	mapped = nullptr;
 }
 
 FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file) {
@@ -553,6 +777,254 @@ FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFil
 	eof = false;
 }
 
+FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const Ref<FileAccess> &p_mapped_pack, const uint8_t *p_mapped) {
+	path = p_path;
+	pf = p_file;
+	mapped_pack = p_mapped_pack;
+	mapped = p_mapped;
+	off = 0;
+	pos = 0;
+	eof = false;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+// COMPRESSED FILE ACCESS
+//////////////////////////////////////////////////////////////////////////////////
+
+Vector<uint8_t> FileAccessPackCompressed::compress_entry(const uint8_t *p_src, uint64_t p_size, const Vector<uint8_t> &p_dictionary, uint32_t p_block_size) {
+	ERR_FAIL_COND_V(p_block_size == 0, Vector<uint8_t>());
+	ERR_FAIL_COND_V(!p_src && p_size > 0, Vector<uint8_t>());
+
+	const uint64_t block_count = p_size == 0 ? 0 : (p_size - 1) / p_block_size + 1;
+	ERR_FAIL_COND_V(block_count > UINT32_MAX, Vector<uint8_t>());
+
+	Vector<uint8_t> entry;
+	entry.resize(16 + block_count * 4);
+	encode_uint64(p_size, &entry.ptrw()[0]);
+	encode_uint32(p_block_size, &entry.ptrw()[8]);
+	encode_uint32(p_dictionary.is_empty() ? 0 : ENTRY_USES_DICTIONARY, &entry.ptrw()[12]);
+
+	LocalVector<uint8_t> compressed;
+	compressed.resize(Compression::get_max_compressed_buffer_size(p_block_size, Compression::MODE_ZSTD));
+
+	for (uint64_t i = 0; i < block_count; i++) {
+		const uint8_t *src = p_src + i * p_block_size;
+		const uint32_t block_length = MIN(p_size - i * p_block_size, (uint64_t)p_block_size);
+
+		int64_t stored_size = Compression::compress_zstd(compressed.ptr(), compressed.size(), src, block_length, p_dictionary);
+		ERR_FAIL_COND_V_MSG(stored_size < 0, Vector<uint8_t>(), "Error compressing pack file block.");
+		const uint8_t *stored = compressed.ptr();
+		if (stored_size >= block_length) {
+			// Not worth it, store the block as is.
+			stored_size = block_length;
+			stored = src;
+		}
+
+		const int64_t block_ofs = entry.size();
+		entry.resize(block_ofs + stored_size);
+		encode_uint32(stored_size, &entry.ptrw()[16 + i * 4]);
+		memcpy(entry.ptrw() + block_ofs, stored, stored_size);
+	}
+
+	return entry;
+}
+
+Error FileAccessPackCompressed::open_entry(const Ref<FileAccess> &p_entry, const Vector<uint8_t> &p_dictionary) {
+	ERR_FAIL_COND_V(p_entry.is_null(), ERR_INVALID_PARAMETER);
+
+	p_entry->seek(0);
+	length = p_entry->get_64();
+	block_size = p_entry->get_32();
+	const uint32_t entry_flags = p_entry->get_32();
+	ERR_FAIL_COND_V_MSG(block_size == 0, ERR_FILE_CORRUPT, "Compressed pack file has a block size of 0, it is corrupted.");
+
+	dictionary.clear();
+	if (entry_flags & ENTRY_USES_DICTIONARY) {
+		ERR_FAIL_COND_V_MSG(p_dictionary.is_empty(), ERR_FILE_CORRUPT, "Compressed pack file needs the dictionary of its pack.");
+		dictionary = p_dictionary;
+	}
+
+	const uint64_t block_count = length == 0 ? 0 : (length - 1) / block_size + 1;
+	ERR_FAIL_COND_V(block_count > UINT32_MAX, ERR_FILE_CORRUPT);
+	block_sizes.resize(block_count);
+	block_offsets.resize(block_count);
+
+	uint64_t block_ofs = 16 + block_count * 4;
+	for (uint32_t i = 0; i < block_count; i++) {
+		block_sizes[i] = p_entry->get_32();
+		block_offsets[i] = block_ofs;
+		block_ofs += block_sizes[i];
+	}
+	ERR_FAIL_COND_V_MSG(p_entry->eof_reached() || block_ofs > p_entry->get_length(), ERR_FILE_CORRUPT, "Compressed pack file is truncated.");
+
+	f = p_entry;
+	current_block = -1;
+	pos = 0;
+	eof = false;
+
+	return OK;
+}
+
+bool FileAccessPackCompressed::_decompress_block(uint32_t p_block, const uint8_t *p_src, uint8_t *p_dst) const {
+	const uint32_t block_length = _get_block_length(p_block);
+	if (block_sizes[p_block] == block_length) {
+		memcpy(p_dst, p_src, block_length);
+		return true;
+	}
+	return Compression::decompress_zstd(p_dst, block_length, p_src, block_sizes[p_block], dictionary) == block_length;
+}
+
+bool FileAccessPackCompressed::_load_block(uint32_t p_block) const {
+	if (current_block == p_block) {
+		return true;
+	}
+
+	const uint32_t stored_size = block_sizes[p_block];
+	f->seek(block_offsets[p_block]);
+	Span<uint8_t> src = f->get_buffer_view(stored_size);
+	if (src.is_empty()) {
+		compressed_block.resize(stored_size);
+		if (f->get_buffer(compressed_block.ptr(), stored_size) != stored_size) {
+			return false;
+		}
+		src = Span<uint8_t>(compressed_block.ptr(), stored_size);
+	}
+	if (src.size() != stored_size) {
+		return false;
+	}
+
+	block.resize(block_size);
+	current_block = -1;
+	if (!_decompress_block(p_block, src.ptr(), block.ptr())) {
+		return false;
+	}
+	current_block = p_block;
+	return true;
+}
+
+struct FileAccessPackCompressed::DecompressJob {
+	const FileAccessPackCompressed *file = nullptr;
+	const uint8_t *src = nullptr;
+	uint8_t *dst = nullptr;
+	uint32_t first = 0;
+	uint32_t count = 0;
+	std::atomic<uint32_t> next = { 0 };
+	SafeFlag failed;
+};
+
+void FileAccessPackCompressed::_decompress_blocks(void *p_job) {
+	DecompressJob *job = static_cast<DecompressJob *>(p_job);
+	const FileAccessPackCompressed *file = job->file;
+	const uint64_t src_base = file->block_offsets[job->first];
+
+	for (uint32_t i = job->next.fetch_add(1); i < job->count; i = job->next.fetch_add(1)) {
+		const uint32_t block_index = job->first + i;
+		if (!file->_decompress_block(block_index, job->src + (file->block_offsets[block_index] - src_base), job->dst + (uint64_t)i * file->block_size)) {
+			job->failed.set();
+		}
+	}
+}
+
+uint64_t FileAccessPackCompressed::_read_blocks_parallel(uint8_t *p_dst, uint32_t p_first, uint32_t p_count) const {
+	const uint32_t last = p_first + p_count - 1;
+	const uint64_t src_size = block_offsets[last] + block_sizes[last] - block_offsets[p_first];
+
+	f->seek(block_offsets[p_first]);
+	Span<uint8_t> src = f->get_buffer_view(src_size);
+	if (src.is_empty()) {
+		compressed_block.resize(src_size);
+		if (f->get_buffer(compressed_block.ptr(), src_size) != src_size) {
+			return 0;
+		}
+		src = Span<uint8_t>(compressed_block.ptr(), src_size);
+	}
+	if (src.size() != src_size) {
+		return 0;
+	}
+
+	DecompressJob job;
+	job.file = this;
+	job.src = src.ptr();
+	job.dst = p_dst;
+	job.first = p_first;
+	job.count = p_count;
+
+	// The calling thread decompresses too, so the read completes even if no worker thread is free.
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	const uint32_t helper_count = MIN(p_count - 1, (uint32_t)pool->get_thread_count());
+	LocalVector<WorkerThreadPool::TaskID> helpers;
+	helpers.reserve(helper_count);
+	for (uint32_t i = 0; i < helper_count; i++) {
+		helpers.push_back(pool->add_native_task(&FileAccessPackCompressed::_decompress_blocks, &job, false, SNAME("Decompress Pack File")));
+	}
+	_decompress_blocks(&job);
+	for (WorkerThreadPool::TaskID helper : helpers) {
+		pool->wait_for_task_completion(helper);
+	}
+
+	if (job.failed.is_set()) {
+		return 0;
+	}
+	return (uint64_t)(p_count - 1) * block_size + _get_block_length(last);
+}
+
+void FileAccessPackCompressed::seek(uint64_t p_position) {
+	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+
+	eof = p_position > length;
+	pos = p_position;
+}
+
+void FileAccessPackCompressed::seek_end(int64_t p_position) {
+	seek(length + p_position);
+}
+
+uint64_t FileAccessPackCompressed::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
+	ERR_FAIL_COND_V_MSG(f.is_null(), -1, "File must be opened before use.");
+	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
+
+	if (eof) {
+		return 0;
+	}
+
+	uint64_t to_read = p_length;
+	if (pos + to_read > length) {
+		eof = true;
+		to_read = pos < length ? length - pos : 0;
+	}
+
+	uint64_t read = 0;
+	while (read < to_read) {
+		const uint32_t block_index = pos / block_size;
+		const uint32_t block_pos = pos % block_size;
+
+		if (block_pos == 0) {
+			// Decompress the whole blocks of large reads straight into the destination, spread over the worker threads.
+			uint32_t whole_blocks = 0;
+			uint64_t whole_size = 0;
+			while (block_index + whole_blocks < block_sizes.size() && whole_size + _get_block_length(block_index + whole_blocks) <= to_read - read) {
+				whole_size += _get_block_length(block_index + whole_blocks);
+				whole_blocks++;
+			}
+			if (whole_blocks >= PARALLEL_MIN_BLOCKS) {
+				const uint64_t decompressed = _read_blocks_parallel(p_dst + read, block_index, whole_blocks);
+				ERR_FAIL_COND_V_MSG(decompressed != whole_size, read, "Compressed pack file is corrupt.");
+				read += decompressed;
+				pos += decompressed;
+				continue;
+			}
+		}
+
+		ERR_FAIL_COND_V_MSG(!_load_block(block_index), read, "Compressed pack file is corrupt.");
+		const uint64_t copied = MIN(to_read - read, (uint64_t)(_get_block_length(block_index) - block_pos));
+		memcpy(p_dst + read, block.ptr() + block_pos, copied);
+		read += copied;
+		pos += copied;
+	}
+
+	return read;
+}
+
 //////////////////////////////////////////////////////////////////////////////////
 // DIR ACCESS
 //////////////////////////////////////////////////////////////////////////////////
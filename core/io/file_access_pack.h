@@ -32,19 +32,30 @@
 
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
 #include "core/string/print_string.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
+#include "core/templates/local_vector.h"
 
 // Godot's packed file magic header ("GDPC" in ASCII).
 #define PACK_HEADER_MAGIC 0x43504447
+// Pack file listing the other files in the order they are first loaded, one path per line.
+#define PACK_LOAD_ORDER_PATH ".godot/pck_load_order"
 
 #define PACK_FORMAT_VERSION_V2 2
 #define PACK_FORMAT_VERSION_V3 3
 #define PACK_FORMAT_VERSION_V4 4
+#define PACK_FORMAT_VERSION_V5 5
 
 // The current packed file format version number.
 #define PACK_FORMAT_VERSION PACK_FORMAT_VERSION_V4
+// Version of packs with compressed files (V4, plus the decompressed size of those files in the directory).
+// Only used when such files are written, so older versions of the engine refuse these packs instead of
+// reading compressed data as file contents.
+#define PACK_FORMAT_VERSION_COMPRESSED PACK_FORMAT_VERSION_V5
 
 enum PackFlags {
 	PACK_DIR_ENCRYPTED = 1 << 0,
@@ -56,6 +67,8 @@ enum PackFileFlags {
 	PACK_FILE_ENCRYPTED = 1 << 0,
 	PACK_FILE_REMOVAL = 1 << 1,
 	PACK_FILE_DELTA = 1 << 2,
+	PACK_FILE_COMPRESSED = 1 << 3,
+	PACK_FILE_DICTIONARY = 1 << 4, // Zstd dictionary shared by the compressed files of the pack, not a project file.
 };
 
 class PackSource;
@@ -64,8 +77,11 @@ class PackedData {
 	friend class FileAccessPack;
 	friend class DirAccessPack;
 	friend class PackSource;
+	friend class TestPackedDataInternalsAccessor;
 
 public:
+	typedef void (*FileOpenNotify)(const String &p_path, uint64_t p_offset);
+
 	struct PackedFile {
 		String pack;
 		uint64_t offset; //if offset is ZERO, the file was ERASED
@@ -75,6 +91,8 @@ public:
 		bool encrypted;
 		bool bundle;
 		bool delta;
+		bool compressed = false;
+		uint64_t decompressed_size = 0; // Only set for compressed files, size is the stored size.
 		String salt;
 	};
 
@@ -113,7 +131,26 @@ private:
 
 	PackedDir *root = nullptr;
 
+	// Files in the order they were first loaded in a recorded run (see PCKPacker::set_load_trace()).
+	// Opening one of them reads the next ones ahead on a background thread, while it is being parsed.
+	struct ReadAhead {
+		LocalVector<PathMD5> order;
+		HashMap<PathMD5, uint32_t, PathMD5> indices;
+		uint32_t queued_until = 0;
+
+		LocalVector<PackedFile> queue;
+		Mutex mutex;
+		Semaphore semaphore;
+		Thread thread;
+		SafeFlag exit;
+	};
+	ReadAhead *read_ahead = nullptr;
+
+	static void _read_ahead_thread(void *p_read_ahead);
+	void _read_ahead_from(const PathMD5 &p_path);
+
 	static inline PackedData *singleton = nullptr;
+	static inline FileOpenNotify file_open_notify = nullptr;
 	bool disabled = false;
 
 	void _free_packed_dirs(PackedDir *p_dir);
@@ -121,7 +158,7 @@ private:
 
 public:
 	void add_pack_source(PackSource *p_source);
-	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_bundle = false, bool p_delta = false, const String &p_salt = String()); // for PackSource
+	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_bundle = false, bool p_delta = false, const String &p_salt = String(), bool p_compressed = false, uint64_t p_decompressed_size = 0); // for PackSource
 	void remove_path(const String &p_path);
 	uint8_t *get_file_hash(const String &p_path);
 	Vector<PackedFile> get_delta_patches(const String &p_path) const;
@@ -132,14 +169,22 @@ public:
 	_FORCE_INLINE_ bool is_disabled() const { return disabled; }
 
 	static PackedData *get_singleton() { return singleton; }
+	// Called with each file opened from a pack, used to record which pack files are loaded and in which order.
+	static void set_file_open_notify_callback(FileOpenNotify p_cbk) { file_open_notify = p_cbk; }
 	Error add_pack(const String &p_path, bool p_replace_files, uint64_t p_offset);
 
+	enum {
+		READ_AHEAD_FILES = 16,
+	};
+	void set_load_order(const Vector<String> &p_paths);
+
 	void clear();
 
 	_FORCE_INLINE_ Ref<FileAccess> try_open_path(const String &p_path);
 	_FORCE_INLINE_ bool has_path(const String &p_path);
 
 	_FORCE_INLINE_ int64_t get_size(const String &p_path);
+	_FORCE_INLINE_ int64_t get_offset(const String &p_path);
 
 	_FORCE_INLINE_ Ref<DirAccess> try_open_directory(const String &p_path);
 	_FORCE_INLINE_ bool has_directory(const String &p_path);
@@ -152,13 +197,25 @@ class PackSource {
 public:
 	virtual bool try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) = 0;
 	virtual Ref<FileAccess> get_file(const String &p_path, PackedData::PackedFile *p_file) = 0;
+	virtual void read_ahead(const PackedData::PackedFile &p_file) {}
+	virtual void clear() {}
 	virtual ~PackSource() {}
 };
 
 class PackedSourcePCK : public PackSource {
+	Mutex mutex;
+	// Packs mapped in memory, kept open so files can be read from the mapping.
+	HashMap<String, Ref<FileAccess>> mapped_packs;
+	// Dictionaries of the packs with compressed files, read once when the pack is opened.
+	HashMap<String, Vector<uint8_t>> dictionaries;
+	// Packs that could not be mapped, opened on the read-ahead thread to give it hints.
+	HashMap<String, Ref<FileAccess>> read_ahead_packs;
+
 public:
 	virtual bool try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) override;
 	virtual Ref<FileAccess> get_file(const String &p_path, PackedData::PackedFile *p_file) override;
+	virtual void read_ahead(const PackedData::PackedFile &p_file) override;
+	virtual void clear() override;
 };
 
 class PackedSourceDirectory : public PackSource {
@@ -179,6 +236,9 @@ class FileAccessPack : public FileAccess {
 	uint64_t off;
 
 	Ref<FileAccess> f;
+	Ref<FileAccess> mapped_pack; // Keeps the mapping alive when reading from it.
+	const uint8_t *mapped = nullptr;
+
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
 	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
 	virtual uint64_t _get_access_time(const String &p_file) override { return 0; }
@@ -205,6 +265,7 @@ public:
 	virtual bool eof_reached() const override;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual Span<uint8_t> get_buffer_view(uint64_t p_length) const override;
 
 	virtual void set_big_endian(bool p_big_endian) override;
 
@@ -219,10 +280,95 @@ public:
 	virtual void close() override;
 
 	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file);
+	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const Ref<FileAccess> &p_mapped_pack, const uint8_t *p_mapped);
+};
+
+// Reads a compressed pack file, stored as independently compressed zstd blocks so that seeking only
+// decompresses the block it lands in. Large sequential reads decompress their blocks in parallel.
+//
+// Entry layout: uncompressed size (64 bits), block size (32 bits), flags (32 bits), compressed size of
+// each block (32 bits each), then the blocks. A block whose compressed size equals its uncompressed size
+// is stored as is.
+class FileAccessPackCompressed : public FileAccess {
+	GDSOFTCLASS(FileAccessPackCompressed, FileAccess);
+
+public:
+	enum {
+		DEFAULT_BLOCK_SIZE = 64 * 1024,
+		PARALLEL_MIN_BLOCKS = 4,
+	};
+
+	enum EntryFlags {
+		ENTRY_USES_DICTIONARY = 1 << 0,
+	};
+
+private:
+	Ref<FileAccess> f;
+	Vector<uint8_t> dictionary;
+	uint64_t length = 0;
+	uint32_t block_size = 0;
+	LocalVector<uint32_t> block_sizes;
+	LocalVector<uint64_t> block_offsets;
+
+	mutable LocalVector<uint8_t> block;
+	mutable LocalVector<uint8_t> compressed_block;
+	mutable int64_t current_block = -1;
+	mutable uint64_t pos = 0;
+	mutable bool eof = false;
+
+	struct DecompressJob;
+	static void _decompress_blocks(void *p_job);
+
+	_FORCE_INLINE_ uint32_t _get_block_length(uint32_t p_block) const {
+		return p_block + 1 < block_sizes.size() ? block_size : uint32_t(length - (uint64_t)p_block * block_size);
+	}
+	bool _decompress_block(uint32_t p_block, const uint8_t *p_src, uint8_t *p_dst) const;
+	bool _load_block(uint32_t p_block) const;
+	uint64_t _read_blocks_parallel(uint8_t *p_dst, uint32_t p_first, uint32_t p_count) const;
+
+	virtual Error open_internal(const String &p_path, int p_mode_flags) override { return ERR_UNAVAILABLE; }
+	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
+	virtual uint64_t _get_access_time(const String &p_file) override { return 0; }
+	virtual int64_t _get_size(const String &p_file) override { return -1; }
+	virtual BitField<FileAccess::UnixPermissionFlags> _get_unix_permissions(const String &p_file) override { return 0; }
+	virtual Error _set_unix_permissions(const String &p_file, BitField<FileAccess::UnixPermissionFlags> p_permissions) override { return FAILED; }
+
+	virtual bool _get_hidden_attribute(const String &p_file) override { return false; }
+	virtual Error _set_hidden_attribute(const String &p_file, bool p_hidden) override { return ERR_UNAVAILABLE; }
+	virtual bool _get_read_only_attribute(const String &p_file) override { return false; }
+	virtual Error _set_read_only_attribute(const String &p_file, bool p_ro) override { return ERR_UNAVAILABLE; }
+
+public:
+	static Vector<uint8_t> compress_entry(const uint8_t *p_src, uint64_t p_size, const Vector<uint8_t> &p_dictionary = Vector<uint8_t>(), uint32_t p_block_size = DEFAULT_BLOCK_SIZE);
+	Error open_entry(const Ref<FileAccess> &p_entry, const Vector<uint8_t> &p_dictionary = Vector<uint8_t>());
+
+	virtual bool is_open() const override { return f.is_valid(); }
+
+	virtual String get_path() const override { return f.is_valid() ? f->get_path() : String(); }
+	virtual String get_path_absolute() const override { return f.is_valid() ? f->get_path_absolute() : String(); }
+
+	virtual void seek(uint64_t p_position) override;
+	virtual void seek_end(int64_t p_position = 0) override;
+	virtual uint64_t get_position() const override { return pos; }
+	virtual uint64_t get_length() const override { return length; }
+
+	virtual bool eof_reached() const override { return eof; }
+
+	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+
+	virtual Error get_error() const override { return eof ? ERR_FILE_EOF : OK; }
+
+	virtual Error resize(int64_t p_length) override { return ERR_UNAVAILABLE; }
+	virtual void flush() override {}
+	virtual bool store_buffer(const uint8_t *p_src, uint64_t p_length) override { return false; }
+
+	virtual bool file_exists(const String &p_name) override { return false; }
+
+	virtual void close() override { f.unref(); }
 };
 
 int64_t PackedData::get_size(const String &p_path) {
-	String simplified_path = p_path.simplify_path();
+	String simplified_path = p_path.simplify_path().trim_prefix("res://");
 	PathMD5 pmd5(simplified_path.md5_buffer());
 	HashMap<PathMD5, PackedFile, PathMD5>::Iterator E = files.find(pmd5);
 	if (!E) {
@@ -231,7 +377,16 @@ int64_t PackedData::get_size(const String &p_path) {
 	if (E->value.offset == 0) {
 		return -1; // File was erased.
 	}
-	return E->value.size;
+	return E->value.compressed ? E->value.decompressed_size : E->value.size;
+}
+
+int64_t PackedData::get_offset(const String &p_path) {
+	PathMD5 pmd5(p_path.simplify_path().trim_prefix("res://").md5_buffer());
+	HashMap<PathMD5, PackedFile, PathMD5>::ConstIterator E = files.find(pmd5);
+	if (!E || E->value.offset == 0) {
+		return -1; // File not found or erased.
+	}
+	return E->value.offset;
 }
 
 Ref<FileAccess> PackedData::try_open_path(const String &p_path) {
@@ -242,6 +397,13 @@ Ref<FileAccess> PackedData::try_open_path(const String &p_path) {
 		return nullptr; // Not found.
 	}
 
+	if (read_ahead) {
+		_read_ahead_from(pmd5);
+	}
+	if (unlikely(file_open_notify)) {
+		file_open_notify("res://" + simplified_path, E->value.offset);
+	}
+
 	return E->value.src->get_file(p_path, &E->value);
 }
 
@@ -34,6 +34,7 @@
 #include "core/io/file_access.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
+#include "core/templates/hash_set.h"
 #include "core/version.h"
 
 static int _get_pad(int p_alignment, int p_n) {
@@ -52,6 +53,10 @@ void PCKPacker::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("add_file_from_buffer", "target_path", "data", "encrypt"), &PCKPacker::add_file_from_buffer, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("add_file_removal", "target_path"), &PCKPacker::add_file_removal);
 	ClassDB::bind_method(D_METHOD("flush", "verbose"), &PCKPacker::flush, DEFVAL(false));
+
+	ClassDB::bind_method(D_METHOD("set_compression_enabled", "enabled"), &PCKPacker::set_compression_enabled);
+	ClassDB::bind_method(D_METHOD("is_compression_enabled"), &PCKPacker::is_compression_enabled);
+	ClassDB::bind_method(D_METHOD("set_load_trace", "trace_path"), &PCKPacker::set_load_trace);
 }
 
 Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const String &p_key, bool p_encrypt_directory) {
@@ -91,6 +96,7 @@ Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const Stri
 	alignment = p_alignment;
 
 	file->store_32(PACK_HEADER_MAGIC);
+	version_ofs = file->get_position();
 	file->store_32(PACK_FORMAT_VERSION);
 	file->store_32(GODOT_VERSION_MAJOR);
 	file->store_32(GODOT_VERSION_MINOR);
@@ -124,6 +130,34 @@ Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const Stri
 	file->seek(file_base);
 
 	files.clear();
+	pending_files.clear();
+
+	return OK;
+}
+
+void PCKPacker::set_compression_enabled(bool p_enabled) {
+	compression = p_enabled;
+}
+
+bool PCKPacker::is_compression_enabled() const {
+	return compression;
+}
+
+Error PCKPacker::set_load_trace(const String &p_trace_path) {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_trace_path, FileAccess::READ, &err);
+	ERR_FAIL_COND_V_MSG(f.is_null(), err, vformat("Can't open load trace: '%s'.", p_trace_path));
+
+	load_order.clear();
+	load_order_paths.clear();
+	while (!f->eof_reached()) {
+		// Lines are written by ResourceLoader::save_load_trace(), the path comes first.
+		const String path = f->get_line().get_slicec('\t', 0).simplify_path().trim_prefix("res://");
+		if (!path.is_empty() && !load_order.has(path)) {
+			load_order.insert(path, load_order_paths.size());
+			load_order_paths.push_back(path);
+		}
+	}
 
 	return OK;
 }
@@ -170,23 +204,42 @@ Error PCKPacker::_add_file(const String &p_target_path, const String &p_source_p
 	// symbols or 'res://' in them still match the MD5 hash for the saved path.
 	pf.path = p_target_path.simplify_path().trim_prefix("res://");
 	pf.src_path = p_source_path;
-	pf.ofs = file->get_position();
-	pf.size = p_data.size();
-
-	{
-		unsigned char hash[16];
-		CryptoCore::md5(p_data.ptr(), p_data.size(), hash);
-		pf.md5.resize(16);
-		for (int i = 0; i < 16; i++) {
-			pf.md5.write[i] = hash[i];
+	pf.md5 = _get_md5(p_data);
+	pf.encrypted = p_encrypt;
+
+	Vector<uint8_t> data = p_data;
+	bool use_dictionary = false;
+	if (compression) {
+		pf.compressed = true;
+		pf.decompressed_size = p_data.size();
+		// The dictionary is stored in clear, so it is only built from files that are not encrypted.
+		use_dictionary = !p_encrypt && _is_dictionary_candidate(p_data);
+		if (!use_dictionary) {
+			data = FileAccessPackCompressed::compress_entry(p_data.ptr(), p_data.size());
+			ERR_FAIL_COND_V_MSG(data.is_empty(), ERR_CANT_CREATE, vformat("Can't compress file: '%s'.", p_source_path));
 		}
 	}
-	pf.encrypted = p_encrypt;
+
+	if (use_dictionary || load_order.has(pf.path)) {
+		PendingFile pending;
+		pending.file = pf;
+		pending.data = data;
+		pending.use_dictionary = use_dictionary;
+		pending_files.push_back(pending);
+		return OK;
+	}
+
+	return _store_file(pf, data);
+}
+
+Error PCKPacker::_store_file(File &p_file, const Vector<uint8_t> &p_data) {
+	p_file.ofs = file->get_position();
+	p_file.size = p_data.size();
 
 	Ref<FileAccess> ftmp = file;
 
 	Ref<FileAccessEncrypted> fae;
-	if (p_encrypt) {
+	if (p_file.encrypted) {
 		fae.instantiate();
 		ERR_FAIL_COND_V(fae.is_null(), ERR_CANT_CREATE);
 
@@ -207,7 +260,135 @@ Error PCKPacker::_add_file(const String &p_target_path, const String &p_source_p
 		file->store_8(0);
 	}
 
-	files.push_back(pf);
+	files.push_back(p_file);
+
+	return OK;
+}
+
+Vector<uint8_t> PCKPacker::_get_md5(const Vector<uint8_t> &p_data) {
+	Vector<uint8_t> md5;
+	md5.resize(16);
+	CryptoCore::md5(p_data.ptr(), p_data.size(), md5.ptrw());
+	return md5;
+}
+
+bool PCKPacker::_is_dictionary_candidate(const Vector<uint8_t> &p_data) {
+	if (p_data.is_empty() || p_data.size() > DICTIONARY_MAX_FILE_SIZE) {
+		return false;
+	}
+	// Only text resources, binary ones share little.
+	const int64_t sample_size = MIN(p_data.size(), (int64_t)DICTIONARY_SAMPLE_SIZE);
+	return memchr(p_data.ptr(), 0, sample_size) == nullptr;
+}
+
+Vector<uint8_t> PCKPacker::_build_dictionary() const {
+	// The bundled zstd has no dictionary trainer, so the dictionary is raw content instead: the lines found at the start
+	// of more than one file (resource headers, property names, common sub-resources).
+	HashMap<String, uint32_t> line_counts;
+	for (const PendingFile &pending : pending_files) {
+		if (!pending.use_dictionary) {
+			continue;
+		}
+		const uint8_t *data = pending.data.ptr();
+		const int64_t sample_size = MIN(pending.data.size(), (int64_t)DICTIONARY_SAMPLE_SIZE);
+
+		HashSet<String> file_lines;
+		int64_t from = 0;
+		for (int64_t i = 0; i <= sample_size; i++) {
+			if (i < sample_size && data[i] != '\n') {
+				continue;
+			}
+			if (i > from) {
+				file_lines.insert(String::utf8((const char *)data + from, i - from));
+			}
+			from = i + 1;
+		}
+		for (const String &line : file_lines) {
+			line_counts[line]++;
+		}
+	}
+
+	struct Line {
+		String text;
+		uint32_t count = 0;
+
+		bool operator<(const Line &p_other) const {
+			return count > p_other.count;
+		}
+	};
+	LocalVector<Line> lines;
+	for (const KeyValue<String, uint32_t> &E : line_counts) {
+		if (E.value > 1) {
+			lines.push_back({ E.key, E.value });
+		}
+	}
+	lines.sort();
+
+	// Most common lines go last, zstd matches content near the end of the dictionary with shorter offsets.
+	LocalVector<CharString> picked;
+	int64_t dictionary_size = 0;
+	for (const Line &line : lines) {
+		CharString utf8 = line.text.utf8();
+		if (dictionary_size + utf8.length() + 1 > DICTIONARY_MAX_SIZE) {
+			continue;
+		}
+		dictionary_size += utf8.length() + 1;
+		picked.push_back(utf8);
+	}
+
+	Vector<uint8_t> dictionary;
+	dictionary.resize(dictionary_size);
+	uint8_t *w = dictionary.ptrw();
+	for (int64_t i = int64_t(picked.size()) - 1; i >= 0; i--) {
+		memcpy(w, picked[i].get_data(), picked[i].length());
+		w += picked[i].length();
+		*w++ = '\n';
+	}
+	return dictionary;
+}
+
+Error PCKPacker::_store_pending_files() {
+	Vector<uint8_t> dictionary = _build_dictionary();
+	if (!dictionary.is_empty()) {
+		File pf;
+		pf.path = ".godot/pck_dictionary.bin";
+		pf.src_path = "<Dictionary>";
+		pf.dictionary = true;
+		pf.md5 = _get_md5(dictionary);
+
+		Error err = _store_file(pf, dictionary);
+		ERR_FAIL_COND_V(err != OK, err);
+	}
+
+	// Files of the load trace go first and in the order they were loaded, so loading reads the pack sequentially.
+	struct Order {
+		uint64_t key = 0;
+		uint32_t index = 0;
+
+		bool operator<(const Order &p_other) const {
+			return key < p_other.key;
+		}
+	};
+	LocalVector<Order> order;
+	order.resize(pending_files.size());
+	for (uint32_t i = 0; i < order.size(); i++) {
+		const uint32_t *load_index = load_order.getptr(pending_files[i].file.path);
+		order[i].key = (uint64_t(load_index ? *load_index : UINT32_MAX) << 32) | i;
+		order[i].index = i;
+	}
+	order.sort();
+
+	for (const Order &E : order) {
+		PendingFile &pending = pending_files.write[E.index];
+		if (pending.use_dictionary) {
+			pending.data = FileAccessPackCompressed::compress_entry(pending.data.ptr(), pending.data.size(), dictionary);
+			ERR_FAIL_COND_V_MSG(pending.data.is_empty(), ERR_CANT_CREATE, vformat("Can't compress file: '%s'.", pending.file.src_path));
+		}
+
+		Error err = _store_file(pending.file, pending.data);
+		ERR_FAIL_COND_V(err != OK, err);
+	}
+	pending_files.clear();
 
 	return OK;
 }
@@ -215,6 +396,23 @@ Error PCKPacker::_add_file(const String &p_target_path, const String &p_source_p
 Error PCKPacker::flush(bool p_verbose) {
 	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
 
+	if (!pending_files.is_empty()) {
+		Error err = _store_pending_files();
+		ERR_FAIL_COND_V(err != OK, err);
+	}
+
+	if (!load_order_paths.is_empty()) {
+		const Vector<uint8_t> data = String("\n").join(load_order_paths).to_utf8_buffer();
+		File pf;
+		pf.path = PACK_LOAD_ORDER_PATH;
+		pf.src_path = "<Load Trace>";
+		pf.md5 = _get_md5(data);
+		pf.encrypted = enc_dir;
+
+		Error err = _store_file(pf, data);
+		ERR_FAIL_COND_V(err != OK, err);
+	}
+
 	int dir_padding = _get_pad(alignment, file->get_position());
 	for (int i = 0; i < dir_padding; i++) {
 		file->store_8(0);
@@ -224,6 +422,15 @@ Error PCKPacker::flush(bool p_verbose) {
 	uint64_t dir_offset = file->get_position();
 	file->seek(dir_base_ofs);
 	file->store_64(dir_offset);
+
+	for (const File &pf : files) {
+		if (pf.compressed || pf.dictionary) {
+			// Older versions of the engine would read compressed files as they are stored.
+			file->seek(version_ofs);
+			file->store_32(PACK_FORMAT_VERSION_COMPRESSED);
+			break;
+		}
+	}
 	file->seek(dir_offset);
 
 	file->store_32(uint32_t(files.size()));
@@ -264,7 +471,16 @@ Error PCKPacker::flush(bool p_verbose) {
 		if (files[i].removal) {
 			flags |= PACK_FILE_REMOVAL;
 		}
+		if (files[i].compressed) {
+			flags |= PACK_FILE_COMPRESSED;
+		}
+		if (files[i].dictionary) {
+			flags |= PACK_FILE_DICTIONARY;
+		}
 		fhead->store_32(flags);
+		if (files[i].compressed) {
+			fhead->store_64(files[i].decompressed_size);
+		}
 
 		if (p_verbose) {
 			print_line(vformat("[%d/%d - %d%%] PCKPacker flush: %s -> %s", i + 1, file_num, float(i + 1) / file_num * 100, files[i].src_path, files[i].path));
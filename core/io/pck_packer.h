@@ -31,6 +31,7 @@
 #pragma once
 
 #include "core/object/ref_counted.h"
+#include "core/templates/hash_map.h"
 
 class FileAccess;
 
@@ -42,8 +43,10 @@ class PCKPacker : public RefCounted {
 
 	Vector<uint8_t> key;
 	bool enc_dir = false;
+	bool compression = false;
 
 	uint64_t file_base = 0;
+	uint64_t version_ofs = 0;
 	uint64_t file_base_ofs = 0;
 	uint64_t dir_base_ofs = 0;
 
@@ -54,19 +57,48 @@ class PCKPacker : public RefCounted {
 		String src_path;
 		uint64_t ofs = 0;
 		uint64_t size = 0;
+		uint64_t decompressed_size = 0;
 		bool encrypted = false;
 		bool removal = false;
+		bool compressed = false;
+		bool dictionary = false;
 		Vector<uint8_t> md5;
 	};
 	Vector<File> files;
 
+	enum {
+		DICTIONARY_MAX_FILE_SIZE = 64 * 1024,
+		DICTIONARY_SAMPLE_SIZE = 4 * 1024,
+		DICTIONARY_MAX_SIZE = 64 * 1024,
+	};
+	// Files written on flush: small text files waiting for the dictionary built from all of them,
+	// and files of the load trace, laid out in the order they are loaded.
+	struct PendingFile {
+		File file;
+		Vector<uint8_t> data;
+		bool use_dictionary = false;
+	};
+	Vector<PendingFile> pending_files;
+
+	HashMap<String, uint32_t> load_order;
+	Vector<String> load_order_paths;
+
+	static Vector<uint8_t> _get_md5(const Vector<uint8_t> &p_data);
+	static bool _is_dictionary_candidate(const Vector<uint8_t> &p_data);
+	Vector<uint8_t> _build_dictionary() const;
+
 	Error _add_file(const String &p_target_path, const String &p_source_path, const Vector<uint8_t> &p_data, bool p_encrypt = false);
+	Error _store_file(File &p_file, const Vector<uint8_t> &p_data);
+	Error _store_pending_files();
 
 public:
 	Error pck_start(const String &p_pck_path, int p_alignment = 32, const String &p_key = "0000000000000000000000000000000000000000000000000000000000000000", bool p_encrypt_directory = false);
 	Error add_file(const String &p_target_path, const String &p_source_path, bool p_encrypt = false);
 	Error add_file_from_buffer(const String &p_target_path, const Vector<uint8_t> &p_data, bool p_encrypt = false);
 	Error add_file_removal(const String &p_target_path);
+	void set_compression_enabled(bool p_enabled);
+	bool is_compression_enabled() const;
+	Error set_load_trace(const String &p_trace_path);
 	Error flush(bool p_verbose = false);
 
 	~PCKPacker();
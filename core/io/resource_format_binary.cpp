@@ -33,6 +33,7 @@
 #include "core/config/project_settings.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access_compressed.h"
+#include "core/io/file_access_memory.h"
 #include "core/io/missing_resource.h"
 #include "core/object/script_language.h"
 #include "core/version.h"
@@ -163,6 +164,10 @@ StringName ResourceLoaderBinary::_get_string() {
 		if (len == 0) {
 			return StringName();
 		}
+		Span<uint8_t> view = f->get_buffer_view(len);
+		if (view.size() == len) {
+			return String::utf8((const char *)view.ptr(), len);
+		}
 		f->get_buffer((uint8_t *)&str_buf[0], len);
 		return String::utf8(&str_buf[0], len);
 	}
@@ -408,7 +413,7 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 					}
 
 					//always use internal cache for loading internal resources
-					if (!internal_index_cache.has(path)) {
+					if ((int)index >= visible_internal_resources || !internal_index_cache.has(path)) {
 						WARN_PRINT(vformat("Couldn't load resource (no cache): %s.", path));
 						r_v = Variant();
 					} else {
@@ -446,10 +451,10 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 						WARN_PRINT("Broken external resource! (index out of size)");
 						r_v = Variant();
 					} else {
-						Ref<ResourceLoader::LoadToken> &load_token = external_resources.write[erindex].load_token;
-						if (load_token.is_valid()) { // If not valid, it's OK since then we know this load accepts broken dependencies.
+						const ExtResource &ext = external_resources[erindex];
+						if (ext.load_token.is_valid()) { // If not valid, it's OK since then we know this load accepts broken dependencies.
 							Error err;
-							Ref<Resource> res = ResourceLoader::_load_complete(*load_token.ptr(), &err);
+							Ref<Resource> res = ext.completed ? ext.resource : ResourceLoader::_load_complete(*ext.load_token.ptr(), &err);
 							if (res.is_null()) {
 								if (!ResourceLoader::is_cleaning_tasks()) {
 									if (!ResourceLoader::get_abort_on_missing_resources()) {
@@ -707,193 +712,359 @@ Error ResourceLoaderBinary::load() {
 		}
 	}
 
+	if (use_sub_threads && internal_resources.size() >= PARALLEL_MIN_RESOURCES && WorkerThreadPool::get_singleton()->get_thread_count() >= parallel_min_threads) {
+		// Readers on other threads need the file in memory. Copying it there would cost more than decoding in parallel saves.
+		const uint64_t position = f->get_position();
+		const uint64_t length = f->get_length();
+		f->seek(0);
+		Span<uint8_t> data = f->get_buffer_view(length);
+		if (data.is_empty()) {
+			data = f->map_read_only();
+		}
+		f->seek(position);
+		if (data.size() == length) {
+			return _load_parallel(data);
+		}
+	}
+
 	for (int i = 0; i < internal_resources.size(); i++) {
 		bool main = i == (internal_resources.size() - 1);
 
-		//maybe it is loaded already
-		String path;
-		String id;
+		Ref<Resource> res;
+		MissingResource *missing_resource = nullptr;
+		Error err = _create_internal_resource(i, res, missing_resource);
+		if (err != OK) {
+			return err;
+		}
+		if (res.is_null()) {
+			continue; // Already loaded.
+		}
 
-		if (!main) {
-			path = internal_resources[i].path;
+		LocalVector<Pair<StringName, Variant>> properties;
+		err = _read_properties(properties);
+		if (err != OK) {
+			return err;
+		}
+		_set_properties(res, missing_resource, properties);
 
-			if (path.begins_with("local://")) {
-				path = path.replace_first("local://", "");
-				id = path;
-				path = res_path + "::" + path;
+		if (progress) {
+			*progress = (i + 1) / float(internal_resources.size());
+		}
 
-				internal_resources.write[i].path = path; // Update path.
-			}
+		resource_cache.push_back(res);
 
-			if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(path)) {
-				Ref<Resource> cached = ResourceCache::get_ref(path);
-				if (cached.is_valid()) {
-					//already loaded, don't do anything
-					error = OK;
-					internal_index_cache[path] = cached;
-					continue;
-				}
-			}
-		} else {
-			if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
-				path = res_path;
-			}
+		if (main) {
+			f.unref();
+			resource = res;
+			resource->set_as_translation_remapped(translation_remapped);
+			error = OK;
+			return OK;
 		}
+	}
 
-		uint64_t offset = internal_resources[i].offset;
+	return ERR_FILE_EOF;
+}
 
-		f->seek(offset);
+Error ResourceLoaderBinary::_create_internal_resource(int p_index, Ref<Resource> &r_res, MissingResource *&r_missing_resource) {
+	bool main = p_index == (internal_resources.size() - 1);
 
-		String t = get_unicode_string();
+	//maybe it is loaded already
+	String path;
+	String id;
 
-		Ref<Resource> res;
-		Resource *r = nullptr;
+	if (!main) {
+		path = internal_resources[p_index].path;
 
-		MissingResource *missing_resource = nullptr;
+		if (path.begins_with("local://")) {
+			path = path.replace_first("local://", "");
+			id = path;
+			path = res_path + "::" + path;
 
-		if (main) {
-			res = ResourceLoader::get_resource_ref_override(local_path);
-			r = res.ptr();
+			internal_resources.write[p_index].path = path; // Update path.
 		}
-		if (!r) {
-			if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
-				//use the existing one
-				Ref<Resource> cached = ResourceCache::get_ref(path);
-				if (cached->get_class() == t) {
-					cached->reset_state();
-					res = cached;
-				}
+
+		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(path)) {
+			Ref<Resource> cached = ResourceCache::get_ref(path);
+			if (cached.is_valid()) {
+				//already loaded, don't do anything
+				error = OK;
+				internal_index_cache[path] = cached;
+				return OK;
 			}
+		}
+	} else {
+		if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
+			path = res_path;
+		}
+	}
 
-			if (res.is_null()) {
-				//did not replace
-
-				Object *obj = ClassDB::instantiate(t);
-				if (!obj) {
-					if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
-						//create a missing resource
-						missing_resource = memnew(MissingResource);
-						missing_resource->set_original_class(t);
-						missing_resource->set_recording_properties(true);
-						obj = missing_resource;
-					} else {
-						error = ERR_FILE_CORRUPT;
-						ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, vformat("'%s': Resource of unrecognized type in file: '%s'.", local_path, t));
-					}
-				}
+	uint64_t offset = internal_resources[p_index].offset;
 
-				r = Object::cast_to<Resource>(obj);
-				if (!r) {
-					String obj_class = obj->get_class();
-					error = ERR_FILE_CORRUPT;
-					memdelete(obj); //bye
-					ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, vformat("'%s': Resource type in resource field not a resource, type is: %s.", local_path, obj_class));
-				}
+	f->seek(offset);
+
+	String t = get_unicode_string();
+
+	Ref<Resource> res;
+	Resource *r = nullptr;
 
-				res = Ref<Resource>(r);
+	if (main) {
+		res = ResourceLoader::get_resource_ref_override(local_path);
+		r = res.ptr();
+	}
+	if (!r) {
+		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
+			//use the existing one
+			Ref<Resource> cached = ResourceCache::get_ref(path);
+			if (cached->get_class() == t) {
+				cached->reset_state();
+				res = cached;
 			}
 		}
 
-		if (r) {
-			if (!path.is_empty()) {
-				if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
-					r->set_path(path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); // If got here because the resource with same path has different type, replace it.
+		if (res.is_null()) {
+			//did not replace
+
+			Object *obj = ClassDB::instantiate(t);
+			if (!obj) {
+				if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
+					//create a missing resource
+					r_missing_resource = memnew(MissingResource);
+					r_missing_resource->set_original_class(t);
+					r_missing_resource->set_recording_properties(true);
+					obj = r_missing_resource;
 				} else {
-					r->set_path_cache(path);
+					error = ERR_FILE_CORRUPT;
+					ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, vformat("'%s': Resource of unrecognized type in file: '%s'.", local_path, t));
 				}
 			}
-			r->set_scene_unique_id(id);
+
+			r = Object::cast_to<Resource>(obj);
+			if (!r) {
+				String obj_class = obj->get_class();
+				error = ERR_FILE_CORRUPT;
+				memdelete(obj); //bye
+				ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, vformat("'%s': Resource type in resource field not a resource, type is: %s.", local_path, obj_class));
+			}
+
+			res = Ref<Resource>(r);
 		}
+	}
 
-		if (!main) {
-			internal_index_cache[path] = res;
+	if (r) {
+		if (!path.is_empty()) {
+			if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
+				r->set_path(path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); // If got here because the resource with same path has different type, replace it.
+			} else {
+				r->set_path_cache(path);
+			}
 		}
+		r->set_scene_unique_id(id);
+	}
 
-		int pc = f->get_32();
+	if (!main) {
+		internal_index_cache[path] = res;
+	}
 
-		//set properties
+	r_res = res;
+	return OK;
+}
 
-		Dictionary missing_resource_properties;
+Error ResourceLoaderBinary::_read_properties(LocalVector<Pair<StringName, Variant>> &r_properties) {
+	int pc = f->get_32();
+	r_properties.reserve(pc);
 
-		for (int j = 0; j < pc; j++) {
-			StringName name = _get_string();
+	for (int j = 0; j < pc; j++) {
+		StringName name = _get_string();
 
-			if (name == StringName()) {
-				error = ERR_FILE_CORRUPT;
-				ERR_FAIL_V(ERR_FILE_CORRUPT);
-			}
+		if (name == StringName()) {
+			error = ERR_FILE_CORRUPT;
+			ERR_FAIL_V(ERR_FILE_CORRUPT);
+		}
 
-			Variant value;
+		Variant value;
 
-			error = parse_variant(value);
-			if (error) {
-				return error;
-			}
+		error = parse_variant(value);
+		if (error) {
+			return error;
+		}
 
-			bool set_valid = true;
-			if (value.get_type() == Variant::OBJECT && missing_resource == nullptr && ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
-				// If the property being set is a missing resource (and the parent is not),
-				// then setting it will most likely not work.
-				// Instead, save it as metadata.
+		r_properties.push_back(Pair<StringName, Variant>(name, value));
+	}
 
-				Ref<MissingResource> mr = value;
-				if (mr.is_valid()) {
-					missing_resource_properties[name] = mr;
-					set_valid = false;
-				}
-			}
+	return OK;
+}
 
-			if (value.get_type() == Variant::ARRAY) {
-				Array set_array = value;
-				bool is_get_valid = false;
-				Variant get_value = res->get(name, &is_get_valid);
-				if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
-					Array get_array = get_value;
-					if (!set_array.is_same_typed(get_array)) {
-						value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
-					}
-				}
+void ResourceLoaderBinary::_set_properties(const Ref<Resource> &p_res, MissingResource *p_missing_resource, LocalVector<Pair<StringName, Variant>> &p_properties) {
+	Dictionary missing_resource_properties;
+
+	for (Pair<StringName, Variant> &property : p_properties) {
+		const StringName &name = property.first;
+		Variant &value = property.second;
+
+		bool set_valid = true;
+		if (value.get_type() == Variant::OBJECT && p_missing_resource == nullptr && ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
+			// If the property being set is a missing resource (and the parent is not),
+			// then setting it will most likely not work.
+			// Instead, save it as metadata.
+
+			Ref<MissingResource> mr = value;
+			if (mr.is_valid()) {
+				missing_resource_properties[name] = mr;
+				set_valid = false;
 			}
+		}
 
-			if (value.get_type() == Variant::DICTIONARY) {
-				Dictionary set_dict = value;
-				bool is_get_valid = false;
-				Variant get_value = res->get(name, &is_get_valid);
-				if (is_get_valid && get_value.get_type() == Variant::DICTIONARY) {
-					Dictionary get_dict = get_value;
-					if (!set_dict.is_same_typed(get_dict)) {
-						value = Dictionary(set_dict, get_dict.get_typed_key_builtin(), get_dict.get_typed_key_class_name(), get_dict.get_typed_key_script(),
-								get_dict.get_typed_value_builtin(), get_dict.get_typed_value_class_name(), get_dict.get_typed_value_script());
-					}
+		if (value.get_type() == Variant::ARRAY) {
+			Array set_array = value;
+			bool is_get_valid = false;
+			Variant get_value = p_res->get(name, &is_get_valid);
+			if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
+				Array get_array = get_value;
+				if (!set_array.is_same_typed(get_array)) {
+					value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
 				}
 			}
+		}
 
-			if (set_valid) {
-				res->set(name, value);
+		if (value.get_type() == Variant::DICTIONARY) {
+			Dictionary set_dict = value;
+			bool is_get_valid = false;
+			Variant get_value = p_res->get(name, &is_get_valid);
+			if (is_get_valid && get_value.get_type() == Variant::DICTIONARY) {
+				Dictionary get_dict = get_value;
+				if (!set_dict.is_same_typed(get_dict)) {
+					value = Dictionary(set_dict, get_dict.get_typed_key_builtin(), get_dict.get_typed_key_class_name(), get_dict.get_typed_key_script(),
+							get_dict.get_typed_value_builtin(), get_dict.get_typed_value_class_name(), get_dict.get_typed_value_script());
+				}
 			}
 		}
 
-		if (missing_resource) {
-			missing_resource->set_recording_properties(false);
+		if (set_valid) {
+			p_res->set(name, value);
 		}
+	}
 
-		if (!missing_resource_properties.is_empty()) {
-			res->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
-		}
+	if (p_missing_resource) {
+		p_missing_resource->set_recording_properties(false);
+	}
+
+	if (!missing_resource_properties.is_empty()) {
+		p_res->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
+	}
 
 #ifdef TOOLS_ENABLED
-		res->set_edited(false);
+	p_res->set_edited(false);
 #endif
+}
+
+struct ResourceLoaderBinary::ParallelDecode {
+	ResourceLoaderBinary *loader = nullptr;
+	Span<uint8_t> data;
+	LocalVector<DecodedResource> *resources = nullptr;
+	std::atomic<uint32_t> next = { 0 };
+};
+
+void ResourceLoaderBinary::_decode_resources(void *p_decode) {
+	ParallelDecode *decode = static_cast<ParallelDecode *>(p_decode);
+	const ResourceLoaderBinary *loader = decode->loader;
+	LocalVector<DecodedResource> &resources = *decode->resources;
+
+	// A reader of its own over the file data, sharing the tables read by the loader.
+	ResourceLoaderBinary reader;
+	reader.local_path = loader->local_path;
+	reader.res_path = loader->res_path;
+	reader.ver_format = loader->ver_format;
+	reader.string_map = loader->string_map;
+	reader.using_named_scene_ids = loader->using_named_scene_ids;
+	reader.using_uids = loader->using_uids;
+	reader.external_resources = loader->external_resources;
+	reader.internal_resources = loader->internal_resources;
+	reader.internal_index_cache = loader->internal_index_cache;
+	reader.remaps = loader->remaps;
+	reader.cache_mode_for_external = loader->cache_mode_for_external;
+
+	Ref<FileAccessMemory> data_file;
+	data_file.instantiate();
+	data_file->open_custom(decode->data.ptr(), decode->data.size());
+	data_file->set_big_endian(loader->f->is_big_endian());
+	data_file->real_is_double = loader->f->real_is_double;
+	reader.f = data_file;
+
+	for (uint32_t i = decode->next.fetch_add(1); i < resources.size(); i = decode->next.fetch_add(1)) {
+		DecodedResource &decoded = resources[i];
+		reader.visible_internal_resources = decoded.index;
+		reader.f->seek(decoded.offset);
+		decoded.error = reader._read_properties(decoded.properties);
+	}
+}
+
+// Sub-resources are saved after the ones they reference, so they can be created first and decoded independently:
+// references to other sub-resources only need the (still empty) resource to exist. Properties are then set in file
+// order on the loading thread, so setters run exactly as in a sequential load.
+Error ResourceLoaderBinary::_load_parallel(Span<uint8_t> p_data) {
+	loaded_in_parallel = true;
+
+	LocalVector<DecodedResource> resources;
+	resources.reserve(internal_resources.size());
+	for (int i = 0; i < internal_resources.size(); i++) {
+		DecodedResource decoded;
+		decoded.index = i;
+		Error err = _create_internal_resource(i, decoded.resource, decoded.missing_resource);
+		if (err != OK) {
+			return err;
+		}
+		if (decoded.resource.is_null()) {
+			continue; // Already loaded.
+		}
+		decoded.offset = f->get_position();
+		resources.push_back(decoded);
+	}
+
+	// Complete the loads of dependencies here, as readers can't wait for them from worker threads.
+	for (ExtResource &ext : external_resources) {
+		if (ext.load_token.is_valid()) {
+			Error err;
+			ext.resource = ResourceLoader::_load_complete(*ext.load_token.ptr(), &err);
+			ext.completed = true;
+		}
+	}
+
+	ParallelDecode decode;
+	decode.loader = this;
+	decode.data = p_data;
+	decode.resources = &resources;
+
+	// The loading thread decodes too, so the load completes even if no worker thread is free.
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	const uint32_t helper_count = MIN(resources.size() - 1, (uint32_t)pool->get_thread_count());
+	LocalVector<WorkerThreadPool::TaskID> helpers;
+	helpers.reserve(helper_count);
+	for (uint32_t i = 0; i < helper_count; i++) {
+		helpers.push_back(pool->add_native_task(&ResourceLoaderBinary::_decode_resources, &decode, false, SNAME("Decode Sub-Resources")));
+	}
+	_decode_resources(&decode);
+	for (WorkerThreadPool::TaskID helper : helpers) {
+		pool->wait_for_task_completion(helper);
+	}
+
+	for (DecodedResource &decoded : resources) {
+		if (decoded.error != OK) {
+			error = decoded.error;
+			return error;
+		}
+
+		_set_properties(decoded.resource, decoded.missing_resource, decoded.properties);
+		decoded.properties.clear();
 
 		if (progress) {
-			*progress = (i + 1) / float(internal_resources.size());
+			*progress = (decoded.index + 1) / float(internal_resources.size());
 		}
 
-		resource_cache.push_back(res);
+		resource_cache.push_back(decoded.resource);
 
-		if (main) {
+		if (decoded.index == internal_resources.size() - 1) {
 			f.unref();
-			resource = res;
+			resource = decoded.resource;
 			resource->set_as_translation_remapped(translation_remapped);
 			error = OK;
 			return OK;
@@ -929,6 +1100,10 @@ String ResourceLoaderBinary::get_unicode_string() {
 	if (len == 0) {
 		return String();
 	}
+	Span<uint8_t> view = f->get_buffer_view(len);
+	if (view.size() == (uint64_t)len) {
+		return String::utf8((const char *)view.ptr(), len);
+	}
 	f->get_buffer((uint8_t *)&str_buf[0], len);
 	return String::utf8(&str_buf[0], len);
 }
@@ -33,8 +33,12 @@
 #include "core/io/file_access.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/pair.h"
 #include "core/templates/rb_map.h"
 
+class MissingResource;
+
 class ResourceLoaderBinary {
 	bool translation_remapped = false;
 	String local_path;
@@ -61,6 +65,9 @@ class ResourceLoaderBinary {
 		String type;
 		ResourceUID::ID uid = ResourceUID::INVALID_ID;
 		Ref<ResourceLoader::LoadToken> load_token;
+		// Completed before sub-resources are decoded in parallel.
+		Ref<Resource> resource;
+		bool completed = false;
 	};
 
 	bool using_named_scene_ids = false;
@@ -77,6 +84,8 @@ class ResourceLoaderBinary {
 
 	Vector<IntResource> internal_resources;
 	HashMap<String, Ref<Resource>> internal_index_cache;
+	// Sub-resources that can be referenced, when decoding in parallel: the ones a sequential load would have created already.
+	int visible_internal_resources = INT32_MAX;
 
 	String get_unicode_string();
 	void _advance_padding(uint32_t p_len);
@@ -88,9 +97,32 @@ class ResourceLoaderBinary {
 	ResourceFormatLoader::CacheMode cache_mode_for_external = ResourceFormatLoader::CACHE_MODE_REUSE;
 
 	friend class ResourceFormatLoaderBinary;
+	friend class TestResourceLoaderBinaryAccessor;
 
 	Error parse_variant(Variant &r_v);
 
+	enum {
+		PARALLEL_MIN_RESOURCES = 16,
+	};
+	int parallel_min_threads = 2; // Worker threads needed for decoding in parallel to pay off.
+	bool loaded_in_parallel = false;
+
+	struct DecodedResource {
+		int index = 0;
+		Ref<Resource> resource;
+		MissingResource *missing_resource = nullptr;
+		uint64_t offset = 0; // Of the properties.
+		LocalVector<Pair<StringName, Variant>> properties;
+		Error error = OK;
+	};
+	struct ParallelDecode;
+	static void _decode_resources(void *p_decode);
+
+	Error _create_internal_resource(int p_index, Ref<Resource> &r_res, MissingResource *&r_missing_resource);
+	Error _read_properties(LocalVector<Pair<StringName, Variant>> &r_properties);
+	void _set_properties(const Ref<Resource> &p_res, MissingResource *p_missing_resource, LocalVector<Pair<StringName, Variant>> &p_properties);
+	Error _load_parallel(Span<uint8_t> p_data);
+
 	HashMap<String, Ref<Resource>> dependency_cache;
 
 public:
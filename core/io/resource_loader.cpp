@@ -34,6 +34,7 @@
 #include "core/core_bind.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/io/file_access_pack.h"
 #include "core/io/resource_importer.h"
 #include "core/object/script_language.h"
 #include "core/os/condition_variable.h"
@@ -303,6 +304,20 @@ Ref<Resource> ResourceLoader::_load(const String &p_path, const String &p_origin
 
 	print_verbose(vformat("Loading resource: %s", p_path));
 
+	int64_t load_trace_index = -1;
+	if (unlikely(load_trace_enabled.is_set())) {
+		MutexLock lock(load_trace_mutex);
+		if (!load_trace_indices.has(p_path)) {
+			LoadTraceEntry entry;
+			entry.path = p_path;
+			entry.offset = PackedData::get_singleton() ? PackedData::get_singleton()->get_offset(p_path) : -1;
+			entry.start_usec = OS::get_singleton()->get_ticks_usec() - load_trace_start_usec;
+			load_trace_index = load_trace.size();
+			load_trace_indices.insert(p_path, load_trace_index);
+			load_trace.push_back(entry);
+		}
+	}
+
 	// Try all loaders and pick the first match for the type hint
 	bool found = false;
 	Ref<Resource> res;
@@ -317,6 +332,15 @@ Ref<Resource> ResourceLoader::_load(const String &p_path, const String &p_origin
 		}
 	}
 
+	if (load_trace_index >= 0) {
+		MutexLock lock(load_trace_mutex);
+		// The trace may have been saved and cleared in the meantime.
+		if (load_trace_index < load_trace.size()) {
+			LoadTraceEntry &entry = load_trace[load_trace_index];
+			entry.duration_usec = OS::get_singleton()->get_ticks_usec() - load_trace_start_usec - entry.start_usec;
+		}
+	}
+
 	load_paths_stack.resize(load_paths_stack.size() - 1);
 	res_ref_overrides.erase(load_nesting);
 	load_nesting--;
@@ -1555,6 +1579,50 @@ Vector<String> ResourceLoader::list_directory(const String &p_directory) {
 	return ret;
 }
 
+void ResourceLoader::_load_trace_file_opened(const String &p_path, uint64_t p_offset) {
+	// Resources are often stored under other paths than the one they are loaded from (imported files,
+	// remaps), so the files actually read from packs are part of the trace too.
+	MutexLock lock(load_trace_mutex);
+	if (!load_trace_enabled.is_set() || load_trace_indices.has(p_path)) {
+		return;
+	}
+
+	LoadTraceEntry entry;
+	entry.path = p_path;
+	entry.offset = p_offset;
+	entry.start_usec = OS::get_singleton()->get_ticks_usec() - load_trace_start_usec;
+	load_trace_indices.insert(p_path, load_trace.size());
+	load_trace.push_back(entry);
+}
+
+void ResourceLoader::start_load_trace() {
+	MutexLock lock(load_trace_mutex);
+	load_trace.clear();
+	load_trace_indices.clear();
+	load_trace_start_usec = OS::get_singleton()->get_ticks_usec();
+	load_trace_enabled.set();
+	PackedData::set_file_open_notify_callback(&ResourceLoader::_load_trace_file_opened);
+}
+
+// Saves the trace as tab-separated lines: path, offset in its pack, start and duration of the load in microseconds.
+Error ResourceLoader::save_load_trace(const String &p_path) {
+	MutexLock lock(load_trace_mutex);
+	ERR_FAIL_COND_V_MSG(!load_trace_enabled.is_set(), ERR_UNCONFIGURED, "No load trace is being recorded.");
+	load_trace_enabled.clear();
+	PackedData::set_file_open_notify_callback(nullptr);
+
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(f.is_null(), err, vformat("Can't open load trace file for writing: '%s'.", p_path));
+	for (const LoadTraceEntry &entry : load_trace) {
+		f->store_line(vformat("%s\t%d\t%d\t%d", entry.path, entry.offset, entry.start_usec, entry.duration_usec));
+	}
+	load_trace.clear();
+	load_trace_indices.clear();
+
+	return OK;
+}
+
 void ResourceLoader::initialize() {}
 
 void ResourceLoader::finalize() {}
@@ -1584,6 +1652,12 @@ bool ResourceLoader::cleaning_tasks = false;
 
 HashMap<String, ResourceLoader::LoadToken *> ResourceLoader::user_load_tokens;
 
+SafeFlag ResourceLoader::load_trace_enabled;
+uint64_t ResourceLoader::load_trace_start_usec = 0;
+Mutex ResourceLoader::load_trace_mutex;
+LocalVector<ResourceLoader::LoadTraceEntry> ResourceLoader::load_trace;
+HashMap<String, uint32_t> ResourceLoader::load_trace_indices;
+
 SelfList<Resource>::List ResourceLoader::remapped_list;
 HashMap<String, Vector<String>> ResourceLoader::translation_remaps;
 
@@ -224,6 +224,20 @@ private:
 
 	static HashMap<String, LoadToken *> user_load_tokens;
 
+	// First load of each resource during a recorded run, used to lay out packs in load order.
+	struct LoadTraceEntry {
+		String path;
+		int64_t offset = -1; // In its pack, -1 if not loaded from one.
+		uint64_t start_usec = 0;
+		uint64_t duration_usec = 0;
+	};
+	static SafeFlag load_trace_enabled;
+	static uint64_t load_trace_start_usec;
+	static Mutex load_trace_mutex;
+	static LocalVector<LoadTraceEntry> load_trace;
+	static HashMap<String, uint32_t> load_trace_indices;
+	static void _load_trace_file_opened(const String &p_path, uint64_t p_offset);
+
 	static float _dependency_get_progress(const String &p_path);
 
 	static bool _ensure_load_progress();
@@ -307,6 +321,10 @@ public:
 	static void remove_custom_loaders();
 
 	static void set_create_missing_resources_if_class_unavailable(bool p_enable);
+
+	static void start_load_trace();
+	static Error save_load_trace(const String &p_path);
+	static bool is_recording_load_trace() { return load_trace_enabled.is_set(); }
 	_FORCE_INLINE_ static bool is_creating_missing_resources_if_class_unavailable_enabled() { return create_missing_resources_if_class_unavailable; }
 
 	static Ref<Resource> ensure_resource_ref_override_for_outer_load(const String &p_path, const String &p_res_type);
@@ -39,24 +39,10 @@
 #include "core/string/print_string.h"
 #include "core/string/translation_server.h"
 #include "core/variant/typed_array.h"
+#include "core/variant/variant_internal.h"
 
 #ifdef DEBUG_ENABLED
 
-struct _ObjectDebugLock {
-	ObjectID obj_id;
-
-	_ObjectDebugLock(Object *p_obj) {
-		obj_id = p_obj->get_instance_id();
-		p_obj->_lock_index.ref();
-	}
-	~_ObjectDebugLock() {
-		Object *obj_ptr = ObjectDB::get_instance(obj_id);
-		if (likely(obj_ptr)) {
-			obj_ptr->_lock_index.unref();
-		}
-	}
-};
-
 #define OBJ_DEBUG_LOCK _ObjectDebugLock _debug_lock(this);
 
 #else
@@ -1270,19 +1256,43 @@ Error Object::_emit_signal(const Variant **p_args, int p_argcount, Callable::Cal
 	return emit_signalp(signal, args, argc);
 }
 
+// Calls the native method a signal connection was resolved to, bypassing the
+// lookup and argument conversion done by `Object::callp()` when possible.
+static void _call_slot_method(MethodBind *p_method, Object *p_target, const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
+#ifdef DEBUG_ENABLED
+	_ObjectDebugLock debug_lock(p_target);
+#endif
+
+	// Validated calls read the arguments' internal values directly, so every
+	// argument must already have the exact type expected by the method.
+	// Objects are excluded, since their class is not checked in that path.
+	bool validated = p_argcount == p_method->get_argument_count();
+	for (int i = 0; validated && i < p_argcount; i++) {
+		const Variant::Type type = p_method->get_argument_type(i);
+		validated = type == Variant::NIL || (type != Variant::OBJECT && type == p_args[i]->get_type());
+	}
+
+	if (!validated) {
+		p_method->call(p_target, p_args, p_argcount, r_error);
+		return;
+	}
+
+	Variant ret;
+	if (p_method->has_return()) {
+		VariantInternal::initialize(&ret, p_method->get_argument_type(-1));
+	}
+	r_error.error = Callable::CallError::CALL_OK;
+	p_method->validated_call(p_target, p_args, &ret);
+}
+
 Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int p_argcount) {
 	if (_block_signals) {
 		return ERR_CANT_ACQUIRE_RESOURCE; //no emit, signals blocked
 	}
 
-	constexpr int MAX_SLOTS_ON_STACK = 5;
-	// Don't default initialize the Callable objects on the stack, just reserve the space - we'll memnew_placement() them later.
-	alignas(Callable) uint8_t slot_callable_stack[sizeof(Callable) * MAX_SLOTS_ON_STACK];
-	uint32_t slot_flags_stack[MAX_SLOTS_ON_STACK];
-
-	Callable *slot_callables = (Callable *)slot_callable_stack;
-	uint32_t *slot_flags = slot_flags_stack;
-	uint32_t slot_count = 0;
+	// Connecting or disconnecting during emission copies the targets on write,
+	// so this snapshot stays as it was when the signal was emitted.
+	Vector<SignalData::Target> targets;
 
 	{
 		OBJ_SIGNAL_LOCK
@@ -1298,32 +1308,19 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 			return ERR_UNAVAILABLE;
 		}
 
-		if (s->slot_map.size() > MAX_SLOTS_ON_STACK) {
-			slot_callables = (Callable *)memalloc(sizeof(Callable) * s->slot_map.size());
-			slot_flags = (uint32_t *)memalloc(sizeof(uint32_t) * s->slot_map.size());
-		}
-
-		// Ensure that disconnecting the signal or even deleting the object
-		// will not affect the signal calling.
-		for (const KeyValue<Callable, SignalData::Slot> &slot_kv : s->slot_map) {
-			memnew_placement(&slot_callables[slot_count], Callable(slot_kv.value.conn.callable));
-			slot_flags[slot_count] = slot_kv.value.conn.flags;
-			++slot_count;
-		}
-
-		DEV_ASSERT(slot_count == s->slot_map.size());
+		targets = s->targets;
 
 		// Disconnect all one-shot connections before emitting to prevent recursion.
-		for (uint32_t i = 0; i < slot_count; ++i) {
-			bool disconnect = slot_flags[i] & CONNECT_ONE_SHOT;
+		for (const SignalData::Target &target : targets) {
+			bool disconnect = target.flags & CONNECT_ONE_SHOT;
 #ifdef TOOLS_ENABLED
-			if (disconnect && (slot_flags[i] & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
+			if (disconnect && (target.flags & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
 				// This signal was connected from the editor, and is being edited. Just don't disconnect for now.
 				disconnect = false;
 			}
 #endif
-			if (disconnect) {
-				_disconnect(p_name, slot_callables[i]);
+			if (disconnect && !target.callable.is_null()) {
+				_disconnect(p_name, target.callable);
 			}
 		}
 	}
@@ -1342,14 +1339,26 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 	Vector<const Variant *> append_source_mem;
 	Variant source = this;
 
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		const Callable &callable = slot_callables[i];
-		const uint32_t &flags = slot_flags[i];
+	for (const SignalData::Target &target : targets) {
+		const Callable &callable = target.callable;
+		const uint32_t &flags = target.flags;
+		MethodBind *method = target.method;
+
+		if (callable.is_null()) {
+			// Disconnected before this emission, waiting for the targets to be compacted.
+			continue;
+		}
 
-		if (!callable.is_valid()) {
+		// With a resolved native method, the target existing is enough for the callable to be valid.
+		Object *method_target = method ? callable.get_object() : nullptr;
+		if (method ? !method_target : !callable.is_valid()) {
 			// Target might have been deleted during signal callback, this is expected and OK.
 			continue;
 		}
+		if (method_target && method_target->get_script_instance()) {
+			// Scripts may override the native method, let the callable dispatch it.
+			method = nullptr;
+		}
 
 		const Variant **args = p_args;
 		int argc = p_argcount;
@@ -1384,8 +1393,12 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		} else {
 			Callable::CallError ce;
 			_emitting = true;
-			Variant ret;
-			callable.callp(args, argc, ret, ce);
+			if (method) {
+				_call_slot_method(method, method_target, args, argc, ce);
+			} else {
+				Variant ret;
+				callable.callp(args, argc, ret, ce);
+			}
 			_emitting = false;
 
 			if (ce.error != Callable::CallError::CALL_OK) {
@@ -1409,15 +1422,6 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		}
 	}
 
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		slot_callables[i].~Callable();
-	}
-
-	if (slot_callables != (Callable *)slot_callable_stack) {
-		memfree(slot_callables);
-		memfree(slot_flags);
-	}
-
 	if (pending_unref) {
 		// We have to do the same Ref<T> would do. We can't just use Ref<T>
 		// because it would do the init ref logic, which is something this function
@@ -1653,19 +1657,37 @@ Error Object::connect(const StringName &p_signal, const Callable &p_callable, ui
 	Object *target_object = p_callable.get_object();
 
 	SignalData::Slot slot;
+	SignalData::Target target;
 
 	Connection conn;
 	conn.callable = p_callable;
 	conn.signal = ::Signal(this, p_signal);
 	conn.flags = p_flags;
 	slot.conn = conn;
+	target.callable = p_callable;
+	target.flags = p_flags;
 	if (target_object) {
 		slot.cE = target_object->connections.push_back(conn);
+
+		// Resolve native targets once, so emission doesn't look the method up by name every time.
+		// Extension classes are skipped, as their method binds don't survive a reload.
+		if (p_callable.is_standard() && p_callable.get_method() != CoreStringName(free_)) {
+			MethodBind *method = ClassDB::get_method(target_object->get_class_name(), p_callable.get_method());
+			if (method && !method->is_vararg() && !method->is_static()) {
+				const ClassDB::APIType api = ClassDB::get_api_type(target_object->get_class_name());
+				if (api == ClassDB::API_CORE || api == ClassDB::API_EDITOR) {
+					target.method = method;
+				}
+			}
+		}
 	}
 	if (p_flags & CONNECT_REFERENCE_COUNTED) {
 		slot.reference_count = 1;
 	}
 
+	slot.target_index = s->targets.size();
+	s->targets.push_back(target);
+
 	//use callable version as key, so binds can be ignored
 	s->slot_map[*p_callable.get_base_comparator()] = slot;
 
@@ -1717,6 +1739,23 @@ void Object::disconnect(const StringName &p_signal, const Callable &p_callable)
 	_disconnect(p_signal, p_callable);
 }
 
+void Object::_compact_signal_targets(SignalData *p_signal_data) {
+	// Slots keep connection order, so rebuilding from them keeps the emission order.
+	Vector<SignalData::Target> targets;
+	targets.resize(p_signal_data->slot_map.size());
+	SignalData::Target *targets_ptrw = targets.ptrw();
+	const SignalData::Target *old_targets = p_signal_data->targets.ptr();
+
+	uint32_t index = 0;
+	for (KeyValue<Callable, SignalData::Slot> &slot_kv : p_signal_data->slot_map) {
+		targets_ptrw[index] = old_targets[slot_kv.value.target_index];
+		slot_kv.value.target_index = index++;
+	}
+
+	p_signal_data->targets = targets;
+	p_signal_data->removed_targets = 0;
+}
+
 bool Object::_disconnect(const StringName &p_signal, const Callable &p_callable, bool p_force) {
 	ERR_FAIL_COND_V_MSG(p_callable.is_null(), false, vformat("Cannot disconnect from '%s': the provided callable is null.", p_signal)); // Should use `is_null`, see note in `connect` about the use of `is_valid`.
 	OBJ_SIGNAL_LOCK
@@ -1747,11 +1786,17 @@ bool Object::_disconnect(const StringName &p_signal, const Callable &p_callable,
 		}
 	}
 
+	// Leave a hole instead of shifting the targets that follow, emission skips it.
+	s->targets.write[slot->target_index] = SignalData::Target();
+	s->removed_targets++;
+
 	s->slot_map.erase(*p_callable.get_base_comparator());
 
 	if (s->slot_map.is_empty() && ClassDB::has_signal(get_class_name(), p_signal)) {
 		//not user signal, delete
 		signal_map.erase(p_signal);
+	} else if (s->removed_targets > s->slot_map.size()) {
+		_compact_signal_targets(s);
 	}
 
 	return true;
@@ -2487,9 +2532,10 @@ void postinitialize_handler(Object *p_object) {
 void ObjectDB::debug_objects(DebugFunc p_func, void *p_user_data) {
 	spin_lock.lock();
 
-	for (uint32_t i = 0, count = slot_count; i < slot_max && count != 0; i++) {
-		if (object_slots[i].validator) {
-			p_func(object_slots[i].object, p_user_data);
+	for (uint32_t i = 0, count = slot_count.get(); i < slot_high_water && count != 0; i++) {
+		const ObjectSlot &object_slot = _get_slot(i);
+		if (object_slot.validator.load(std::memory_order_acquire)) {
+			p_func(object_slot.object.load(std::memory_order_acquire), p_user_data);
 			count--;
 		}
 	}
@@ -2543,45 +2589,94 @@ void Object::get_argument_options(const StringName &p_function, int p_idx, List<
 #endif
 
 SpinLock ObjectDB::spin_lock;
-uint32_t ObjectDB::slot_count = 0;
-uint32_t ObjectDB::slot_max = 0;
-ObjectDB::ObjectSlot *ObjectDB::object_slots = nullptr;
-uint64_t ObjectDB::validator_counter = 0;
+SafeNumeric<uint32_t> ObjectDB::slot_count;
+std::atomic<uint32_t> ObjectDB::slot_max = { 0 };
+uint32_t ObjectDB::slot_high_water = 0;
+std::atomic<ObjectDB::ObjectSlot *> ObjectDB::slot_segments[OBJECTDB_SEGMENT_COUNT] = {};
+LocalVector<uint32_t> ObjectDB::free_slots;
+SafeNumeric<uint64_t> ObjectDB::validator_counter;
+thread_local ObjectDB::FreeSlotCache ObjectDB::free_slot_cache;
+
+ObjectDB::FreeSlotCache::~FreeSlotCache() {
+	// Give the slots back when the thread exits, unless ObjectDB is already gone.
+	if (count > 0 && ObjectDB::slot_max.load(std::memory_order_acquire) > 0) {
+		ObjectDB::_release_free_slots(*this, count);
+	}
+}
 
 int ObjectDB::get_object_count() {
-	return slot_count;
+	return slot_count.get();
 }
 
-ObjectID ObjectDB::add_instance(Object *p_object) {
+void ObjectDB::_acquire_free_slots(FreeSlotCache &r_cache) {
+	// Refill half of the cache, so a thread that alternates between creating
+	// and freeing objects doesn't keep going back to the shared list.
+	const uint32_t batch = OBJECTDB_FREE_SLOT_CACHE_SIZE / 2;
+
 	spin_lock.lock();
-	if (unlikely(slot_count == slot_max)) {
-		CRASH_COND(slot_count == (1 << OBJECTDB_SLOT_MAX_COUNT_BITS));
 
-		uint32_t new_slot_max = slot_max > 0 ? slot_max * 2 : 1;
-		object_slots = (ObjectSlot *)memrealloc(object_slots, sizeof(ObjectSlot) * new_slot_max);
-		for (uint32_t i = slot_max; i < new_slot_max; i++) {
-			object_slots[i].object = nullptr;
-			object_slots[i].is_ref_counted = false;
-			object_slots[i].next_free = i;
-			object_slots[i].validator = 0;
+	while (r_cache.count < batch && !free_slots.is_empty()) {
+		r_cache.slots[r_cache.count++] = free_slots[free_slots.size() - 1];
+		free_slots.resize(free_slots.size() - 1);
+	}
+
+	while (r_cache.count < batch) {
+		uint32_t max = slot_max.load(std::memory_order_relaxed);
+		if (unlikely(slot_high_water == max)) {
+			if (unlikely(max == (uint32_t(1) << OBJECTDB_SLOT_MAX_COUNT_BITS))) {
+				if (r_cache.count > 0) {
+					break;
+				}
+				spin_lock.unlock();
+				CRASH_NOW_MSG("ObjectDB is full.");
+			}
+
+			ObjectSlot *segment = (ObjectSlot *)memalloc(sizeof(ObjectSlot) * OBJECTDB_SEGMENT_SIZE);
+			for (uint32_t i = 0; i < OBJECTDB_SEGMENT_SIZE; i++) {
+				memnew_placement(&segment[i], ObjectSlot);
+			}
+			// Publish the segment before the new limit, lookups check the limit first.
+			slot_segments[max >> OBJECTDB_SEGMENT_BITS].store(segment, std::memory_order_release);
+			slot_max.store(max + OBJECTDB_SEGMENT_SIZE, std::memory_order_release);
 		}
-		slot_max = new_slot_max;
+
+		r_cache.slots[r_cache.count++] = slot_high_water++;
 	}
 
-	uint32_t slot = object_slots[slot_count].next_free;
-	if (object_slots[slot].object != nullptr) {
-		spin_lock.unlock();
-		ERR_FAIL_COND_V(object_slots[slot].object != nullptr, ObjectID());
+	spin_lock.unlock();
+}
+
+void ObjectDB::_release_free_slots(FreeSlotCache &r_cache, uint32_t p_count) {
+	DEV_ASSERT(p_count <= r_cache.count);
+
+	spin_lock.lock();
+	for (uint32_t i = 0; i < p_count; i++) {
+		free_slots.push_back(r_cache.slots[--r_cache.count]);
 	}
-	object_slots[slot].object = p_object;
-	object_slots[slot].is_ref_counted = p_object->is_ref_counted();
-	validator_counter = (validator_counter + 1) & OBJECTDB_VALIDATOR_MASK;
-	if (unlikely(validator_counter == 0)) {
-		validator_counter = 1;
+	spin_lock.unlock();
+}
+
+ObjectID ObjectDB::add_instance(Object *p_object) {
+	FreeSlotCache &cache = free_slot_cache;
+	if (unlikely(cache.count == 0)) {
+		_acquire_free_slots(cache);
 	}
-	object_slots[slot].validator = validator_counter;
 
-	uint64_t id = validator_counter;
+	uint32_t slot = cache.slots[--cache.count];
+	ObjectSlot &object_slot = _get_slot(slot);
+	ERR_FAIL_COND_V(object_slot.object.load(std::memory_order_relaxed) != nullptr, ObjectID());
+
+	uint64_t validator;
+	do {
+		validator = validator_counter.increment() & OBJECTDB_VALIDATOR_MASK;
+	} while (unlikely(validator == 0));
+
+	// The object must be visible before the validator that makes the slot valid.
+	object_slot.is_ref_counted = p_object->is_ref_counted();
+	object_slot.object.store(p_object, std::memory_order_release);
+	object_slot.validator.store(validator, std::memory_order_release);
+
+	uint64_t id = validator;
 	id <<= OBJECTDB_SLOT_MAX_COUNT_BITS;
 	id |= uint64_t(slot);
 
@@ -2589,9 +2684,7 @@ ObjectID ObjectDB::add_instance(Object *p_object) {
 		id |= OBJECTDB_REFERENCE_BIT;
 	}
 
-	slot_count++;
-
-	spin_lock.unlock();
+	slot_count.increment();
 
 	return ObjectID(id);
 }
@@ -2599,34 +2692,31 @@ ObjectID ObjectDB::add_instance(Object *p_object) {
 void ObjectDB::remove_instance(Object *p_object) {
 	uint64_t t = p_object->get_instance_id();
 	uint32_t slot = t & OBJECTDB_SLOT_MAX_COUNT_MASK; //slot is always valid on valid object
-
-	spin_lock.lock();
+	ObjectSlot &object_slot = _get_slot(slot);
 
 #ifdef DEBUG_ENABLED
 
-	if (object_slots[slot].object != p_object) {
-		spin_lock.unlock();
-		ERR_FAIL_COND(object_slots[slot].object != p_object);
-	}
+	ERR_FAIL_COND(object_slot.object.load(std::memory_order_relaxed) != p_object);
 	{
 		uint64_t validator = (t >> OBJECTDB_SLOT_MAX_COUNT_BITS) & OBJECTDB_VALIDATOR_MASK;
-		if (object_slots[slot].validator != validator) {
-			spin_lock.unlock();
-			ERR_FAIL_COND(object_slots[slot].validator != validator);
-		}
+		ERR_FAIL_COND(object_slot.validator.load(std::memory_order_relaxed) != validator);
 	}
 
 #endif
-	//decrease slot count
-	slot_count--;
-	//set the free slot properly
-	object_slots[slot_count].next_free = slot;
 	//invalidate, so checks against it fail
-	object_slots[slot].validator = 0;
-	object_slots[slot].is_ref_counted = false;
-	object_slots[slot].object = nullptr;
+	object_slot.validator.store(0, std::memory_order_release);
+	object_slot.is_ref_counted = false;
+	object_slot.object.store(nullptr, std::memory_order_release);
 
-	spin_lock.unlock();
+	//decrease slot count
+	slot_count.decrement();
+
+	//keep the free slot for this thread, handing half back when full
+	FreeSlotCache &cache = free_slot_cache;
+	if (unlikely(cache.count == OBJECTDB_FREE_SLOT_CACHE_SIZE)) {
+		_release_free_slots(cache, OBJECTDB_FREE_SLOT_CACHE_SIZE / 2);
+	}
+	cache.slots[cache.count++] = slot;
 }
 
 void ObjectDB::setup() {
@@ -2636,7 +2726,7 @@ void ObjectDB::setup() {
 void ObjectDB::cleanup() {
 	spin_lock.lock();
 
-	if (slot_count > 0) {
+	if (slot_count.get() > 0) {
 		WARN_PRINT("ObjectDB instances leaked at exit (run with --verbose for details).");
 		if (OS::get_singleton()->is_stdout_verbose()) {
 			// Ensure calling the native classes because if a leaked instance has a script
@@ -2646,9 +2736,11 @@ void ObjectDB::cleanup() {
 			MethodBind *resource_get_path = ClassDB::get_method("Resource", "get_path");
 			Callable::CallError call_error;
 
-			for (uint32_t i = 0, count = slot_count; i < slot_max && count != 0; i++) {
-				if (object_slots[i].validator) {
-					Object *obj = object_slots[i].object;
+			for (uint32_t i = 0, count = slot_count.get(); i < slot_high_water && count != 0; i++) {
+				const ObjectSlot &object_slot = _get_slot(i);
+				uint64_t validator = object_slot.validator.load(std::memory_order_acquire);
+				if (validator) {
+					Object *obj = object_slot.object.load(std::memory_order_acquire);
 
 					String extra_info;
 					if (obj->is_class("Node")) {
@@ -2661,7 +2753,7 @@ void ObjectDB::cleanup() {
 						extra_info = " - Reference count: " + itos((static_cast<RefCounted *>(obj))->get_reference_count());
 					}
 
-					uint64_t id = uint64_t(i) | (uint64_t(object_slots[i].validator) << OBJECTDB_SLOT_MAX_COUNT_BITS) | (object_slots[i].is_ref_counted ? OBJECTDB_REFERENCE_BIT : 0);
+					uint64_t id = uint64_t(i) | (validator << OBJECTDB_SLOT_MAX_COUNT_BITS) | (object_slot.is_ref_counted ? OBJECTDB_REFERENCE_BIT : 0);
 					DEV_ASSERT(id == (uint64_t)obj->get_instance_id()); // We could just use the id from the object, but this check may help catching memory corruption catastrophes.
 					print_line("Leaked instance: " + String(obj->get_class()) + ":" + uitos(id) + extra_info);
 
@@ -2672,9 +2764,18 @@ void ObjectDB::cleanup() {
 		}
 	}
 
-	if (object_slots) {
-		memfree(object_slots);
+	uint32_t max = slot_max.load(std::memory_order_relaxed);
+	slot_max.store(0, std::memory_order_release);
+	for (uint32_t i = 0; i < (max >> OBJECTDB_SEGMENT_BITS); i++) {
+		ObjectSlot *segment = slot_segments[i].exchange(nullptr, std::memory_order_acq_rel);
+		for (uint32_t j = 0; j < OBJECTDB_SEGMENT_SIZE; j++) {
+			segment[j].~ObjectSlot();
+		}
+		memfree(segment);
 	}
+	slot_high_water = 0;
+	free_slots.reset();
+	free_slot_cache.count = 0;
 
 	spin_lock.unlock();
 }
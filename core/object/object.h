@@ -38,6 +38,7 @@
 #include "core/templates/hash_map.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/safe_refcount.h"
 #include "core/variant/variant.h"
 
@@ -628,14 +629,25 @@ private:
 	GDExtensionClassInstancePtr _extension_instance = nullptr;
 
 	struct SignalData {
+		struct Target {
+			Callable callable; // Null once disconnected, until the targets are compacted.
+			uint32_t flags = 0;
+			MethodBind *method = nullptr; // Native target method resolved on connect, called without a name lookup.
+		};
+
 		struct Slot {
 			int reference_count = 0;
 			Connection conn;
 			List<Connection>::Element *cE = nullptr;
+			uint32_t target_index = 0;
 		};
 
 		MethodInfo user;
 		HashMap<Callable, Slot> slot_map;
+		// Targets in connection order. Emission holds a reference to this vector instead of
+		// copying it, so connecting or disconnecting while emitting copies it on write.
+		Vector<Target> targets;
+		uint32_t removed_targets = 0;
 		bool removable = false;
 	};
 	friend struct _ObjectSignalLock;
@@ -795,6 +807,7 @@ protected:
 	static void _get_property_list_from_classdb(const StringName &p_class, List<PropertyInfo> *p_list, bool p_no_inheritance, const Object *p_validator);
 
 	bool _disconnect(const StringName &p_signal, const Callable &p_callable, bool p_force = false);
+	static void _compact_signal_targets(SignalData *p_signal_data);
 	void _define_ancestry(AncestralClass p_class) { _ancestry |= (uint32_t)p_class; }
 	// Prefer using derives_from.
 	bool _has_ancestry(AncestralClass p_class) const { return _ancestry & (uint32_t)p_class; }
@@ -1076,19 +1089,44 @@ class ObjectDB {
 #define OBJECTDB_SLOT_MAX_COUNT_BITS 24
 #define OBJECTDB_SLOT_MAX_COUNT_MASK ((uint64_t(1) << OBJECTDB_SLOT_MAX_COUNT_BITS) - 1)
 #define OBJECTDB_REFERENCE_BIT (uint64_t(1) << (OBJECTDB_SLOT_MAX_COUNT_BITS + OBJECTDB_VALIDATOR_BITS))
+#define OBJECTDB_SEGMENT_BITS 12
+#define OBJECTDB_SEGMENT_SIZE (uint32_t(1) << OBJECTDB_SEGMENT_BITS)
+#define OBJECTDB_SEGMENT_MASK (OBJECTDB_SEGMENT_SIZE - 1)
+#define OBJECTDB_SEGMENT_COUNT (uint32_t(1) << (OBJECTDB_SLOT_MAX_COUNT_BITS - OBJECTDB_SEGMENT_BITS))
+#define OBJECTDB_FREE_SLOT_CACHE_SIZE 64
+
+	// Slots are allocated in fixed-size segments that never move once published,
+	// so lookups don't need to lock: they validate the slot before and after reading it.
+	struct ObjectSlot {
+		std::atomic<uint64_t> validator = { 0 }; // Zero while the slot is free.
+		std::atomic<Object *> object = { nullptr };
+		bool is_ref_counted = false;
+	};
 
-	struct ObjectSlot { // 128 bits per slot.
-		uint64_t validator : OBJECTDB_VALIDATOR_BITS;
-		uint64_t next_free : OBJECTDB_SLOT_MAX_COUNT_BITS;
-		uint64_t is_ref_counted : 1;
-		Object *object = nullptr;
+	// Slots freed by a thread are kept for its next allocations, and only
+	// moved to or from the shared free list in batches.
+	struct FreeSlotCache {
+		uint32_t slots[OBJECTDB_FREE_SLOT_CACHE_SIZE];
+		uint32_t count = 0;
+
+		~FreeSlotCache();
 	};
 
 	static SpinLock spin_lock;
-	static uint32_t slot_count;
-	static uint32_t slot_max;
-	static ObjectSlot *object_slots;
-	static uint64_t validator_counter;
+	static SafeNumeric<uint32_t> slot_count;
+	static std::atomic<uint32_t> slot_max;
+	static uint32_t slot_high_water;
+	static std::atomic<ObjectSlot *> slot_segments[OBJECTDB_SEGMENT_COUNT];
+	static LocalVector<uint32_t> free_slots;
+	static SafeNumeric<uint64_t> validator_counter;
+	static thread_local FreeSlotCache free_slot_cache;
+
+	_ALWAYS_INLINE_ static ObjectSlot &_get_slot(uint32_t p_slot) {
+		return slot_segments[p_slot >> OBJECTDB_SEGMENT_BITS].load(std::memory_order_acquire)[p_slot & OBJECTDB_SEGMENT_MASK];
+	}
+
+	static void _acquire_free_slots(FreeSlotCache &r_cache);
+	static void _release_free_slots(FreeSlotCache &r_cache, uint32_t p_count);
 
 	friend class Object;
 	friend void unregister_core_types();
@@ -1107,20 +1145,21 @@ public:
 		uint64_t id = p_instance_id;
 		uint32_t slot = id & OBJECTDB_SLOT_MAX_COUNT_MASK;
 
-		ERR_FAIL_COND_V(slot >= slot_max, nullptr); // This should never happen unless RID is corrupted.
-
-		spin_lock.lock();
+		ERR_FAIL_COND_V(slot >= slot_max.load(std::memory_order_acquire), nullptr); // This should never happen unless RID is corrupted.
 
+		const ObjectSlot &object_slot = _get_slot(slot);
 		uint64_t validator = (id >> OBJECTDB_SLOT_MAX_COUNT_BITS) & OBJECTDB_VALIDATOR_MASK;
 
-		if (unlikely(object_slots[slot].validator != validator)) {
-			spin_lock.unlock();
+		if (unlikely(object_slot.validator.load(std::memory_order_acquire) != validator)) {
 			return nullptr;
 		}
 
-		Object *object = object_slots[slot].object;
+		Object *object = object_slot.object.load(std::memory_order_acquire);
 
-		spin_lock.unlock();
+		// The slot may have been freed and reused while reading it.
+		if (unlikely(object_slot.validator.load(std::memory_order_acquire) != validator)) {
+			return nullptr;
+		}
 
 		return object;
 	}
@@ -1137,6 +1176,26 @@ public:
 	static int get_object_count();
 };
 
+#ifdef DEBUG_ENABLED
+
+// Prevents an object from being freed while one of its methods is running.
+struct _ObjectDebugLock {
+	ObjectID obj_id;
+
+	_ObjectDebugLock(Object *p_obj) {
+		obj_id = p_obj->get_instance_id();
+		p_obj->_lock_index.ref();
+	}
+	~_ObjectDebugLock() {
+		Object *obj_ptr = ObjectDB::get_instance(obj_id);
+		if (likely(obj_ptr)) {
+			obj_ptr->_lock_index.unref();
+		}
+	}
+};
+
+#endif // DEBUG_ENABLED
+
 // Using `RequiredResult<T>` as the return type indicates that null will only be returned in the case of an error.
 // This allows GDExtension language bindings to use the appropriate error handling mechanism for that language
 // when null is returned (for example, throwing an exception), rather than simply returning the value.
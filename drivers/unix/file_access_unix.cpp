@@ -36,6 +36,7 @@
 #include "core/string/print_string.h"
 
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #if !defined(__FreeBSD__) && !defined(__OpenBSD__) && !defined(__NetBSD__) && !defined(WEB_ENABLED)
@@ -204,6 +205,12 @@ void FileAccessUnix::_close() {
 		return;
 	}
 
+	if (mapped) {
+		munmap(mapped, mapped_length);
+		mapped = nullptr;
+		mapped_length = 0;
+	}
+
 	fclose(f);
 	f = nullptr;
 
@@ -309,6 +316,51 @@ uint64_t FileAccessUnix::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return read;
 }
 
+Span<uint8_t> FileAccessUnix::map_read_only() {
+	ERR_FAIL_NULL_V_MSG(f, Span<uint8_t>(), "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(flags != READ, Span<uint8_t>(), "Only files opened for reading can be mapped.");
+
+#if !defined(WEB_ENABLED)
+	if (!mapped) {
+		int fd = fileno(f);
+		struct stat st = {};
+		if (fstat(fd, &st) != 0 || st.st_size <= 0 || (uint64_t)st.st_size > (uint64_t)SIZE_MAX) {
+			return Span<uint8_t>();
+		}
+
+		void *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (addr == MAP_FAILED) {
+			return Span<uint8_t>();
+		}
+		mapped = (uint8_t *)addr;
+		mapped_length = st.st_size;
+	}
+#endif
+
+	return Span<uint8_t>(mapped, mapped_length);
+}
+
+void FileAccessUnix::read_ahead(uint64_t p_offset, uint64_t p_length) const {
+	ERR_FAIL_NULL_MSG(f, "File must be opened before use.");
+
+	if (mapped) {
+#ifdef MADV_WILLNEED
+		if (p_offset >= mapped_length) {
+			return;
+		}
+		// The range must start on a page boundary.
+		const uint64_t page_size = sysconf(_SC_PAGESIZE);
+		const uint64_t start = p_offset - p_offset % page_size;
+		madvise(mapped + start, MIN(p_offset + p_length, mapped_length) - start, MADV_WILLNEED);
+#endif
+		return;
+	}
+
+#ifdef POSIX_FADV_WILLNEED
+	posix_fadvise(fileno(f), p_offset, p_length, POSIX_FADV_WILLNEED);
+#endif
+}
+
 Error FileAccessUnix::get_error() const {
 	return last_error;
 }
@@ -41,6 +41,8 @@ class FileAccessUnix : public FileAccess {
 	GDSOFTCLASS(FileAccessUnix, FileAccess);
 	FILE *f = nullptr;
 	int flags = 0;
+	uint8_t *mapped = nullptr;
+	uint64_t mapped_length = 0;
 	void check_errors(bool p_write = false) const;
 	mutable Error last_error = OK;
 	String save_path;
@@ -71,6 +73,8 @@ public:
 	virtual bool eof_reached() const override; ///< reading passed EOF
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual Span<uint8_t> map_read_only() override;
+	virtual void read_ahead(uint64_t p_offset, uint64_t p_length) const override;
 
 	virtual Error get_error() const override; ///< get last error
 
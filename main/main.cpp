@@ -210,6 +210,7 @@ static bool project_manager = false;
 static bool cmdline_tool = false;
 static String locale;
 static String log_file;
+static String load_trace_file;
 static bool show_help = false;
 static uint64_t quit_after = 0;
 static OS::ProcessID editor_pid = 0;
@@ -618,6 +619,8 @@ void Main::print_help(const char *p_binary) {
 	print_help_option("", "--fixed-fps is forced when enabled, but it can be used to change movie FPS.\n");
 	print_help_option("", "--disable-vsync can speed up movie writing but makes interaction more difficult.\n");
 	print_help_option("", "--quit-after can be used to specify the number of frames to write.\n");
+	print_help_option("--record-load-trace <file>", "Record the resources loaded and the pack files read during the run, in order, and write them to the specified path on exit.\n");
+	print_help_option("", "The trace can be given to PCKPacker to lay out packs in load order.\n");
 
 	print_help_title("Display options");
 	print_help_option("-f, --fullscreen", "Request fullscreen mode.\n");
@@ -1895,6 +1898,15 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 				OS::get_singleton()->print("Missing write-movie argument, aborting.\n");
 				goto error;
 			}
+		} else if (arg == "--record-load-trace") {
+			if (N) {
+				load_trace_file = N->get();
+				N = N->next();
+				ResourceLoader::start_load_trace();
+			} else {
+				OS::get_singleton()->print("Missing load trace path argument, aborting.\n");
+				goto error;
+			}
 		} else if (arg == "--disable-vsync") {
 			disable_vsync = true;
 		} else if (arg == "--print-fps") {
@@ -5115,6 +5127,10 @@ void Main::cleanup(bool p_force) {
 
 	ResourceLoader::clear_thread_load_tasks();
 
+	if (!load_trace_file.is_empty()) {
+		ResourceLoader::save_load_trace(load_trace_file);
+	}
+
 	ResourceLoader::remove_custom_loaders();
 	ResourceSaver::remove_custom_savers();
 	PropertyListHelper::clear_base_helpers();
@@ -132,6 +132,7 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(NAVIGATION_3D_EDGE_CONNECTION_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_3D_EDGE_FREE_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_3D_OBSTACLE_COUNT);
+	BIND_ENUM_CONSTANT(NAVIGATION_3D_PATH_QUERY_NODE_COUNT);
 #endif // NAVIGATION_3D_DISABLED
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 
@@ -227,6 +228,7 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		PNAME("navigation_3d/edges_connected"),
 		PNAME("navigation_3d/edges_free"),
 		PNAME("navigation_3d/obstacles"),
+		PNAME("navigation_3d/path_query_nodes"),
 #endif // NAVIGATION_3D_DISABLED
 	};
 	static_assert(std_size(names) == MONITOR_MAX);
@@ -451,6 +453,8 @@ double Performance::get_monitor(Monitor p_monitor) const {
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_FREE_COUNT);
 		case NAVIGATION_3D_OBSTACLE_COUNT:
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_OBSTACLE_COUNT);
+		case NAVIGATION_3D_PATH_QUERY_NODE_COUNT:
+			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_PATH_QUERY_NODE_COUNT);
 #endif // NAVIGATION_3D_DISABLED
 
 		default: {
@@ -524,6 +528,7 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
 #endif // _3D_DISABLED
 
 	};
@@ -120,6 +120,7 @@ public:
 		NAVIGATION_3D_EDGE_CONNECTION_COUNT,
 		NAVIGATION_3D_EDGE_FREE_COUNT,
 		NAVIGATION_3D_OBSTACLE_COUNT,
+		NAVIGATION_3D_PATH_QUERY_NODE_COUNT,
 #endif // _3D_DISABLED
 		MONITOR_MAX
 	};
@@ -31,6 +31,7 @@
 #include "gdscript.h"
 
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
@@ -810,6 +811,23 @@ Error GDScript::reload(bool p_keep_state) {
 	}
 #endif
 
+	// A script that was never compiled can be restored from the bytecode cache instead.
+	// Scripts with instances are always recompiled, so their state is kept as usual.
+	const bool use_bytecode_cache = GDScriptBytecodeCache::is_enabled();
+	const bool try_bytecode_cache = use_bytecode_cache && !valid && !has_instances;
+	if (try_bytecode_cache && GDScriptBytecodeCache::load(this) == OK) {
+		can_run = ScriptServer::is_scripting_enabled() || is_tool();
+		if (can_run) {
+			Error err = _static_init();
+			if (err) {
+				reloading = false;
+				return err;
+			}
+		}
+		reloading = false;
+		return OK;
+	}
+
 	valid = false;
 	GDScriptParser parser;
 	Error err;
@@ -865,6 +883,12 @@ Error GDScript::reload(bool p_keep_state) {
 		}
 	}
 
+	// The entry is missing or outdated if it could not be loaded above, otherwise check it before rewriting it.
+	if (use_bytecode_cache && (try_bytecode_cache || !GDScriptBytecodeCache::has_valid_entry(this))) {
+		// Failing to write the cache only means the script is compiled again next time.
+		GDScriptBytecodeCache::save(this);
+	}
+
 #ifdef TOOLS_ENABLED
 	// Done after compilation because it needs the GDScript object's inner class GDScript objects,
 	// which are made by calling make_scripts() within compiler.compile() above.
@@ -1297,8 +1321,12 @@ void GDScript::get_script_signal_list(List<MethodInfo> *r_signals) const {
 	_get_script_signal_list(r_signals, true);
 }
 
+SafeNumeric<uint32_t> GDScript::inline_cache_version_counter;
+
 GDScript::GDScript() :
 		script_list(this) {
+	inline_cache_version.set(inline_cache_version_counter.increment());
+
 	{
 		MutexLock lock(GDScriptLanguage::get_singleton()->mutex);
 
@@ -1411,12 +1439,39 @@ void GDScript::_recurse_replace_function_ptrs(const HashMap<GDScriptFunction *,
 	}
 }
 
+void GDScript::_invalidate_inline_caches() {
+	MutexLock lock(GDScriptLanguage::get_singleton()->mutex);
+
+	SelfList<GDScript> *elem = GDScriptLanguage::get_singleton()->script_list.first();
+	while (elem) {
+		GDScript *script = elem->self();
+		bool affected = false;
+		for (const GDScript *base_script = script; base_script && !affected; base_script = base_script->base.ptr()) {
+			for (const GDScript *owner_script = base_script; owner_script; owner_script = owner_script->_owner) {
+				if (owner_script == this) {
+					affected = true;
+					break;
+				}
+			}
+		}
+		if (affected) {
+			script->inline_cache_version.set(inline_cache_version_counter.increment());
+		}
+		elem = elem->next();
+	}
+}
+
 void GDScript::clear() {
 	if (clearing) {
 		return;
 	}
 	clearing = true;
 
+	if (!destructing) {
+		// A destroyed script has no inheriting scripts left, and a script created at the same address gets a new version.
+		_invalidate_inline_caches();
+	}
+
 	RBSet<GDScriptFunction *> functions_to_clear;
 
 	{
@@ -2819,6 +2874,8 @@ GDScriptLanguage::GDScriptLanguage() {
 	_debug_max_call_stack = GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "debug/settings/gdscript/max_call_stack", PROPERTY_HINT_RANGE, "512," + itos(GDScriptFunction::MAX_CALL_DEPTH - 1) + ",1"), 1024);
 	track_call_stack = GLOBAL_DEF_RST("debug/settings/gdscript/always_track_call_stacks", false);
 	track_locals = GLOBAL_DEF_RST("debug/settings/gdscript/always_track_local_variables", false);
+	GLOBAL_DEF_RST("gdscript/bytecode_cache/enabled", false);
+	GLOBAL_DEF("gdscript/loading/parallel_parsing", true);
 
 #ifdef DEBUG_ENABLED
 	track_call_stack = true;
@@ -2852,6 +2909,7 @@ GDScriptLanguage::GDScriptLanguage() {
 }
 
 GDScriptLanguage::~GDScriptLanguage() {
+	GDScriptFunction::clear_await_frame_pool();
 	singleton = nullptr;
 }
 
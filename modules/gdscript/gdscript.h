@@ -84,6 +84,7 @@ class GDScript : public Script {
 	friend class GDScriptInstance;
 	friend class GDScriptFunction;
 	friend class GDScriptAnalyzer;
+	friend class GDScriptBytecodeCache;
 	friend class GDScriptCompiler;
 	friend class GDScriptDocGen;
 	friend class GDScriptLambdaCallable;
@@ -177,6 +178,15 @@ private:
 	RBSet<Object *> instances;
 	bool destructing = false;
 	bool clearing = false;
+
+	// Inline cache entries resolved for instances of this script are only used while this is unchanged.
+	// Values come from a global counter, so they are never reused, not even by a script at the same address.
+	static SafeNumeric<uint32_t> inline_cache_version_counter;
+	SafeNumeric<uint32_t> inline_cache_version;
+
+	// Must be called whenever the members or functions of the script may have changed.
+	// Also invalidates the scripts inheriting from it and from its inner classes.
+	void _invalidate_inline_caches();
 	//exported members
 	String source;
 	Vector<uint8_t> binary_tokens;
@@ -447,6 +457,7 @@ class GDScriptLanguage : public ScriptLanguage {
 	String _get_global_class_name(const String &p_path, String *r_base_type, String *r_icon_path, bool *r_is_abstract, bool *r_is_tool, LocalVector<String> &r_visited) const;
 
 	friend class GDScriptInstance;
+	friend class GDScriptSamplingProfiler;
 
 	Mutex mutex;
 
@@ -150,6 +150,7 @@ void GDScriptByteCodeGenerator::start_parameters() {
 	if (function->_default_arg_count > 0) {
 		append(GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT);
 		function->default_arguments.push_back(opcodes.size());
+		last_jump_label = opcodes.size();
 	}
 }
 
@@ -183,6 +184,8 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 #endif
 	append_opcode(GDScriptFunction::OPCODE_END);
 
+	thread_jumps();
+
 	for (int i = 0; i < temporaries.size(); i++) {
 		int stack_index = i + max_locals + GDScriptFunction::FIXED_ADDRESSES_MAX;
 		for (int j = 0; j < temporaries[i].bytecode_indices.size(); j++) {
@@ -221,6 +224,8 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		function->_global_names_count = 0;
 	}
 
+	function->_init_inline_caches(inline_cache_count);
+
 	if (opcodes.size()) {
 		function->code = opcodes;
 		function->_code_ptr = &function->code.write[0];
@@ -584,6 +589,141 @@ void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Va
 	}
 }
 
+// Returns the conditional jump fused with the given typed comparison, or `OPCODE_JUMP_IF_NOT` if there is none.
+static GDScriptFunction::Opcode _get_fused_jump_if_not_opcode(int p_compare_opcode) {
+	switch (p_compare_opcode) {
+		case GDScriptFunction::OPCODE_OPERATOR_EQUAL_INT:
+			return GDScriptFunction::OPCODE_JUMP_IF_NOT_EQUAL_INT;
+		case GDScriptFunction::OPCODE_OPERATOR_NOT_EQUAL_INT:
+			return GDScriptFunction::OPCODE_JUMP_IF_NOT_NOT_EQUAL_INT;
+		case GDScriptFunction::OPCODE_OPERATOR_LESS_INT:
+			return GDScriptFunction::OPCODE_JUMP_IF_NOT_LESS_INT;
+		case GDScriptFunction::OPCODE_OPERATOR_LESS_EQUAL_INT:
+			return GDScriptFunction::OPCODE_JUMP_IF_NOT_LESS_EQUAL_INT;
+		case GDScriptFunction::OPCODE_OPERATOR_GREATER_INT:
+			return GDScriptFunction::OPCODE_JUMP_IF_NOT_GREATER_INT;
+		case GDScriptFunction::OPCODE_OPERATOR_GREATER_EQUAL_INT:
+			return GDScriptFunction::OPCODE_JUMP_IF_NOT_GREATER_EQUAL_INT;
+		case GDScriptFunction::OPCODE_OPERATOR_LESS_FLOAT:
+			return GDScriptFunction::OPCODE_JUMP_IF_NOT_LESS_FLOAT;
+		case GDScriptFunction::OPCODE_OPERATOR_LESS_EQUAL_FLOAT:
+			return GDScriptFunction::OPCODE_JUMP_IF_NOT_LESS_EQUAL_FLOAT;
+		case GDScriptFunction::OPCODE_OPERATOR_GREATER_FLOAT:
+			return GDScriptFunction::OPCODE_JUMP_IF_NOT_GREATER_FLOAT;
+		case GDScriptFunction::OPCODE_OPERATOR_GREATER_EQUAL_FLOAT:
+			return GDScriptFunction::OPCODE_JUMP_IF_NOT_GREATER_EQUAL_FLOAT;
+		default:
+			return GDScriptFunction::OPCODE_JUMP_IF_NOT;
+	}
+}
+
+int GDScriptByteCodeGenerator::append_jump_if_not(const Address &p_condition) {
+	// If the condition is a temporary that was just computed by a typed comparison, and nothing jumps
+	// between the two, rewrite the comparison in place into a compare-and-jump. The temporary is then
+	// never written, which is fine since the compiler pops it right after the jump.
+	int pos = last_typed_compare_pos;
+	if (p_condition.mode == Address::TEMPORARY && pos >= 0 && pos + 4 == opcodes.size() && last_jump_label <= pos) {
+		Vector<int> &indices = temporaries.write[p_condition.address].bytecode_indices;
+		if (!indices.is_empty() && indices[indices.size() - 1] == pos + 3) {
+			indices.remove_at(indices.size() - 1);
+			opcodes.write[pos] = _get_fused_jump_if_not_opcode(opcodes[pos]);
+			opcodes.write[pos + 3] = 0; // Jump destination, will be patched.
+			last_typed_compare_pos = -1;
+			return pos + 3;
+		}
+	}
+
+	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
+	append(p_condition);
+	int jump_pos = opcodes.size();
+	append(0); // Jump destination, will be patched.
+	return jump_pos;
+}
+
+void GDScriptByteCodeGenerator::thread_jumps() {
+	// Retarget jumps landing on an unconditional jump to its final destination, e.g. the end of an
+	// `if` block at the end of a loop body jumps straight back to the loop condition.
+	for (int operand : jump_operands) {
+		int to = opcodes[operand];
+		for (int i = 0; i < 8 && to < opcodes.size() && opcodes[to] == GDScriptFunction::OPCODE_JUMP && opcodes[to + 1] != to; i++) {
+			to = opcodes[to + 1];
+		}
+		opcodes.write[operand] = to;
+	}
+}
+
+// Returns the opcode operating directly on the operand values, or `OPCODE_OPERATOR_VALIDATED` if there is none.
+static GDScriptFunction::Opcode _get_typed_operator_opcode(Variant::Operator p_operator, Variant::Type p_left_type, Variant::Type p_right_type) {
+	if (p_left_type == Variant::INT && p_right_type == Variant::INT) {
+		switch (p_operator) {
+			case Variant::OP_ADD:
+				return GDScriptFunction::OPCODE_OPERATOR_ADD_INT;
+			case Variant::OP_SUBTRACT:
+				return GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_INT;
+			case Variant::OP_MULTIPLY:
+				return GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_INT;
+			case Variant::OP_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_EQUAL_INT;
+			case Variant::OP_NOT_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_NOT_EQUAL_INT;
+			case Variant::OP_LESS:
+				return GDScriptFunction::OPCODE_OPERATOR_LESS_INT;
+			case Variant::OP_LESS_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_LESS_EQUAL_INT;
+			case Variant::OP_GREATER:
+				return GDScriptFunction::OPCODE_OPERATOR_GREATER_INT;
+			case Variant::OP_GREATER_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_GREATER_EQUAL_INT;
+			default:
+				break;
+		}
+	} else if (p_left_type == Variant::FLOAT && p_right_type == Variant::FLOAT) {
+		switch (p_operator) {
+			case Variant::OP_ADD:
+				return GDScriptFunction::OPCODE_OPERATOR_ADD_FLOAT;
+			case Variant::OP_SUBTRACT:
+				return GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_FLOAT;
+			case Variant::OP_MULTIPLY:
+				return GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_FLOAT;
+			case Variant::OP_DIVIDE:
+				return GDScriptFunction::OPCODE_OPERATOR_DIVIDE_FLOAT;
+			case Variant::OP_LESS:
+				return GDScriptFunction::OPCODE_OPERATOR_LESS_FLOAT;
+			case Variant::OP_LESS_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_LESS_EQUAL_FLOAT;
+			case Variant::OP_GREATER:
+				return GDScriptFunction::OPCODE_OPERATOR_GREATER_FLOAT;
+			case Variant::OP_GREATER_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_GREATER_EQUAL_FLOAT;
+			default:
+				break;
+		}
+	} else if (p_left_type == Variant::VECTOR2 && (p_right_type == Variant::VECTOR2 || p_right_type == Variant::FLOAT)) {
+		switch (p_operator) {
+			case Variant::OP_ADD:
+				return p_right_type == Variant::VECTOR2 ? GDScriptFunction::OPCODE_OPERATOR_ADD_VECTOR2 : GDScriptFunction::OPCODE_OPERATOR_VALIDATED;
+			case Variant::OP_SUBTRACT:
+				return p_right_type == Variant::VECTOR2 ? GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_VECTOR2 : GDScriptFunction::OPCODE_OPERATOR_VALIDATED;
+			case Variant::OP_MULTIPLY:
+				return p_right_type == Variant::VECTOR2 ? GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR2 : GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR2_FLOAT;
+			default:
+				break;
+		}
+	} else if (p_left_type == Variant::VECTOR3 && (p_right_type == Variant::VECTOR3 || p_right_type == Variant::FLOAT)) {
+		switch (p_operator) {
+			case Variant::OP_ADD:
+				return p_right_type == Variant::VECTOR3 ? GDScriptFunction::OPCODE_OPERATOR_ADD_VECTOR3 : GDScriptFunction::OPCODE_OPERATOR_VALIDATED;
+			case Variant::OP_SUBTRACT:
+				return p_right_type == Variant::VECTOR3 ? GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_VECTOR3 : GDScriptFunction::OPCODE_OPERATOR_VALIDATED;
+			case Variant::OP_MULTIPLY:
+				return p_right_type == Variant::VECTOR3 ? GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR3 : GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT;
+			default:
+				break;
+		}
+	}
+	return GDScriptFunction::OPCODE_OPERATOR_VALIDATED;
+}
+
 void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, Variant::Operator p_operator, const Address &p_left_operand, const Address &p_right_operand) {
 	bool valid = HAS_BUILTIN_TYPE(p_left_operand) && HAS_BUILTIN_TYPE(p_right_operand);
 
@@ -613,6 +753,19 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 			}
 		}
 
+		// Use a dedicated opcode for common numeric operators, to avoid calling the evaluator.
+		GDScriptFunction::Opcode typed_opcode = _get_typed_operator_opcode(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
+		if (typed_opcode != GDScriptFunction::OPCODE_OPERATOR_VALIDATED) {
+			if (_get_fused_jump_if_not_opcode(typed_opcode) != GDScriptFunction::OPCODE_JUMP_IF_NOT) {
+				last_typed_compare_pos = opcodes.size();
+			}
+			append_opcode(typed_opcode);
+			append(p_left_operand);
+			append(p_right_operand);
+			append(p_target);
+			return;
+		}
+
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 
@@ -694,17 +847,11 @@ void GDScriptByteCodeGenerator::write_type_test(const Address &p_target, const A
 }
 
 void GDScriptByteCodeGenerator::write_and_left_operand(const Address &p_left_operand) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_left_operand);
-	logic_op_jump_pos1.push_back(opcodes.size());
-	append(0); // Jump target, will be patched.
+	logic_op_jump_pos1.push_back(append_jump_if_not(p_left_operand));
 }
 
 void GDScriptByteCodeGenerator::write_and_right_operand(const Address &p_right_operand) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_right_operand);
-	logic_op_jump_pos2.push_back(opcodes.size());
-	append(0); // Jump target, will be patched.
+	logic_op_jump_pos2.push_back(append_jump_if_not(p_right_operand));
 }
 
 void GDScriptByteCodeGenerator::write_end_and(const Address &p_target) {
@@ -713,7 +860,7 @@ void GDScriptByteCodeGenerator::write_end_and(const Address &p_target) {
 	append(p_target);
 	// Jump away from the fail condition.
 	append_opcode(GDScriptFunction::OPCODE_JUMP);
-	append(opcodes.size() + 3);
+	append_jump_target(opcodes.size() + 3);
 	// Here it means one of operands is false.
 	patch_jump(logic_op_jump_pos1.back()->get());
 	patch_jump(logic_op_jump_pos2.back()->get());
@@ -743,7 +890,7 @@ void GDScriptByteCodeGenerator::write_end_or(const Address &p_target) {
 	append(p_target);
 	// Jump away from the success condition.
 	append_opcode(GDScriptFunction::OPCODE_JUMP);
-	append(opcodes.size() + 3);
+	append_jump_target(opcodes.size() + 3);
 	// Here it means one of operands is true.
 	patch_jump(logic_op_jump_pos1.back()->get());
 	patch_jump(logic_op_jump_pos2.back()->get());
@@ -758,10 +905,7 @@ void GDScriptByteCodeGenerator::write_start_ternary(const Address &p_target) {
 }
 
 void GDScriptByteCodeGenerator::write_ternary_condition(const Address &p_condition) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
-	ternary_jump_fail_pos.push_back(opcodes.size());
-	append(0); // Jump target, will be patched.
+	ternary_jump_fail_pos.push_back(append_jump_if_not(p_condition));
 }
 
 void GDScriptByteCodeGenerator::write_ternary_true_expr(const Address &p_expr) {
@@ -862,6 +1006,7 @@ void GDScriptByteCodeGenerator::write_set_named(const Address &p_target, const S
 	append(p_target);
 	append(p_source);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const StringName &p_name, const Address &p_source) {
@@ -880,6 +1025,7 @@ void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const S
 	append(p_source);
 	append(p_target);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_set_member(const Address &p_value, const StringName &p_name) {
@@ -1024,6 +1170,7 @@ void GDScriptByteCodeGenerator::write_assign_default_parameter(const Address &p_
 		write_assign(p_dst, p_src);
 	}
 	function->default_arguments.push_back(opcodes.size());
+	last_jump_label = opcodes.size();
 }
 
 void GDScriptByteCodeGenerator::write_store_global(const Address &p_dst, int p_global_index) {
@@ -1093,6 +1240,7 @@ void GDScriptByteCodeGenerator::write_call(const Address &p_target, const Addres
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1118,6 +1266,7 @@ void GDScriptByteCodeGenerator::write_call_async(const Address &p_target, const
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1352,6 +1501,7 @@ void GDScriptByteCodeGenerator::write_call_self(const Address &p_target, const S
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1365,6 +1515,7 @@ void GDScriptByteCodeGenerator::write_call_self_async(const Address &p_target, c
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1378,6 +1529,7 @@ void GDScriptByteCodeGenerator::write_call_script_function(const Address &p_targ
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1512,10 +1664,7 @@ void GDScriptByteCodeGenerator::write_await(const Address &p_target, const Addre
 }
 
 void GDScriptByteCodeGenerator::write_if(const Address &p_condition) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
-	if_jmp_addrs.push_back(opcodes.size());
-	append(0); // Jump destination, will be patched.
+	if_jmp_addrs.push_back(append_jump_if_not(p_condition));
 }
 
 void GDScriptByteCodeGenerator::write_else() {
@@ -1726,11 +1875,12 @@ void GDScriptByteCodeGenerator::write_for(const Address &p_variable, bool p_use_
 	for_jmp_addrs.push_back(opcodes.size());
 	append(0); // End of loop address, will be patched.
 	append_opcode(GDScriptFunction::OPCODE_JUMP);
-	append(opcodes.size() + (p_is_range ? 7 : 6)); // Skip over 'continue' code.
+	append_jump_target(opcodes.size() + (p_is_range ? 7 : 6)); // Skip over 'continue' code.
 
 	// Next iteration.
 	int continue_addr = opcodes.size();
 	continue_addrs.push_back(continue_addr);
+	last_jump_label = continue_addr;
 	append_opcode(iterate_opcode);
 	append(counter);
 	if (p_is_range) {
@@ -1754,7 +1904,7 @@ void GDScriptByteCodeGenerator::write_for(const Address &p_variable, bool p_use_
 void GDScriptByteCodeGenerator::write_endfor(bool p_is_range) {
 	// Jump back to loop check.
 	append_opcode(GDScriptFunction::OPCODE_JUMP);
-	append(continue_addrs.back()->get());
+	append_jump_target(continue_addrs.back()->get());
 	continue_addrs.pop_back();
 
 	// Patch end jumps (two of them).
@@ -1783,20 +1933,18 @@ void GDScriptByteCodeGenerator::write_endfor(bool p_is_range) {
 void GDScriptByteCodeGenerator::start_while_condition() {
 	current_breaks_to_patch.push_back(List<int>());
 	continue_addrs.push_back(opcodes.size());
+	last_jump_label = opcodes.size();
 }
 
 void GDScriptByteCodeGenerator::write_while(const Address &p_condition) {
 	// Condition check.
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
-	while_jmp_addrs.push_back(opcodes.size());
-	append(0); // End of loop address, will be patched.
+	while_jmp_addrs.push_back(append_jump_if_not(p_condition)); // End of loop address, will be patched.
 }
 
 void GDScriptByteCodeGenerator::write_endwhile() {
 	// Jump back to loop check.
 	append_opcode(GDScriptFunction::OPCODE_JUMP);
-	append(continue_addrs.back()->get());
+	append_jump_target(continue_addrs.back()->get());
 	continue_addrs.pop_back();
 
 	// Patch end jump.
@@ -1818,7 +1966,7 @@ void GDScriptByteCodeGenerator::write_break() {
 
 void GDScriptByteCodeGenerator::write_continue() {
 	append_opcode(GDScriptFunction::OPCODE_JUMP);
-	append(continue_addrs.back()->get());
+	append_jump_target(continue_addrs.back()->get());
 }
 
 void GDScriptByteCodeGenerator::write_breakpoint() {
@@ -100,6 +100,15 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	int current_line = 0;
 	int instr_args_max = 0;
 
+	// Peephole state. Positions of every jump destination operand, so jumps can be threaded once the
+	// function is complete, and the last address that is the target of a jump (a comparison cannot be
+	// fused with the following jump if something may jump in between them).
+	Vector<int> jump_operands;
+	int last_jump_label = 0;
+	int last_typed_compare_pos = -1;
+
+	int inline_cache_count = 0;
+
 #ifdef DEBUG_ENABLED
 	List<int> temp_stack;
 #endif
@@ -451,10 +460,25 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 		opcodes.push_back(get_lambda_function_pos(p_lambda_function));
 	}
 
+	void append_inline_cache() {
+		opcodes.push_back(inline_cache_count++);
+	}
+
+	void append_jump_target(int p_target) {
+		jump_operands.push_back(opcodes.size());
+		last_jump_label = MAX(last_jump_label, p_target);
+		opcodes.push_back(p_target);
+	}
+
 	void patch_jump(int p_address) {
 		opcodes.write[p_address] = opcodes.size();
+		jump_operands.push_back(p_address);
+		last_jump_label = opcodes.size();
 	}
 
+	int append_jump_if_not(const Address &p_condition);
+	void thread_jumps();
+
 public:
 	virtual uint32_t add_parameter(const StringName &p_name, bool p_is_optional, const GDScriptDataType &p_type) override;
 	virtual uint32_t add_local(const StringName &p_name, const GDScriptDataType &p_type) override;
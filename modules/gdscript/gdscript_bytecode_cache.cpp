@@ -0,0 +1,2209 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_bytecode_cache.h"
+
+#include "gdscript.h"
+#include "gdscript_cache.h"
+#include "gdscript_function.h"
+#include "gdscript_utility_functions.h"
+
+#include "core/config/engine.h"
+#include "core/config/project_settings.h"
+#include "core/crypto/crypto_core.h"
+#include "core/debugger/engine_debugger.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/io/marshalls.h"
+#include "core/io/resource_loader.h"
+#include "core/object/class_db.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+#include "core/version.h"
+
+Mutex GDScriptBytecodeCache::mutex;
+HashMap<String, String> GDScriptBytecodeCache::source_md5_cache;
+HashMap<String, Vector<uint8_t>> GDScriptBytecodeCache::pending_buffers;
+
+static constexpr uint8_t BYTECODE_CACHE_MAGIC[4] = { 'G', 'D', 'B', 'C' };
+static constexpr uint32_t BYTECODE_CACHE_HASH_SIZE = 32;
+
+enum BytecodeCacheBuildFlags {
+	BUILD_FLAG_DEBUG = 1 << 0,
+	BUILD_FLAG_TOOLS = 1 << 1,
+	BUILD_FLAG_TRACK_LOCALS = 1 << 2,
+	BUILD_FLAG_TRACK_CALL_STACK = 1 << 3,
+};
+
+enum BytecodeCacheScriptRef {
+	SCRIPT_REF_NONE,
+	SCRIPT_REF_LOCAL, // A class of the script being stored, by its index in the class tree.
+	SCRIPT_REF_GDSCRIPT, // A class of another GDScript file, by path and fully qualified name.
+	SCRIPT_REF_RESOURCE, // A script of another language, by path.
+};
+
+enum BytecodeCacheVariant {
+	VARIANT_VALUE,
+	VARIANT_NULL_OBJECT,
+	VARIANT_NATIVE_CLASS,
+	VARIANT_SCRIPT,
+	VARIANT_RESOURCE,
+	VARIANT_ARRAY,
+	VARIANT_DICTIONARY,
+};
+
+static uint32_t _get_build_flags() {
+	uint32_t flags = 0;
+#ifdef DEBUG_ENABLED
+	flags |= BUILD_FLAG_DEBUG;
+#endif
+#ifdef TOOLS_ENABLED
+	flags |= BUILD_FLAG_TOOLS;
+#endif
+	if (GDScriptLanguage::get_singleton()->should_track_locals()) {
+		flags |= BUILD_FLAG_TRACK_LOCALS;
+	}
+	if (GDScriptLanguage::get_singleton()->should_track_call_stack()) {
+		flags |= BUILD_FLAG_TRACK_CALL_STACK;
+	}
+	return flags;
+}
+
+// Only the version is used, so rebuilding the same engine version keeps the cache.
+// Changes to the bytecode or to the file layout must bump `FORMAT_VERSION` instead.
+static String _get_engine_version() {
+	return GODOT_VERSION_FULL_BUILD;
+}
+
+// The bytecode refers to engine functions by pointer. These tables map the pointers back to
+// the names they can be looked up with, since the pointers change between runs.
+struct BytecodeCacheFunctionNames {
+	struct OperatorKey {
+		Variant::Operator op;
+		Variant::Type type_a;
+		Variant::Type type_b;
+	};
+
+	struct MemberKey {
+		Variant::Type type;
+		StringName name;
+	};
+
+	struct ConstructorKey {
+		Variant::Type type;
+		int index;
+	};
+
+	HashMap<Variant::ValidatedOperatorEvaluator, OperatorKey> operators;
+	HashMap<Variant::ValidatedSetter, MemberKey> setters;
+	HashMap<Variant::ValidatedGetter, MemberKey> getters;
+	HashMap<Variant::ValidatedKeyedSetter, Variant::Type> keyed_setters;
+	HashMap<Variant::ValidatedKeyedGetter, Variant::Type> keyed_getters;
+	HashMap<Variant::ValidatedIndexedSetter, Variant::Type> indexed_setters;
+	HashMap<Variant::ValidatedIndexedGetter, Variant::Type> indexed_getters;
+	HashMap<Variant::ValidatedBuiltInMethod, MemberKey> builtin_methods;
+	HashMap<Variant::ValidatedConstructor, ConstructorKey> constructors;
+	HashMap<Variant::ValidatedUtilityFunction, StringName> utilities;
+	HashMap<GDScriptUtilityFunctions::FunctionPtr, StringName> gds_utilities;
+
+	BytecodeCacheFunctionNames() {
+		for (int i = 0; i < Variant::VARIANT_MAX; i++) {
+			const Variant::Type type = (Variant::Type)i;
+
+			for (int op = 0; op < Variant::OP_MAX; op++) {
+				for (int j = 0; j < Variant::VARIANT_MAX; j++) {
+					Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator((Variant::Operator)op, type, (Variant::Type)j);
+					if (evaluator && !operators.has(evaluator)) {
+						operators.insert(evaluator, { (Variant::Operator)op, type, (Variant::Type)j });
+					}
+				}
+			}
+
+			List<StringName> members;
+			Variant::get_member_list(type, &members);
+			for (const StringName &member : members) {
+				Variant::ValidatedSetter setter = Variant::get_member_validated_setter(type, member);
+				if (setter && !setters.has(setter)) {
+					setters.insert(setter, { type, member });
+				}
+				Variant::ValidatedGetter getter = Variant::get_member_validated_getter(type, member);
+				if (getter && !getters.has(getter)) {
+					getters.insert(getter, { type, member });
+				}
+			}
+
+			Variant::ValidatedKeyedSetter keyed_setter = Variant::get_member_validated_keyed_setter(type);
+			if (keyed_setter && !keyed_setters.has(keyed_setter)) {
+				keyed_setters.insert(keyed_setter, type);
+			}
+			Variant::ValidatedKeyedGetter keyed_getter = Variant::get_member_validated_keyed_getter(type);
+			if (keyed_getter && !keyed_getters.has(keyed_getter)) {
+				keyed_getters.insert(keyed_getter, type);
+			}
+			Variant::ValidatedIndexedSetter indexed_setter = Variant::get_member_validated_indexed_setter(type);
+			if (indexed_setter && !indexed_setters.has(indexed_setter)) {
+				indexed_setters.insert(indexed_setter, type);
+			}
+			Variant::ValidatedIndexedGetter indexed_getter = Variant::get_member_validated_indexed_getter(type);
+			if (indexed_getter && !indexed_getters.has(indexed_getter)) {
+				indexed_getters.insert(indexed_getter, type);
+			}
+
+			List<StringName> methods;
+			Variant::get_builtin_method_list(type, &methods);
+			for (const StringName &method : methods) {
+				Variant::ValidatedBuiltInMethod builtin_method = Variant::get_validated_builtin_method(type, method);
+				if (builtin_method && !builtin_methods.has(builtin_method)) {
+					builtin_methods.insert(builtin_method, { type, method });
+				}
+			}
+
+			for (int j = 0; j < Variant::get_constructor_count(type); j++) {
+				Variant::ValidatedConstructor constructor = Variant::get_validated_constructor(type, j);
+				if (constructor && !constructors.has(constructor)) {
+					constructors.insert(constructor, { type, j });
+				}
+			}
+		}
+
+		List<StringName> functions;
+		Variant::get_utility_function_list(&functions);
+		for (const StringName &function : functions) {
+			Variant::ValidatedUtilityFunction utility = Variant::get_validated_utility_function(function);
+			if (utility && !utilities.has(utility)) {
+				utilities.insert(utility, function);
+			}
+		}
+
+		functions.clear();
+		GDScriptUtilityFunctions::get_function_list(&functions);
+		for (const StringName &function : functions) {
+			GDScriptUtilityFunctions::FunctionPtr utility = GDScriptUtilityFunctions::get_function(function);
+			if (utility && !gds_utilities.has(utility)) {
+				gds_utilities.insert(utility, function);
+			}
+		}
+	}
+};
+
+static const BytecodeCacheFunctionNames &_get_function_names() {
+	static BytecodeCacheFunctionNames names;
+	return names;
+}
+
+class GDScriptBytecodeCache::Serializer {
+	LocalVector<uint8_t> data;
+	HashMap<const GDScript *, uint32_t> local_classes;
+
+public:
+	HashSet<String> external_paths;
+	String error;
+
+	_FORCE_INLINE_ bool has_failed() const { return !error.is_empty(); }
+
+	void fail(const String &p_error) {
+		if (error.is_empty()) {
+			error = p_error;
+		}
+	}
+
+	Vector<uint8_t> get_data() const {
+		Vector<uint8_t> buffer;
+		buffer.resize(data.size());
+		if (data.size()) {
+			memcpy(buffer.ptrw(), data.ptr(), data.size());
+		}
+		return buffer;
+	}
+
+	void put_data(const uint8_t *p_data, uint32_t p_size) {
+		uint32_t pos = data.size();
+		data.resize(pos + p_size);
+		if (p_size) {
+			memcpy(&data[pos], p_data, p_size);
+		}
+	}
+
+	void put_u8(uint8_t p_value) {
+		data.push_back(p_value);
+	}
+
+	void put_u32(uint32_t p_value) {
+		uint32_t pos = data.size();
+		data.resize(pos + 4);
+		encode_uint32(p_value, &data[pos]);
+	}
+
+	void put_string(const String &p_string) {
+		CharString utf8 = p_string.utf8();
+		put_u32(utf8.length());
+		put_data((const uint8_t *)utf8.get_data(), utf8.length());
+	}
+
+	void put_strings(const Vector<String> &p_strings) {
+		put_u32(p_strings.size());
+		for (const String &string : p_strings) {
+			put_string(string);
+		}
+	}
+
+	void write_class_tree(const GDScript *p_class) {
+		local_classes.insert(p_class, local_classes.size());
+		put_string(p_class->fully_qualified_name);
+		put_string(p_class->local_name);
+		put_string(p_class->global_name);
+		put_string(p_class->simplified_icon_path);
+
+		put_u32(p_class->subclasses.size());
+		for (const KeyValue<StringName, Ref<GDScript>> &E : p_class->subclasses) {
+			write_class_tree(E.value.ptr());
+		}
+	}
+
+	void write_script_ref(const Script *p_script) {
+		if (p_script == nullptr) {
+			put_u8(SCRIPT_REF_NONE);
+			return;
+		}
+
+		const GDScript *gdscript = Object::cast_to<GDScript>(p_script);
+		if (gdscript) {
+			if (const uint32_t *index = local_classes.getptr(gdscript)) {
+				put_u8(SCRIPT_REF_LOCAL);
+				put_u32(*index);
+				return;
+			}
+
+			const String script_path = gdscript->get_script_path();
+			if (!script_path.is_resource_file()) {
+				fail(vformat(R"(References the built-in script "%s".)", gdscript->fully_qualified_name));
+				return;
+			}
+			put_u8(SCRIPT_REF_GDSCRIPT);
+			put_string(script_path);
+			put_string(gdscript->fully_qualified_name);
+			external_paths.insert(script_path);
+			return;
+		}
+
+		const String script_path = p_script->get_path();
+		if (!script_path.is_resource_file()) {
+			fail(vformat(R"(References the built-in script "%s".)", script_path));
+			return;
+		}
+		put_u8(SCRIPT_REF_RESOURCE);
+		put_string(script_path);
+	}
+
+	void write_data_type(const GDScriptDataType &p_type) {
+		put_u8(p_type.kind);
+		put_u8(p_type.builtin_type);
+		put_string(p_type.native_type);
+		put_u8(p_type.script_type_ref.is_valid());
+		write_script_ref(p_type.script_type);
+
+		put_u32(p_type.container_element_types.size());
+		for (const GDScriptDataType &element_type : p_type.container_element_types) {
+			write_data_type(element_type);
+		}
+	}
+
+	void write_property_info(const PropertyInfo &p_info) {
+		put_u8(p_info.type);
+		put_string(p_info.name);
+		put_string(p_info.class_name);
+		put_u32(p_info.hint);
+		put_string(p_info.hint_string);
+		put_u32(p_info.usage);
+	}
+
+	void write_method_info(const MethodInfo &p_info) {
+		put_string(p_info.name);
+		write_property_info(p_info.return_val);
+		put_u32(p_info.flags);
+		put_u32(p_info.id);
+		put_u32(p_info.arguments.size());
+		for (const PropertyInfo &argument : p_info.arguments) {
+			write_property_info(argument);
+		}
+		put_u32(p_info.default_arguments.size());
+		for (const Variant &default_argument : p_info.default_arguments) {
+			write_variant(default_argument);
+		}
+		put_u32(p_info.return_val_metadata);
+		put_u32(p_info.arguments_metadata.size());
+		for (int metadata : p_info.arguments_metadata) {
+			put_u32(metadata);
+		}
+	}
+
+	void write_variant(const Variant &p_value) {
+		switch (p_value.get_type()) {
+			case Variant::OBJECT: {
+				Object *object = p_value.get_validated_object();
+				if (object == nullptr) {
+					put_u8(VARIANT_NULL_OBJECT);
+					return;
+				}
+
+				if (const GDScriptNativeClass *native_class = Object::cast_to<GDScriptNativeClass>(object)) {
+					put_u8(VARIANT_NATIVE_CLASS);
+					put_string(native_class->get_name());
+					return;
+				}
+
+				if (const Script *script = Object::cast_to<Script>(object)) {
+					put_u8(VARIANT_SCRIPT);
+					write_script_ref(script);
+					return;
+				}
+
+				if (const Resource *resource = Object::cast_to<Resource>(object)) {
+					const String resource_path = resource->get_path();
+					if (!resource_path.is_resource_file()) {
+						fail(vformat(R"(Holds a built-in resource of type "%s".)", resource->get_class()));
+						return;
+					}
+					put_u8(VARIANT_RESOURCE);
+					put_string(resource_path);
+					put_string(resource->get_class());
+					return;
+				}
+
+				fail(vformat(R"(Holds an object of type "%s".)", object->get_class()));
+			} break;
+
+			case Variant::ARRAY: {
+				const Array array = p_value;
+				put_u8(VARIANT_ARRAY);
+				put_u8(array.is_read_only());
+				put_u8(array.get_typed_builtin());
+				put_string(array.get_typed_class_name());
+				write_script_ref(Object::cast_to<Script>(array.get_typed_script()));
+
+				put_u32(array.size());
+				for (int i = 0; i < array.size(); i++) {
+					write_variant(array[i]);
+				}
+			} break;
+
+			case Variant::DICTIONARY: {
+				const Dictionary dictionary = p_value;
+				put_u8(VARIANT_DICTIONARY);
+				put_u8(dictionary.is_read_only());
+				put_u8(dictionary.get_typed_key_builtin());
+				put_string(dictionary.get_typed_key_class_name());
+				write_script_ref(Object::cast_to<Script>(dictionary.get_typed_key_script()));
+				put_u8(dictionary.get_typed_value_builtin());
+				put_string(dictionary.get_typed_value_class_name());
+				write_script_ref(Object::cast_to<Script>(dictionary.get_typed_value_script()));
+
+				put_u32(dictionary.size());
+				for (int i = 0; i < dictionary.size(); i++) {
+					write_variant(dictionary.get_key_at_index(i));
+					write_variant(dictionary.get_value_at_index(i));
+				}
+			} break;
+
+			case Variant::RID:
+			case Variant::CALLABLE:
+			case Variant::SIGNAL: {
+				fail(vformat(R"(Holds a value of type "%s".)", Variant::get_type_name(p_value.get_type())));
+			} break;
+
+			default: {
+				int len = 0;
+				Error err = encode_variant(p_value, nullptr, len);
+				if (err != OK) {
+					fail(vformat(R"(Cannot encode a value of type "%s".)", Variant::get_type_name(p_value.get_type())));
+					return;
+				}
+				put_u8(VARIANT_VALUE);
+				put_u32(len);
+				uint32_t pos = data.size();
+				data.resize(pos + len);
+				encode_variant(p_value, &data[pos], len);
+			} break;
+		}
+	}
+
+	void write_member_info(const GDScript::MemberInfo &p_info) {
+		put_u32(p_info.index);
+		put_string(p_info.setter);
+		put_string(p_info.getter);
+		write_data_type(p_info.data_type);
+		write_property_info(p_info.property_info);
+	}
+
+	void write_function(const GDScriptFunction *p_function) {
+		const BytecodeCacheFunctionNames &names = _get_function_names();
+
+		put_string(p_function->name);
+		put_u8(p_function->_static);
+		put_u32(p_function->argument_types.size());
+		for (const GDScriptDataType &argument_type : p_function->argument_types) {
+			write_data_type(argument_type);
+		}
+		write_data_type(p_function->return_type);
+		write_method_info(p_function->method_info);
+		write_variant(p_function->rpc_config);
+
+		put_u32(p_function->_initial_line);
+		put_u32(p_function->_argument_count);
+		put_u32(p_function->_vararg_index);
+		put_u32(p_function->_stack_size);
+		put_u32(p_function->_instruction_args_size);
+		put_u32(p_function->_inline_cache_count);
+
+		put_u32(p_function->temporary_slots.size());
+		for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+			put_u32(E.key);
+			put_u8(E.value);
+		}
+
+		put_u32(p_function->stack_debug.size());
+		for (const GDScriptFunction::StackDebug &stack_debug : p_function->stack_debug) {
+			put_u32(stack_debug.line);
+			put_u32(stack_debug.pos);
+			put_u8(stack_debug.added);
+			put_string(stack_debug.identifier);
+		}
+
+		put_u32(p_function->code.size());
+		for (int code : p_function->code) {
+			put_u32(code);
+		}
+		put_u32(p_function->default_arguments.size());
+		for (int default_argument : p_function->default_arguments) {
+			put_u32(default_argument);
+		}
+
+		put_u32(p_function->constants.size());
+		for (const Variant &constant : p_function->constants) {
+			write_variant(constant);
+		}
+		put_u32(p_function->constant_map.size());
+		for (const KeyValue<StringName, Variant> &E : p_function->constant_map) {
+			put_string(E.key);
+			write_variant(E.value);
+		}
+		put_u32(p_function->global_names.size());
+		for (const StringName &global_name : p_function->global_names) {
+			put_string(global_name);
+		}
+
+		put_u32(p_function->operator_funcs.size());
+		for (Variant::ValidatedOperatorEvaluator evaluator : p_function->operator_funcs) {
+			const BytecodeCacheFunctionNames::OperatorKey *key = names.operators.getptr(evaluator);
+			if (key == nullptr) {
+				fail("Uses an unknown operator.");
+				return;
+			}
+			put_u8(key->op);
+			put_u8(key->type_a);
+			put_u8(key->type_b);
+		}
+
+		put_u32(p_function->setters.size());
+		for (Variant::ValidatedSetter setter : p_function->setters) {
+			const BytecodeCacheFunctionNames::MemberKey *key = names.setters.getptr(setter);
+			if (key == nullptr) {
+				fail("Uses an unknown member setter.");
+				return;
+			}
+			put_u8(key->type);
+			put_string(key->name);
+		}
+		put_u32(p_function->getters.size());
+		for (Variant::ValidatedGetter getter : p_function->getters) {
+			const BytecodeCacheFunctionNames::MemberKey *key = names.getters.getptr(getter);
+			if (key == nullptr) {
+				fail("Uses an unknown member getter.");
+				return;
+			}
+			put_u8(key->type);
+			put_string(key->name);
+		}
+
+		put_u32(p_function->keyed_setters.size());
+		for (Variant::ValidatedKeyedSetter setter : p_function->keyed_setters) {
+			const Variant::Type *type = names.keyed_setters.getptr(setter);
+			if (type == nullptr) {
+				fail("Uses an unknown keyed setter.");
+				return;
+			}
+			put_u8(*type);
+		}
+		put_u32(p_function->keyed_getters.size());
+		for (Variant::ValidatedKeyedGetter getter : p_function->keyed_getters) {
+			const Variant::Type *type = names.keyed_getters.getptr(getter);
+			if (type == nullptr) {
+				fail("Uses an unknown keyed getter.");
+				return;
+			}
+			put_u8(*type);
+		}
+		put_u32(p_function->indexed_setters.size());
+		for (Variant::ValidatedIndexedSetter setter : p_function->indexed_setters) {
+			const Variant::Type *type = names.indexed_setters.getptr(setter);
+			if (type == nullptr) {
+				fail("Uses an unknown indexed setter.");
+				return;
+			}
+			put_u8(*type);
+		}
+		put_u32(p_function->indexed_getters.size());
+		for (Variant::ValidatedIndexedGetter getter : p_function->indexed_getters) {
+			const Variant::Type *type = names.indexed_getters.getptr(getter);
+			if (type == nullptr) {
+				fail("Uses an unknown indexed getter.");
+				return;
+			}
+			put_u8(*type);
+		}
+
+		put_u32(p_function->builtin_methods.size());
+		for (Variant::ValidatedBuiltInMethod method : p_function->builtin_methods) {
+			const BytecodeCacheFunctionNames::MemberKey *key = names.builtin_methods.getptr(method);
+			if (key == nullptr) {
+				fail("Uses an unknown built-in method.");
+				return;
+			}
+			put_u8(key->type);
+			put_string(key->name);
+		}
+
+		put_u32(p_function->constructors.size());
+		for (Variant::ValidatedConstructor constructor : p_function->constructors) {
+			const BytecodeCacheFunctionNames::ConstructorKey *key = names.constructors.getptr(constructor);
+			if (key == nullptr) {
+				fail("Uses an unknown constructor.");
+				return;
+			}
+			put_u8(key->type);
+			put_u32(key->index);
+		}
+
+		put_u32(p_function->utilities.size());
+		for (Variant::ValidatedUtilityFunction utility : p_function->utilities) {
+			const StringName *name = names.utilities.getptr(utility);
+			if (name == nullptr) {
+				fail("Uses an unknown utility function.");
+				return;
+			}
+			put_string(*name);
+		}
+		put_u32(p_function->gds_utilities.size());
+		for (GDScriptUtilityFunctions::FunctionPtr utility : p_function->gds_utilities) {
+			const StringName *name = names.gds_utilities.getptr(utility);
+			if (name == nullptr) {
+				fail("Uses an unknown GDScript utility function.");
+				return;
+			}
+			put_string(*name);
+		}
+
+		put_u32(p_function->methods.size());
+		for (const MethodBind *method : p_function->methods) {
+			put_string(method->get_instance_class());
+			put_string(method->get_name());
+		}
+
+		put_u32(p_function->lambdas.size());
+		for (GDScriptFunction *lambda : p_function->lambdas) {
+			const GDScript::LambdaInfo *info = lambda->_script->lambda_info.getptr(lambda);
+			if (info == nullptr) {
+				fail("Has a lambda without capture info.");
+				return;
+			}
+			put_u32(info->capture_count);
+			put_u8(info->use_self);
+			write_function(lambda);
+		}
+
+#ifdef DEBUG_ENABLED
+		put_string(p_function->profile.signature);
+		put_strings(p_function->operator_names);
+		put_strings(p_function->setter_names);
+		put_strings(p_function->getter_names);
+		put_strings(p_function->builtin_methods_names);
+		put_strings(p_function->constructors_names);
+		put_strings(p_function->utilities_names);
+		put_strings(p_function->gds_utilities_names);
+#endif
+	}
+
+	void write_optional_function(const GDScriptFunction *p_function) {
+		put_u8(p_function != nullptr);
+		if (p_function) {
+			write_function(p_function);
+		}
+	}
+
+	void write_class(const GDScript *p_class) {
+		put_u8(p_class->tool);
+		put_u8(p_class->_is_abstract);
+		put_string(p_class->native.is_valid() ? p_class->native->get_name() : StringName());
+		write_script_ref(p_class->base.ptr());
+
+		put_u32(p_class->member_indices.size());
+		for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_class->member_indices) {
+			put_string(E.key);
+			write_member_info(E.value);
+		}
+		put_u32(p_class->members.size());
+		for (const StringName &member : p_class->members) {
+			put_string(member);
+		}
+		put_u32(p_class->static_variables_indices.size());
+		for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_class->static_variables_indices) {
+			put_string(E.key);
+			write_member_info(E.value);
+		}
+
+		put_u32(p_class->constants.size());
+		for (const KeyValue<StringName, Variant> &E : p_class->constants) {
+			put_string(E.key);
+			write_variant(E.value);
+		}
+		put_u32(p_class->_signals.size());
+		for (const KeyValue<StringName, MethodInfo> &E : p_class->_signals) {
+			put_string(E.key);
+			write_method_info(E.value);
+		}
+		write_variant(p_class->rpc_config);
+
+		put_u32(p_class->member_functions.size());
+		for (const KeyValue<StringName, GDScriptFunction *> &E : p_class->member_functions) {
+			write_function(E.value);
+		}
+		write_optional_function(p_class->implicit_initializer);
+		write_optional_function(p_class->implicit_ready);
+		write_optional_function(p_class->static_initializer);
+
+#ifdef TOOLS_ENABLED
+		put_u32(p_class->member_default_values.size());
+		for (const KeyValue<StringName, Variant> &E : p_class->member_default_values) {
+			put_string(E.key);
+			write_variant(E.value);
+		}
+#endif
+
+		for (const KeyValue<StringName, Ref<GDScript>> &E : p_class->subclasses) {
+			write_class(E.value.ptr());
+		}
+	}
+};
+
+class GDScriptBytecodeCache::Deserializer {
+	const uint8_t *data = nullptr;
+	uint32_t size = 0;
+	uint32_t pos = 0;
+
+	GDScript *root = nullptr;
+	LocalVector<GDScript *> local_classes;
+
+public:
+	bool failed = false;
+
+	uint8_t get_u8() {
+		if (failed || pos >= size) {
+			failed = true;
+			return 0;
+		}
+		return data[pos++];
+	}
+
+	uint32_t get_u32() {
+		if (failed || size - pos < 4) {
+			failed = true;
+			return 0;
+		}
+		uint32_t value = decode_uint32(&data[pos]);
+		pos += 4;
+		return value;
+	}
+
+	// Element counts are checked against the remaining data, so a corrupted file cannot cause huge allocations.
+	uint32_t get_count() {
+		uint32_t count = get_u32();
+		if (count > size - pos) {
+			failed = true;
+			return 0;
+		}
+		return count;
+	}
+
+	String get_string() {
+		uint32_t length = get_count();
+		if (failed) {
+			return String();
+		}
+		String string = String::utf8((const char *)&data[pos], length);
+		pos += length;
+		return string;
+	}
+
+	StringName get_string_name() {
+		return StringName(get_string());
+	}
+
+	Vector<String> get_strings() {
+		Vector<String> strings;
+		strings.resize(get_count());
+		for (String &string : strings) {
+			string = get_string();
+		}
+		return strings;
+	}
+
+	Variant::Type get_variant_type() {
+		uint8_t type = get_u8();
+		if (type >= Variant::VARIANT_MAX) {
+			failed = true;
+			return Variant::NIL;
+		}
+		return (Variant::Type)type;
+	}
+
+	Error read_header(const GDScript *p_script) {
+		if (size - pos < 4 || memcmp(data, BYTECODE_CACHE_MAGIC, 4) != 0) {
+			return ERR_FILE_UNRECOGNIZED;
+		}
+		pos += 4;
+		if (get_u32() != FORMAT_VERSION || get_string() != _get_engine_version() || get_u32() != _get_build_flags()) {
+			return ERR_FILE_UNRECOGNIZED;
+		}
+
+		const String source_md5 = get_string();
+		if (failed || source_md5 != _get_script_md5(p_script)) {
+			return ERR_INVALID_DATA;
+		}
+		uint32_t dependency_count = get_count();
+		for (uint32_t i = 0; i < dependency_count; i++) {
+			const String dependency_path = get_string();
+			const String dependency_md5 = get_string();
+			if (failed || dependency_md5 != _get_source_md5(dependency_path)) {
+				return ERR_INVALID_DATA;
+			}
+		}
+
+		// The checksum covers the rest of the file, so a damaged or truncated entry is not restored.
+		if (failed || size - pos < BYTECODE_CACHE_HASH_SIZE) {
+			return ERR_FILE_CORRUPT;
+		}
+		unsigned char content_hash[BYTECODE_CACHE_HASH_SIZE];
+		CryptoCore::sha256(data + pos + BYTECODE_CACHE_HASH_SIZE, size - pos - BYTECODE_CACHE_HASH_SIZE, content_hash);
+		if (memcmp(content_hash, data + pos, BYTECODE_CACHE_HASH_SIZE) != 0) {
+			return ERR_FILE_CORRUPT;
+		}
+		pos += BYTECODE_CACHE_HASH_SIZE;
+		return OK;
+	}
+
+	void read_class_tree(GDScript *p_class) {
+		local_classes.push_back(p_class);
+		p_class->fully_qualified_name = get_string();
+		p_class->local_name = get_string_name();
+		p_class->global_name = get_string_name();
+		p_class->simplified_icon_path = get_string();
+
+		HashMap<StringName, Ref<GDScript>> old_subclasses(p_class->subclasses);
+		p_class->subclasses.clear();
+
+		uint32_t subclass_count = get_count();
+		for (uint32_t i = 0; i < subclass_count && !failed; i++) {
+			// Peek the name of the inner class to reuse its script, like the compiler does.
+			uint32_t start = pos;
+			const String fully_qualified_name = get_string();
+			const StringName name = get_string_name();
+			pos = start;
+			if (failed) {
+				return;
+			}
+
+			Ref<GDScript> subclass;
+			if (old_subclasses.has(name)) {
+				subclass = old_subclasses[name];
+			} else {
+				subclass = GDScriptLanguage::get_singleton()->get_orphan_subclass(fully_qualified_name);
+			}
+			if (subclass.is_null()) {
+				subclass.instantiate();
+			}
+
+			subclass->_owner = p_class;
+			subclass->path = p_class->path;
+			p_class->subclasses.insert(name, subclass);
+
+			read_class_tree(subclass.ptr());
+		}
+	}
+
+	Ref<Script> read_script_ref() {
+		switch (get_u8()) {
+			case SCRIPT_REF_NONE: {
+				return Ref<Script>();
+			}
+			case SCRIPT_REF_LOCAL: {
+				uint32_t index = get_u32();
+				if (index >= local_classes.size()) {
+					break;
+				}
+				return Ref<Script>(local_classes[index]);
+			}
+			case SCRIPT_REF_GDSCRIPT: {
+				const String script_path = get_string();
+				const String fully_qualified_name = get_string();
+				if (failed) {
+					break;
+				}
+				Error err = OK;
+				Ref<GDScript> script = GDScriptCache::get_shallow_script(script_path, err, root->path);
+				if (err != OK || script.is_null()) {
+					break;
+				}
+				GDScript *found = script->find_class(fully_qualified_name);
+				if (found == nullptr) {
+					break;
+				}
+				return Ref<Script>(found);
+			}
+			case SCRIPT_REF_RESOURCE: {
+				const String script_path = get_string();
+				if (failed) {
+					break;
+				}
+				Ref<Script> script = ResourceLoader::load(script_path);
+				if (script.is_null()) {
+					break;
+				}
+				return script;
+			}
+		}
+		failed = true;
+		return Ref<Script>();
+	}
+
+	GDScriptDataType read_data_type() {
+		GDScriptDataType type;
+		uint8_t kind = get_u8();
+		if (kind > GDScriptDataType::GDSCRIPT) {
+			failed = true;
+			return type;
+		}
+		type.kind = (GDScriptDataType::Kind)kind;
+		type.builtin_type = get_variant_type();
+		type.native_type = get_string_name();
+		bool has_script_type_ref = get_u8();
+		Ref<Script> script_type = read_script_ref();
+		type.script_type = script_type.ptr();
+		if (has_script_type_ref) {
+			type.script_type_ref = script_type;
+		}
+
+		type.container_element_types.resize(get_count());
+		for (GDScriptDataType &element_type : type.container_element_types) {
+			element_type = read_data_type();
+		}
+		return type;
+	}
+
+	PropertyInfo read_property_info() {
+		PropertyInfo info;
+		info.type = get_variant_type();
+		info.name = get_string();
+		info.class_name = get_string_name();
+		info.hint = (PropertyHint)get_u32();
+		info.hint_string = get_string();
+		info.usage = get_u32();
+		return info;
+	}
+
+	MethodInfo read_method_info() {
+		MethodInfo info;
+		info.name = get_string();
+		info.return_val = read_property_info();
+		info.flags = get_u32();
+		info.id = get_u32();
+		info.arguments.resize(get_count());
+		for (PropertyInfo &argument : info.arguments) {
+			argument = read_property_info();
+		}
+		info.default_arguments.resize(get_count());
+		for (Variant &default_argument : info.default_arguments) {
+			default_argument = read_variant();
+		}
+		info.return_val_metadata = get_u32();
+		info.arguments_metadata.resize(get_count());
+		for (int &metadata : info.arguments_metadata) {
+			metadata = get_u32();
+		}
+		return info;
+	}
+
+	Variant read_variant() {
+		switch (get_u8()) {
+			case VARIANT_VALUE: {
+				uint32_t length = get_count();
+				if (failed) {
+					break;
+				}
+				Variant value;
+				if (decode_variant(value, &data[pos], length) != OK) {
+					break;
+				}
+				pos += length;
+				return value;
+			}
+			case VARIANT_NULL_OBJECT: {
+				return Variant((Object *)nullptr);
+			}
+			case VARIANT_NATIVE_CLASS: {
+				const StringName name = get_string_name();
+				const HashMap<StringName, int> &global_map = GDScriptLanguage::get_singleton()->get_global_map();
+				if (failed || !global_map.has(name)) {
+					break;
+				}
+				Ref<GDScriptNativeClass> native_class = GDScriptLanguage::get_singleton()->get_global_array()[global_map[name]];
+				if (native_class.is_null()) {
+					break;
+				}
+				return native_class;
+			}
+			case VARIANT_SCRIPT: {
+				Ref<Script> script = read_script_ref();
+				if (script.is_null()) {
+					break;
+				}
+				return script;
+			}
+			case VARIANT_RESOURCE: {
+				const String resource_path = get_string();
+				const String type_hint = get_string();
+				if (failed) {
+					break;
+				}
+				Ref<Resource> resource = ResourceLoader::load(resource_path, type_hint);
+				if (resource.is_null()) {
+					break;
+				}
+				return resource;
+			}
+			case VARIANT_ARRAY: {
+				bool read_only = get_u8();
+				Variant::Type type = get_variant_type();
+				StringName class_name = get_string_name();
+				Ref<Script> script = read_script_ref();
+
+				Array array;
+				if (type != Variant::NIL) {
+					array.set_typed(type, class_name, script);
+				}
+				uint32_t count = get_count();
+				for (uint32_t i = 0; i < count && !failed; i++) {
+					array.push_back(read_variant());
+				}
+				if (read_only) {
+					array.make_read_only();
+				}
+				return array;
+			}
+			case VARIANT_DICTIONARY: {
+				bool read_only = get_u8();
+				Variant::Type key_type = get_variant_type();
+				StringName key_class_name = get_string_name();
+				Ref<Script> key_script = read_script_ref();
+				Variant::Type value_type = get_variant_type();
+				StringName value_class_name = get_string_name();
+				Ref<Script> value_script = read_script_ref();
+
+				Dictionary dictionary;
+				if (key_type != Variant::NIL || value_type != Variant::NIL) {
+					dictionary.set_typed(key_type, key_class_name, key_script, value_type, value_class_name, value_script);
+				}
+				uint32_t count = get_count();
+				for (uint32_t i = 0; i < count && !failed; i++) {
+					Variant key = read_variant();
+					dictionary[key] = read_variant();
+				}
+				if (read_only) {
+					dictionary.make_read_only();
+				}
+				return dictionary;
+			}
+		}
+		failed = true;
+		return Variant();
+	}
+
+	GDScript::MemberInfo read_member_info() {
+		GDScript::MemberInfo info;
+		info.index = get_u32();
+		info.setter = get_string_name();
+		info.getter = get_string_name();
+		info.data_type = read_data_type();
+		info.property_info = read_property_info();
+		return info;
+	}
+
+	GDScriptFunction *read_function(GDScript *p_class) {
+		GDScriptFunction *function = memnew(GDScriptFunction);
+		// Set the script first, the destructor needs it when the function fails to load.
+		function->_script = p_class;
+		function->name = get_string_name();
+		function->source = p_class->get_script_path();
+#ifdef DEBUG_ENABLED
+		function->func_cname = (String(function->source) + " - " + String(function->name)).utf8();
+		function->_func_cname = function->func_cname.get_data();
+#endif
+
+		function->_static = get_u8();
+		function->argument_types.resize(get_count());
+		for (GDScriptDataType &argument_type : function->argument_types) {
+			argument_type = read_data_type();
+		}
+		function->return_type = read_data_type();
+		function->method_info = read_method_info();
+		function->rpc_config = read_variant();
+
+		function->_initial_line = get_u32();
+		function->_argument_count = get_u32();
+		function->_vararg_index = get_u32();
+		function->_stack_size = get_u32();
+		function->_instruction_args_size = get_u32();
+		int inline_cache_count = get_u32();
+
+		uint32_t temporary_slot_count = get_count();
+		for (uint32_t i = 0; i < temporary_slot_count && !failed; i++) {
+			int slot = get_u32();
+			function->temporary_slots[slot] = get_variant_type();
+		}
+
+		uint32_t stack_debug_count = get_count();
+		for (uint32_t i = 0; i < stack_debug_count && !failed; i++) {
+			GDScriptFunction::StackDebug stack_debug;
+			stack_debug.line = get_u32();
+			stack_debug.pos = get_u32();
+			stack_debug.added = get_u8();
+			stack_debug.identifier = get_string_name();
+			function->stack_debug.push_back(stack_debug);
+		}
+
+		function->code.resize(get_count());
+		for (int &code : function->code) {
+			code = get_u32();
+		}
+		function->default_arguments.resize(get_count());
+		for (int &default_argument : function->default_arguments) {
+			default_argument = get_u32();
+		}
+
+		function->constants.resize(get_count());
+		for (Variant &constant : function->constants) {
+			constant = read_variant();
+		}
+		uint32_t constant_map_count = get_count();
+		for (uint32_t i = 0; i < constant_map_count && !failed; i++) {
+			const StringName name = get_string_name();
+			function->constant_map.insert(name, read_variant());
+		}
+		function->global_names.resize(get_count());
+		for (StringName &global_name : function->global_names) {
+			global_name = get_string_name();
+		}
+
+		function->operator_funcs.resize(get_count());
+		for (Variant::ValidatedOperatorEvaluator &evaluator : function->operator_funcs) {
+			uint8_t op = get_u8();
+			Variant::Type type_a = get_variant_type();
+			Variant::Type type_b = get_variant_type();
+			evaluator = op < Variant::OP_MAX ? Variant::get_validated_operator_evaluator((Variant::Operator)op, type_a, type_b) : nullptr;
+			failed = failed || evaluator == nullptr;
+		}
+
+		function->setters.resize(get_count());
+		for (Variant::ValidatedSetter &setter : function->setters) {
+			Variant::Type type = get_variant_type();
+			setter = Variant::get_member_validated_setter(type, get_string_name());
+			failed = failed || setter == nullptr;
+		}
+		function->getters.resize(get_count());
+		for (Variant::ValidatedGetter &getter : function->getters) {
+			Variant::Type type = get_variant_type();
+			getter = Variant::get_member_validated_getter(type, get_string_name());
+			failed = failed || getter == nullptr;
+		}
+
+		function->keyed_setters.resize(get_count());
+		for (Variant::ValidatedKeyedSetter &setter : function->keyed_setters) {
+			setter = Variant::get_member_validated_keyed_setter(get_variant_type());
+			failed = failed || setter == nullptr;
+		}
+		function->keyed_getters.resize(get_count());
+		for (Variant::ValidatedKeyedGetter &getter : function->keyed_getters) {
+			getter = Variant::get_member_validated_keyed_getter(get_variant_type());
+			failed = failed || getter == nullptr;
+		}
+		function->indexed_setters.resize(get_count());
+		for (Variant::ValidatedIndexedSetter &setter : function->indexed_setters) {
+			setter = Variant::get_member_validated_indexed_setter(get_variant_type());
+			failed = failed || setter == nullptr;
+		}
+		function->indexed_getters.resize(get_count());
+		for (Variant::ValidatedIndexedGetter &getter : function->indexed_getters) {
+			getter = Variant::get_member_validated_indexed_getter(get_variant_type());
+			failed = failed || getter == nullptr;
+		}
+
+		function->builtin_methods.resize(get_count());
+		for (Variant::ValidatedBuiltInMethod &method : function->builtin_methods) {
+			Variant::Type type = get_variant_type();
+			method = Variant::get_validated_builtin_method(type, get_string_name());
+			failed = failed || method == nullptr;
+		}
+
+		function->constructors.resize(get_count());
+		for (Variant::ValidatedConstructor &constructor : function->constructors) {
+			Variant::Type type = get_variant_type();
+			int index = get_u32();
+			constructor = index < Variant::get_constructor_count(type) ? Variant::get_validated_constructor(type, index) : nullptr;
+			failed = failed || constructor == nullptr;
+		}
+
+		function->utilities.resize(get_count());
+		for (Variant::ValidatedUtilityFunction &utility : function->utilities) {
+			utility = Variant::get_validated_utility_function(get_string_name());
+			failed = failed || utility == nullptr;
+		}
+		function->gds_utilities.resize(get_count());
+		for (GDScriptUtilityFunctions::FunctionPtr &utility : function->gds_utilities) {
+			utility = GDScriptUtilityFunctions::get_function(get_string_name());
+			failed = failed || utility == nullptr;
+		}
+
+		function->methods.resize(get_count());
+		for (MethodBind *&method : function->methods) {
+			const StringName class_name = get_string_name();
+			method = ClassDB::get_method(class_name, get_string_name());
+			failed = failed || method == nullptr;
+		}
+
+		uint32_t lambda_count = get_count();
+		for (uint32_t i = 0; i < lambda_count && !failed; i++) {
+			GDScript::LambdaInfo info;
+			info.capture_count = get_u32();
+			info.use_self = get_u8();
+			GDScriptFunction *lambda = read_function(p_class);
+			if (lambda == nullptr) {
+				break;
+			}
+			function->lambdas.push_back(lambda);
+			p_class->lambda_info.insert(lambda, info);
+		}
+
+#ifdef DEBUG_ENABLED
+		function->profile.signature = get_string_name();
+		function->operator_names = get_strings();
+		function->setter_names = get_strings();
+		function->getter_names = get_strings();
+		function->builtin_methods_names = get_strings();
+		function->constructors_names = get_strings();
+		function->utilities_names = get_strings();
+		function->gds_utilities_names = get_strings();
+#endif
+
+		Vector<int> operator_caches;
+		failed = failed || !_is_valid_code(function, p_class, function->code, inline_cache_count, &operator_caches);
+		if (failed) {
+			memdelete(function);
+			return nullptr;
+		}
+		// The operator caches hold evaluators of the run that stored the code, if it ran before being stored.
+		constexpr int operator_cache_size = 2 + sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(int);
+		for (int position : operator_caches) {
+			memset(function->code.ptrw() + position, 0, operator_cache_size * sizeof(int));
+		}
+
+		// Same as `GDScriptByteCodeGenerator::write_end()`.
+		function->_code_size = function->code.size();
+		function->_code_ptr = function->code.is_empty() ? nullptr : function->code.ptrw();
+		function->_default_arg_count = function->default_arguments.is_empty() ? 0 : function->default_arguments.size() - 1;
+		function->_default_arg_ptr = function->default_arguments.is_empty() ? nullptr : function->default_arguments.ptr();
+		function->_constant_count = function->constants.size();
+		function->_constants_ptr = function->constants.is_empty() ? nullptr : function->constants.ptrw();
+		function->_global_names_count = function->global_names.size();
+		function->_global_names_ptr = function->global_names.is_empty() ? nullptr : function->global_names.ptr();
+		function->_operator_funcs_count = function->operator_funcs.size();
+		function->_operator_funcs_ptr = function->operator_funcs.is_empty() ? nullptr : function->operator_funcs.ptr();
+		function->_setters_count = function->setters.size();
+		function->_setters_ptr = function->setters.is_empty() ? nullptr : function->setters.ptr();
+		function->_getters_count = function->getters.size();
+		function->_getters_ptr = function->getters.is_empty() ? nullptr : function->getters.ptr();
+		function->_keyed_setters_count = function->keyed_setters.size();
+		function->_keyed_setters_ptr = function->keyed_setters.is_empty() ? nullptr : function->keyed_setters.ptr();
+		function->_keyed_getters_count = function->keyed_getters.size();
+		function->_keyed_getters_ptr = function->keyed_getters.is_empty() ? nullptr : function->keyed_getters.ptr();
+		function->_indexed_setters_count = function->indexed_setters.size();
+		function->_indexed_setters_ptr = function->indexed_setters.is_empty() ? nullptr : function->indexed_setters.ptr();
+		function->_indexed_getters_count = function->indexed_getters.size();
+		function->_indexed_getters_ptr = function->indexed_getters.is_empty() ? nullptr : function->indexed_getters.ptr();
+		function->_builtin_methods_count = function->builtin_methods.size();
+		function->_builtin_methods_ptr = function->builtin_methods.is_empty() ? nullptr : function->builtin_methods.ptr();
+		function->_constructors_count = function->constructors.size();
+		function->_constructors_ptr = function->constructors.is_empty() ? nullptr : function->constructors.ptr();
+		function->_utilities_count = function->utilities.size();
+		function->_utilities_ptr = function->utilities.is_empty() ? nullptr : function->utilities.ptr();
+		function->_gds_utilities_count = function->gds_utilities.size();
+		function->_gds_utilities_ptr = function->gds_utilities.is_empty() ? nullptr : function->gds_utilities.ptr();
+		function->_methods_count = function->methods.size();
+		function->_methods_ptr = function->methods.is_empty() ? nullptr : function->methods.ptrw();
+		function->_lambdas_count = function->lambdas.size();
+		function->_lambdas_ptr = function->lambdas.is_empty() ? nullptr : function->lambdas.ptrw();
+		function->_init_inline_caches(inline_cache_count);
+
+		return function;
+	}
+
+	GDScriptFunction *read_optional_function(GDScript *p_class) {
+		if (!get_u8()) {
+			return nullptr;
+		}
+		GDScriptFunction *function = read_function(p_class);
+		failed = failed || function == nullptr;
+		return function;
+	}
+
+	// Same as the cleanup in `GDScriptCompiler::_prepare_compilation()`.
+	static void clear_class(GDScript *p_class) {
+		p_class->_invalidate_inline_caches();
+		p_class->clearing = true;
+		p_class->cancel_pending_functions(true);
+
+		p_class->native = Ref<GDScriptNativeClass>();
+		p_class->base = Ref<GDScript>();
+		p_class->members.clear();
+
+		// Clear through copies, so freeing a constant or function cannot modify the maps being cleared.
+		HashMap<StringName, Variant> constants(p_class->constants);
+		p_class->constants.clear();
+		constants.clear();
+		HashMap<StringName, GDScriptFunction *> member_functions(p_class->member_functions);
+		p_class->member_functions.clear();
+		for (const KeyValue<StringName, GDScriptFunction *> &E : member_functions) {
+			memdelete(E.value);
+		}
+
+		if (p_class->implicit_initializer) {
+			memdelete(p_class->implicit_initializer);
+		}
+		if (p_class->implicit_ready) {
+			memdelete(p_class->implicit_ready);
+		}
+		if (p_class->static_initializer) {
+			memdelete(p_class->static_initializer);
+		}
+
+		p_class->member_functions.clear();
+		p_class->member_indices.clear();
+		p_class->static_variables_indices.clear();
+		p_class->static_variables.clear();
+		p_class->_signals.clear();
+		p_class->initializer = nullptr;
+		p_class->implicit_initializer = nullptr;
+		p_class->implicit_ready = nullptr;
+		p_class->static_initializer = nullptr;
+		p_class->rpc_config.clear();
+		p_class->lambda_info.clear();
+#ifdef TOOLS_ENABLED
+		p_class->member_default_values.clear();
+#endif
+
+		p_class->clearing = false;
+		p_class->valid = false;
+	}
+
+	void read_class(GDScript *p_class) {
+		clear_class(p_class);
+
+		p_class->tool = get_u8();
+		p_class->_is_abstract = get_u8();
+
+		const StringName native_name = get_string_name();
+		if (native_name != StringName()) {
+			const HashMap<StringName, int> &global_map = GDScriptLanguage::get_singleton()->get_global_map();
+			if (!global_map.has(native_name)) {
+				failed = true;
+				return;
+			}
+			p_class->native = GDScriptLanguage::get_singleton()->get_global_array()[global_map[native_name]];
+			failed = failed || p_class->native.is_null();
+		}
+		p_class->base = read_script_ref();
+
+		uint32_t member_count = get_count();
+		for (uint32_t i = 0; i < member_count && !failed; i++) {
+			const StringName name = get_string_name();
+			p_class->member_indices.insert(name, read_member_info());
+		}
+		member_count = get_count();
+		for (uint32_t i = 0; i < member_count && !failed; i++) {
+			p_class->members.insert(get_string_name());
+		}
+		member_count = get_count();
+		for (uint32_t i = 0; i < member_count && !failed; i++) {
+			const StringName name = get_string_name();
+			p_class->static_variables_indices.insert(name, read_member_info());
+		}
+		p_class->static_variables.resize(p_class->static_variables_indices.size());
+
+		uint32_t constant_count = get_count();
+		for (uint32_t i = 0; i < constant_count && !failed; i++) {
+			const StringName name = get_string_name();
+			p_class->constants.insert(name, read_variant());
+		}
+		uint32_t signal_count = get_count();
+		for (uint32_t i = 0; i < signal_count && !failed; i++) {
+			const StringName name = get_string_name();
+			p_class->_signals.insert(name, read_method_info());
+		}
+		p_class->rpc_config = read_variant();
+
+		uint32_t function_count = get_count();
+		for (uint32_t i = 0; i < function_count && !failed; i++) {
+			GDScriptFunction *function = read_function(p_class);
+			if (function == nullptr) {
+				failed = true;
+				break;
+			}
+			p_class->member_functions[function->get_name()] = function;
+		}
+		if (GDScriptFunction **initializer = p_class->member_functions.getptr(GDScriptLanguage::get_singleton()->strings._init)) {
+			p_class->initializer = *initializer;
+		}
+		p_class->implicit_initializer = read_optional_function(p_class);
+		p_class->implicit_ready = read_optional_function(p_class);
+		p_class->static_initializer = read_optional_function(p_class);
+
+#ifdef TOOLS_ENABLED
+		uint32_t default_value_count = get_count();
+		for (uint32_t i = 0; i < default_value_count && !failed; i++) {
+			const StringName name = get_string_name();
+			p_class->member_default_values.insert(name, read_variant());
+		}
+#endif
+
+		for (KeyValue<StringName, Ref<GDScript>> &E : p_class->subclasses) {
+			if (failed) {
+				return;
+			}
+			read_class(E.value.ptr());
+		}
+	}
+
+	Error read(GDScript *p_root, bool p_shallow) {
+		root = p_root;
+		Error err = read_header(root);
+		if (err != OK) {
+			return err;
+		}
+
+		read_class_tree(root);
+		if (failed) {
+			return ERR_FILE_CORRUPT;
+		}
+		if (p_shallow) {
+			return OK;
+		}
+
+		bool is_static = get_u8();
+		root->_owner = nullptr;
+		read_class(root);
+
+		if (failed) {
+			for (GDScript *local_class : local_classes) {
+				clear_class(local_class);
+			}
+			return ERR_FILE_CORRUPT;
+		}
+
+		for (GDScript *local_class : local_classes) {
+			local_class->_static_default_init();
+			local_class->valid = true;
+		}
+		if (is_static) {
+			GDScriptCache::add_static_script(root);
+		}
+		return OK;
+	}
+
+	Deserializer(const Vector<uint8_t> &p_buffer) :
+			data(p_buffer.ptr()),
+			size(p_buffer.size()) {}
+};
+
+String GDScriptBytecodeCache::_get_script_md5(const GDScript *p_script) {
+	// Use the loaded source rather than the file, it may have been changed after loading.
+	if (!p_script->binary_tokens.is_empty()) {
+		unsigned char md5[16];
+		CryptoCore::md5(p_script->binary_tokens.ptr(), p_script->binary_tokens.size(), md5);
+		return String::hex_encode_buffer(md5, 16);
+	}
+	return p_script->source.md5_text();
+}
+
+String GDScriptBytecodeCache::_get_source_md5(const String &p_path) {
+	MutexLock lock(mutex);
+	if (const String *md5 = source_md5_cache.getptr(p_path)) {
+		return *md5;
+	}
+	String md5 = FileAccess::get_md5(ResourceLoader::path_remap(p_path));
+	source_md5_cache.insert(p_path, md5);
+	return md5;
+}
+
+Vector<uint8_t> GDScriptBytecodeCache::_read_valid_buffer(const GDScript *p_script) {
+	Error err = OK;
+	Vector<uint8_t> buffer = FileAccess::get_file_as_bytes(get_cache_path(p_script->path), &err);
+	if (err != OK || buffer.is_empty()) {
+		return buffer;
+	}
+
+	Deserializer deserializer(buffer);
+	if (deserializer.read_header(p_script) != OK) {
+		return Vector<uint8_t>();
+	}
+	return buffer;
+}
+
+bool GDScriptBytecodeCache::_is_valid_code(const GDScriptFunction *p_function, const GDScript *p_class, const Vector<int> &p_code, int p_inline_cache_count, Vector<int> *r_operator_caches) {
+	typedef GDScriptFunction F;
+
+	const int stack_size = p_function->_stack_size;
+	if (p_function->_argument_count < 0 || stack_size < F::FIXED_ADDRESSES_MAX + p_function->_argument_count || p_function->_instruction_args_size < 0) {
+		return false;
+	}
+	if (p_function->_vararg_index >= stack_size || p_inline_cache_count < 0 || p_inline_cache_count > p_code.size()) {
+		return false;
+	}
+	for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+		if (E.key < F::FIXED_ADDRESSES_MAX || E.key >= stack_size) {
+			return false;
+		}
+	}
+
+	const int *code = p_code.ptr();
+	const int code_size = p_code.size();
+	const int address_limits[F::ADDR_TYPE_MAX] = { stack_size, (int)p_function->constants.size(), (int)p_class->member_indices.size() };
+	LocalVector<bool> instruction_starts;
+	instruction_starts.resize_initialized(code_size + 1);
+	LocalVector<int> jump_targets;
+	bool valid = true;
+
+	int ip = 0;
+	int last_opcode = -1;
+	// Reads the operand at the offset of the current instruction, reading past the code makes it invalid.
+	auto operand = [&](int p_offset) -> int {
+		if (p_offset >= code_size - ip) {
+			valid = false;
+			return 0;
+		}
+		return code[ip + p_offset];
+	};
+	auto check_addresses = [&](int p_offset, int p_count) {
+		for (int i = 0; i < p_count && valid; i++) {
+			const int address = operand(p_offset + i);
+			const int address_type = (address & F::ADDR_TYPE_MASK) >> F::ADDR_BITS;
+			valid = valid && address_type >= 0 && address_type < F::ADDR_TYPE_MAX && (address & F::ADDR_MASK) < address_limits[address_type];
+		}
+	};
+	auto check_index = [&](int p_offset, int p_count) {
+		const int index = operand(p_offset);
+		valid = valid && index >= 0 && index < p_count;
+	};
+	auto check_type = [&](int p_offset) {
+		check_index(p_offset, Variant::VARIANT_MAX);
+	};
+	auto check_jump = [&](int p_offset) {
+		jump_targets.push_back(operand(p_offset));
+	};
+	// Instructions with a variable number of addresses store the count first, followed by the addresses
+	// and the fixed operands. Returns the offset of the first fixed operand.
+	// `p_argc_offset` is the position of the argument count among the fixed operands, the addresses must hold
+	// `argc * p_argc_multiplier + p_extra_args` entries.
+	auto check_instruction_args = [&](int p_argc_offset, int p_extra_args, int p_argc_multiplier) -> int {
+		const int count = operand(1);
+		valid = valid && count >= 0 && count <= p_function->_instruction_args_size;
+		if (!valid) {
+			return 0;
+		}
+		check_addresses(2, count);
+		const int argc = operand(2 + count + p_argc_offset);
+		valid = valid && argc >= 0 && argc <= count && argc * p_argc_multiplier + p_extra_args <= count;
+		return 2 + count;
+	};
+
+	while (valid && ip < code_size) {
+		instruction_starts[ip] = true;
+		const int opcode = code[ip];
+		if (opcode < 0 || opcode > F::OPCODE_END) {
+			return false;
+		}
+		last_opcode = opcode;
+
+		int length = 0;
+		switch (F::Opcode(opcode)) {
+			case F::OPCODE_OPERATOR: {
+				constexpr int _pointer_size = sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(*code);
+				check_addresses(1, 3);
+				check_index(4, Variant::OP_MAX);
+				// The signature, return type and evaluator after the operator are filled in when it first runs.
+				if (r_operator_caches) {
+					r_operator_caches->push_back(ip + 5);
+				}
+				length = 7 + _pointer_size;
+			} break;
+			case F::OPCODE_OPERATOR_VALIDATED: {
+				check_addresses(1, 3);
+				check_index(4, p_function->operator_funcs.size());
+				length = 5;
+			} break;
+			case F::OPCODE_OPERATOR_ADD_INT:
+			case F::OPCODE_OPERATOR_SUBTRACT_INT:
+			case F::OPCODE_OPERATOR_MULTIPLY_INT:
+			case F::OPCODE_OPERATOR_EQUAL_INT:
+			case F::OPCODE_OPERATOR_NOT_EQUAL_INT:
+			case F::OPCODE_OPERATOR_LESS_INT:
+			case F::OPCODE_OPERATOR_LESS_EQUAL_INT:
+			case F::OPCODE_OPERATOR_GREATER_INT:
+			case F::OPCODE_OPERATOR_GREATER_EQUAL_INT:
+			case F::OPCODE_OPERATOR_ADD_FLOAT:
+			case F::OPCODE_OPERATOR_SUBTRACT_FLOAT:
+			case F::OPCODE_OPERATOR_MULTIPLY_FLOAT:
+			case F::OPCODE_OPERATOR_DIVIDE_FLOAT:
+			case F::OPCODE_OPERATOR_LESS_FLOAT:
+			case F::OPCODE_OPERATOR_LESS_EQUAL_FLOAT:
+			case F::OPCODE_OPERATOR_GREATER_FLOAT:
+			case F::OPCODE_OPERATOR_GREATER_EQUAL_FLOAT:
+			case F::OPCODE_OPERATOR_ADD_VECTOR2:
+			case F::OPCODE_OPERATOR_SUBTRACT_VECTOR2:
+			case F::OPCODE_OPERATOR_MULTIPLY_VECTOR2:
+			case F::OPCODE_OPERATOR_MULTIPLY_VECTOR2_FLOAT:
+			case F::OPCODE_OPERATOR_ADD_VECTOR3:
+			case F::OPCODE_OPERATOR_SUBTRACT_VECTOR3:
+			case F::OPCODE_OPERATOR_MULTIPLY_VECTOR3:
+			case F::OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT:
+			case F::OPCODE_SET_KEYED:
+			case F::OPCODE_GET_KEYED:
+			case F::OPCODE_TYPE_TEST_SCRIPT:
+			case F::OPCODE_ASSIGN_TYPED_NATIVE:
+			case F::OPCODE_ASSIGN_TYPED_SCRIPT:
+			case F::OPCODE_CAST_TO_NATIVE:
+			case F::OPCODE_CAST_TO_SCRIPT: {
+				check_addresses(1, 3);
+				length = 4;
+			} break;
+			case F::OPCODE_TYPE_TEST_BUILTIN:
+			case F::OPCODE_ASSIGN_TYPED_BUILTIN:
+			case F::OPCODE_CAST_TO_BUILTIN: {
+				check_addresses(1, 2);
+				check_type(3);
+				length = 4;
+			} break;
+			case F::OPCODE_TYPE_TEST_ARRAY:
+			case F::OPCODE_ASSIGN_TYPED_ARRAY: {
+				check_addresses(1, 3);
+				check_type(4);
+				check_index(5, p_function->global_names.size());
+				length = 6;
+			} break;
+			case F::OPCODE_TYPE_TEST_DICTIONARY:
+			case F::OPCODE_ASSIGN_TYPED_DICTIONARY: {
+				check_addresses(1, 4);
+				check_type(5);
+				check_index(6, p_function->global_names.size());
+				check_type(7);
+				check_index(8, p_function->global_names.size());
+				length = 9;
+			} break;
+			case F::OPCODE_TYPE_TEST_NATIVE: {
+				check_addresses(1, 2);
+				check_index(3, p_function->global_names.size());
+				length = 4;
+			} break;
+			case F::OPCODE_SET_KEYED_VALIDATED: {
+				check_addresses(1, 3);
+				check_index(4, p_function->keyed_setters.size());
+				length = 5;
+			} break;
+			case F::OPCODE_SET_INDEXED_VALIDATED: {
+				check_addresses(1, 3);
+				check_index(4, p_function->indexed_setters.size());
+				length = 5;
+			} break;
+			case F::OPCODE_GET_KEYED_VALIDATED: {
+				check_addresses(1, 3);
+				check_index(4, p_function->keyed_getters.size());
+				length = 5;
+			} break;
+			case F::OPCODE_GET_INDEXED_VALIDATED: {
+				check_addresses(1, 3);
+				check_index(4, p_function->indexed_getters.size());
+				length = 5;
+			} break;
+			case F::OPCODE_SET_NAMED:
+			case F::OPCODE_GET_NAMED: {
+				check_addresses(1, 2);
+				check_index(3, p_function->global_names.size());
+				check_index(4, p_inline_cache_count);
+				length = 5;
+			} break;
+			case F::OPCODE_SET_NAMED_VALIDATED: {
+				check_addresses(1, 2);
+				check_index(3, p_function->setters.size());
+				length = 4;
+			} break;
+			case F::OPCODE_GET_NAMED_VALIDATED: {
+				check_addresses(1, 2);
+				check_index(3, p_function->getters.size());
+				length = 4;
+			} break;
+			case F::OPCODE_SET_MEMBER:
+			case F::OPCODE_GET_MEMBER:
+			case F::OPCODE_STORE_NAMED_GLOBAL: {
+				check_addresses(1, 1);
+				check_index(2, p_function->global_names.size());
+				length = 3;
+			} break;
+			case F::OPCODE_SET_STATIC_VARIABLE:
+			case F::OPCODE_GET_STATIC_VARIABLE: {
+				// The index is checked against the script the class operand holds when the instruction runs.
+				check_addresses(1, 2);
+				check_index(3, INT_MAX);
+				length = 4;
+			} break;
+			case F::OPCODE_ASSIGN: {
+				check_addresses(1, 2);
+				length = 3;
+			} break;
+			case F::OPCODE_ASSIGN_NULL:
+			case F::OPCODE_ASSIGN_TRUE:
+			case F::OPCODE_ASSIGN_FALSE:
+			case F::OPCODE_AWAIT_RESUME:
+			case F::OPCODE_RETURN:
+			case F::OPCODE_TYPE_ADJUST_BOOL:
+			case F::OPCODE_TYPE_ADJUST_INT:
+			case F::OPCODE_TYPE_ADJUST_FLOAT:
+			case F::OPCODE_TYPE_ADJUST_STRING:
+			case F::OPCODE_TYPE_ADJUST_VECTOR2:
+			case F::OPCODE_TYPE_ADJUST_VECTOR2I:
+			case F::OPCODE_TYPE_ADJUST_RECT2:
+			case F::OPCODE_TYPE_ADJUST_RECT2I:
+			case F::OPCODE_TYPE_ADJUST_VECTOR3:
+			case F::OPCODE_TYPE_ADJUST_VECTOR3I:
+			case F::OPCODE_TYPE_ADJUST_TRANSFORM2D:
+			case F::OPCODE_TYPE_ADJUST_VECTOR4:
+			case F::OPCODE_TYPE_ADJUST_VECTOR4I:
+			case F::OPCODE_TYPE_ADJUST_PLANE:
+			case F::OPCODE_TYPE_ADJUST_QUATERNION:
+			case F::OPCODE_TYPE_ADJUST_AABB:
+			case F::OPCODE_TYPE_ADJUST_BASIS:
+			case F::OPCODE_TYPE_ADJUST_TRANSFORM3D:
+			case F::OPCODE_TYPE_ADJUST_PROJECTION:
+			case F::OPCODE_TYPE_ADJUST_COLOR:
+			case F::OPCODE_TYPE_ADJUST_STRING_NAME:
+			case F::OPCODE_TYPE_ADJUST_NODE_PATH:
+			case F::OPCODE_TYPE_ADJUST_RID:
+			case F::OPCODE_TYPE_ADJUST_OBJECT:
+			case F::OPCODE_TYPE_ADJUST_CALLABLE:
+			case F::OPCODE_TYPE_ADJUST_SIGNAL:
+			case F::OPCODE_TYPE_ADJUST_DICTIONARY:
+			case F::OPCODE_TYPE_ADJUST_ARRAY:
+			case F::OPCODE_TYPE_ADJUST_PACKED_BYTE_ARRAY:
+			case F::OPCODE_TYPE_ADJUST_PACKED_INT32_ARRAY:
+			case F::OPCODE_TYPE_ADJUST_PACKED_INT64_ARRAY:
+			case F::OPCODE_TYPE_ADJUST_PACKED_FLOAT32_ARRAY:
+			case F::OPCODE_TYPE_ADJUST_PACKED_FLOAT64_ARRAY:
+			case F::OPCODE_TYPE_ADJUST_PACKED_STRING_ARRAY:
+			case F::OPCODE_TYPE_ADJUST_PACKED_VECTOR2_ARRAY:
+			case F::OPCODE_TYPE_ADJUST_PACKED_VECTOR3_ARRAY:
+			case F::OPCODE_TYPE_ADJUST_PACKED_COLOR_ARRAY:
+			case F::OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY: {
+				check_addresses(1, 1);
+				length = 2;
+			} break;
+			case F::OPCODE_CONSTRUCT: {
+				const int ofs = check_instruction_args(0, 1, 1);
+				check_type(ofs + 1);
+				length = ofs + 2;
+			} break;
+			case F::OPCODE_CONSTRUCT_VALIDATED: {
+				const int ofs = check_instruction_args(0, 1, 1);
+				check_index(ofs + 1, p_function->constructors.size());
+				length = ofs + 2;
+			} break;
+			case F::OPCODE_CONSTRUCT_ARRAY: {
+				length = check_instruction_args(0, 1, 1) + 1;
+			} break;
+			case F::OPCODE_CONSTRUCT_TYPED_ARRAY: {
+				const int ofs = check_instruction_args(0, 2, 1);
+				check_type(ofs + 1);
+				check_index(ofs + 2, p_function->global_names.size());
+				length = ofs + 3;
+			} break;
+			case F::OPCODE_CONSTRUCT_DICTIONARY: {
+				length = check_instruction_args(0, 1, 2) + 1;
+			} break;
+			case F::OPCODE_CONSTRUCT_TYPED_DICTIONARY: {
+				const int ofs = check_instruction_args(0, 3, 2);
+				check_type(ofs + 1);
+				check_index(ofs + 2, p_function->global_names.size());
+				check_type(ofs + 3);
+				check_index(ofs + 4, p_function->global_names.size());
+				length = ofs + 5;
+			} break;
+			case F::OPCODE_CALL:
+			case F::OPCODE_CALL_RETURN:
+			case F::OPCODE_CALL_ASYNC: {
+				const int ofs = check_instruction_args(0, opcode == F::OPCODE_CALL ? 1 : 2, 1);
+				check_index(ofs + 1, p_function->global_names.size());
+				check_index(ofs + 2, p_inline_cache_count);
+				length = ofs + 3;
+			} break;
+			case F::OPCODE_CALL_METHOD_BIND:
+			case F::OPCODE_CALL_METHOD_BIND_RET: {
+				const int ofs = check_instruction_args(0, opcode == F::OPCODE_CALL_METHOD_BIND ? 1 : 2, 1);
+				check_index(ofs + 1, p_function->methods.size());
+				length = ofs + 2;
+			} break;
+			case F::OPCODE_CALL_BUILTIN_STATIC: {
+				const int ofs = check_instruction_args(2, 1, 1);
+				check_type(ofs);
+				check_index(ofs + 1, p_function->global_names.size());
+				length = ofs + 3;
+			} break;
+			case F::OPCODE_CALL_NATIVE_STATIC: {
+				const int ofs = check_instruction_args(1, 1, 1);
+				check_index(ofs, p_function->methods.size());
+				length = ofs + 2;
+			} break;
+			case F::OPCODE_CALL_NATIVE_STATIC_VALIDATED_RETURN:
+			case F::OPCODE_CALL_NATIVE_STATIC_VALIDATED_NO_RETURN: {
+				const int ofs = check_instruction_args(0, 1, 1);
+				check_index(ofs + 1, p_function->methods.size());
+				length = ofs + 2;
+			} break;
+			case F::OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN:
+			case F::OPCODE_CALL_METHOD_BIND_VALIDATED_NO_RETURN: {
+				const int ofs = check_instruction_args(0, 2, 1);
+				check_index(ofs + 1, p_function->methods.size());
+				length = ofs + 2;
+			} break;
+			case F::OPCODE_CALL_BUILTIN_TYPE_VALIDATED: {
+				const int ofs = check_instruction_args(0, 2, 1);
+				check_index(ofs + 1, p_function->builtin_methods.size());
+				length = ofs + 2;
+			} break;
+			case F::OPCODE_CALL_UTILITY:
+			case F::OPCODE_CALL_SELF_BASE: {
+				const int ofs = check_instruction_args(0, 1, 1);
+				check_index(ofs + 1, p_function->global_names.size());
+				length = ofs + 2;
+			} break;
+			case F::OPCODE_CALL_UTILITY_VALIDATED: {
+				const int ofs = check_instruction_args(0, 1, 1);
+				check_index(ofs + 1, p_function->utilities.size());
+				length = ofs + 2;
+			} break;
+			case F::OPCODE_CALL_GDSCRIPT_UTILITY: {
+				const int ofs = check_instruction_args(0, 1, 1);
+				check_index(ofs + 1, p_function->gds_utilities.size());
+				length = ofs + 2;
+			} break;
+			case F::OPCODE_CREATE_LAMBDA:
+			case F::OPCODE_CREATE_SELF_LAMBDA: {
+				const int ofs = check_instruction_args(0, 1, 1);
+				check_index(ofs + 1, p_function->lambdas.size());
+				length = ofs + 2;
+			} break;
+			case F::OPCODE_AWAIT: {
+				// Awaiting a value that is not a signal writes it to the target of the next instruction.
+				check_addresses(1, 1);
+				valid = valid && operand(2) == F::OPCODE_AWAIT_RESUME;
+				length = 2;
+			} break;
+			case F::OPCODE_JUMP: {
+				check_jump(1);
+				length = 2;
+			} break;
+			case F::OPCODE_JUMP_IF:
+			case F::OPCODE_JUMP_IF_NOT:
+			case F::OPCODE_JUMP_IF_SHARED: {
+				check_addresses(1, 1);
+				check_jump(2);
+				length = 3;
+			} break;
+			case F::OPCODE_JUMP_IF_NOT_EQUAL_INT:
+			case F::OPCODE_JUMP_IF_NOT_NOT_EQUAL_INT:
+			case F::OPCODE_JUMP_IF_NOT_LESS_INT:
+			case F::OPCODE_JUMP_IF_NOT_LESS_EQUAL_INT:
+			case F::OPCODE_JUMP_IF_NOT_GREATER_INT:
+			case F::OPCODE_JUMP_IF_NOT_GREATER_EQUAL_INT:
+			case F::OPCODE_JUMP_IF_NOT_LESS_FLOAT:
+			case F::OPCODE_JUMP_IF_NOT_LESS_EQUAL_FLOAT:
+			case F::OPCODE_JUMP_IF_NOT_GREATER_FLOAT:
+			case F::OPCODE_JUMP_IF_NOT_GREATER_EQUAL_FLOAT: {
+				check_addresses(1, 2);
+				check_jump(3);
+				length = 4;
+			} break;
+			case F::OPCODE_JUMP_TO_DEF_ARGUMENT:
+			case F::OPCODE_BREAKPOINT:
+			case F::OPCODE_END: {
+				length = 1;
+			} break;
+			case F::OPCODE_RETURN_TYPED_BUILTIN: {
+				check_addresses(1, 1);
+				check_type(2);
+				length = 3;
+			} break;
+			case F::OPCODE_RETURN_TYPED_ARRAY: {
+				check_addresses(1, 2);
+				check_type(3);
+				check_index(4, p_function->global_names.size());
+				length = 5;
+			} break;
+			case F::OPCODE_RETURN_TYPED_DICTIONARY: {
+				check_addresses(1, 3);
+				check_type(4);
+				check_index(5, p_function->global_names.size());
+				check_type(6);
+				check_index(7, p_function->global_names.size());
+				length = 8;
+			} break;
+			case F::OPCODE_RETURN_TYPED_NATIVE:
+			case F::OPCODE_RETURN_TYPED_SCRIPT: {
+				check_addresses(1, 2);
+				length = 3;
+			} break;
+			case F::OPCODE_ITERATE_BEGIN:
+			case F::OPCODE_ITERATE_BEGIN_INT:
+			case F::OPCODE_ITERATE_BEGIN_FLOAT:
+			case F::OPCODE_ITERATE_BEGIN_VECTOR2:
+			case F::OPCODE_ITERATE_BEGIN_VECTOR2I:
+			case F::OPCODE_ITERATE_BEGIN_VECTOR3:
+			case F::OPCODE_ITERATE_BEGIN_VECTOR3I:
+			case F::OPCODE_ITERATE_BEGIN_STRING:
+			case F::OPCODE_ITERATE_BEGIN_DICTIONARY:
+			case F::OPCODE_ITERATE_BEGIN_ARRAY:
+			case F::OPCODE_ITERATE_BEGIN_PACKED_BYTE_ARRAY:
+			case F::OPCODE_ITERATE_BEGIN_PACKED_INT32_ARRAY:
+			case F::OPCODE_ITERATE_BEGIN_PACKED_INT64_ARRAY:
+			case F::OPCODE_ITERATE_BEGIN_PACKED_FLOAT32_ARRAY:
+			case F::OPCODE_ITERATE_BEGIN_PACKED_FLOAT64_ARRAY:
+			case F::OPCODE_ITERATE_BEGIN_PACKED_STRING_ARRAY:
+			case F::OPCODE_ITERATE_BEGIN_PACKED_VECTOR2_ARRAY:
+			case F::OPCODE_ITERATE_BEGIN_PACKED_VECTOR3_ARRAY:
+			case F::OPCODE_ITERATE_BEGIN_PACKED_COLOR_ARRAY:
+			case F::OPCODE_ITERATE_BEGIN_PACKED_VECTOR4_ARRAY:
+			case F::OPCODE_ITERATE_BEGIN_OBJECT:
+			case F::OPCODE_ITERATE:
+			case F::OPCODE_ITERATE_INT:
+			case F::OPCODE_ITERATE_FLOAT:
+			case F::OPCODE_ITERATE_VECTOR2:
+			case F::OPCODE_ITERATE_VECTOR2I:
+			case F::OPCODE_ITERATE_VECTOR3:
+			case F::OPCODE_ITERATE_VECTOR3I:
+			case F::OPCODE_ITERATE_STRING:
+			case F::OPCODE_ITERATE_DICTIONARY:
+			case F::OPCODE_ITERATE_ARRAY:
+			case F::OPCODE_ITERATE_PACKED_BYTE_ARRAY:
+			case F::OPCODE_ITERATE_PACKED_INT32_ARRAY:
+			case F::OPCODE_ITERATE_PACKED_INT64_ARRAY:
+			case F::OPCODE_ITERATE_PACKED_FLOAT32_ARRAY:
+			case F::OPCODE_ITERATE_PACKED_FLOAT64_ARRAY:
+			case F::OPCODE_ITERATE_PACKED_STRING_ARRAY:
+			case F::OPCODE_ITERATE_PACKED_VECTOR2_ARRAY:
+			case F::OPCODE_ITERATE_PACKED_VECTOR3_ARRAY:
+			case F::OPCODE_ITERATE_PACKED_COLOR_ARRAY:
+			case F::OPCODE_ITERATE_PACKED_VECTOR4_ARRAY:
+			case F::OPCODE_ITERATE_OBJECT: {
+				check_addresses(1, 3);
+				check_jump(4);
+				length = 5;
+			} break;
+			case F::OPCODE_ITERATE_BEGIN_RANGE: {
+				check_addresses(1, 5);
+				check_jump(6);
+				length = 7;
+			} break;
+			case F::OPCODE_ITERATE_RANGE: {
+				check_addresses(1, 4);
+				check_jump(5);
+				length = 6;
+			} break;
+			case F::OPCODE_STORE_GLOBAL: {
+				check_addresses(1, 1);
+				check_index(2, GDScriptLanguage::get_singleton()->get_global_array_size());
+				length = 3;
+			} break;
+			case F::OPCODE_ASSERT: {
+				check_addresses(1, 2);
+				length = 3;
+			} break;
+			case F::OPCODE_LINE: {
+				length = 2;
+			} break;
+		}
+
+		valid = valid && length > 0 && length <= code_size - ip;
+		ip += length;
+	}
+
+	// Same as `GDScriptByteCodeGenerator::write_end()`, non-empty code always ends the function.
+	if (!valid || (code_size > 0 && last_opcode != F::OPCODE_END)) {
+		return false;
+	}
+	// Jumps may only land on an instruction, or at the end of the code.
+	instruction_starts[code_size] = true;
+	for (int target : jump_targets) {
+		if (target < 0 || target > code_size || !instruction_starts[target]) {
+			return false;
+		}
+	}
+	for (int default_argument : p_function->default_arguments) {
+		if (default_argument < 0 || default_argument > code_size || !instruction_starts[default_argument]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool GDScriptBytecodeCache::is_enabled() {
+	if (Engine::get_singleton()->is_editor_hint() || EngineDebugger::is_active()) {
+		// The editor and the debugger need the parser output, e.g. for documentation and breakpoints.
+		return false;
+	}
+	return GLOBAL_GET_CACHED(bool, "gdscript/bytecode_cache/enabled");
+}
+
+String GDScriptBytecodeCache::get_cache_path(const String &p_script_path) {
+	return String("user://.gdscript_bytecode").path_join(p_script_path.md5_text() + ".gdbc");
+}
+
+Vector<uint8_t> GDScriptBytecodeCache::serialize(const GDScript *p_script, Error &r_error) {
+	ERR_FAIL_NULL_V(p_script, Vector<uint8_t>());
+	ERR_FAIL_COND_V_MSG(!p_script->valid, Vector<uint8_t>(), "Cannot serialize a script that is not compiled.");
+	ERR_FAIL_COND_V_MSG(p_script->_owner != nullptr, Vector<uint8_t>(), "Cannot serialize an inner class.");
+
+	Serializer body;
+	body.write_class_tree(p_script);
+	bool is_static;
+	{
+		MutexLock lock(GDScriptCache::mutex);
+		is_static = GDScriptCache::singleton->static_gdscript_cache.has(p_script->fully_qualified_name);
+	}
+	body.put_u8(is_static);
+	body.write_class(p_script);
+
+	if (body.has_failed()) {
+		print_verbose(vformat(R"(GDScript: Not caching the bytecode of "%s": %s)", p_script->path, body.error));
+		r_error = ERR_UNAVAILABLE;
+		return Vector<uint8_t>();
+	}
+
+	// The cached bytecode depends on everything the analyzer looked up in other scripts,
+	// so the entry is outdated as soon as any of them changes.
+	// Only the dependency map is copied under the lock, the walk runs without it.
+	HashMap<String, LocalVector<String>> owner_dependencies;
+	{
+		MutexLock lock(GDScriptCache::mutex);
+		for (const KeyValue<String, HashSet<String>> &E : GDScriptCache::singleton->parser_inverse_dependencies) {
+			for (const String &owner : E.value) {
+				owner_dependencies[owner].push_back(E.key);
+			}
+		}
+	}
+
+	HashSet<String> dependencies(body.external_paths);
+	LocalVector<String> to_visit;
+	to_visit.push_back(p_script->path);
+	while (!to_visit.is_empty()) {
+		const String owner = to_visit[to_visit.size() - 1];
+		to_visit.remove_at(to_visit.size() - 1);
+		const LocalVector<String> *owner_dependency_paths = owner_dependencies.getptr(owner);
+		if (!owner_dependency_paths) {
+			continue;
+		}
+		for (const String &dependency : *owner_dependency_paths) {
+			if (dependency != p_script->path && !dependencies.has(dependency)) {
+				dependencies.insert(dependency);
+				to_visit.push_back(dependency);
+			}
+		}
+	}
+
+	Serializer header;
+	header.put_data(BYTECODE_CACHE_MAGIC, 4);
+	header.put_u32(FORMAT_VERSION);
+	header.put_string(_get_engine_version());
+	header.put_u32(_get_build_flags());
+	header.put_string(_get_script_md5(p_script));
+	header.put_u32(dependencies.size());
+	for (const String &dependency : dependencies) {
+		header.put_string(dependency);
+		header.put_string(_get_source_md5(dependency));
+	}
+
+	const Vector<uint8_t> body_data = body.get_data();
+	unsigned char content_hash[BYTECODE_CACHE_HASH_SIZE];
+	CryptoCore::sha256(body_data.ptr(), body_data.size(), content_hash);
+	header.put_data(content_hash, BYTECODE_CACHE_HASH_SIZE);
+
+	Vector<uint8_t> buffer = header.get_data();
+	buffer.append_array(body_data);
+	r_error = OK;
+	return buffer;
+}
+
+Error GDScriptBytecodeCache::deserialize(GDScript *p_script, const Vector<uint8_t> &p_buffer) {
+	ERR_FAIL_NULL_V(p_script, ERR_INVALID_PARAMETER);
+
+	Deserializer deserializer(p_buffer);
+	Error err = deserializer.read(p_script, false);
+	p_script->_invalidate_inline_caches();
+	if (err != OK) {
+		return err;
+	}
+	return GDScriptCache::finish_compiling(p_script->path);
+}
+
+Error GDScriptBytecodeCache::make_scripts(GDScript *p_script, const Vector<uint8_t> &p_buffer) {
+	ERR_FAIL_NULL_V(p_script, ERR_INVALID_PARAMETER);
+
+	Deserializer deserializer(p_buffer);
+	return deserializer.read(p_script, true);
+}
+
+bool GDScriptBytecodeCache::has_valid_entry(const GDScript *p_script) {
+	if (!p_script->path.is_resource_file()) {
+		return false;
+	}
+	return !_read_valid_buffer(p_script).is_empty();
+}
+
+Error GDScriptBytecodeCache::save(const GDScript *p_script) {
+	if (!p_script->path.is_resource_file()) {
+		return ERR_UNAVAILABLE;
+	}
+
+	Error err = OK;
+	Vector<uint8_t> buffer = serialize(p_script, err);
+	if (err != OK) {
+		return err;
+	}
+
+	const String cache_path = get_cache_path(p_script->path);
+	err = DirAccess::make_dir_recursive_absolute(cache_path.get_base_dir());
+	ERR_FAIL_COND_V(err != OK, err);
+
+	// Write to a file of this process and thread and move it into place, so a crash or another instance
+	// writing the same entry cannot leave a partially written file behind.
+	const String temp_path = vformat("%s.%d.%d.tmp", cache_path, OS::get_singleton()->get_process_id(), (uint64_t)Thread::get_caller_id());
+	{
+		Ref<FileAccess> file = FileAccess::open(temp_path, FileAccess::WRITE, &err);
+		ERR_FAIL_COND_V_MSG(err != OK, err, vformat(R"(Cannot write the GDScript bytecode cache file "%s".)", temp_path));
+		if (!file->store_buffer(buffer)) {
+			err = ERR_FILE_CANT_WRITE;
+		}
+	}
+	if (err == OK) {
+		err = DirAccess::rename_absolute(temp_path, cache_path);
+	}
+	if (err != OK) {
+		DirAccess::remove_absolute(temp_path);
+		ERR_FAIL_V_MSG(err, vformat(R"(Cannot write the GDScript bytecode cache file "%s".)", cache_path));
+	}
+	return OK;
+}
+
+Error GDScriptBytecodeCache::load(GDScript *p_script) {
+	if (!p_script->path.is_resource_file()) {
+		return ERR_UNAVAILABLE;
+	}
+
+	Vector<uint8_t> buffer;
+	{
+		MutexLock lock(mutex);
+		if (Vector<uint8_t> *pending = pending_buffers.getptr(p_script->path)) {
+			buffer = *pending;
+			pending_buffers.erase(p_script->path);
+		}
+	}
+	if (buffer.is_empty()) {
+		buffer = _read_valid_buffer(p_script);
+	}
+	if (buffer.is_empty()) {
+		return ERR_FILE_NOT_FOUND;
+	}
+
+	Error err = deserialize(p_script, buffer);
+	if (err != OK) {
+		print_verbose(vformat(R"(GDScript: The bytecode cache of "%s" is outdated, compiling from source.)", p_script->path));
+	}
+	return err;
+}
+
+Error GDScriptBytecodeCache::load_shallow(GDScript *p_script) {
+	if (!p_script->path.is_resource_file()) {
+		return ERR_UNAVAILABLE;
+	}
+
+	Vector<uint8_t> buffer = _read_valid_buffer(p_script);
+	if (buffer.is_empty()) {
+		return ERR_FILE_NOT_FOUND;
+	}
+	Error err = make_scripts(p_script, buffer);
+	if (err != OK) {
+		return err;
+	}
+
+	// Keep the buffer, the script is usually fully loaded right after.
+	MutexLock lock(mutex);
+	pending_buffers[p_script->path] = buffer;
+	return OK;
+}
+
+void GDScriptBytecodeCache::clear() {
+	MutexLock lock(mutex);
+	source_md5_cache.clear();
+	pending_buffers.clear();
+}
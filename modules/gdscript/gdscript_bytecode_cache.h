@@ -0,0 +1,91 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/mutex.h"
+#include "core/string/ustring.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/vector.h"
+
+class GDScript;
+class GDScriptFunction;
+
+#ifdef TESTS_ENABLED
+namespace GDScriptTests {
+class TestGDScriptBytecodeCacheAccessor;
+}
+#endif // TESTS_ENABLED
+
+// Stores the compiled bytecode of scripts, so later runs can skip parsing, analyzing and compiling them.
+// A cache entry is only used while the engine version, the script source and the sources of all the scripts
+// it depends on are unchanged, and while its contents match their checksum and hold well-formed bytecode,
+// otherwise the script is compiled from source again.
+class GDScriptBytecodeCache {
+	static constexpr uint32_t FORMAT_VERSION = 6;
+
+	class Serializer;
+	class Deserializer;
+
+	static Mutex mutex;
+	static HashMap<String, String> source_md5_cache;
+	static HashMap<String, Vector<uint8_t>> pending_buffers;
+
+	static String _get_script_md5(const GDScript *p_script);
+	static String _get_source_md5(const String &p_path);
+	static Vector<uint8_t> _read_valid_buffer(const GDScript *p_script);
+	// Whether the code only holds known opcodes whose operands stay within the function's tables,
+	// the VM trusts them in release builds. Returns the positions of the operator caches to reset.
+	static bool _is_valid_code(const GDScriptFunction *p_function, const GDScript *p_class, const Vector<int> &p_code, int p_inline_cache_count, Vector<int> *r_operator_caches = nullptr);
+
+#ifdef TESTS_ENABLED
+	friend class GDScriptTests::TestGDScriptBytecodeCacheAccessor;
+#endif // TESTS_ENABLED
+
+public:
+	static bool is_enabled();
+	static String get_cache_path(const String &p_script_path);
+
+	// Serializes the compiled script, fails if it holds data that cannot be restored from a file (e.g. built-in resources).
+	static Vector<uint8_t> serialize(const GDScript *p_script, Error &r_error);
+	// Restores a compiled script, fails if the buffer is outdated.
+	static Error deserialize(GDScript *p_script, const Vector<uint8_t> &p_buffer);
+	// Creates the inner class scripts so the script can be referenced before it is loaded.
+	static Error make_scripts(GDScript *p_script, const Vector<uint8_t> &p_buffer);
+
+	// Whether the cache file of the script exists and is up to date.
+	static bool has_valid_entry(const GDScript *p_script);
+
+	static Error save(const GDScript *p_script);
+	static Error load(GDScript *p_script);
+	static Error load_shallow(GDScript *p_script);
+
+	static void clear();
+};
@@ -32,10 +32,13 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
 
+#include "core/config/project_settings.h"
 #include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/vector.h"
 
 GDScriptParserRef::Status GDScriptParserRef::get_status() const {
@@ -79,16 +82,7 @@ Error GDScriptParserRef::raise_status(Status p_new_status) {
 				// It's ok if its the first thing done here.
 				get_parser()->clear();
 				status = PARSED;
-				String remapped_path = ResourceLoader::path_remap(path);
-				if (remapped_path.has_extension("gdc")) {
-					Vector<uint8_t> tokens = GDScriptCache::get_binary_tokens(remapped_path);
-					source_hash = hash_djb2_buffer(tokens.ptr(), tokens.size());
-					result = get_parser()->parse_binary(tokens, path);
-				} else {
-					String source = GDScriptCache::get_source_code(remapped_path);
-					source_hash = source.hash();
-					result = get_parser()->parse(source, path, false);
-				}
+				result = _parse_file(get_parser(), path, source_hash);
 			} break;
 			case PARSED: {
 				status = INHERITANCE_SOLVED;
@@ -111,6 +105,29 @@ Error GDScriptParserRef::raise_status(Status p_new_status) {
 	return result;
 }
 
+Error GDScriptParserRef::_parse_file(GDScriptParser *p_parser, const String &p_path, uint32_t &r_source_hash) {
+	const String remapped_path = ResourceLoader::path_remap(p_path);
+	if (remapped_path.has_extension("gdc")) {
+		Ref<FileAccess> f = FileAccess::open(remapped_path, FileAccess::READ);
+		ERR_FAIL_COND_V_MSG(f.is_null(), ERR_FILE_CANT_OPEN, "Failed to open binary GDScript file '" + remapped_path + "'.");
+
+		// Parse the tokens in place when the file can provide a view of them, the parser keeps no reference to them.
+		const uint64_t length = f->get_length();
+		Span<uint8_t> tokens = f->get_buffer_view(length);
+		Vector<uint8_t> buffer;
+		if (tokens.size() != length) {
+			buffer = f->get_buffer(length);
+			tokens = buffer;
+		}
+		r_source_hash = hash_djb2_buffer(tokens.ptr(), tokens.size());
+		return p_parser->parse_binary(tokens, p_path);
+	}
+
+	String source = GDScriptCache::get_source_code(remapped_path);
+	r_source_hash = source.hash();
+	return p_parser->parse(source, p_path, false);
+}
+
 void GDScriptParserRef::clear() {
 	if (clearing) {
 		return;
@@ -147,6 +164,7 @@ GDScriptParserRef::~GDScriptParserRef() {
 }
 
 GDScriptCache *GDScriptCache::singleton = nullptr;
+thread_local uint32_t GDScriptCache::full_script_depth = 0;
 
 SafeBinaryMutex<GDScriptCache::BINARY_MUTEX_TAG> &_get_gdscript_cache_mutex() {
 	return GDScriptCache::mutex;
@@ -299,6 +317,116 @@ Vector<uint8_t> GDScriptCache::get_binary_tokens(const String &p_path) {
 	return buffer;
 }
 
+void GDScriptCache::_parse_task(void *p_userdata, uint32_t p_index) {
+	ParseTask &task = static_cast<ParseTask *>(p_userdata)[p_index];
+	task.result = GDScriptParserRef::_parse_file(task.parser, task.path, task.source_hash);
+}
+
+// Parses the given script and the scripts it refers to, level by level, with the independent files of each level
+// spread over the worker threads. Only the parse step is done ahead of time: the parsers are left in the
+// `PARSED` state, and analysis and compilation still happen in dependency order through `get_parser()`,
+// so cyclic references resolve exactly as they do without prefetching.
+void GDScriptCache::_prefetch_parsers(const String &p_path, LocalVector<Ref<GDScriptParserRef>> &r_parsers) {
+	if (!GLOBAL_GET_CACHED(bool, "gdscript/loading/parallel_parsing") || GDScriptBytecodeCache::is_enabled()) {
+		return;
+	}
+
+	HashSet<String> visited;
+	visited.insert(p_path);
+	LocalVector<String> level;
+	level.push_back(p_path);
+
+	while (!level.is_empty()) {
+		LocalVector<ParseTask> tasks;
+		LocalVector<Ref<GDScriptParserRef>> parsed;
+
+		for (const String &path : level) {
+			if (HashMap<String, GDScriptParserRef *>::Iterator E = singleton->parser_map.find(path)) {
+				Ref<GDScriptParserRef> ref = Ref<GDScriptParserRef>(E->value);
+				if (ref.is_valid() && ref->status != GDScriptParserRef::EMPTY) {
+					// Parsed before, only its references need to be followed.
+					parsed.push_back(ref);
+					continue;
+				}
+			} else if (!FileAccess::exists(ResourceLoader::path_remap(path))) {
+				continue;
+			}
+
+			ParseTask task;
+			task.path = path;
+			task.parser = memnew(GDScriptParser);
+			tasks.push_back(task);
+		}
+
+		if (tasks.size() == 1 || WorkerThreadPool::get_singleton() == nullptr) {
+			for (uint32_t i = 0; i < tasks.size(); i++) {
+				_parse_task(tasks.ptr(), i);
+			}
+		} else if (tasks.size() > 1) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&_parse_task, tasks.ptr(), tasks.size(), -1, true, SNAME("GDScriptParse"));
+			// Other threads may need the cache while the files are parsed; the parser map is looked up again afterwards.
+			uint32_t allowance_id = WorkerThreadPool::thread_enter_unlock_allowance_zone(singleton->mutex);
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+			WorkerThreadPool::thread_exit_unlock_allowance_zone(allowance_id);
+		}
+
+		for (ParseTask &task : tasks) {
+			Ref<GDScriptParserRef> ref;
+			HashMap<String, GDScriptParserRef *>::Iterator E = singleton->parser_map.find(task.path);
+			if (E) {
+				ref = Ref<GDScriptParserRef>(E->value);
+			} else {
+				ref.instantiate();
+				ref->path = task.path;
+				singleton->parser_map[task.path] = ref.ptr();
+			}
+
+			// The parser may have been created while waiting for the tasks; keep the one already in use.
+			if (ref.is_null() || ref->status != GDScriptParserRef::EMPTY || ref->parser != nullptr) {
+				memdelete(task.parser);
+				continue;
+			}
+
+			ref->parser = task.parser;
+			ref->status = GDScriptParserRef::PARSED;
+			ref->result = task.result;
+			ref->source_hash = task.source_hash;
+			r_parsers.push_back(ref);
+			parsed.push_back(ref);
+		}
+
+		level.clear();
+		for (const Ref<GDScriptParserRef> &ref : parsed) {
+			if (ref->result != OK || ref->parser == nullptr) {
+				continue;
+			}
+
+			const String base_dir = ref->path.get_base_dir();
+			for (String path : ref->parser->get_script_path_hints()) {
+				if (path.is_relative_path()) {
+					path = base_dir.path_join(path);
+				}
+				path = path.simplify_path();
+				if ((path.has_extension("gd") || path.has_extension("gdc")) && !visited.has(path)) {
+					visited.insert(path);
+					level.push_back(path);
+				}
+			}
+
+			for (const StringName &type_name : ref->parser->get_type_name_hints()) {
+				if (!ScriptServer::is_global_class(type_name) || ScriptServer::get_global_class_language(type_name) != SNAME("GDScript")) {
+					continue;
+				}
+				const String path = ScriptServer::get_global_class_path(type_name);
+				if (!visited.has(path)) {
+					visited.insert(path);
+					level.push_back(path);
+				}
+			}
+		}
+	}
+}
+
 Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_error, const String &p_owner) {
 	MutexLock lock(singleton->mutex);
 
@@ -332,9 +460,12 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 		return Ref<GDScript>(); // Returns null and does not cache when the script fails to load.
 	}
 
-	Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
-	if (r_error == OK) {
-		GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
+	// The inner classes can be made from the bytecode cache, without parsing the script.
+	if (!GDScriptBytecodeCache::is_enabled() || GDScriptBytecodeCache::load_shallow(script.ptr()) != OK) {
+		Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
+		if (r_error == OK) {
+			GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
+		}
 	}
 
 	singleton->shallow_gdscript_cache[p_path] = script;
@@ -358,6 +489,12 @@ Ref<GDScript> GDScriptCache::get_full_script(const String &p_path, Error &r_erro
 		}
 	}
 
+	// Keeps the prefetched parsers alive until the scripts depending on them are compiled.
+	LocalVector<Ref<GDScriptParserRef>> prefetched_parsers;
+	if (script.is_null() && full_script_depth == 0) {
+		_prefetch_parsers(p_path, prefetched_parsers);
+	}
+
 	if (script.is_null()) {
 		script = get_shallow_script(p_path, r_error);
 		// Only exit early if script failed to load, otherwise let reload report errors.
@@ -388,7 +525,9 @@ Ref<GDScript> GDScriptCache::get_full_script(const String &p_path, Error &r_erro
 	// which, as a last resort deadlock prevention strategy, is a good tradeoff.
 	{
 		uint32_t allowance_id = WorkerThreadPool::thread_enter_unlock_allowance_zone(singleton->mutex);
+		full_script_depth++;
 		r_error = script->reload(true);
+		full_script_depth--;
 		WorkerThreadPool::thread_exit_unlock_allowance_zone(allowance_id);
 	}
 
@@ -467,6 +606,8 @@ void GDScriptCache::clear() {
 	}
 	singleton->cleared = true;
 
+	GDScriptBytecodeCache::clear();
+
 	singleton->parser_inverse_dependencies.clear();
 
 	for (const KeyValue<String, Vector<ObjectID>> &KV : singleton->abandoned_parser_map) {
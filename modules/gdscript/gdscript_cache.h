@@ -36,6 +36,7 @@
 #include "core/os/safe_binary_mutex.h"
 #include "core/templates/hash_map.h"
 #include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
 
 class GDScriptAnalyzer;
 class GDScriptParser;
@@ -65,6 +66,8 @@ private:
 	friend class GDScriptCache;
 	friend class GDScript;
 
+	static Error _parse_file(GDScriptParser *p_parser, const String &p_path, uint32_t &r_source_hash);
+
 public:
 	Status get_status() const;
 	String get_path() const;
@@ -95,6 +98,7 @@ class GDScriptCache {
 	HashMap<String, HashSet<String>> parser_inverse_dependencies;
 
 	friend class GDScript;
+	friend class GDScriptBytecodeCache;
 	friend class GDScriptParserRef;
 	friend class GDScriptInstance;
 #ifdef TESTS_ENABLED
@@ -105,6 +109,19 @@ class GDScriptCache {
 
 	bool cleared = false;
 
+	struct ParseTask {
+		String path;
+		GDScriptParser *parser = nullptr;
+		uint32_t source_hash = 0;
+		Error result = OK;
+	};
+
+	// Nesting of `get_full_script()` reloads on the current thread; dependencies are only prefetched by the outermost one.
+	static thread_local uint32_t full_script_depth;
+
+	static void _parse_task(void *p_userdata, uint32_t p_index);
+	static void _prefetch_parsers(const String &p_path, LocalVector<Ref<GDScriptParserRef>> &r_parsers);
+
 public:
 	static const int BINARY_MUTEX_TAG = 2;
 
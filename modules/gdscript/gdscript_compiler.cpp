@@ -2702,6 +2702,7 @@ Error GDScriptCompiler::_prepare_compilation(GDScript *p_script, const GDScriptP
 
 	parsing_classes.insert(p_script);
 
+	p_script->_invalidate_inline_caches();
 	p_script->clearing = true;
 
 	p_script->cancel_pending_functions(true);
@@ -3343,6 +3344,7 @@ Error GDScriptCompiler::compile(const GDScriptParser *p_parser, GDScript *p_scri
 	}
 
 	err = _compile_class(main_script, root, p_keep_state);
+	main_script->_invalidate_inline_caches(); // Members and functions of the script changed.
 	if (err) {
 		return err;
 	}
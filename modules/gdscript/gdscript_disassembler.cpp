@@ -141,6 +141,45 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+
+#define DISASSEMBLE_OPERATOR_TYPED(m_name, m_operator) \
+	case OPCODE_OPERATOR_##m_name: { \
+		text += "typed operator ("; \
+		text += #m_name; \
+		text += ") "; \
+		text += DADDR(3); \
+		text += " = "; \
+		text += DADDR(1); \
+		text += " " m_operator " "; \
+		text += DADDR(2); \
+		incr += 4; \
+	} break
+
+				DISASSEMBLE_OPERATOR_TYPED(ADD_INT, "+");
+				DISASSEMBLE_OPERATOR_TYPED(SUBTRACT_INT, "-");
+				DISASSEMBLE_OPERATOR_TYPED(MULTIPLY_INT, "*");
+				DISASSEMBLE_OPERATOR_TYPED(EQUAL_INT, "==");
+				DISASSEMBLE_OPERATOR_TYPED(NOT_EQUAL_INT, "!=");
+				DISASSEMBLE_OPERATOR_TYPED(LESS_INT, "<");
+				DISASSEMBLE_OPERATOR_TYPED(LESS_EQUAL_INT, "<=");
+				DISASSEMBLE_OPERATOR_TYPED(GREATER_INT, ">");
+				DISASSEMBLE_OPERATOR_TYPED(GREATER_EQUAL_INT, ">=");
+				DISASSEMBLE_OPERATOR_TYPED(ADD_FLOAT, "+");
+				DISASSEMBLE_OPERATOR_TYPED(SUBTRACT_FLOAT, "-");
+				DISASSEMBLE_OPERATOR_TYPED(MULTIPLY_FLOAT, "*");
+				DISASSEMBLE_OPERATOR_TYPED(DIVIDE_FLOAT, "/");
+				DISASSEMBLE_OPERATOR_TYPED(LESS_FLOAT, "<");
+				DISASSEMBLE_OPERATOR_TYPED(LESS_EQUAL_FLOAT, "<=");
+				DISASSEMBLE_OPERATOR_TYPED(GREATER_FLOAT, ">");
+				DISASSEMBLE_OPERATOR_TYPED(GREATER_EQUAL_FLOAT, ">=");
+				DISASSEMBLE_OPERATOR_TYPED(ADD_VECTOR2, "+");
+				DISASSEMBLE_OPERATOR_TYPED(SUBTRACT_VECTOR2, "-");
+				DISASSEMBLE_OPERATOR_TYPED(MULTIPLY_VECTOR2, "*");
+				DISASSEMBLE_OPERATOR_TYPED(MULTIPLY_VECTOR2_FLOAT, "*");
+				DISASSEMBLE_OPERATOR_TYPED(ADD_VECTOR3, "+");
+				DISASSEMBLE_OPERATOR_TYPED(SUBTRACT_VECTOR3, "-");
+				DISASSEMBLE_OPERATOR_TYPED(MULTIPLY_VECTOR3, "*");
+				DISASSEMBLE_OPERATOR_TYPED(MULTIPLY_VECTOR3_FLOAT, "*");
 			case OPCODE_TYPE_TEST_BUILTIN: {
 				text += "type test ";
 				text += DADDR(1);
@@ -308,7 +347,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += "\"] = ";
 				text += DADDR(2);
 
-				incr += 4;
+				incr += 5;
 			} break;
 			case OPCODE_SET_NAMED_VALIDATED: {
 				text += "set_named validated ";
@@ -329,7 +368,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += _global_names_ptr[_code_ptr[ip + 3]];
 				text += "\"]";
 
-				incr += 4;
+				incr += 5;
 			} break;
 			case OPCODE_GET_NAMED_VALIDATED: {
 				text += "get_named validated ";
@@ -708,7 +747,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				}
 				text += ")";
 
-				incr = 5 + argc;
+				incr = 6 + argc;
 			} break;
 			case OPCODE_CALL_METHOD_BIND:
 			case OPCODE_CALL_METHOD_BIND_RET: {
@@ -1071,6 +1110,30 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr = 3;
 			} break;
+
+#define DISASSEMBLE_JUMP_IF_NOT_TYPED(m_name, m_operator) \
+	case OPCODE_JUMP_IF_NOT_##m_name: { \
+		text += "jump-if-not ("; \
+		text += #m_name; \
+		text += ") "; \
+		text += DADDR(1); \
+		text += " " m_operator " "; \
+		text += DADDR(2); \
+		text += " to "; \
+		text += itos(_code_ptr[ip + 3]); \
+		incr = 4; \
+	} break
+
+				DISASSEMBLE_JUMP_IF_NOT_TYPED(EQUAL_INT, "==");
+				DISASSEMBLE_JUMP_IF_NOT_TYPED(NOT_EQUAL_INT, "!=");
+				DISASSEMBLE_JUMP_IF_NOT_TYPED(LESS_INT, "<");
+				DISASSEMBLE_JUMP_IF_NOT_TYPED(LESS_EQUAL_INT, "<=");
+				DISASSEMBLE_JUMP_IF_NOT_TYPED(GREATER_INT, ">");
+				DISASSEMBLE_JUMP_IF_NOT_TYPED(GREATER_EQUAL_INT, ">=");
+				DISASSEMBLE_JUMP_IF_NOT_TYPED(LESS_FLOAT, "<");
+				DISASSEMBLE_JUMP_IF_NOT_TYPED(LESS_EQUAL_FLOAT, "<=");
+				DISASSEMBLE_JUMP_IF_NOT_TYPED(GREATER_FLOAT, ">");
+				DISASSEMBLE_JUMP_IF_NOT_TYPED(GREATER_EQUAL_FLOAT, ">=");
 			case OPCODE_RETURN: {
 				text += "return ";
 				text += DADDR(1);
@@ -32,6 +32,9 @@
 
 #include "gdscript.h"
 
+#include "core/object/class_db.h"
+#include "scene/scene_string_names.h"
+
 Variant GDScriptFunction::get_constant(int p_idx) const {
 	ERR_FAIL_INDEX_V(p_idx, constants.size(), "<errconst>");
 	return constants[p_idx];
@@ -42,6 +45,99 @@ StringName GDScriptFunction::get_global_name(int p_idx) const {
 	return global_names[p_idx];
 }
 
+void GDScriptFunction::_init_inline_caches(int p_count) {
+	_inline_cache_count = p_count;
+	if (p_count > 0) {
+		_inline_caches_ptr = memnew_arr(InlineCache, p_count);
+	}
+}
+
+void GDScriptFunction::_add_inline_cache_entry(int p_cache, const InlineCacheEntry &p_entry) {
+	MutexLock lock(inline_cache_mutex);
+
+	// Overwrite, in order of preference, the outdated entry of the same receiver type, an unused slot,
+	// or the slots in turn, so a site never holds more than `INLINE_CACHE_SIZE` entries.
+	InlineCache &cache = _inline_caches_ptr[p_cache];
+	int slot_index = -1;
+	for (int i = 0; i < INLINE_CACHE_SIZE; i++) {
+		// Slots are filled in order, the first unused one ends the search.
+		const InlineCacheSlot &slot = cache.slots[i];
+		if (slot.sequence.load(std::memory_order_relaxed) == 0 || (slot.script.load(std::memory_order_relaxed) == p_entry.script && slot.native_type.load(std::memory_order_relaxed) == p_entry.native_type)) {
+			slot_index = i;
+			break;
+		}
+	}
+	if (slot_index < 0) {
+		slot_index = cache.next_replaced_slot;
+		cache.next_replaced_slot = (cache.next_replaced_slot + 1) % INLINE_CACHE_SIZE;
+	}
+
+	InlineCacheSlot &slot = cache.slots[slot_index];
+	const uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+	slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	slot.script.store(p_entry.script, std::memory_order_relaxed);
+	slot.native_type.store(p_entry.native_type, std::memory_order_relaxed);
+	slot.script_version.store(p_entry.script_version, std::memory_order_relaxed);
+	slot.member_index.store(p_entry.member_index, std::memory_order_relaxed);
+	slot.member_type.store(p_entry.member_type, std::memory_order_relaxed);
+	slot.function.store(p_entry.function, std::memory_order_relaxed);
+	slot.method.store(p_entry.method, std::memory_order_relaxed);
+	slot.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+GDScriptFunction::InlineCacheEntry GDScriptFunction::_resolve_member_inline_cache(int p_cache, const GDScript *p_script, uint32_t p_script_version, const StringName &p_name, bool p_set) {
+	// Same lookup as `GDScriptInstance::get()` and `GDScriptInstance::set()` for plain member variables.
+	InlineCacheEntry entry;
+	entry.script = p_script;
+	entry.script_version = p_script_version;
+
+	HashMap<StringName, GDScript::MemberInfo>::ConstIterator E = p_script->member_indices.find(p_name);
+	if (E) {
+		const StringName &accessor = p_set ? E->value.setter : E->value.getter;
+		if (!p_script->valid || accessor == StringName()) {
+			entry.member_index = E->value.index;
+			entry.member_type = &E->value.data_type;
+		}
+	}
+
+	_add_inline_cache_entry(p_cache, entry);
+	return entry;
+}
+
+GDScriptFunction::InlineCacheEntry GDScriptFunction::_resolve_call_inline_cache(int p_cache, const GDScript *p_script, uint32_t p_script_version, const Object *p_object, const StringName &p_method) {
+	// Same lookup as `Object::callp()`, script functions first and then native methods.
+	InlineCacheEntry entry;
+	entry.script = p_script;
+	entry.script_version = p_script_version;
+	entry.native_type = &p_object->get_gdtype();
+
+	// Those need the generic path: `free()` is handled by `Object::callp()` itself, `_ready()` also runs
+	// the implicit ready of every class, and extension classes may be unloaded.
+	ClassDB::APIType api = ClassDB::get_api_type(p_object->get_class_name());
+	bool cacheable = p_method != CoreStringName(free_) && p_method != SceneStringName(_ready) && api != ClassDB::API_EXTENSION && api != ClassDB::API_EDITOR_EXTENSION;
+
+	if (cacheable && p_script) {
+		const GDScript *sptr = p_script;
+		while (sptr) {
+			if (likely(sptr->valid)) {
+				HashMap<StringName, GDScriptFunction *>::ConstIterator E = sptr->member_functions.find(p_method);
+				if (E) {
+					entry.function = E->value;
+					break;
+				}
+			}
+			sptr = sptr->base.ptr();
+		}
+	}
+	if (cacheable && !entry.function) {
+		entry.method = ClassDB::get_method(p_object->get_class_name(), p_method);
+	}
+
+	_add_inline_cache_entry(p_cache, entry);
+	return entry;
+}
+
 struct _GDFKC {
 	int order = 0;
 	List<int> pos;
@@ -116,6 +212,14 @@ GDScriptFunction::GDScriptFunction() {
 
 GDScriptFunction::~GDScriptFunction() {
 	get_script()->member_functions.erase(name);
+	if (!get_script()->clearing) {
+		// Clearing the script already invalidated the caches.
+		get_script()->_invalidate_inline_caches();
+	}
+
+	if (_inline_caches_ptr) {
+		memdelete_arr(_inline_caches_ptr);
+	}
 
 	for (int i = 0; i < lambdas.size(); i++) {
 		memdelete(lambdas[i]);
@@ -132,8 +236,125 @@ GDScriptFunction::~GDScriptFunction() {
 #endif
 }
 
+// Size classes go from 256 bytes to 32 KiB; bigger frames are allocated directly.
+static constexpr uint32_t AWAIT_FRAME_MIN_SHIFT = 8;
+static constexpr uint32_t AWAIT_FRAME_CLASSES = 8;
+static constexpr uint32_t AWAIT_FRAME_POOL_LIMIT = 256;
+
+struct AwaitFramePool {
+	Mutex mutex;
+	LocalVector<uint8_t *> frames;
+};
+
+static AwaitFramePool await_frame_pools[AWAIT_FRAME_CLASSES];
+
+static _FORCE_INLINE_ uint32_t _get_await_frame_class(uint32_t p_bytes) {
+	uint32_t size_class = 0;
+	while (size_class < AWAIT_FRAME_CLASSES && (1u << (AWAIT_FRAME_MIN_SHIFT + size_class)) < p_bytes) {
+		size_class++;
+	}
+	return size_class;
+}
+
+uint8_t *GDScriptFunction::alloc_await_frame(uint32_t p_bytes, uint32_t &r_capacity) {
+	const uint32_t size_class = _get_await_frame_class(p_bytes);
+	if (size_class == AWAIT_FRAME_CLASSES) {
+		r_capacity = p_bytes;
+		return (uint8_t *)Memory::alloc_static(p_bytes);
+	}
+
+	r_capacity = 1u << (AWAIT_FRAME_MIN_SHIFT + size_class);
+	AwaitFramePool &pool = await_frame_pools[size_class];
+	{
+		MutexLock lock(pool.mutex);
+		if (!pool.frames.is_empty()) {
+			uint8_t *frame = pool.frames[pool.frames.size() - 1];
+			pool.frames.resize(pool.frames.size() - 1);
+			return frame;
+		}
+	}
+	return (uint8_t *)Memory::alloc_static(r_capacity);
+}
+
+void GDScriptFunction::free_await_frame(uint8_t *p_frame, uint32_t p_capacity) {
+	if (p_frame == nullptr) {
+		return;
+	}
+
+	const uint32_t size_class = _get_await_frame_class(p_capacity);
+	if (size_class < AWAIT_FRAME_CLASSES && p_capacity == (1u << (AWAIT_FRAME_MIN_SHIFT + size_class))) {
+		AwaitFramePool &pool = await_frame_pools[size_class];
+		MutexLock lock(pool.mutex);
+		if (pool.frames.size() < AWAIT_FRAME_POOL_LIMIT) {
+			pool.frames.push_back(p_frame);
+			return;
+		}
+	}
+	Memory::free_static(p_frame);
+}
+
+void GDScriptFunction::clear_await_frame_pool() {
+	for (AwaitFramePool &pool : await_frame_pools) {
+		MutexLock lock(pool.mutex);
+		for (uint8_t *frame : pool.frames) {
+			Memory::free_static(frame);
+		}
+		pool.frames.reset();
+	}
+}
+
 /////////////////////
 
+// Resumes a suspended function when the awaited signal is emitted. Unlike binding the state to a method
+// callable, it takes a single allocation per `await`.
+class GDScriptResumeCallable : public CallableCustom {
+	Ref<GDScriptFunctionState> state;
+
+	static bool compare_equal(const CallableCustom *p_a, const CallableCustom *p_b) {
+		return static_cast<const GDScriptResumeCallable *>(p_a)->state == static_cast<const GDScriptResumeCallable *>(p_b)->state;
+	}
+
+	static bool compare_less(const CallableCustom *p_a, const CallableCustom *p_b) {
+		return static_cast<const GDScriptResumeCallable *>(p_a)->state.ptr() < static_cast<const GDScriptResumeCallable *>(p_b)->state.ptr();
+	}
+
+public:
+	uint32_t hash() const override { return hash_one_uint64((uint64_t)state->get_instance_id()); }
+	String get_as_text() const override { return "GDScriptFunctionState::_signal_callback"; }
+	CompareEqualFunc get_compare_equal_func() const override { return compare_equal; }
+	CompareLessFunc get_compare_less_func() const override { return compare_less; }
+	ObjectID get_object() const override { return state->get_instance_id(); }
+	StringName get_method() const override { return SNAME("_signal_callback"); }
+
+	void call(const Variant **p_arguments, int p_argcount, Variant &r_return_value, Callable::CallError &r_call_error) const override {
+		r_call_error.error = Callable::CallError::CALL_OK;
+		// Keeps the state alive even if the one-shot connection holding this callable is removed during the call.
+		Ref<GDScriptFunctionState> self = state;
+		r_return_value = self->_resume_from_signal(p_arguments, p_argcount);
+	}
+
+	GDScriptResumeCallable(const Ref<GDScriptFunctionState> &p_state) :
+			state(p_state) {}
+};
+
+Variant GDScriptFunctionState::_resume_from_signal(const Variant **p_args, int p_argcount) {
+	Variant arg;
+	if (p_argcount == 1) {
+		arg = *p_args[0];
+	} else if (p_argcount > 1) {
+		Array extra_args;
+		for (int i = 0; i < p_argcount; i++) {
+			extra_args.push_back(*p_args[i]);
+		}
+		arg = extra_args;
+	}
+	return resume(arg);
+}
+
+Error GDScriptFunctionState::_connect_resume(Signal &p_signal) {
+	return p_signal.connect(Callable(memnew(GDScriptResumeCallable(Ref<GDScriptFunctionState>(this)))), Object::CONNECT_ONE_SHOT);
+}
+
 Variant GDScriptFunctionState::_signal_callback(const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
 	Variant arg;
 	r_error.error = Callable::CallError::CALL_OK;
@@ -142,16 +363,6 @@ Variant GDScriptFunctionState::_signal_callback(const Variant **p_args, int p_ar
 		r_error.error = Callable::CallError::CALL_ERROR_TOO_FEW_ARGUMENTS;
 		r_error.expected = 1;
 		return Variant();
-	} else if (p_argcount == 1) {
-		//noooneee
-	} else if (p_argcount == 2) {
-		arg = *p_args[0];
-	} else {
-		Array extra_args;
-		for (int i = 0; i < p_argcount - 1; i++) {
-			extra_args.push_back(*p_args[i]);
-		}
-		arg = extra_args;
 	}
 
 	Ref<GDScriptFunctionState> self = *p_args[p_argcount - 1];
@@ -163,7 +374,7 @@ Variant GDScriptFunctionState::_signal_callback(const Variant **p_args, int p_ar
 		return Variant();
 	}
 
-	return resume(arg);
+	return _resume_from_signal(p_args, p_argcount - 1);
 }
 
 bool GDScriptFunctionState::is_valid(bool p_extended_check) const {
@@ -240,7 +451,7 @@ Variant GDScriptFunctionState::resume(const Variant &p_arg) {
 
 void GDScriptFunctionState::_clear_stack() {
 	if (state.stack_size) {
-		Variant *stack = (Variant *)state.stack.ptr();
+		Variant *stack = (Variant *)state.stack;
 		// First `GDScriptFunction::FIXED_ADDRESSES_MAX` stack addresses are special
 		// and not copied to the state, so we skip them here.
 		for (int i = GDScriptFunction::FIXED_ADDRESSES_MAX; i < state.stack_size; i++) {
@@ -278,4 +489,8 @@ GDScriptFunctionState::~GDScriptFunctionState() {
 		scripts_list.remove_from_list();
 		instances_list.remove_from_list();
 	}
+
+	// A frame is only left here if the function was never resumed, or was resumed without running.
+	_clear_stack();
+	GDScriptFunction::free_await_frame(state.stack, state.stack_capacity);
 }
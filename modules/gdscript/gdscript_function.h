@@ -34,12 +34,16 @@
 
 #include "core/object/ref_counted.h"
 #include "core/object/script_language.h"
+#include "core/os/mutex.h"
 #include "core/os/thread.h"
 #include "core/string/string_name.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/pair.h"
 #include "core/templates/self_list.h"
 #include "core/variant/variant.h"
 
+#include <atomic>
+
 class GDScriptInstance;
 class GDScript;
 
@@ -265,6 +269,32 @@ public:
 	enum Opcode {
 		OPCODE_OPERATOR,
 		OPCODE_OPERATOR_VALIDATED,
+		// Operators on builtin types known at compile time, the operands are accessed directly.
+		OPCODE_OPERATOR_ADD_INT,
+		OPCODE_OPERATOR_SUBTRACT_INT,
+		OPCODE_OPERATOR_MULTIPLY_INT,
+		OPCODE_OPERATOR_EQUAL_INT,
+		OPCODE_OPERATOR_NOT_EQUAL_INT,
+		OPCODE_OPERATOR_LESS_INT,
+		OPCODE_OPERATOR_LESS_EQUAL_INT,
+		OPCODE_OPERATOR_GREATER_INT,
+		OPCODE_OPERATOR_GREATER_EQUAL_INT,
+		OPCODE_OPERATOR_ADD_FLOAT,
+		OPCODE_OPERATOR_SUBTRACT_FLOAT,
+		OPCODE_OPERATOR_MULTIPLY_FLOAT,
+		OPCODE_OPERATOR_DIVIDE_FLOAT,
+		OPCODE_OPERATOR_LESS_FLOAT,
+		OPCODE_OPERATOR_LESS_EQUAL_FLOAT,
+		OPCODE_OPERATOR_GREATER_FLOAT,
+		OPCODE_OPERATOR_GREATER_EQUAL_FLOAT,
+		OPCODE_OPERATOR_ADD_VECTOR2,
+		OPCODE_OPERATOR_SUBTRACT_VECTOR2,
+		OPCODE_OPERATOR_MULTIPLY_VECTOR2,
+		OPCODE_OPERATOR_MULTIPLY_VECTOR2_FLOAT,
+		OPCODE_OPERATOR_ADD_VECTOR3,
+		OPCODE_OPERATOR_SUBTRACT_VECTOR3,
+		OPCODE_OPERATOR_MULTIPLY_VECTOR3,
+		OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT,
 		OPCODE_TYPE_TEST_BUILTIN,
 		OPCODE_TYPE_TEST_ARRAY,
 		OPCODE_TYPE_TEST_DICTIONARY,
@@ -327,6 +357,16 @@ public:
 		OPCODE_JUMP_IF_NOT,
 		OPCODE_JUMP_TO_DEF_ARGUMENT,
 		OPCODE_JUMP_IF_SHARED,
+		OPCODE_JUMP_IF_NOT_EQUAL_INT,
+		OPCODE_JUMP_IF_NOT_NOT_EQUAL_INT,
+		OPCODE_JUMP_IF_NOT_LESS_INT,
+		OPCODE_JUMP_IF_NOT_LESS_EQUAL_INT,
+		OPCODE_JUMP_IF_NOT_GREATER_INT,
+		OPCODE_JUMP_IF_NOT_GREATER_EQUAL_INT,
+		OPCODE_JUMP_IF_NOT_LESS_FLOAT,
+		OPCODE_JUMP_IF_NOT_LESS_EQUAL_FLOAT,
+		OPCODE_JUMP_IF_NOT_GREATER_FLOAT,
+		OPCODE_JUMP_IF_NOT_GREATER_EQUAL_FLOAT,
 		OPCODE_RETURN,
 		OPCODE_RETURN_TYPED_BUILTIN,
 		OPCODE_RETURN_TYPED_ARRAY,
@@ -452,9 +492,11 @@ public:
 
 private:
 	friend class GDScript;
+	friend class GDScriptBytecodeCache;
 	friend class GDScriptCompiler;
 	friend class GDScriptByteCodeGenerator;
 	friend class GDScriptLanguage;
+	friend class GDScriptSamplingProfiler;
 
 	StringName name;
 	StringName source;
@@ -531,6 +573,54 @@ private:
 	MethodBind **_methods_ptr = nullptr;
 	GDScriptFunction **_lambdas_ptr = nullptr;
 
+	// Inline caches of untyped `GET_NAMED`, `SET_NAMED` and `CALL` instructions, indexed by their last operand.
+	// Each site remembers what the name resolved to for the last few receiver types. Entries are stored in place
+	// and guarded by a sequence number, so the VM reads them without locking and a site never holds more than
+	// `INLINE_CACHE_SIZE` entries. An entry is only used while the receiver script's inline cache version is unchanged.
+	static constexpr int INLINE_CACHE_SIZE = 4;
+
+	struct InlineCacheEntry {
+		const GDScript *script = nullptr; // Script of the receiver instance, null if it has none.
+		const GDType *native_type = nullptr; // Native type of the receiver, only used for calls.
+		uint32_t script_version = 0; // `GDScript::inline_cache_version` of the receiver script when resolved.
+		// What the name resolved to. When everything is empty the site is handled by the generic path.
+		int member_index = -1;
+		const GDScriptDataType *member_type = nullptr;
+		GDScriptFunction *function = nullptr;
+		MethodBind *method = nullptr;
+	};
+
+	struct InlineCacheSlot {
+		// Odd while the entry is written, zero if it never was.
+		std::atomic<uint32_t> sequence = 0;
+		std::atomic<const GDScript *> script = nullptr;
+		std::atomic<const GDType *> native_type = nullptr;
+		std::atomic<uint32_t> script_version = 0;
+		std::atomic<int> member_index = -1;
+		std::atomic<const GDScriptDataType *> member_type = nullptr;
+		std::atomic<GDScriptFunction *> function = nullptr;
+		std::atomic<MethodBind *> method = nullptr;
+	};
+
+	struct InlineCache {
+		InlineCacheSlot slots[INLINE_CACHE_SIZE];
+		uint32_t next_replaced_slot = 0; // Only accessed with `inline_cache_mutex` held.
+	};
+
+	int _inline_cache_count = 0;
+	InlineCache *_inline_caches_ptr = nullptr;
+	Mutex inline_cache_mutex;
+
+	void _init_inline_caches(int p_count);
+	void _add_inline_cache_entry(int p_cache, const InlineCacheEntry &p_entry);
+	bool _find_inline_cache(int p_cache, const GDScript *p_script, uint32_t p_script_version, const GDType *p_native_type, InlineCacheEntry &r_entry) const;
+	InlineCacheEntry _resolve_member_inline_cache(int p_cache, const GDScript *p_script, uint32_t p_script_version, const StringName &p_name, bool p_set);
+	InlineCacheEntry _resolve_call_inline_cache(int p_cache, const GDScript *p_script, uint32_t p_script_version, const Object *p_object, const StringName &p_method);
+	bool _call_inline_cached(int p_cache, Variant *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err);
+
+	// Identifier of this function in `GDScriptSamplingProfiler`'s frame table, assigned on first sample (0 = none yet).
+	SafeNumeric<uint32_t> sampling_frame_id;
+
 #ifdef DEBUG_ENABLED
 	CharString func_cname;
 	const char *_func_cname = nullptr;
@@ -579,7 +669,9 @@ public:
 		StringName function_name;
 		String script_path;
 #endif
-		Vector<uint8_t> stack;
+		uint8_t *stack = nullptr; // Frame from the await frame pool.
+		uint32_t stack_bytes = 0;
+		uint32_t stack_capacity = 0;
 		int stack_size = 0;
 		int ip = 0;
 		int line = 0;
@@ -601,6 +693,11 @@ public:
 	StringName get_global_name(int p_idx) const;
 
 	Variant call(GDScriptInstance *p_instance, const Variant **p_args, int p_argcount, Callable::CallError &r_err, CallState *p_state = nullptr);
+
+	// Suspended frames are recycled by size class, since coroutines suspend and resume very often.
+	static uint8_t *alloc_await_frame(uint32_t p_bytes, uint32_t &r_capacity);
+	static void free_await_frame(uint8_t *p_frame, uint32_t p_capacity);
+	static void clear_await_frame_pool();
 	void debug_get_stack_member_state(int p_line, List<Pair<StringName, int>> *r_stackvars) const;
 
 #ifdef DEBUG_ENABLED
@@ -615,9 +712,11 @@ public:
 class GDScriptFunctionState : public RefCounted {
 	GDCLASS(GDScriptFunctionState, RefCounted);
 	friend class GDScriptFunction;
+	friend class GDScriptResumeCallable;
 	GDScriptFunction *function = nullptr;
 	GDScriptFunction::CallState state;
 	Variant _signal_callback(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
+	Variant _resume_from_signal(const Variant **p_args, int p_argcount);
 	Ref<GDScriptFunctionState> first_state;
 
 	SelfList<GDScriptFunctionState> scripts_list;
@@ -639,6 +738,7 @@ public:
 
 	void _clear_stack();
 	void _clear_connections();
+	Error _connect_resume(Signal &p_signal);
 
 	GDScriptFunctionState();
 	~GDScriptFunctionState();
@@ -221,10 +221,41 @@ GDScriptParser::~GDScriptParser() {
 	while (list != nullptr) {
 		Node *element = list;
 		list = list->next;
-		memdelete(element);
+		element->~Node();
+	}
+
+	while (node_chunk != nullptr) {
+		NodeChunk *chunk = node_chunk;
+		node_chunk = chunk->prev;
+		Memory::free_static(chunk);
 	}
 }
 
+void *GDScriptParser::_alloc_node_memory(size_t p_size, size_t p_align) {
+	if (node_chunk != nullptr) {
+		const uintptr_t base = uintptr_t(node_chunk + 1);
+		const uintptr_t address = (base + node_chunk->used + p_align - 1) & ~uintptr_t(p_align - 1);
+		if (address + p_size <= base + node_chunk->size) {
+			node_chunk->used = address + p_size - base;
+			return (void *)address;
+		}
+	}
+
+	// Chunks grow with the script, so small scripts don't reserve much and big ones don't need many chunks.
+	size_t chunk_size = node_chunk != nullptr ? MIN(node_chunk->size * 2, NODE_CHUNK_MAX_SIZE) : NODE_CHUNK_MIN_SIZE;
+	chunk_size = MAX(chunk_size, p_size + p_align);
+
+	NodeChunk *chunk = memnew_placement(Memory::alloc_static(sizeof(NodeChunk) + chunk_size), NodeChunk);
+	chunk->prev = node_chunk;
+	chunk->size = chunk_size;
+	node_chunk = chunk;
+
+	const uintptr_t base = uintptr_t(chunk + 1);
+	const uintptr_t address = (base + p_align - 1) & ~uintptr_t(p_align - 1);
+	chunk->used = address + p_size - base;
+	return (void *)address;
+}
+
 void GDScriptParser::clear() {
 	GDScriptParser tmp;
 	tmp = *this;
@@ -526,7 +557,7 @@ Error GDScriptParser::parse(const String &p_source_code, const String &p_script_
 	}
 }
 
-Error GDScriptParser::parse_binary(const Vector<uint8_t> &p_binary, const String &p_script_path) {
+Error GDScriptParser::parse_binary(Span<uint8_t> p_binary, const String &p_script_path) {
 	GDScriptTokenizerBuffer *buffer_tokenizer = memnew(GDScriptTokenizerBuffer);
 	Error err = buffer_tokenizer->set_code_buffer(p_binary);
 
@@ -1012,6 +1043,7 @@ void GDScriptParser::parse_extends() {
 			push_error(vformat(R"(Only strings or identifiers can be used after "extends", found "%s" instead.)", Variant::get_type_name(previous.literal.get_type())));
 		}
 		current_class->extends_path = previous.literal;
+		script_path_hints.insert(current_class->extends_path);
 
 		if (!match(GDScriptTokenizer::Token::PERIOD)) {
 			return;
@@ -1024,6 +1056,9 @@ void GDScriptParser::parse_extends() {
 		return;
 	}
 	current_class->extends.push_back(parse_identifier());
+	if (current_class->extends_path.is_empty()) {
+		type_name_hints.insert(current_class->extends[0]->name);
+	}
 
 	while (match(GDScriptTokenizer::Token::PERIOD)) {
 		make_completion_context(COMPLETION_INHERIT_TYPE, current_class, chain_index++);
@@ -3687,6 +3722,10 @@ GDScriptParser::ExpressionNode *GDScriptParser::parse_preload(ExpressionNode *p_
 		push_error(R"(Expected resource path after "(".)");
 	} else if (preload->path->type == Node::LITERAL) {
 		override_completion_context(preload->path, COMPLETION_RESOURCE_PATH, preload);
+		const Variant &path = static_cast<LiteralNode *>(preload->path)->value;
+		if (path.get_type() == Variant::STRING) {
+			script_path_hints.insert(path);
+		}
 	}
 
 	pop_completion_call();
@@ -3872,6 +3911,7 @@ GDScriptParser::TypeNode *GDScriptParser::parse_type(bool p_allow_void) {
 	IdentifierNode *type_element = parse_identifier();
 
 	type->type_chain.push_back(type_element);
+	type_name_hints.insert(type_element->name);
 
 	if (match(GDScriptTokenizer::Token::BRACKET_OPEN)) {
 		// Typed collection (like Array[int], Dictionary[String, int]).
@@ -1351,10 +1351,28 @@ private:
 	List<bool> multiline_stack;
 	HashMap<String, Ref<GDScriptParserRef>> depended_parsers;
 
+	// Script paths and type names mentioned by `extends`, `preload()` and type hints, so that `GDScriptCache`
+	// can parse the scripts they refer to ahead of analysis. The analyzer still resolves the actual dependencies.
+	HashSet<String> script_path_hints;
+	HashSet<StringName> type_name_hints;
+
 	ClassNode *head = nullptr;
 	Node *list = nullptr;
 	List<ParserError> errors;
 
+	// Nodes are bump-allocated from chunks owned by the parser. They are still linked in `list` so their
+	// destructors run, but their memory is released one chunk at a time when the parser is destroyed.
+	struct NodeChunk {
+		NodeChunk *prev = nullptr;
+		size_t size = 0;
+		size_t used = 0;
+	};
+	static constexpr size_t NODE_CHUNK_MIN_SIZE = 16 * 1024;
+	static constexpr size_t NODE_CHUNK_MAX_SIZE = 256 * 1024;
+	NodeChunk *node_chunk = nullptr;
+
+	void *_alloc_node_memory(size_t p_size, size_t p_align);
+
 #ifdef DEBUG_ENABLED
 public:
 	struct WarningDirectoryRule {
@@ -1466,7 +1484,7 @@ private:
 
 	template <typename T>
 	T *alloc_node() {
-		T *node = memnew(T);
+		T *node = memnew_placement(_alloc_node_memory(sizeof(T), alignof(T)), T);
 
 		node->next = list;
 		list = node;
@@ -1481,7 +1499,7 @@ private:
 	// Such nodes don't track their extents as they don't relate to actual tokens.
 	template <typename T>
 	T *alloc_recovery_node() {
-		T *node = memnew(T);
+		T *node = memnew_placement(_alloc_node_memory(sizeof(T), alignof(T)), T);
 		node->next = list;
 		list = node;
 
@@ -1624,11 +1642,13 @@ private:
 
 public:
 	Error parse(const String &p_source_code, const String &p_script_path, bool p_for_completion, bool p_parse_body = true);
-	Error parse_binary(const Vector<uint8_t> &p_binary, const String &p_script_path);
+	Error parse_binary(Span<uint8_t> p_binary, const String &p_script_path);
 	ClassNode *get_tree() const { return head; }
 	bool is_tool() const { return _is_tool; }
 	Ref<GDScriptParserRef> get_depended_parser_for(const String &p_path);
 	const HashMap<String, Ref<GDScriptParserRef>> &get_depended_parsers();
+	const HashSet<String> &get_script_path_hints() const { return script_path_hints; }
+	const HashSet<StringName> &get_type_name_hints() const { return type_name_hints; }
 	ClassNode *find_class(const String &p_qualified_name) const;
 	bool has_class(const GDScriptParser::ClassNode *p_class) const;
 	static Variant::Type get_builtin_type(const StringName &p_type); // Excluding `Variant::NIL` and `Variant::OBJECT`.
@@ -0,0 +1,338 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_sampling_profiler.h"
+
+#include "gdscript.h"
+#include "gdscript_function.h"
+
+#include "core/io/json.h"
+#include "core/os/os.h"
+
+GDScriptSamplingProfiler *GDScriptSamplingProfiler::singleton = nullptr;
+SafeFlag GDScriptSamplingProfiler::active;
+SafeNumeric<uint32_t> GDScriptSamplingProfiler::serial;
+thread_local GDScriptSamplingProfiler::ThreadData *GDScriptSamplingProfiler::thread_data = nullptr;
+thread_local uint32_t GDScriptSamplingProfiler::thread_data_serial = 0;
+
+void GDScriptSamplingProfiler::_sampler_thread_func(void *p_userdata) {
+	GDScriptSamplingProfiler *self = static_cast<GDScriptSamplingProfiler *>(p_userdata);
+	Thread::set_name("GDScript Sampling Profiler");
+
+	while (!self->exit_sampler.is_set()) {
+		OS::get_singleton()->delay_usec(self->interval_usec);
+
+		{
+			MutexLock lock(self->threads_mutex);
+			for (ThreadData *td : self->threads) {
+				td->pending.store(true, std::memory_order_relaxed);
+			}
+		}
+
+		MutexLock lock(self->data_mutex);
+		self->_drain();
+	}
+}
+
+void GDScriptSamplingProfiler::_sample_thread() {
+	GDScriptSamplingProfiler *self = singleton;
+	if (self == nullptr) {
+		return;
+	}
+
+	ThreadData *td = thread_data;
+	if (unlikely(td == nullptr || thread_data_serial != serial.get())) {
+		// First time this thread runs script code while profiling; it stays registered until the profiler is freed.
+		td = memnew(ThreadData);
+		td->thread_id = Thread::get_caller_id();
+		{
+			MutexLock lock(self->threads_mutex);
+			self->threads.push_back(td);
+		}
+		thread_data = td;
+		thread_data_serial = serial.get();
+		return;
+	}
+
+	td->pending.store(false, std::memory_order_relaxed);
+
+	const uint32_t head = td->head.load(std::memory_order_relaxed);
+	if (head - td->tail.load(std::memory_order_acquire) >= RING_SIZE) {
+		td->dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	Sample &sample = td->ring[head & (RING_SIZE - 1)];
+	sample.time = OS::get_singleton()->get_ticks_usec();
+	sample.depth = 0;
+	for (const GDScriptLanguage::CallLevel *cl = GDScriptLanguage::_call_stack; cl != nullptr && sample.depth < MAX_DEPTH; cl = cl->prev) {
+		sample.frames[sample.depth++] = self->_get_frame_id(cl->function);
+	}
+	if (sample.depth == 0) {
+		return;
+	}
+
+	td->head.store(head + 1, std::memory_order_release);
+}
+
+uint32_t GDScriptSamplingProfiler::_get_frame_id(GDScriptFunction *p_function) {
+	uint32_t id = p_function->sampling_frame_id.get();
+	if (likely(id != 0)) {
+		return id;
+	}
+
+	MutexLock lock(frames_mutex);
+	id = p_function->sampling_frame_id.get();
+	if (id == 0) {
+		String name = vformat("%s (%s:%d)", p_function->get_name(), p_function->get_source(), p_function->_initial_line);
+		// Semicolons separate frames in the collapsed stack format.
+		frame_names.push_back(name.replace(";", ","));
+		id = frame_names.size() - 1;
+		p_function->sampling_frame_id.set(id);
+	}
+	return id;
+}
+
+uint32_t GDScriptSamplingProfiler::_get_node(uint32_t p_parent, uint32_t p_frame) {
+	const uint64_t key = (uint64_t(p_parent) << 32) | p_frame;
+	HashMap<uint64_t, uint32_t>::ConstIterator E = node_lookup.find(key);
+	if (E) {
+		return E->value;
+	}
+
+	StackNode node;
+	node.parent = p_parent;
+	node.frame = p_frame;
+	nodes.push_back(node);
+	node_lookup.insert(key, nodes.size() - 1);
+	return nodes.size() - 1;
+}
+
+void GDScriptSamplingProfiler::_drain() {
+	MutexLock lock(threads_mutex);
+
+	for (ThreadData *td : threads) {
+		uint32_t tail = td->tail.load(std::memory_order_relaxed);
+		const uint32_t head = td->head.load(std::memory_order_acquire);
+
+		while (tail != head) {
+			const Sample &sample = td->ring[tail & (RING_SIZE - 1)];
+
+			uint32_t node = 0;
+			for (int i = sample.depth - 1; i >= 0; i--) {
+				node = _get_node(node, sample.frames[i]);
+			}
+			nodes[node].self_samples++;
+			sample_count++;
+
+			if (trace_samples.size() < MAX_TRACE_SAMPLES) {
+				TraceSample trace_sample;
+				trace_sample.time = sample.time;
+				trace_sample.thread_id = td->thread_id;
+				trace_sample.node = node;
+				trace_samples.push_back(trace_sample);
+			}
+
+			tail++;
+		}
+
+		td->tail.store(tail, std::memory_order_release);
+		dropped_count += td->dropped.exchange(0, std::memory_order_relaxed);
+	}
+}
+
+void GDScriptSamplingProfiler::_reset_data() {
+	nodes.clear();
+	nodes.push_back(StackNode());
+	node_lookup.clear();
+	trace_samples.clear();
+	sample_count = 0;
+	dropped_count = 0;
+}
+
+Error GDScriptSamplingProfiler::start(int p_frequency) {
+#ifdef THREADS_ENABLED
+	ERR_FAIL_COND_V_MSG(p_frequency < 1 || p_frequency > 10000, ERR_INVALID_PARAMETER, "Sampling frequency must be between 1 and 10000 Hz.");
+	ERR_FAIL_COND_V_MSG(active.is_set(), ERR_ALREADY_IN_USE, "The GDScript sampling profiler is already running.");
+	ERR_FAIL_COND_V_MSG(!GDScriptLanguage::get_singleton()->should_track_call_stack(), ERR_UNAVAILABLE, "The GDScript sampling profiler requires call stack tracking. Enable the \"debug/settings/gdscript/always_track_call_stacks\" project setting to use it in release builds.");
+
+	interval_usec = 1000000 / p_frequency;
+	exit_sampler.clear();
+	active.set();
+	sampler_thread.start(_sampler_thread_func, this);
+	return OK;
+#else
+	ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "The GDScript sampling profiler requires thread support.");
+#endif
+}
+
+void GDScriptSamplingProfiler::stop() {
+	if (!active.is_set()) {
+		return;
+	}
+
+	exit_sampler.set();
+	sampler_thread.wait_to_finish();
+	active.clear();
+
+	MutexLock lock(data_mutex);
+	_drain();
+}
+
+bool GDScriptSamplingProfiler::is_running() const {
+	return active.is_set();
+}
+
+void GDScriptSamplingProfiler::clear() {
+	MutexLock lock(data_mutex);
+	_drain();
+	_reset_data();
+}
+
+int64_t GDScriptSamplingProfiler::get_sample_count() {
+	MutexLock lock(data_mutex);
+	_drain();
+	return sample_count;
+}
+
+int64_t GDScriptSamplingProfiler::get_dropped_sample_count() {
+	MutexLock lock(data_mutex);
+	_drain();
+	return dropped_count;
+}
+
+String GDScriptSamplingProfiler::get_collapsed_stacks() {
+	MutexLock lock(data_mutex);
+	_drain();
+	MutexLock frames_lock(frames_mutex);
+
+	String result;
+	LocalVector<uint32_t> path;
+	for (uint32_t i = 1; i < nodes.size(); i++) {
+		if (nodes[i].self_samples == 0) {
+			continue;
+		}
+
+		path.clear();
+		for (uint32_t node = i; node != 0; node = nodes[node].parent) {
+			path.push_back(node);
+		}
+
+		String line;
+		for (int j = path.size() - 1; j >= 0; j--) {
+			line += frame_names[nodes[path[j]].frame];
+			line += j > 0 ? ";" : " ";
+		}
+		result += line + itos(nodes[i].self_samples) + "\n";
+	}
+	return result;
+}
+
+String GDScriptSamplingProfiler::get_chrome_trace() {
+	MutexLock lock(data_mutex);
+	_drain();
+	MutexLock frames_lock(frames_mutex);
+
+	Array trace_events;
+	HashMap<Thread::ID, bool> named_threads;
+	Array samples;
+	for (const TraceSample &trace_sample : trace_samples) {
+		if (!named_threads.has(trace_sample.thread_id)) {
+			named_threads.insert(trace_sample.thread_id, true);
+
+			Dictionary args;
+			args["name"] = trace_sample.thread_id == Thread::get_main_id() ? String("Main Thread") : vformat("Thread %d", trace_sample.thread_id);
+			Dictionary event;
+			event["ph"] = "M";
+			event["name"] = "thread_name";
+			event["pid"] = 1;
+			event["tid"] = trace_sample.thread_id;
+			event["args"] = args;
+			trace_events.push_back(event);
+		}
+
+		Dictionary sample;
+		sample["cpu"] = 0;
+		sample["tid"] = trace_sample.thread_id;
+		sample["ts"] = itos(trace_sample.time);
+		sample["name"] = "GDScript";
+		sample["sf"] = itos(trace_sample.node);
+		sample["weight"] = "1";
+		samples.push_back(sample);
+	}
+
+	Dictionary stack_frames;
+	for (uint32_t i = 1; i < nodes.size(); i++) {
+		Dictionary frame;
+		frame["category"] = "GDScript";
+		frame["name"] = frame_names[nodes[i].frame];
+		if (nodes[i].parent != 0) {
+			frame["parent"] = itos(nodes[i].parent);
+		}
+		stack_frames[itos(i)] = frame;
+	}
+
+	Dictionary trace;
+	trace["traceEvents"] = trace_events;
+	trace["stackFrames"] = stack_frames;
+	trace["samples"] = samples;
+	return JSON::stringify(trace, "", false);
+}
+
+void GDScriptSamplingProfiler::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("start", "frequency"), &GDScriptSamplingProfiler::start, DEFVAL(1000));
+	ClassDB::bind_method(D_METHOD("stop"), &GDScriptSamplingProfiler::stop);
+	ClassDB::bind_method(D_METHOD("is_running"), &GDScriptSamplingProfiler::is_running);
+	ClassDB::bind_method(D_METHOD("clear"), &GDScriptSamplingProfiler::clear);
+	ClassDB::bind_method(D_METHOD("get_sample_count"), &GDScriptSamplingProfiler::get_sample_count);
+	ClassDB::bind_method(D_METHOD("get_dropped_sample_count"), &GDScriptSamplingProfiler::get_dropped_sample_count);
+	ClassDB::bind_method(D_METHOD("get_collapsed_stacks"), &GDScriptSamplingProfiler::get_collapsed_stacks);
+	ClassDB::bind_method(D_METHOD("get_chrome_trace"), &GDScriptSamplingProfiler::get_chrome_trace);
+}
+
+GDScriptSamplingProfiler::GDScriptSamplingProfiler() {
+	singleton = this;
+	serial.increment();
+	frame_names.push_back(String());
+	_reset_data();
+}
+
+GDScriptSamplingProfiler::~GDScriptSamplingProfiler() {
+	stop();
+
+	// Invalidates the per-thread pointers before their data is freed.
+	serial.increment();
+	for (ThreadData *td : threads) {
+		memdelete(td);
+	}
+	if (singleton == this) {
+		singleton = nullptr;
+	}
+}
@@ -0,0 +1,145 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/class_db.h"
+#include "core/object/object.h"
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+#include <atomic>
+
+class GDScriptFunction;
+
+// Statistical profiler for GDScript code.
+//
+// A background thread requests a sample from every thread running GDScript at a fixed frequency. The request
+// is answered by the thread itself the next time it reaches a line safepoint in the VM, by copying its script
+// call stack into a per-thread ring buffer. Nothing is recorded while the profiler is stopped, and the only cost
+// left in the VM is a single flag check per line.
+class GDScriptSamplingProfiler : public Object {
+	GDCLASS(GDScriptSamplingProfiler, Object);
+
+	static constexpr uint32_t MAX_DEPTH = 64;
+	static constexpr uint32_t RING_SIZE = 256; // Must be a power of two.
+	static constexpr uint32_t MAX_TRACE_SAMPLES = 1 << 20;
+
+	struct Sample {
+		uint64_t time = 0;
+		uint32_t depth = 0;
+		uint32_t frames[MAX_DEPTH]; // Innermost frame first.
+	};
+
+	// Written by the thread it belongs to, drained by whoever holds `data_mutex`.
+	struct ThreadData {
+		Thread::ID thread_id = 0;
+		std::atomic<bool> pending = false;
+		std::atomic<uint32_t> head = 0;
+		std::atomic<uint32_t> tail = 0;
+		std::atomic<uint64_t> dropped = 0;
+		Sample ring[RING_SIZE];
+	};
+
+	struct StackNode {
+		uint32_t parent = 0;
+		uint32_t frame = 0;
+		uint64_t self_samples = 0;
+	};
+
+	struct TraceSample {
+		uint64_t time = 0;
+		Thread::ID thread_id = 0;
+		uint32_t node = 0;
+	};
+
+	static GDScriptSamplingProfiler *singleton;
+	static SafeFlag active;
+	static SafeNumeric<uint32_t> serial;
+	static thread_local ThreadData *thread_data;
+	static thread_local uint32_t thread_data_serial;
+
+	Thread sampler_thread;
+	SafeFlag exit_sampler;
+	uint64_t interval_usec = 1000;
+
+	Mutex threads_mutex;
+	LocalVector<ThreadData *> threads;
+
+	Mutex frames_mutex;
+	LocalVector<String> frame_names; // Indexed by `GDScriptFunction::sampling_frame_id`, 0 is unused.
+
+	Mutex data_mutex;
+	LocalVector<StackNode> nodes; // Node 0 is the root of every stack.
+	HashMap<uint64_t, uint32_t> node_lookup; // (parent << 32 | frame) -> node.
+	LocalVector<TraceSample> trace_samples;
+	uint64_t sample_count = 0;
+	uint64_t dropped_count = 0;
+
+	static void _sampler_thread_func(void *p_userdata);
+	static void _sample_thread();
+
+	uint32_t _get_frame_id(GDScriptFunction *p_function);
+	uint32_t _get_node(uint32_t p_parent, uint32_t p_frame);
+	void _drain();
+	void _reset_data();
+
+protected:
+	static void _bind_methods();
+
+public:
+	static GDScriptSamplingProfiler *get_singleton() { return singleton; }
+
+	// Called by the VM at every line safepoint.
+	_FORCE_INLINE_ static void poll() {
+		if (unlikely(active.is_set())) {
+			const ThreadData *td = thread_data;
+			if (unlikely(td == nullptr || thread_data_serial != serial.get() || td->pending.load(std::memory_order_relaxed))) {
+				_sample_thread();
+			}
+		}
+	}
+
+	Error start(int p_frequency = 1000);
+	void stop();
+	bool is_running() const;
+	void clear();
+
+	int64_t get_sample_count();
+	int64_t get_dropped_sample_count();
+	String get_collapsed_stacks();
+	String get_chrome_trace();
+
+	GDScriptSamplingProfiler();
+	~GDScriptSamplingProfiler();
+};
@@ -136,7 +136,7 @@ GDScriptTokenizer::Token GDScriptTokenizerBuffer::_binary_to_token(const uint8_t
 	return token;
 }
 
-Error GDScriptTokenizerBuffer::set_code_buffer(const Vector<uint8_t> &p_buffer) {
+Error GDScriptTokenizerBuffer::set_code_buffer(Span<uint8_t> p_buffer) {
 	const uint8_t *buf = p_buffer.ptr();
 	ERR_FAIL_COND_V(p_buffer.size() < 12 || p_buffer[0] != 'G' || p_buffer[1] != 'D' || p_buffer[2] != 'S' || p_buffer[3] != 'C', ERR_INVALID_DATA);
 
@@ -147,7 +147,8 @@ Error GDScriptTokenizerBuffer::set_code_buffer(const Vector<uint8_t> &p_buffer)
 
 	Vector<uint8_t> contents;
 	if (decompressed_size == 0) {
-		contents = p_buffer.slice(12);
+		contents.resize(p_buffer.size() - 12);
+		memcpy(contents.ptrw(), &buf[12], contents.size());
 	} else {
 		contents.resize(decompressed_size);
 		const int64_t result = Compression::decompress(contents.ptrw(), contents.size(), &buf[12], p_buffer.size() - 12, Compression::MODE_ZSTD);
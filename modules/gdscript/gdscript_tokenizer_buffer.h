@@ -67,7 +67,7 @@ public:
 	Token _binary_to_token(const uint8_t *p_buffer);
 
 public:
-	Error set_code_buffer(const Vector<uint8_t> &p_buffer);
+	Error set_code_buffer(Span<uint8_t> p_buffer);
 	static Vector<uint8_t> parse_code_string(const String &p_code, CompressMode p_compress_mode);
 
 	virtual int get_cursor_line() const override;
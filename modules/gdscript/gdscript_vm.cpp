@@ -31,6 +31,7 @@
 #include "gdscript.h"
 #include "gdscript_function.h"
 #include "gdscript_lambda_callable.h"
+#include "gdscript_sampling_profiler.h"
 
 #include "core/os/os.h"
 #include "core/profiling/profiling.h"
@@ -116,6 +117,86 @@ void GDScriptFunction::_profile_native_call(uint64_t p_t_taken, const String &p_
 
 #endif // DEBUG_ENABLED
 
+// Returns the instance if `p_object` runs a GDScript, or null (also for placeholders and other languages).
+static _FORCE_INLINE_ GDScriptInstance *_get_gdscript_instance(Object *p_object) {
+	ScriptInstance *script_instance = p_object->get_script_instance();
+	if (script_instance && script_instance->get_language() == GDScriptLanguage::get_singleton() && !script_instance->is_placeholder()) {
+		return static_cast<GDScriptInstance *>(script_instance);
+	}
+	return nullptr;
+}
+
+bool GDScriptFunction::_find_inline_cache(int p_cache, const GDScript *p_script, uint32_t p_script_version, const GDType *p_native_type, InlineCacheEntry &r_entry) const {
+	const InlineCache &cache = _inline_caches_ptr[p_cache];
+	for (int i = 0; i < INLINE_CACHE_SIZE; i++) {
+		const InlineCacheSlot &slot = cache.slots[i];
+		const uint32_t sequence = slot.sequence.load(std::memory_order_acquire);
+		if (sequence == 0) {
+			break;
+		}
+		if (sequence & 1) {
+			// Being written.
+			continue;
+		}
+		r_entry.script = slot.script.load(std::memory_order_relaxed);
+		r_entry.native_type = slot.native_type.load(std::memory_order_relaxed);
+		r_entry.script_version = slot.script_version.load(std::memory_order_relaxed);
+		r_entry.member_index = slot.member_index.load(std::memory_order_relaxed);
+		r_entry.member_type = slot.member_type.load(std::memory_order_relaxed);
+		r_entry.function = slot.function.load(std::memory_order_relaxed);
+		r_entry.method = slot.method.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (slot.sequence.load(std::memory_order_relaxed) != sequence) {
+			// Overwritten while reading.
+			continue;
+		}
+		if (r_entry.script == p_script && r_entry.native_type == p_native_type && r_entry.script_version == p_script_version) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// Calls the function or method the call site resolved to last time for this receiver type, like `Object::callp()` would.
+// Returns `false` if the call must go through the generic path.
+bool GDScriptFunction::_call_inline_cached(int p_cache, Variant *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err) {
+	if (p_base->get_type() != Variant::OBJECT) {
+		return false;
+	}
+	Object *obj = p_base->get_validated_object();
+	if (!obj) {
+		return false;
+	}
+	GDScriptInstance *receiver = nullptr;
+	if (obj->get_script_instance()) {
+		receiver = _get_gdscript_instance(obj);
+		if (!receiver) {
+			return false;
+		}
+	}
+
+	const GDScript *receiver_script = receiver ? receiver->script.ptr() : nullptr;
+	const uint32_t receiver_script_version = receiver_script ? receiver_script->inline_cache_version.get() : 0;
+	InlineCacheEntry entry;
+	if (!_find_inline_cache(p_cache, receiver_script, receiver_script_version, &obj->get_gdtype(), entry)) {
+		entry = _resolve_call_inline_cache(p_cache, receiver_script, receiver_script_version, obj, p_method);
+	}
+	if (!entry.function && !entry.method) {
+		return false;
+	}
+
+	r_err.error = Callable::CallError::CALL_OK;
+#ifdef DEBUG_ENABLED
+	_ObjectDebugLock debug_lock(obj);
+#endif
+	if (entry.function) {
+		r_ret = entry.function->call(receiver, p_args, p_argcount, r_err);
+	} else {
+		r_ret = entry.method->call(obj, p_args, p_argcount, r_err);
+	}
+	return true;
+}
+
 Variant GDScriptFunction::_get_default_variant_for_data_type(const GDScriptDataType &p_data_type) {
 	if (p_data_type.kind == GDScriptDataType::BUILTIN) {
 		if (p_data_type.builtin_type == Variant::ARRAY) {
@@ -255,6 +336,31 @@ void (*type_init_function_table[])(Variant *) = {
 	static const void *switch_table_ops[] = { \
 		&&OPCODE_OPERATOR, \
 		&&OPCODE_OPERATOR_VALIDATED, \
+		&&OPCODE_OPERATOR_ADD_INT, \
+		&&OPCODE_OPERATOR_SUBTRACT_INT, \
+		&&OPCODE_OPERATOR_MULTIPLY_INT, \
+		&&OPCODE_OPERATOR_EQUAL_INT, \
+		&&OPCODE_OPERATOR_NOT_EQUAL_INT, \
+		&&OPCODE_OPERATOR_LESS_INT, \
+		&&OPCODE_OPERATOR_LESS_EQUAL_INT, \
+		&&OPCODE_OPERATOR_GREATER_INT, \
+		&&OPCODE_OPERATOR_GREATER_EQUAL_INT, \
+		&&OPCODE_OPERATOR_ADD_FLOAT, \
+		&&OPCODE_OPERATOR_SUBTRACT_FLOAT, \
+		&&OPCODE_OPERATOR_MULTIPLY_FLOAT, \
+		&&OPCODE_OPERATOR_DIVIDE_FLOAT, \
+		&&OPCODE_OPERATOR_LESS_FLOAT, \
+		&&OPCODE_OPERATOR_LESS_EQUAL_FLOAT, \
+		&&OPCODE_OPERATOR_GREATER_FLOAT, \
+		&&OPCODE_OPERATOR_GREATER_EQUAL_FLOAT, \
+		&&OPCODE_OPERATOR_ADD_VECTOR2, \
+		&&OPCODE_OPERATOR_SUBTRACT_VECTOR2, \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR2, \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR2_FLOAT, \
+		&&OPCODE_OPERATOR_ADD_VECTOR3, \
+		&&OPCODE_OPERATOR_SUBTRACT_VECTOR3, \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR3, \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT, \
 		&&OPCODE_TYPE_TEST_BUILTIN, \
 		&&OPCODE_TYPE_TEST_ARRAY, \
 		&&OPCODE_TYPE_TEST_DICTIONARY, \
@@ -317,6 +423,16 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_JUMP_IF_NOT, \
 		&&OPCODE_JUMP_TO_DEF_ARGUMENT, \
 		&&OPCODE_JUMP_IF_SHARED, \
+		&&OPCODE_JUMP_IF_NOT_EQUAL_INT, \
+		&&OPCODE_JUMP_IF_NOT_NOT_EQUAL_INT, \
+		&&OPCODE_JUMP_IF_NOT_LESS_INT, \
+		&&OPCODE_JUMP_IF_NOT_LESS_EQUAL_INT, \
+		&&OPCODE_JUMP_IF_NOT_GREATER_INT, \
+		&&OPCODE_JUMP_IF_NOT_GREATER_EQUAL_INT, \
+		&&OPCODE_JUMP_IF_NOT_LESS_FLOAT, \
+		&&OPCODE_JUMP_IF_NOT_LESS_EQUAL_FLOAT, \
+		&&OPCODE_JUMP_IF_NOT_GREATER_FLOAT, \
+		&&OPCODE_JUMP_IF_NOT_GREATER_EQUAL_FLOAT, \
 		&&OPCODE_RETURN, \
 		&&OPCODE_RETURN_TYPED_BUILTIN, \
 		&&OPCODE_RETURN_TYPED_ARRAY, \
@@ -543,11 +659,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 	if (p_state) {
 		//use existing (supplied) state (awaited)
-		stack = (Variant *)p_state->stack.ptr();
-		instruction_args = (Variant **)&p_state->stack.ptr()[sizeof(Variant) * p_state->stack_size]; //ptr() to avoid bounds check
+		stack = (Variant *)p_state->stack;
+		instruction_args = (Variant **)&p_state->stack[sizeof(Variant) * p_state->stack_size];
 		line = p_state->line;
 		ip = p_state->ip;
-		alloca_size = p_state->stack.size();
+		alloca_size = p_state->stack_bytes;
 		script = p_state->script;
 		p_instance = p_state->instance;
 		defarg = p_state->defarg;
@@ -738,6 +854,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #endif
 
 	bool awaited = false;
+	bool stack_handed_over = false;
 	Variant *variant_addresses[ADDR_TYPE_MAX] = { stack, _constants_ptr, p_instance ? p_instance->members.ptrw() : nullptr };
 
 #ifdef DEBUG_ENABLED
@@ -852,6 +969,43 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+#define OPCODE_OPERATOR_TYPED(m_name, m_result_type, m_left_type, m_operator, m_right_type) \
+	OPCODE(OPCODE_OPERATOR_##m_name) { \
+		CHECK_SPACE(4); \
+		GET_VARIANT_PTR(a, 0); \
+		GET_VARIANT_PTR(b, 1); \
+		GET_VARIANT_PTR(dst, 2); \
+		VariantInternalAccessor<m_result_type>::get(dst) = VariantInternalAccessor<m_left_type>::get(a) m_operator VariantInternalAccessor<m_right_type>::get(b); \
+		ip += 4; \
+	} \
+	DISPATCH_OPCODE
+
+			OPCODE_OPERATOR_TYPED(ADD_INT, int64_t, int64_t, +, int64_t);
+			OPCODE_OPERATOR_TYPED(SUBTRACT_INT, int64_t, int64_t, -, int64_t);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_INT, int64_t, int64_t, *, int64_t);
+			OPCODE_OPERATOR_TYPED(EQUAL_INT, bool, int64_t, ==, int64_t);
+			OPCODE_OPERATOR_TYPED(NOT_EQUAL_INT, bool, int64_t, !=, int64_t);
+			OPCODE_OPERATOR_TYPED(LESS_INT, bool, int64_t, <, int64_t);
+			OPCODE_OPERATOR_TYPED(LESS_EQUAL_INT, bool, int64_t, <=, int64_t);
+			OPCODE_OPERATOR_TYPED(GREATER_INT, bool, int64_t, >, int64_t);
+			OPCODE_OPERATOR_TYPED(GREATER_EQUAL_INT, bool, int64_t, >=, int64_t);
+			OPCODE_OPERATOR_TYPED(ADD_FLOAT, double, double, +, double);
+			OPCODE_OPERATOR_TYPED(SUBTRACT_FLOAT, double, double, -, double);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_FLOAT, double, double, *, double);
+			OPCODE_OPERATOR_TYPED(DIVIDE_FLOAT, double, double, /, double);
+			OPCODE_OPERATOR_TYPED(LESS_FLOAT, bool, double, <, double);
+			OPCODE_OPERATOR_TYPED(LESS_EQUAL_FLOAT, bool, double, <=, double);
+			OPCODE_OPERATOR_TYPED(GREATER_FLOAT, bool, double, >, double);
+			OPCODE_OPERATOR_TYPED(GREATER_EQUAL_FLOAT, bool, double, >=, double);
+			OPCODE_OPERATOR_TYPED(ADD_VECTOR2, Vector2, Vector2, +, Vector2);
+			OPCODE_OPERATOR_TYPED(SUBTRACT_VECTOR2, Vector2, Vector2, -, Vector2);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_VECTOR2, Vector2, Vector2, *, Vector2);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_VECTOR2_FLOAT, Vector2, Vector2, *, double);
+			OPCODE_OPERATOR_TYPED(ADD_VECTOR3, Vector3, Vector3, +, Vector3);
+			OPCODE_OPERATOR_TYPED(SUBTRACT_VECTOR3, Vector3, Vector3, -, Vector3);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_VECTOR3, Vector3, Vector3, *, Vector3);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_VECTOR3_FLOAT, Vector3, Vector3, *, double);
+
 			OPCODE(OPCODE_TYPE_TEST_BUILTIN) {
 				CHECK_SPACE(4);
 
@@ -1196,7 +1350,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_SET_NAMED) {
-				CHECK_SPACE(3);
+				CHECK_SPACE(5);
 
 				GET_VARIANT_PTR(dst, 0);
 				GET_VARIANT_PTR(value, 1);
@@ -1206,6 +1360,30 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
+#ifndef TOOLS_ENABLED
+				// Editor builds go through `Object::set()` since it also marks the object as edited.
+				int cache_index = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_index < 0 || cache_index >= _inline_cache_count);
+
+				if (dst->get_type() == Variant::OBJECT) {
+					Object *obj = dst->get_validated_object();
+					GDScriptInstance *receiver = obj ? _get_gdscript_instance(obj) : nullptr;
+					if (receiver) {
+						const GDScript *receiver_script = receiver->script.ptr();
+						const uint32_t receiver_script_version = receiver_script->inline_cache_version.get();
+						InlineCacheEntry entry;
+						if (!_find_inline_cache(cache_index, receiver_script, receiver_script_version, nullptr, entry)) {
+							entry = _resolve_member_inline_cache(cache_index, receiver_script, receiver_script_version, *index, true);
+						}
+						if (entry.member_index >= 0 && entry.member_index < receiver->members.size() && entry.member_type->is_type(*value)) {
+							receiver->members.write[entry.member_index] = *value;
+							ip += 5;
+							DISPATCH_OPCODE;
+						}
+					}
+				}
+#endif
+
 				bool valid;
 				dst->set_named(*index, *value, valid);
 
@@ -1228,7 +1406,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					OPCODE_BREAK;
 				}
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1248,7 +1426,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_GET_NAMED) {
-				CHECK_SPACE(4);
+				CHECK_SPACE(5);
 
 				GET_VARIANT_PTR(src, 0);
 				GET_VARIANT_PTR(dst, 1);
@@ -1258,6 +1436,29 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
+				int cache_index = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_index < 0 || cache_index >= _inline_cache_count);
+
+				if (src->get_type() == Variant::OBJECT) {
+					Object *obj = src->get_validated_object();
+					GDScriptInstance *receiver = obj ? _get_gdscript_instance(obj) : nullptr;
+					if (receiver) {
+						const GDScript *receiver_script = receiver->script.ptr();
+						const uint32_t receiver_script_version = receiver_script->inline_cache_version.get();
+						InlineCacheEntry entry;
+						if (!_find_inline_cache(cache_index, receiver_script, receiver_script_version, nullptr, entry)) {
+							entry = _resolve_member_inline_cache(cache_index, receiver_script, receiver_script_version, *index, false);
+						}
+						if (entry.member_index >= 0 && entry.member_index < receiver->members.size()) {
+							// Copy first, `src` and `dst` may be the same stack position.
+							Variant member = receiver->members[entry.member_index];
+							*dst = std::move(member);
+							ip += 5;
+							DISPATCH_OPCODE;
+						}
+					}
+				}
+
 				bool valid;
 #ifdef DEBUG_ENABLED
 				//allow better error message in cases where src and dst are the same stack position
@@ -1273,7 +1474,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 				*dst = ret;
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1896,7 +2097,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				bool call_async = (_code_ptr[ip]) == OPCODE_CALL_ASYNC;
 #endif
 				LOAD_INSTRUCTION_ARGS
-				CHECK_SPACE(3 + instr_arg_count);
+				CHECK_SPACE(4 + instr_arg_count);
 
 				ip += instr_arg_count;
 
@@ -1907,6 +2108,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(methodname_idx < 0 || methodname_idx >= _global_names_count);
 				const StringName *methodname = &_global_names_ptr[methodname_idx];
 
+				int cache_index = _code_ptr[ip + 3];
+				GD_ERR_BREAK(cache_index < 0 || cache_index >= _inline_cache_count);
+
 				GodotProfileZoneScriptSystemCall(methodname, source, name, *methodname, line);
 
 				GET_INSTRUCTION_ARG(base, argc);
@@ -1927,7 +2131,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				Callable::CallError err;
 				if (call_ret) {
 					GET_INSTRUCTION_ARG(ret, argc + 1);
-					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					if (!_call_inline_cached(cache_index, base, *methodname, (const Variant **)argptrs, argc, temp_ret, err)) {
+						base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					}
 					*ret = temp_ret;
 #ifdef DEBUG_ENABLED
 					if (ret->get_type() == Variant::NIL) {
@@ -1956,7 +2162,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 						}
 					}
 #endif
-				} else {
+				} else if (!_call_inline_cached(cache_index, base, *methodname, (const Variant **)argptrs, argc, temp_ret, err)) {
 					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
 				}
 #ifdef DEBUG_ENABLED
@@ -2012,7 +2218,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 #endif // DEBUG_ENABLED
 
-				ip += 3;
+				ip += 4;
 			}
 			DISPATCH_OPCODE;
 
@@ -2594,11 +2800,26 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					Ref<GDScriptFunctionState> gdfs = memnew(GDScriptFunctionState);
 					gdfs->function = this;
 
-					gdfs->state.stack.resize(alloca_size);
-
-					// First `FIXED_ADDRESSES_MAX` stack addresses are special, so we just skip them here.
-					for (int i = FIXED_ADDRESSES_MAX; i < _stack_size; i++) {
-						memnew_placement(&gdfs->state.stack.write[sizeof(Variant) * i], Variant(stack[i]));
+					if (p_state) {
+						// A resumed function already runs on a heap frame, which the new state takes over as is.
+						gdfs->state.stack = p_state->stack;
+						gdfs->state.stack_bytes = p_state->stack_bytes;
+						gdfs->state.stack_capacity = p_state->stack_capacity;
+						p_state->stack = nullptr;
+						p_state->stack_bytes = 0;
+						p_state->stack_capacity = 0;
+						p_state->stack_size = 0;
+						stack_handed_over = true;
+					} else {
+						gdfs->state.stack = alloc_await_frame(alloca_size, gdfs->state.stack_capacity);
+						gdfs->state.stack_bytes = alloca_size;
+
+						// First `FIXED_ADDRESSES_MAX` stack addresses are special, so we just skip them here.
+						// The values are moved, so the slots left behind are cheap to destroy.
+						Variant *frame = (Variant *)gdfs->state.stack;
+						for (int i = FIXED_ADDRESSES_MAX; i < _stack_size; i++) {
+							memnew_placement(&frame[i], Variant(std::move(stack[i])));
+						}
 					}
 					gdfs->state.stack_size = _stack_size;
 					gdfs->state.ip = ip + 2;
@@ -2630,7 +2851,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 					retvalue = gdfs;
 
-					Error err = sig.connect(Callable(gdfs.ptr(), "_signal_callback").bind(retvalue), Object::CONNECT_ONE_SHOT);
+					Error err = gdfs->_connect_resume(sig);
 					if (err != OK) {
 						err_text = "Error connecting to signal: " + sig.get_name() + " during await.";
 						OPCODE_BREAK;
@@ -2789,6 +3010,32 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+#define OPCODE_JUMP_IF_NOT_TYPED(m_name, m_type, m_operator) \
+	OPCODE(OPCODE_JUMP_IF_NOT_##m_name) { \
+		CHECK_SPACE(4); \
+		GET_VARIANT_PTR(a, 0); \
+		GET_VARIANT_PTR(b, 1); \
+		if (!(VariantInternalAccessor<m_type>::get(a) m_operator VariantInternalAccessor<m_type>::get(b))) { \
+			int to = _code_ptr[ip + 3]; \
+			GD_ERR_BREAK(to < 0 || to > _code_size); \
+			ip = to; \
+		} else { \
+			ip += 4; \
+		} \
+	} \
+	DISPATCH_OPCODE
+
+			OPCODE_JUMP_IF_NOT_TYPED(EQUAL_INT, int64_t, ==);
+			OPCODE_JUMP_IF_NOT_TYPED(NOT_EQUAL_INT, int64_t, !=);
+			OPCODE_JUMP_IF_NOT_TYPED(LESS_INT, int64_t, <);
+			OPCODE_JUMP_IF_NOT_TYPED(LESS_EQUAL_INT, int64_t, <=);
+			OPCODE_JUMP_IF_NOT_TYPED(GREATER_INT, int64_t, >);
+			OPCODE_JUMP_IF_NOT_TYPED(GREATER_EQUAL_INT, int64_t, >=);
+			OPCODE_JUMP_IF_NOT_TYPED(LESS_FLOAT, double, <);
+			OPCODE_JUMP_IF_NOT_TYPED(LESS_EQUAL_FLOAT, double, <=);
+			OPCODE_JUMP_IF_NOT_TYPED(GREATER_FLOAT, double, >);
+			OPCODE_JUMP_IF_NOT_TYPED(GREATER_EQUAL_FLOAT, double, >=);
+
 			OPCODE(OPCODE_RETURN) {
 				CHECK_SPACE(2);
 				GET_VARIANT_PTR(r, 0);
@@ -3903,6 +4150,8 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				line = _code_ptr[ip + 1];
 				ip += 2;
 
+				GDScriptSamplingProfiler::poll();
+
 				if (EngineDebugger::is_active()) {
 					// line
 					bool do_break = false;
@@ -4000,9 +4249,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	if (!p_state || awaited) {
 		GDScriptLanguage::get_singleton()->exit_function();
 
-		// Free stack, except reserved addresses.
-		for (int i = FIXED_ADDRESSES_MAX; i < _stack_size; i++) {
-			stack[i].~Variant();
+		// Free stack, except reserved addresses, unless the frame now belongs to the new function state.
+		if (!stack_handed_over) {
+			for (int i = FIXED_ADDRESSES_MAX; i < _stack_size; i++) {
+				stack[i].~Variant();
+			}
 		}
 	}
 
@@ -33,6 +33,7 @@
 #include "gdscript.h"
 #include "gdscript_cache.h"
 #include "gdscript_parser.h"
+#include "gdscript_sampling_profiler.h"
 #include "gdscript_tokenizer_buffer.h"
 #include "gdscript_utility_functions.h"
 
@@ -71,6 +72,7 @@ GDScriptLanguage *script_language_gd = nullptr;
 Ref<ResourceFormatLoaderGDScript> resource_loader_gd;
 Ref<ResourceFormatSaverGDScript> resource_saver_gd;
 GDScriptCache *gdscript_cache = nullptr;
+GDScriptSamplingProfiler *sampling_profiler = nullptr;
 
 #ifdef TOOLS_ENABLED
 
@@ -145,6 +147,10 @@ void initialize_gdscript_module(ModuleInitializationLevel p_level) {
 
 		gdscript_cache = memnew(GDScriptCache);
 
+		GDREGISTER_CLASS(GDScriptSamplingProfiler);
+		sampling_profiler = memnew(GDScriptSamplingProfiler);
+		Engine::get_singleton()->add_singleton(Engine::Singleton("GDScriptSamplingProfiler", sampling_profiler));
+
 		GDScriptUtilityFunctions::register_functions();
 	}
 
@@ -173,6 +179,10 @@ void uninitialize_gdscript_module(ModuleInitializationLevel p_level) {
 	if (p_level == MODULE_INITIALIZATION_LEVEL_SERVERS) {
 		ScriptServer::unregister_language(script_language_gd);
 
+		if (sampling_profiler) {
+			memdelete(sampling_profiler);
+		}
+
 		if (gdscript_cache) {
 			memdelete(gdscript_cache);
 		}
@@ -219,6 +229,10 @@ void test_compiler() {
 	GDScriptTests::test(GDScriptTests::TestType::TEST_COMPILER);
 }
 
+void benchmark_parser() {
+	GDScriptTests::benchmark_parser();
+}
+
 void test_bytecode() {
 	GDScriptTests::test(GDScriptTests::TestType::TEST_BYTECODE);
 }
@@ -227,5 +241,6 @@ REGISTER_TEST_COMMAND("gdscript-tokenizer", &test_tokenizer);
 REGISTER_TEST_COMMAND("gdscript-tokenizer-buffer", &test_tokenizer_buffer);
 REGISTER_TEST_COMMAND("gdscript-parser", &test_parser);
 REGISTER_TEST_COMMAND("gdscript-compiler", &test_compiler);
+REGISTER_TEST_COMMAND("gdscript-parser-benchmark", &benchmark_parser);
 REGISTER_TEST_COMMAND("gdscript-bytecode", &test_bytecode);
 #endif
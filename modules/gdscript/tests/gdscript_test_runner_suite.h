@@ -32,7 +32,9 @@
 
 #include "gdscript_test_runner.h"
 
+#include "modules/gdscript/gdscript_bytecode_cache.h"
 #include "modules/gdscript/gdscript_cache.h"
+#include "modules/gdscript/gdscript_sampling_profiler.h"
 #include "tests/test_macros.h"
 #include "tests/test_utils.h"
 
@@ -49,6 +51,13 @@ public:
 	}
 };
 
+class TestGDScriptBytecodeCacheAccessor {
+public:
+	static bool is_valid_code(const GDScriptFunction *p_function, const Vector<int> &p_code) {
+		return GDScriptBytecodeCache::_is_valid_code(p_function, p_function->get_script(), p_code, 0);
+	}
+};
+
 // TODO: Handle some cases failing on release builds. See: https://github.com/godotengine/godot/pull/88452
 #ifdef TOOLS_ENABLED
 TEST_SUITE("[Modules][GDScript]") {
@@ -105,6 +114,190 @@ TEST_CASE("[Modules][GDScript] Loading keeps ResourceCache and GDScriptCache in
 	CHECK(TestGDScriptCacheAccessor::has_full(path));
 }
 
+TEST_CASE("[Modules][GDScript] Loading prefetches dependencies without changing cyclic references") {
+	GDScriptLanguage::get_singleton()->init();
+	const String main_path = TestUtils::get_temp_path("gdscript_prefetch_main.gd");
+	const String base_path = TestUtils::get_temp_path("gdscript_prefetch_base.gd");
+	const String helper_path = TestUtils::get_temp_path("gdscript_prefetch_helper.gd");
+
+	const String files[3][2] = {
+		{ main_path, R"(
+extends "gdscript_prefetch_base.gd"
+
+const Helper = preload("gdscript_prefetch_helper.gd")
+
+func compute() -> int:
+	return base_value() + Helper.twice(5)
+)" },
+		{ base_path, R"(
+extends RefCounted
+
+func base_value() -> int:
+	return 7
+)" },
+		{ helper_path, R"(
+const Main = preload("gdscript_prefetch_main.gd")
+
+static func twice(p_value: int) -> int:
+	return p_value * 2
+
+static func make() -> RefCounted:
+	return Main.new()
+)" },
+	};
+	for (const String(&file)[2] : files) {
+		Ref<FileAccess> fa = FileAccess::open(file[0], FileAccess::ModeFlags::WRITE);
+		fa->store_string(file[1]);
+		fa->close();
+	}
+
+	Ref<GDScript> loaded = ResourceLoader::load(main_path);
+	REQUIRE(loaded.is_valid());
+	CHECK(loaded->is_valid());
+	CHECK(TestGDScriptCacheAccessor::has_full(main_path));
+	CHECK(TestGDScriptCacheAccessor::has_full(helper_path));
+
+	Ref<RefCounted> object = memnew(RefCounted);
+	object->set_script(loaded);
+	CHECK(int(object->call("compute")) == 17);
+}
+
+TEST_CASE("[Modules][GDScript] Bytecode cache restores compiled scripts") {
+	GDScriptLanguage::get_singleton()->init();
+	const String source = R"(
+extends RefCounted
+
+const FACTOR = 3
+
+class Accumulator:
+	var total := 0
+
+	func add(p_value: int) -> void:
+		total += p_value
+
+var values: Array[int] = [1, 2, 3]
+
+func compute() -> String:
+	var accumulator := Accumulator.new()
+	for value in values:
+		accumulator.add(value * FACTOR)
+	var doubled := values.map(func(p_value): return p_value * 2)
+	return "%d %s %s" % [accumulator.total, str(doubled), Vector2(3, 4).length()]
+)";
+
+	Ref<GDScript> compiled;
+	compiled.instantiate();
+	compiled->set_source_code(source);
+	ERR_PRINT_OFF;
+	REQUIRE(compiled->reload() == OK);
+	ERR_PRINT_ON;
+
+	Error error = FAILED;
+	const Vector<uint8_t> buffer = GDScriptBytecodeCache::serialize(compiled.ptr(), error);
+	REQUIRE_MESSAGE(error == OK, "The compiled script should be serialized successfully.");
+
+	Ref<GDScript> restored;
+	restored.instantiate();
+	restored->set_source_code(source);
+	CHECK_MESSAGE(GDScriptBytecodeCache::deserialize(restored.ptr(), buffer) == OK, "The script should be restored from its bytecode.");
+	CHECK(restored->is_valid());
+
+	Ref<RefCounted> compiled_object = memnew(RefCounted);
+	compiled_object->set_script(compiled);
+	Ref<RefCounted> restored_object = memnew(RefCounted);
+	restored_object->set_script(restored);
+	CHECK(String(compiled_object->call("compute")) == "18 [2, 4, 6] 5.0");
+	CHECK_MESSAGE(String(restored_object->call("compute")) == String(compiled_object->call("compute")), "The restored script should behave like the compiled one.");
+
+	Ref<GDScript> changed;
+	changed.instantiate();
+	changed->set_source_code(source + "\n# Changed.\n");
+	CHECK_MESSAGE(GDScriptBytecodeCache::deserialize(changed.ptr(), buffer) != OK, "The bytecode of a different source should be rejected.");
+	CHECK_FALSE(changed->is_valid());
+
+	Vector<uint8_t> damaged_buffer = buffer;
+	damaged_buffer.write[damaged_buffer.size() - 1] ^= 0xFF;
+	Ref<GDScript> damaged;
+	damaged.instantiate();
+	damaged->set_source_code(source);
+	CHECK_MESSAGE(GDScriptBytecodeCache::deserialize(damaged.ptr(), damaged_buffer) == ERR_FILE_CORRUPT, "A damaged entry should fail its checksum.");
+	CHECK_FALSE(damaged->is_valid());
+}
+
+TEST_CASE("[Modules][GDScript] Bytecode cache rejects malformed code") {
+	GDScriptLanguage::get_singleton()->init();
+	Ref<GDScript> script;
+	script.instantiate();
+	script->set_source_code(R"(
+extends RefCounted
+
+func compute() -> int:
+	var value := 1
+	return value
+)");
+	ERR_PRINT_OFF;
+	REQUIRE(script->reload() == OK);
+	ERR_PRINT_ON;
+
+	typedef GDScriptFunction F;
+	const GDScriptFunction *function = script->get_member_functions()[SNAME("compute")];
+	REQUIRE(function != nullptr);
+	const int local = F::FIXED_ADDRESSES_MAX;
+	const int constant = F::ADDR_TYPE_CONSTANT << F::ADDR_BITS;
+
+	CHECK(TestGDScriptBytecodeCacheAccessor::is_valid_code(function, Vector<int>()));
+	CHECK(TestGDScriptBytecodeCacheAccessor::is_valid_code(function, { F::OPCODE_ASSIGN_NULL, local, F::OPCODE_JUMP, 4, F::OPCODE_RETURN, local, F::OPCODE_END }));
+
+	CHECK_FALSE_MESSAGE(TestGDScriptBytecodeCacheAccessor::is_valid_code(function, { 0xFFFF, F::OPCODE_END }), "Unknown opcodes should be rejected.");
+	CHECK_FALSE_MESSAGE(TestGDScriptBytecodeCacheAccessor::is_valid_code(function, { F::OPCODE_ASSIGN, local }), "Truncated instructions should be rejected.");
+	CHECK_FALSE_MESSAGE(TestGDScriptBytecodeCacheAccessor::is_valid_code(function, { F::OPCODE_RETURN, local }), "Code should end with the end opcode.");
+	CHECK_FALSE_MESSAGE(TestGDScriptBytecodeCacheAccessor::is_valid_code(function, { F::OPCODE_ASSIGN_NULL, function->get_max_stack_size(), F::OPCODE_END }), "Stack addresses past the stack should be rejected.");
+	CHECK_FALSE_MESSAGE(TestGDScriptBytecodeCacheAccessor::is_valid_code(function, { F::OPCODE_RETURN, constant | 0xFFFF, F::OPCODE_END }), "Constant addresses past the constants should be rejected.");
+	CHECK_FALSE_MESSAGE(TestGDScriptBytecodeCacheAccessor::is_valid_code(function, { F::OPCODE_RETURN, 3 << F::ADDR_BITS, F::OPCODE_END }), "Unknown address types should be rejected.");
+	CHECK_FALSE_MESSAGE(TestGDScriptBytecodeCacheAccessor::is_valid_code(function, { F::OPCODE_GET_NAMED_VALIDATED, local, local, 0xFFFF, F::OPCODE_END }), "Indices past the function tables should be rejected.");
+	CHECK_FALSE_MESSAGE(TestGDScriptBytecodeCacheAccessor::is_valid_code(function, { F::OPCODE_JUMP, 1000, F::OPCODE_END }), "Jumps past the code should be rejected.");
+	CHECK_FALSE_MESSAGE(TestGDScriptBytecodeCacheAccessor::is_valid_code(function, { F::OPCODE_JUMP, 3, F::OPCODE_ASSIGN_NULL, local, F::OPCODE_END }), "Jumps into the operands of an instruction should be rejected.");
+}
+
+TEST_CASE("[Modules][GDScript] Sampling profiler records script stacks") {
+	GDScriptLanguage::get_singleton()->init();
+	GDScriptSamplingProfiler *profiler = GDScriptSamplingProfiler::get_singleton();
+	REQUIRE(profiler != nullptr);
+
+	Ref<GDScript> script;
+	script.instantiate();
+	script->set_source_code(R"(
+extends RefCounted
+
+func spin() -> int:
+	var total := 0
+	var end := Time.get_ticks_msec() + 100
+	while Time.get_ticks_msec() < end:
+		total += 1
+	return total
+)");
+	ERR_PRINT_OFF;
+	REQUIRE(script->reload() == OK);
+	ERR_PRINT_ON;
+
+	Ref<RefCounted> object = memnew(RefCounted);
+	object->set_script(script);
+
+	profiler->clear();
+	REQUIRE(profiler->start(1000) == OK);
+	CHECK(profiler->is_running());
+	object->call("spin");
+	profiler->stop();
+	CHECK_FALSE(profiler->is_running());
+
+	CHECK_MESSAGE(profiler->get_sample_count() > 0, "Samples should be recorded while script code runs.");
+	CHECK_MESSAGE(profiler->get_collapsed_stacks().contains("spin ("), "The busy function should appear in the collapsed stacks.");
+	CHECK(profiler->get_chrome_trace().contains("\"stackFrames\""));
+
+	profiler->clear();
+	CHECK(profiler->get_sample_count() == 0);
+}
+
 TEST_CASE("[Modules][GDScript] Validate built-in API") {
 	GDScriptLanguage *lang = GDScriptLanguage::get_singleton();
 
@@ -0,0 +1,28 @@
+signal step(value)
+
+var results := []
+
+func accumulate(p_label: String) -> String:
+	var total = 0
+	var parts = ""
+	var scale = Vector2(1, 2)
+	for i in 3:
+		var value = await step
+		total += value
+		parts += str(value) + ";"
+		scale *= 2
+	return "%s %d %s %s" % [p_label, total, parts, scale]
+
+func forward(p_label: String) -> void:
+	var result = await accumulate(p_label)
+	results.append(result)
+
+func test():
+	@warning_ignore("missing_await")
+	forward("first")
+	@warning_ignore("missing_await")
+	forward("second")
+	for value in [1, 10, 100]:
+		step.emit(value)
+	for entry in results:
+		print(entry)
@@ -0,0 +1,52 @@
+# Typed comparisons feeding a condition are fused with the jump, and jumps to jumps are threaded.
+# Check control flow is unchanged.
+
+func count_below(limit: int) -> int:
+	var count := 0
+	var i := 0
+	while i < limit:
+		if i % 2 == 0:
+			count += 1
+		else:
+			if i >= 7:
+				break
+		i += 1
+	return count
+
+func test():
+	print(count_below(5))
+	print(count_below(20))
+
+	var a: int = 4
+	var b: int = 9
+	if a < b and b != 10:
+		print("and taken")
+	if a > b and b != 10:
+		print("and not taken")
+	else:
+		print("else taken")
+	if a >= 4 and a <= 4 and a == 4:
+		print("equal bounds")
+
+	var x: float = 0.25
+	var y: float = 0.5
+	print("less" if x < y else "not less")
+	print("greater" if x > y else "not greater")
+
+	var nan: float = NAN
+	if nan < y:
+		print("nan less")
+	else:
+		print("nan not less")
+	if not nan >= y:
+		print("nan not greater or equal")
+
+	var total := 0
+	for i in 10:
+		if i > 2:
+			if i <= 5:
+				total += i
+			else:
+				continue
+		total += 100
+	print(total)
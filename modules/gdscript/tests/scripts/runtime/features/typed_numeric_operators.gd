@@ -0,0 +1,31 @@
+# Statically typed operands use dedicated opcodes, check they give the same results as untyped ones.
+
+func test():
+	var a: int = 7
+	var b: int = 3
+	print(a + b, " ", a - b, " ", a * b)
+	print(a == b, " ", a != b, " ", a < b, " ", a <= b, " ", a > b, " ", a >= b)
+
+	var x: float = 1.5
+	var y: float = 0.5
+	print(x + y, " ", x - y, " ", x * y, " ", x / y)
+	print(x < y, " ", x <= y, " ", x > y, " ", x >= y)
+
+	var u := Vector2(1, 2)
+	var v := Vector2(3, 4)
+	print(u + v, " ", u - v, " ", u * v, " ", u * x)
+
+	var p := Vector3(1, 2, 3)
+	var q := Vector3(4, 5, 6)
+	print(p + q, " ", p - q, " ", p * q, " ", p * x)
+
+	var untyped_a: Variant = a
+	var untyped_x: Variant = x
+	print(a * b - a == untyped_a * b - untyped_a, " ", x / y + x == untyped_x / y + untyped_x)
+
+	var sum := 0
+	var i := 0
+	while i < 10:
+		sum += i * i
+		i += 1
+	print(sum)
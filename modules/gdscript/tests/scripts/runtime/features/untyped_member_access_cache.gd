@@ -0,0 +1,86 @@
+# Untyped property access and method calls remember what they resolved to per receiver type.
+# Check each receiver still gets its own member, method, getter and setter.
+
+class A:
+	var first = "A.first"
+	var value = 1
+
+	func describe():
+		return "A(%s)" % value
+
+class B:
+	var padding = 0
+	var value = 2
+
+	func describe():
+		return "B(%s)" % value
+
+class C extends A:
+	var extra = 3
+
+	func describe():
+		return "C(%s, %s)" % [value, extra]
+
+class D:
+	var value = 4:
+		get:
+			return value * 10
+		set(new_value):
+			value = new_value + 1
+
+	func describe():
+		return "D(%s)" % value
+
+class E:
+	var value: int = 5
+
+	func describe():
+		return "E(%s)" % value
+
+class F extends Node:
+	var value = 6
+
+	func describe():
+		return "F(%s)" % value
+
+func read_value(object):
+	return object.value
+
+func write_value(object, new_value):
+	object.value = new_value
+
+func call_describe(object):
+	return object.describe()
+
+func print_receivers(receivers):
+	var values = []
+	var descriptions = []
+	for receiver in receivers:
+		values.append(read_value(receiver))
+		descriptions.append(call_describe(receiver))
+	print(values)
+	print(descriptions)
+
+func test():
+	var node := F.new()
+	var receivers = [A.new(), B.new(), C.new(), D.new(), E.new(), node]
+
+	# Twice, so the second time runs from the caches.
+	print_receivers(receivers)
+	print_receivers(receivers)
+
+	for receiver in receivers:
+		write_value(receiver, 7.0)
+	var values = []
+	for receiver in receivers:
+		values.append(read_value(receiver))
+	print(values)
+	print(type_string(typeof(receivers[4].value)))
+
+	# Native method on a scripted object.
+	print(call_name(node))
+	node.free()
+
+func call_name(object):
+	object.set_name("Cached")
+	return object.get_name()
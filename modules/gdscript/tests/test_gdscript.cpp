@@ -37,6 +37,7 @@
 #include "../gdscript_tokenizer_buffer.h"
 
 #include "core/config/project_settings.h"
+#include "core/io/dir_access.h"
 #include "core/io/file_access.h"
 #include "core/os/os.h"
 #include "core/string/string_builder.h"
@@ -363,4 +364,61 @@ void test(TestType p_type) {
 
 	finish_language();
 }
+
+static void collect_scripts(const String &p_dir, Vector<String> &r_paths) {
+	Ref<DirAccess> dir = DirAccess::open(p_dir);
+	ERR_FAIL_COND_MSG(dir.is_null(), "Could not open directory: " + p_dir);
+
+	dir->list_dir_begin();
+	String next = dir->get_next();
+	while (!next.is_empty()) {
+		if (dir->current_is_dir()) {
+			if (next != "." && next != "..") {
+				collect_scripts(p_dir.path_join(next), r_paths);
+			}
+		} else if (next.ends_with(".gd")) {
+			r_paths.push_back(p_dir.path_join(next));
+		}
+		next = dir->get_next();
+	}
+	dir->list_dir_end();
+}
+
+void benchmark_parser() {
+	// Parses every script of a directory (the test scripts by default) several times and reports the best pass.
+	String dir = "modules/gdscript/tests/scripts";
+	List<String> cmdlargs = OS::get_singleton()->get_cmdline_args();
+	if (!cmdlargs.is_empty() && DirAccess::dir_exists_absolute(cmdlargs.back()->get())) {
+		dir = cmdlargs.back()->get();
+	}
+
+	Vector<String> paths;
+	collect_scripts(dir, paths);
+	ERR_FAIL_COND_MSG(paths.is_empty(), "No GDScript files found in: " + dir);
+
+	init_language(dir);
+
+	Vector<String> sources;
+	uint64_t total_size = 0;
+	for (const String &path : paths) {
+		sources.push_back(FileAccess::get_file_as_string(path));
+		total_size += sources[sources.size() - 1].utf8().length();
+	}
+
+	const int passes = 10;
+	uint64_t best_usec = UINT64_MAX;
+	for (int pass = 0; pass < passes; pass++) {
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < sources.size(); i++) {
+			GDScriptParser parser;
+			parser.parse(sources[i], paths[i], false);
+		}
+		best_usec = MIN(best_usec, OS::get_singleton()->get_ticks_usec() - begin);
+	}
+
+	print_line(vformat("Parsed %d scripts (%s) in %.2f ms, best of %d passes: %.2f MiB/s.", paths.size(), String::humanize_size(total_size), best_usec / 1000.0, passes, (total_size / (1024.0 * 1024.0)) / (MAX(best_usec, (uint64_t)1) / 1000000.0)));
+
+	finish_language();
+}
+
 } // namespace GDScriptTests
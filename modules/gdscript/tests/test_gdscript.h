@@ -45,5 +45,6 @@ enum TestType {
 };
 
 void test(TestType p_type);
+void benchmark_parser();
 
 } // namespace GDScriptTests
@@ -46,6 +46,8 @@ class GodotAreaPair3D : public GodotConstraint3D {
 	bool body_has_attached_area = false;
 
 public:
+	virtual uint64_t get_order_key() const override { return hash64_murmur3_64(area->get_self().get_id(), (uint64_t(uint32_t(body_shape)) << 32) | uint32_t(area_shape)); }
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
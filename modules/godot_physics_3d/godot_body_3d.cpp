@@ -799,6 +799,47 @@ bool GodotBody3D::sleep_test(real_t p_step) {
 	}
 }
 
+void GodotBody3D::save_state(uint8_t *r_state) const {
+	physics_state_write(r_state, get_transform());
+	physics_state_write(r_state, new_transform);
+	physics_state_write(r_state, linear_velocity);
+	physics_state_write(r_state, angular_velocity);
+	physics_state_write(r_state, prev_linear_velocity);
+	physics_state_write(r_state, prev_angular_velocity);
+	physics_state_write(r_state, applied_force);
+	physics_state_write(r_state, applied_torque);
+	physics_state_write(r_state, constant_force);
+	physics_state_write(r_state, constant_torque);
+	physics_state_write(r_state, still_time);
+	physics_state_write(r_state, uint8_t(active));
+}
+
+void GodotBody3D::restore_state(const uint8_t *p_state) {
+	Transform3D transform;
+	physics_state_read(p_state, transform);
+	physics_state_read(p_state, new_transform);
+	physics_state_read(p_state, linear_velocity);
+	physics_state_read(p_state, angular_velocity);
+	physics_state_read(p_state, prev_linear_velocity);
+	physics_state_read(p_state, prev_angular_velocity);
+	physics_state_read(p_state, applied_force);
+	physics_state_read(p_state, applied_torque);
+	physics_state_read(p_state, constant_force);
+	physics_state_read(p_state, constant_torque);
+	physics_state_read(p_state, still_time);
+	uint8_t was_active = 0;
+	physics_state_read(p_state, was_active);
+
+	if (transform != get_transform()) {
+		_set_transform(transform);
+		// Match the inverse computed by `integrate_velocities()` so re-simulation stays bit-identical.
+		_set_inv_transform(mode >= PhysicsServer3D::BODY_MODE_RIGID ? transform.inverse() : transform.affine_inverse());
+		_update_transform_dependent();
+	}
+
+	set_active(was_active);
+}
+
 void GodotBody3D::set_state_sync_callback(const Callable &p_callable) {
 	body_state_callback = p_callable;
 }
@@ -38,6 +38,19 @@
 class GodotConstraint3D;
 class GodotPhysicsDirectBodyState3D;
 
+// Raw field (de)serialization used by space state snapshots.
+template <typename T>
+_FORCE_INLINE_ void physics_state_write(uint8_t *&r_state, const T &p_value) {
+	memcpy(r_state, &p_value, sizeof(T));
+	r_state += sizeof(T);
+}
+
+template <typename T>
+_FORCE_INLINE_ void physics_state_read(const uint8_t *&p_state, T &r_value) {
+	memcpy(&r_value, p_state, sizeof(T));
+	p_state += sizeof(T);
+}
+
 class GodotBody3D : public GodotCollisionObject3D {
 	PhysicsServer3D::BodyMode mode = PhysicsServer3D::BODY_MODE_RIGID;
 
@@ -150,6 +163,11 @@ class GodotBody3D : public GodotCollisionObject3D {
 	friend class GodotPhysicsDirectBodyState3D; // i give up, too many functions to expose
 
 public:
+	static constexpr uint32_t STATE_SIZE = sizeof(Transform3D) * 2 + sizeof(Vector3) * 8 + sizeof(real_t) + 1;
+
+	void save_state(uint8_t *r_state) const;
+	void restore_state(const uint8_t *p_state);
+
 	void set_state_sync_callback(const Callable &p_callable);
 	void set_force_integration_callback(const Callable &p_callable, const Variant &p_udata = Variant());
 
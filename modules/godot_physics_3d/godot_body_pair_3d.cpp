@@ -595,6 +595,70 @@ void GodotBodyPair3D::solve(real_t p_step) {
 	}
 }
 
+void GodotBodyContact3D::_save_contact_state(const Contact &p_contact, uint8_t *&r_state) {
+	physics_state_write(r_state, p_contact.position);
+	physics_state_write(r_state, p_contact.normal);
+	physics_state_write(r_state, p_contact.local_A);
+	physics_state_write(r_state, p_contact.local_B);
+	physics_state_write(r_state, p_contact.acc_impulse);
+	physics_state_write(r_state, p_contact.acc_tangent_impulse);
+	physics_state_write(r_state, p_contact.acc_normal_impulse);
+	physics_state_write(r_state, p_contact.acc_bias_impulse);
+	physics_state_write(r_state, p_contact.acc_bias_impulse_center_of_mass);
+	physics_state_write(r_state, p_contact.depth);
+	physics_state_write(r_state, int32_t(p_contact.index_A));
+	physics_state_write(r_state, int32_t(p_contact.index_B));
+	physics_state_write(r_state, uint8_t(p_contact.active));
+	physics_state_write(r_state, uint8_t(p_contact.used));
+}
+
+void GodotBodyContact3D::_restore_contact_state(Contact &r_contact, const uint8_t *&p_state) {
+	physics_state_read(p_state, r_contact.position);
+	physics_state_read(p_state, r_contact.normal);
+	physics_state_read(p_state, r_contact.local_A);
+	physics_state_read(p_state, r_contact.local_B);
+	physics_state_read(p_state, r_contact.acc_impulse);
+	physics_state_read(p_state, r_contact.acc_tangent_impulse);
+	physics_state_read(p_state, r_contact.acc_normal_impulse);
+	physics_state_read(p_state, r_contact.acc_bias_impulse);
+	physics_state_read(p_state, r_contact.acc_bias_impulse_center_of_mass);
+	physics_state_read(p_state, r_contact.depth);
+	int32_t index = 0;
+	physics_state_read(p_state, index);
+	r_contact.index_A = index;
+	physics_state_read(p_state, index);
+	r_contact.index_B = index;
+	uint8_t flag = 0;
+	physics_state_read(p_state, flag);
+	r_contact.active = flag;
+	physics_state_read(p_state, flag);
+	r_contact.used = flag;
+}
+
+void GodotBodyPair3D::save_state(uint8_t *r_state) const {
+	physics_state_write(r_state, sep_axis);
+	physics_state_write(r_state, uint32_t(contact_count));
+	for (int i = 0; i < MAX_CONTACTS; i++) {
+		if (i < contact_count) {
+			_save_contact_state(contacts[i], r_state);
+		} else {
+			// Keep unused slots zeroed so the snapshot (and its hash) only depends on live contacts.
+			memset(r_state, 0, CONTACT_STATE_SIZE);
+			r_state += CONTACT_STATE_SIZE;
+		}
+	}
+}
+
+void GodotBodyPair3D::restore_state(const uint8_t *p_state) {
+	physics_state_read(p_state, sep_axis);
+	uint32_t count = 0;
+	physics_state_read(p_state, count);
+	contact_count = MIN(int(count), int(MAX_CONTACTS));
+	for (int i = 0; i < contact_count; i++) {
+		_restore_contact_state(contacts[i], p_state);
+	}
+}
+
 GodotBodyPair3D::GodotBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotBody3D *p_B, int p_shape_B) :
 		GodotBodyContact3D(_arr, 2) {
 	A = p_A;
@@ -64,6 +64,11 @@ protected:
 
 	GodotSpace3D *space = nullptr;
 
+	static constexpr uint32_t CONTACT_STATE_SIZE = sizeof(Vector3) * 6 + sizeof(real_t) * 4 + sizeof(int32_t) * 2 + 2;
+
+	static void _save_contact_state(const Contact &p_contact, uint8_t *&r_state);
+	static void _restore_contact_state(Contact &r_contact, const uint8_t *&p_state);
+
 	GodotBodyContact3D(GodotBody3D **p_body_ptr = nullptr, int p_body_count = 0) :
 			GodotConstraint3D(p_body_ptr, p_body_count) {
 	}
@@ -104,6 +109,12 @@ class GodotBodyPair3D : public GodotBodyContact3D {
 	bool _test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A, const Transform3D &p_xform_A, GodotBody3D *p_B, int p_shape_B, const Transform3D &p_xform_B);
 
 public:
+	virtual uint64_t get_order_key() const override { return (uint64_t(uint32_t(shape_A)) << 32) | uint32_t(shape_B); }
+
+	virtual uint32_t get_state_size() const override { return sizeof(Vector3) + sizeof(uint32_t) + CONTACT_STATE_SIZE * MAX_CONTACTS; }
+	virtual void save_state(uint8_t *r_state) const override;
+	virtual void restore_state(const uint8_t *p_state) override;
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
@@ -132,6 +143,8 @@ class GodotBodySoftBodyPair3D : public GodotBodyContact3D {
 	void validate_contacts();
 
 public:
+	virtual uint64_t get_order_key() const override { return hash64_murmur3_64(soft_body->get_self().get_id(), uint32_t(body_shape)); }
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
@@ -73,6 +73,14 @@ public:
 	_FORCE_INLINE_ void disable_collisions_between_bodies(const bool p_disabled) { disabled_collisions_between_bodies = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled_collisions_between_bodies() const { return disabled_collisions_between_bodies; }
 
+	// Disambiguates constraints sharing the same bodies when islands are sorted in deterministic mode.
+	virtual uint64_t get_order_key() const { return self.get_id(); }
+
+	// Solver state carried between steps (e.g. warm starting), saved with space snapshots.
+	virtual uint32_t get_state_size() const { return 0; }
+	virtual void save_state(uint8_t *r_state) const {}
+	virtual void restore_state(const uint8_t *p_state) {}
+
 	virtual bool setup(real_t p_step) = 0;
 	virtual bool pre_solve(real_t p_step) = 0;
 	virtual void solve(real_t p_step) = 0;
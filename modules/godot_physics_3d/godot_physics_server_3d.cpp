@@ -214,6 +214,24 @@ int GodotPhysicsServer3D::space_get_contact_count(RID p_space) const {
 	return space->get_debug_contact_count();
 }
 
+PackedByteArray GodotPhysicsServer3D::space_save_state(RID p_space) const {
+	const GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, PackedByteArray());
+	return space->save_state();
+}
+
+Error GodotPhysicsServer3D::space_restore_state(RID p_space, const PackedByteArray &p_state) {
+	GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, ERR_INVALID_PARAMETER);
+	return space->restore_state(p_state);
+}
+
+uint32_t GodotPhysicsServer3D::space_get_state_hash(RID p_space) const {
+	const GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, 0);
+	return space->get_state_hash();
+}
+
 RID GodotPhysicsServer3D::area_create() {
 	GodotArea3D *area = memnew(GodotArea3D);
 	RID rid = area_owner.make_rid(area);
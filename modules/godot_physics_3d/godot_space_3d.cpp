@@ -1064,6 +1064,11 @@ void *GodotSpace3D::_broadphase_pair(GodotCollisionObject3D *A, int p_subindex_A
 			GodotBodySoftBodyPair3D *soft_pair = memnew(GodotBodySoftBodyPair3D(static_cast<GodotBody3D *>(A), p_subindex_A, static_cast<GodotSoftBody3D *>(B)));
 			return soft_pair;
 		} else {
+			if (self->deterministic && A->get_self().get_id() > B->get_self().get_id()) {
+				// Solve pairs in a fixed body order regardless of how the broadphase reported them.
+				SWAP(A, B);
+				SWAP(p_subindex_A, p_subindex_B);
+			}
 			GodotBodyPair3D *b = memnew(GodotBodyPair3D(static_cast<GodotBody3D *>(A), p_subindex_A, static_cast<GodotBody3D *>(B), p_subindex_B));
 			return b;
 		}
@@ -1240,6 +1245,188 @@ real_t GodotSpace3D::get_param(PhysicsServer3D::SpaceParameter p_param) const {
 	return 0;
 }
 
+#define STATE_MAGIC 0x33535047 // "GPS3"
+#define STATE_VERSION 1
+
+void GodotSpace3D::_get_state_bodies(LocalVector<GodotBody3D *> &r_bodies) const {
+	r_bodies.reserve(objects.size());
+	for (GodotCollisionObject3D *E : objects) {
+		if (E->get_type() != GodotCollisionObject3D::TYPE_BODY || E->get_self() == static_global_body) {
+			continue;
+		}
+		r_bodies.push_back(static_cast<GodotBody3D *>(E));
+	}
+	r_bodies.sort_custom<GodotBody3DRIDSort>();
+}
+
+void GodotSpace3D::_get_state_constraints(const LocalVector<GodotBody3D *> &p_bodies, LocalVector<GodotConstraint3D *> &r_constraints) const {
+	for (const GodotBody3D *body : p_bodies) {
+		for (const KeyValue<GodotConstraint3D *, int> &E : body->get_constraint_map()) {
+			// Each constraint is recorded once, through its first body.
+			if (E.value == 0 && E.key->get_state_size() > 0) {
+				r_constraints.push_back(E.key);
+			}
+		}
+	}
+	r_constraints.sort_custom<GodotConstraint3DSort>();
+}
+
+Vector<uint8_t> GodotSpace3D::save_state() const {
+	LocalVector<GodotBody3D *> bodies;
+	_get_state_bodies(bodies);
+	LocalVector<GodotConstraint3D *> constraints;
+	_get_state_constraints(bodies, constraints);
+
+	const uint32_t constraint_key_size = sizeof(uint64_t) * 3 + sizeof(uint32_t);
+	uint64_t size = sizeof(uint32_t) * 4 + uint64_t(bodies.size()) * (sizeof(uint64_t) + GodotBody3D::STATE_SIZE);
+	for (const GodotConstraint3D *constraint : constraints) {
+		size += constraint_key_size + constraint->get_state_size();
+	}
+
+	Vector<uint8_t> state;
+	state.resize(size);
+	uint8_t *w = state.ptrw();
+
+	physics_state_write(w, uint32_t(STATE_MAGIC));
+	physics_state_write(w, uint32_t(STATE_VERSION));
+	physics_state_write(w, bodies.size());
+	physics_state_write(w, constraints.size());
+
+	for (const GodotBody3D *body : bodies) {
+		physics_state_write(w, body->get_self().get_id());
+		body->save_state(w);
+		w += GodotBody3D::STATE_SIZE;
+	}
+
+	for (const GodotConstraint3D *constraint : constraints) {
+		uint64_t key[3];
+		GodotConstraint3DSort::get_key(constraint, key);
+		physics_state_write(w, key[0]);
+		physics_state_write(w, key[1]);
+		physics_state_write(w, key[2]);
+		physics_state_write(w, constraint->get_state_size());
+		constraint->save_state(w);
+		w += constraint->get_state_size();
+	}
+
+	return state;
+}
+
+Error GodotSpace3D::restore_state(const Vector<uint8_t> &p_state) {
+	ERR_FAIL_COND_V_MSG(locked, ERR_LOCKED, "Space state can't be restored while the space is being stepped.");
+	ERR_FAIL_COND_V(p_state.size() < int64_t(sizeof(uint32_t) * 4), ERR_INVALID_DATA);
+
+	const uint8_t *r = p_state.ptr();
+	const uint8_t *end = r + p_state.size();
+
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	uint32_t body_count = 0;
+	uint32_t constraint_count = 0;
+	physics_state_read(r, magic);
+	physics_state_read(r, version);
+	physics_state_read(r, body_count);
+	physics_state_read(r, constraint_count);
+	ERR_FAIL_COND_V_MSG(magic != STATE_MAGIC || version != STATE_VERSION, ERR_INVALID_DATA, "Invalid physics space state.");
+	ERR_FAIL_COND_V(uint64_t(end - r) < uint64_t(body_count) * (sizeof(uint64_t) + GodotBody3D::STATE_SIZE), ERR_INVALID_DATA);
+
+	// Validate the constraint records before touching any body, so a bad snapshot leaves the space as it was.
+	{
+		const uint8_t *c = r + uint64_t(body_count) * (sizeof(uint64_t) + GodotBody3D::STATE_SIZE);
+		for (uint32_t i = 0; i < constraint_count; i++) {
+			ERR_FAIL_COND_V(end - c < int64_t(sizeof(uint64_t) * 3 + sizeof(uint32_t)), ERR_INVALID_DATA);
+			c += sizeof(uint64_t) * 3;
+			uint32_t size = 0;
+			physics_state_read(c, size);
+			ERR_FAIL_COND_V(end - c < int64_t(size), ERR_INVALID_DATA);
+			c += size;
+		}
+		ERR_FAIL_COND_V_MSG(c != end, ERR_INVALID_DATA, "Invalid physics space state.");
+	}
+
+	LocalVector<GodotBody3D *> bodies;
+	_get_state_bodies(bodies);
+
+	// Both lists are sorted by RID, so they can be merged in a single pass.
+	uint32_t body_index = 0;
+	for (uint32_t i = 0; i < body_count; i++) {
+		uint64_t id = 0;
+		physics_state_read(r, id);
+		while (body_index < bodies.size() && bodies[body_index]->get_self().get_id() < id) {
+			body_index++;
+		}
+		if (body_index < bodies.size() && bodies[body_index]->get_self().get_id() == id) {
+			bodies[body_index]->restore_state(r);
+		}
+		r += GodotBody3D::STATE_SIZE;
+	}
+
+	// Re-pair with the restored transforms so contact caches can be matched to their pairs.
+	broadphase->update();
+
+	LocalVector<GodotConstraint3D *> constraints;
+	_get_state_constraints(bodies, constraints);
+
+	uint32_t constraint_index = 0;
+	for (uint32_t i = 0; i < constraint_count; i++) {
+		uint64_t key[3] = {};
+		uint32_t size = 0;
+		ERR_FAIL_COND_V(end - r < int64_t(sizeof(key) + sizeof(size)), ERR_INVALID_DATA);
+		physics_state_read(r, key[0]);
+		physics_state_read(r, key[1]);
+		physics_state_read(r, key[2]);
+		physics_state_read(r, size);
+		ERR_FAIL_COND_V(end - r < int64_t(size), ERR_INVALID_DATA);
+
+		while (constraint_index < constraints.size()) {
+			GodotConstraint3D *constraint = constraints[constraint_index];
+			uint64_t current[3];
+			GodotConstraint3DSort::get_key(constraint, current);
+			if (GodotConstraint3DSort::compare_keys(current, key)) {
+				constraint_index++;
+				continue;
+			}
+			if (!GodotConstraint3DSort::compare_keys(key, current) && constraint->get_state_size() == size) {
+				constraint->restore_state(r);
+			}
+			break;
+		}
+		r += size;
+	}
+
+	return OK;
+}
+
+uint32_t GodotSpace3D::get_state_hash() const {
+	// Hashes the same records as save_state(), one at a time, without building the snapshot.
+	LocalVector<GodotBody3D *> bodies;
+	_get_state_bodies(bodies);
+	LocalVector<GodotConstraint3D *> constraints;
+	_get_state_constraints(bodies, constraints);
+
+	uint32_t hash = hash_murmur3_one_32(bodies.size());
+	hash = hash_murmur3_one_32(constraints.size(), hash);
+
+	uint8_t body_state[GodotBody3D::STATE_SIZE];
+	for (const GodotBody3D *body : bodies) {
+		hash = hash_murmur3_one_64(body->get_self().get_id(), hash);
+		body->save_state(body_state);
+		hash = hash_murmur3_buffer(body_state, GodotBody3D::STATE_SIZE, hash);
+	}
+
+	LocalVector<uint8_t> constraint_state;
+	for (const GodotConstraint3D *constraint : constraints) {
+		uint64_t key[3];
+		GodotConstraint3DSort::get_key(constraint, key);
+		hash = hash_murmur3_buffer(key, sizeof(key), hash);
+		constraint_state.resize(constraint->get_state_size());
+		constraint->save_state(constraint_state.ptr());
+		hash = hash_murmur3_buffer(constraint_state.ptr(), constraint_state.size(), hash);
+	}
+
+	return hash_fmix32(hash);
+}
+
 void GodotSpace3D::lock() {
 	locked = true;
 }
@@ -1265,6 +1452,7 @@ GodotSpace3D::GodotSpace3D() {
 	contact_max_separation = GLOBAL_GET("physics/3d/solver/contact_max_separation");
 	contact_max_allowed_penetration = GLOBAL_GET("physics/3d/solver/contact_max_allowed_penetration");
 	contact_bias = GLOBAL_GET("physics/3d/solver/default_contact_bias");
+	deterministic = GLOBAL_GET("physics/3d/solver/deterministic");
 
 	broadphase = GodotBroadPhase3D::create_func();
 	broadphase->set_pair_callback(_broadphase_pair, this);
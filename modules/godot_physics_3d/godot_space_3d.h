@@ -34,6 +34,7 @@
 #include "godot_body_3d.h"
 #include "godot_broad_phase_3d.h"
 #include "godot_collision_object_3d.h"
+#include "godot_constraint_3d.h"
 #include "godot_soft_body_3d.h"
 
 #include "core/typedefs.h"
@@ -55,6 +56,39 @@ public:
 	GodotPhysicsDirectSpaceState3D();
 };
 
+struct GodotBody3DRIDSort {
+	_FORCE_INLINE_ bool operator()(const GodotBody3D *p_a, const GodotBody3D *p_b) const {
+		return p_a->get_self().get_id() < p_b->get_self().get_id();
+	}
+};
+
+// Orders constraints by the bodies they link, so island solving doesn't depend on pair creation order.
+struct GodotConstraint3DSort {
+	static _FORCE_INLINE_ void get_key(const GodotConstraint3D *p_constraint, uint64_t r_key[3]) {
+		r_key[0] = p_constraint->get_body_count() > 0 ? p_constraint->get_body_ptr()[0]->get_self().get_id() : 0;
+		r_key[1] = p_constraint->get_body_count() > 1 ? p_constraint->get_body_ptr()[1]->get_self().get_id() : 0;
+		r_key[2] = p_constraint->get_order_key();
+	}
+
+	static _FORCE_INLINE_ bool compare_keys(const uint64_t p_a[3], const uint64_t p_b[3]) {
+		if (p_a[0] != p_b[0]) {
+			return p_a[0] < p_b[0];
+		}
+		if (p_a[1] != p_b[1]) {
+			return p_a[1] < p_b[1];
+		}
+		return p_a[2] < p_b[2];
+	}
+
+	_FORCE_INLINE_ bool operator()(const GodotConstraint3D *p_a, const GodotConstraint3D *p_b) const {
+		uint64_t key_a[3];
+		uint64_t key_b[3];
+		get_key(p_a, key_a);
+		get_key(p_b, key_b);
+		return compare_keys(key_a, key_b);
+	}
+};
+
 class GodotSpace3D {
 public:
 	enum ElapsedTime {
@@ -107,6 +141,7 @@ private:
 	real_t body_time_to_sleep = 0.0;
 
 	bool locked = false;
+	bool deterministic = false;
 
 	real_t last_step = 0.001;
 
@@ -123,6 +158,9 @@ private:
 
 	int _cull_aabb_for_body(GodotBody3D *p_body, const AABB &p_aabb);
 
+	void _get_state_bodies(LocalVector<GodotBody3D *> &r_bodies) const;
+	void _get_state_constraints(const LocalVector<GodotBody3D *> &p_bodies, LocalVector<GodotConstraint3D *> &r_constraints) const;
+
 public:
 	_FORCE_INLINE_ void set_self(const RID &p_self) { self = p_self; }
 	_FORCE_INLINE_ RID get_self() const { return self; }
@@ -198,6 +236,12 @@ public:
 	_FORCE_INLINE_ Vector<Vector3> get_debug_contacts() { return contact_debug; }
 	_FORCE_INLINE_ int get_debug_contact_count() { return contact_debug_count; }
 
+	_FORCE_INLINE_ bool is_deterministic() const { return deterministic; }
+
+	Vector<uint8_t> save_state() const;
+	Error restore_state(const Vector<uint8_t> &p_state);
+	uint32_t get_state_hash() const;
+
 	void set_static_global_body(RID p_body) { static_global_body = p_body; }
 	RID get_static_global_body() { return static_global_body; }
 
@@ -260,13 +260,22 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
 
+	const bool deterministic = p_space->is_deterministic();
+
+	island_bodies.clear();
 	b = body_list->first();
+	while (b) {
+		island_bodies.push_back(b->self());
+		b = b->next();
+	}
+	if (deterministic) {
+		// The active list order depends on activation history, use a stable one instead.
+		island_bodies.sort_custom<GodotBody3DRIDSort>();
+	}
 
 	uint32_t body_island_count = 0;
 
-	while (b) {
-		GodotBody3D *body = b->self();
-
+	for (GodotBody3D *body : island_bodies) {
 		if (body->get_island_step() != _step) {
 			++body_island_count;
 			if (body_islands.size() < body_island_count) {
@@ -286,6 +295,11 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 			_populate_island(body, body_island, constraint_island);
 
+			if (deterministic) {
+				// Constraint maps are ordered by pair creation, which varies with broadphase history.
+				constraint_island.sort_custom<GodotConstraint3DSort>();
+			}
+
 			if (body_island.is_empty()) {
 				--body_island_count;
 			}
@@ -294,7 +308,6 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 				--island_count;
 			}
 		}
-		b = b->next();
 	}
 
 	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE SOFT BODIES */
@@ -322,6 +335,10 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 			_populate_island_soft_body(soft_body, body_island, constraint_island);
 
+			if (deterministic) {
+				constraint_island.sort_custom<GodotConstraint3DSort>();
+			}
+
 			if (body_island.is_empty()) {
 				--body_island_count;
 			}
@@ -40,6 +40,7 @@ class GodotStep3D {
 	int iterations = 0;
 	real_t delta = 0.0;
 
+	LocalVector<GodotBody3D *> island_bodies;
 	LocalVector<LocalVector<GodotBody3D *>> body_islands;
 	LocalVector<LocalVector<GodotConstraint3D *>> constraint_islands;
 	LocalVector<GodotConstraint3D *> all_constraints;
@@ -0,0 +1,125 @@
+/**************************************************************************/
+/*  test_godot_physics_3d.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../godot_physics_server_3d.h"
+
+#include "core/config/project_settings.h"
+
+#include "tests/test_macros.h"
+
+namespace TestGodotPhysics3D {
+
+TEST_CASE("[Physics][GodotPhysics3D] Restoring a space state replays the same simulation") {
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/deterministic", true);
+
+	GodotPhysicsServer3D *server = memnew(GodotPhysicsServer3D(false));
+	server->init();
+
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+
+	RID floor_shape = server->box_shape_create();
+	server->shape_set_data(floor_shape, Vector3(10, 0.5, 10));
+	RID floor = server->body_create();
+	server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+	server->body_add_shape(floor, floor_shape);
+	server->body_set_state(floor, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, -0.5, 0)));
+	server->body_set_space(floor, space);
+
+	// A leaning stack of boxes, so bodies keep colliding with each other and with the floor.
+	RID box_shape = server->box_shape_create();
+	server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	LocalVector<RID> boxes;
+	for (int i = 0; i < 4; i++) {
+		RID box = server->body_create();
+		server->body_add_shape(box, box_shape);
+		server->body_set_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(Vector3(0, 1, 0), 0.1 * i), Vector3(0.3 * i, 0.6 + 1.05 * i, 0)));
+		server->body_set_space(box, space);
+		boxes.push_back(box);
+	}
+
+	const real_t step = 1.0 / 60.0;
+	const int steps = 30;
+
+	for (int i = 0; i < 10; i++) {
+		server->step(step);
+	}
+
+	const PackedByteArray state = server->space_save_state(space);
+	const uint32_t state_hash = server->space_get_state_hash(space);
+	CHECK_FALSE(state.is_empty());
+
+	LocalVector<uint32_t> hashes;
+	for (int i = 0; i < steps; i++) {
+		server->step(step);
+		hashes.push_back(server->space_get_state_hash(space));
+	}
+	LocalVector<Transform3D> transforms;
+	for (const RID &box : boxes) {
+		transforms.push_back(server->body_get_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM));
+	}
+	CHECK_NE(hashes[steps - 1], state_hash);
+
+	CHECK_EQ(server->space_restore_state(space, state), OK);
+	CHECK_EQ(server->space_get_state_hash(space), state_hash);
+
+	for (int i = 0; i < steps; i++) {
+		server->step(step);
+		CHECK_MESSAGE(server->space_get_state_hash(space) == hashes[i], vformat("State diverged at step %d.", i));
+	}
+	for (uint32_t i = 0; i < boxes.size(); i++) {
+		CHECK_EQ(Transform3D(server->body_get_state(boxes[i], PhysicsServer3D::BODY_STATE_TRANSFORM)), transforms[i]);
+	}
+
+	SUBCASE("Invalid snapshots are rejected") {
+		ERR_PRINT_OFF;
+		PackedByteArray corrupt = state;
+		corrupt.set(0, corrupt[0] ^ 0xFF);
+		CHECK_EQ(server->space_restore_state(space, corrupt), ERR_INVALID_DATA);
+		CHECK_EQ(server->space_restore_state(space, state.slice(0, state.size() / 2)), ERR_INVALID_DATA);
+		ERR_PRINT_ON;
+	}
+
+	for (const RID &box : boxes) {
+		server->free_rid(box);
+	}
+	server->free_rid(box_shape);
+	server->free_rid(floor);
+	server->free_rid(floor_shape);
+	server->free_rid(space);
+	server->finish();
+	memdelete(server);
+
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/deterministic", false);
+}
+
+} // namespace TestGodotPhysics3D
@@ -206,6 +206,20 @@ bool GodotNavigationServer3D::map_get_use_edge_connections(RID p_map) const {
 	return map->get_use_edge_connections();
 }
 
+COMMAND_2(map_set_use_hierarchical_pathfinding, RID, p_map, bool, p_enabled) {
+	NavMap3D *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL(map);
+
+	map->set_use_hierarchical_pathfinding(p_enabled);
+}
+
+bool GodotNavigationServer3D::map_get_use_hierarchical_pathfinding(RID p_map) const {
+	NavMap3D *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL_V(map, false);
+
+	return map->get_use_hierarchical_pathfinding();
+}
+
 COMMAND_2(map_set_edge_connection_margin, RID, p_map, real_t, p_connection_margin) {
 	NavMap3D *map = map_owner.get_or_null(p_map);
 	ERR_FAIL_NULL(map);
@@ -259,6 +273,13 @@ Vector<Vector3> GodotNavigationServer3D::map_get_path(RID p_map, Vector3 p_origi
 	return query_result->get_path();
 }
 
+Vector3 GodotNavigationServer3D::map_get_flow_field_next_position(RID p_map, const Vector3 &p_target_position, const Vector3 &p_from_position, uint32_t p_navigation_layers) {
+	NavMap3D *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL_V(map, Vector3());
+
+	return map->get_flow_field_next_position(p_target_position, p_from_position, p_navigation_layers);
+}
+
 Vector3 GodotNavigationServer3D::map_get_closest_point_to_segment(RID p_map, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const {
 	const NavMap3D *map = map_owner.get_or_null(p_map);
 	ERR_FAIL_NULL_V(map, Vector3());
@@ -1403,6 +1424,7 @@ void GodotNavigationServer3D::physics_process(double p_delta_time) {
 	int _new_pm_edge_connection_count = 0;
 	int _new_pm_edge_free_count = 0;
 	int _new_pm_obstacle_count = 0;
+	int _new_pm_path_query_node_count = 0;
 
 	MutexLock lock(operations_mutex);
 	for (uint32_t i(0); i < active_maps.size(); i++) {
@@ -1419,6 +1441,7 @@ void GodotNavigationServer3D::physics_process(double p_delta_time) {
 		_new_pm_edge_connection_count += active_maps[i]->get_pm_edge_connection_count();
 		_new_pm_edge_free_count += active_maps[i]->get_pm_edge_free_count();
 		_new_pm_obstacle_count += active_maps[i]->get_pm_obstacle_count();
+		_new_pm_path_query_node_count += active_maps[i]->get_pm_path_query_node_count();
 	}
 
 	pm_region_count = _new_pm_region_count;
@@ -1430,6 +1453,7 @@ void GodotNavigationServer3D::physics_process(double p_delta_time) {
 	pm_edge_connection_count = _new_pm_edge_connection_count;
 	pm_edge_free_count = _new_pm_edge_free_count;
 	pm_obstacle_count = _new_pm_obstacle_count;
+	pm_path_query_node_count = _new_pm_path_query_node_count;
 }
 
 void GodotNavigationServer3D::init() {
@@ -1457,6 +1481,39 @@ void GodotNavigationServer3D::query_path(const Ref<NavigationPathQueryParameters
 	NavMeshQueries3D::map_query_path(map, p_query_parameters, p_query_result, p_callback);
 }
 
+void GodotNavigationServer3D::query_paths(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results, const Callable &p_callback) {
+	ERR_FAIL_COND_MSG(p_query_parameters.size() != p_query_results.size(), "The number of path query parameters and results must match.");
+
+	struct MapQueries {
+		LocalVector<Ref<NavigationPathQueryParameters3D>> parameters;
+		LocalVector<Ref<NavigationPathQueryResult3D>> results;
+	};
+
+	// Queries are batched per map so each map iteration is only locked once.
+	HashMap<NavMap3D *, MapQueries> map_queries;
+	for (int64_t i = 0; i < p_query_parameters.size(); i++) {
+		Ref<NavigationPathQueryParameters3D> query_parameters = p_query_parameters[i];
+		Ref<NavigationPathQueryResult3D> query_result = p_query_results[i];
+		ERR_CONTINUE(query_parameters.is_null());
+		ERR_CONTINUE(query_result.is_null());
+
+		NavMap3D *map = map_owner.get_or_null(query_parameters->get_map());
+		ERR_CONTINUE(map == nullptr);
+
+		MapQueries &queries = map_queries[map];
+		queries.parameters.push_back(query_parameters);
+		queries.results.push_back(query_result);
+	}
+
+	for (KeyValue<NavMap3D *, MapQueries> &E : map_queries) {
+		NavMeshQueries3D::map_query_paths(E.key, E.value.parameters, E.value.results);
+	}
+
+	if (p_callback.is_valid()) {
+		NavMeshQueries3D::emit_callback(p_callback);
+	}
+}
+
 RID GodotNavigationServer3D::source_geometry_parser_create() {
 	RWLockWrite write_lock(geometry_parser_rwlock);
 
@@ -1544,6 +1601,9 @@ int GodotNavigationServer3D::get_process_info(ProcessInfo p_info) const {
 		case INFO_OBSTACLE_COUNT: {
 			return pm_obstacle_count;
 		} break;
+		case INFO_PATH_QUERY_NODE_COUNT: {
+			return pm_path_query_node_count;
+		} break;
 	}
 
 	return 0;
@@ -0,0 +1,218 @@
+/**************************************************************************/
+/*  nav_avoidance_grid_3d.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "nav_avoidance_grid_3d.h"
+
+#include "../nav_agent_3d.h"
+
+Vector3i NavAvoidanceGrid3D::_get_cell(float p_x, float p_y, float p_z) const {
+	return Vector3i(
+			int(Math::floor(p_x * inv_cell_size)),
+			int(Math::floor(p_y * inv_cell_size)),
+			int(Math::floor(p_z * inv_cell_size)));
+}
+
+void NavAvoidanceGrid3D::_sort_agents(const LocalVector<NavAgent3D *> &p_agents) {
+	const uint32_t agent_count = p_agents.size();
+
+	// Counting sort, first count the agents of each cell.
+	cells.clear();
+	for (uint32_t i = 0; i < agent_count; i++) {
+		cells[agent_cells[i]].end++;
+	}
+
+	uint32_t start = 0;
+	for (KeyValue<Vector3i, CellRange> &E : cells) {
+		const uint32_t count = E.value.end;
+		E.value.start = start;
+		E.value.end = start;
+		start += count;
+	}
+
+	sorted_agents.resize(agent_count);
+	for (uint32_t i = 0; i < agent_count; i++) {
+		CellRange *range = cells.getptr(agent_cells[i]);
+		sorted_agents[range->end++] = p_agents[i];
+	}
+}
+
+void NavAvoidanceGrid3D::update(const LocalVector<NavAgent3D *> &p_agents, bool p_use_3d_avoidance) {
+	const uint32_t agent_count = p_agents.size();
+	bool cells_changed = dirty || agent_cells.size() != agent_count;
+
+	if (cells_changed) {
+		// Cells are sized after the average neighbor distance so most agents only need to look at their adjacent cells.
+		float neighbor_distance_sum = 0.0f;
+		uint32_t neighbor_distance_count = 0;
+		for (NavAgent3D *agent : p_agents) {
+			const float neighbor_distance = p_use_3d_avoidance ? agent->get_rvo_agent_3d()->neighborDist_ : agent->get_rvo_agent_2d()->neighborDist_;
+			if (neighbor_distance > 0.0f) {
+				neighbor_distance_sum += neighbor_distance;
+				neighbor_distance_count++;
+			}
+		}
+		cell_size = neighbor_distance_count > 0 ? MAX(neighbor_distance_sum / neighbor_distance_count, 0.01f) : 1.0f;
+		inv_cell_size = 1.0f / cell_size;
+
+		agent_cells.resize(agent_count);
+	}
+
+	for (uint32_t i = 0; i < agent_count; i++) {
+		Vector3i cell;
+		if (p_use_3d_avoidance) {
+			const RVO3D::Vector3 &position = p_agents[i]->get_rvo_agent_3d()->position_;
+			cell = _get_cell(position.x(), position.y(), position.z());
+		} else {
+			const RVO2D::Vector2 &position = p_agents[i]->get_rvo_agent_2d()->position_;
+			cell = _get_cell(position.x(), 0.0f, position.y());
+		}
+		if (agent_cells[i] != cell) {
+			agent_cells[i] = cell;
+			cells_changed = true;
+		}
+	}
+
+	if (cells_changed) {
+		_sort_agents(p_agents);
+	}
+
+	// Agents move every step even when they stay in their cell.
+	positions_x.resize(agent_count);
+	positions_y.resize(agent_count);
+	positions_z.resize(agent_count);
+	avoidance_layers.resize(agent_count);
+
+	for (uint32_t i = 0; i < agent_count; i++) {
+		if (p_use_3d_avoidance) {
+			const RVO3D::Agent3D *rvo_agent = sorted_agents[i]->get_rvo_agent_3d();
+			positions_x[i] = rvo_agent->position_.x();
+			positions_y[i] = rvo_agent->position_.y();
+			positions_z[i] = rvo_agent->position_.z();
+			avoidance_layers[i] = rvo_agent->avoidance_layers_;
+		} else {
+			const RVO2D::Agent2D *rvo_agent = sorted_agents[i]->get_rvo_agent_2d();
+			positions_x[i] = rvo_agent->position_.x();
+			positions_y[i] = 0.0f;
+			positions_z[i] = rvo_agent->position_.y();
+			avoidance_layers[i] = rvo_agent->avoidance_layers_;
+		}
+	}
+
+	dirty = false;
+}
+
+template <typename F>
+void NavAvoidanceGrid3D::_query_cells(const Vector3i &p_from, const Vector3i &p_to, F &&p_callback) const {
+	const int64_t window_size = int64_t(p_to.x - p_from.x + 1) * int64_t(p_to.y - p_from.y + 1) * int64_t(p_to.z - p_from.z + 1);
+
+	// Agents with a neighbor distance far above the average would look up more cells than exist.
+	if (window_size > int64_t(cells.size())) {
+		for (const KeyValue<Vector3i, CellRange> &E : cells) {
+			const Vector3i &cell = E.key;
+			if (cell.x >= p_from.x && cell.x <= p_to.x && cell.y >= p_from.y && cell.y <= p_to.y && cell.z >= p_from.z && cell.z <= p_to.z) {
+				p_callback(E.value);
+			}
+		}
+		return;
+	}
+
+	for (int z = p_from.z; z <= p_to.z; z++) {
+		for (int y = p_from.y; y <= p_to.y; y++) {
+			for (int x = p_from.x; x <= p_to.x; x++) {
+				const CellRange *range = cells.getptr(Vector3i(x, y, z));
+				if (range) {
+					p_callback(*range);
+				}
+			}
+		}
+	}
+}
+
+void NavAvoidanceGrid3D::compute_agent_neighbors_2d(NavAgent3D *p_agent) const {
+	RVO2D::Agent2D *rvo_agent = p_agent->get_rvo_agent_2d();
+	rvo_agent->agentNeighbors_.clear();
+
+	if (rvo_agent->maxNeighbors_ == 0) {
+		return;
+	}
+
+	const float neighbor_distance = rvo_agent->neighborDist_;
+	const float x = rvo_agent->position_.x();
+	const float z = rvo_agent->position_.y();
+	const uint32_t avoidance_mask = rvo_agent->avoidance_mask_;
+
+	// Shrinks once the agent has found its max neighbors.
+	float range_sq = neighbor_distance * neighbor_distance;
+
+	const Vector3i from = _get_cell(x - neighbor_distance, 0.0f, z - neighbor_distance);
+	const Vector3i to = _get_cell(x + neighbor_distance, 0.0f, z + neighbor_distance);
+
+	_query_cells(from, to, [&](const CellRange &p_range) {
+		for (uint32_t i = p_range.start; i < p_range.end; i++) {
+			const float dx = positions_x[i] - x;
+			const float dz = positions_z[i] - z;
+			if (dx * dx + dz * dz < range_sq && (avoidance_mask & avoidance_layers[i]) != 0) {
+				rvo_agent->insertAgentNeighbor(sorted_agents[i]->get_rvo_agent_2d(), range_sq);
+			}
+		}
+	});
+}
+
+void NavAvoidanceGrid3D::compute_agent_neighbors_3d(NavAgent3D *p_agent) const {
+	RVO3D::Agent3D *rvo_agent = p_agent->get_rvo_agent_3d();
+	rvo_agent->agentNeighbors_.clear();
+
+	if (rvo_agent->maxNeighbors_ == 0) {
+		return;
+	}
+
+	const float neighbor_distance = rvo_agent->neighborDist_;
+	const float x = rvo_agent->position_.x();
+	const float y = rvo_agent->position_.y();
+	const float z = rvo_agent->position_.z();
+	const uint32_t avoidance_mask = rvo_agent->avoidance_mask_;
+
+	// Shrinks once the agent has found its max neighbors.
+	float range_sq = neighbor_distance * neighbor_distance;
+
+	const Vector3i from = _get_cell(x - neighbor_distance, y - neighbor_distance, z - neighbor_distance);
+	const Vector3i to = _get_cell(x + neighbor_distance, y + neighbor_distance, z + neighbor_distance);
+
+	_query_cells(from, to, [&](const CellRange &p_range) {
+		for (uint32_t i = p_range.start; i < p_range.end; i++) {
+			const float dx = positions_x[i] - x;
+			const float dy = positions_y[i] - y;
+			const float dz = positions_z[i] - z;
+			if (dx * dx + dy * dy + dz * dz < range_sq && (avoidance_mask & avoidance_layers[i]) != 0) {
+				rvo_agent->insertAgentNeighbor(sorted_agents[i]->get_rvo_agent_3d(), range_sq);
+			}
+		}
+	});
+}
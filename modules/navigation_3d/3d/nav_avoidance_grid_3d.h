@@ -0,0 +1,82 @@
+/**************************************************************************/
+/*  nav_avoidance_grid_3d.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/vector3i.h"
+#include "core/templates/a_hash_map.h"
+#include "core/templates/local_vector.h"
+
+class NavAgent3D;
+
+// Uniform spatial hash used to find the avoidance agent neighbors.
+// Agents are sorted by cell so the positions of each cell are stored contiguously,
+// and the sort is only redone when an agent moves to another cell.
+class NavAvoidanceGrid3D {
+	struct CellRange {
+		uint32_t start = 0;
+		uint32_t end = 0;
+	};
+
+	bool dirty = true;
+
+	float cell_size = 1.0f;
+	float inv_cell_size = 1.0f;
+
+	// Indexed like the agent list given to update().
+	LocalVector<Vector3i> agent_cells;
+
+	// Indexed in cell order.
+	LocalVector<NavAgent3D *> sorted_agents;
+	LocalVector<float> positions_x;
+	LocalVector<float> positions_y;
+	LocalVector<float> positions_z;
+	LocalVector<uint32_t> avoidance_layers;
+
+	AHashMap<Vector3i, CellRange> cells;
+
+	Vector3i _get_cell(float p_x, float p_y, float p_z) const;
+	void _sort_agents(const LocalVector<NavAgent3D *> &p_agents);
+
+	template <typename F>
+	void _query_cells(const Vector3i &p_from, const Vector3i &p_to, F &&p_callback) const;
+
+public:
+	// Forces a full rebuild on the next update, e.g. after agents were added, removed or changed their neighbor distance.
+	void set_dirty() { dirty = true; }
+
+	void update(const LocalVector<NavAgent3D *> &p_agents, bool p_use_3d_avoidance);
+
+	void compute_agent_neighbors_2d(NavAgent3D *p_agent) const;
+	void compute_agent_neighbors_3d(NavAgent3D *p_agent) const;
+
+	uint32_t get_cell_count() const { return cells.size(); }
+	float get_cell_size() const { return cell_size; }
+};
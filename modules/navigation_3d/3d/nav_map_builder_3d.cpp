@@ -37,6 +37,7 @@
 #include "nav_region_iteration_3d.h"
 
 #include "core/config/project_settings.h"
+#include "servers/nav_heap.h"
 
 using namespace Nav3D;
 
@@ -72,6 +73,8 @@ void NavMapBuilder3D::build_navmap_iteration(NavMapIterationBuild3D &r_build) {
 
 	_build_step_navlink_connections(r_build);
 
+	_build_step_cluster_graph(r_build);
+
 	_build_update_map_iteration(r_build);
 }
 
@@ -394,6 +397,282 @@ void NavMapBuilder3D::_build_step_navlink_connections(NavMapIterationBuild3D &r_
 	r_build.polygon_count = polygon_count;
 }
 
+void NavMapBuilder3D::_build_step_cluster_graph(NavMapIterationBuild3D &r_build) {
+	NavMapIteration3D *map_iteration = r_build.map_iteration;
+	NavClusterGraph3D &cluster_graph = map_iteration->cluster_graph;
+
+	cluster_graph.clear();
+
+	if (!r_build.use_hierarchical_pathfinding) {
+		r_build.cluster_cost_cache.clear();
+		return;
+	}
+
+	const uint32_t polygon_count = r_build.polygon_count;
+	const Vector3 cluster_cell_size = Vector3(1.0, 1.0, 1.0) * MAX(r_build.hierarchical_cluster_size, (real_t)CMP_EPSILON);
+
+	// Map polygon ids follow the same order as the path query slots, region polygons first and link polygons last.
+	AHashMap<const NavBaseIteration3D *, uint32_t> navbase_polygon_offsets;
+	LocalVector<Vector3> polygon_centers;
+	polygon_centers.resize(polygon_count);
+	cluster_graph.polygon_clusters.resize(polygon_count);
+
+	// Cell key of every cluster, used to match the clusters of a region with the cost cache.
+	LocalVector<uint64_t> cluster_cell_keys;
+	LocalVector<LocalVector<uint32_t>> cluster_polygons;
+
+	uint32_t polygon_offset = 0;
+	for (const Ref<NavRegionIteration3D> &region : map_iteration->region_iterations) {
+		navbase_polygon_offsets[region.ptr()] = polygon_offset;
+
+		AHashMap<uint64_t, uint32_t> cell_clusters;
+		for (const Polygon &polygon : region->navmesh_polygons) {
+			Vector3 center;
+			for (const Vector3 &vertex : polygon.vertices) {
+				center += vertex;
+			}
+			if (!polygon.vertices.is_empty()) {
+				center /= polygon.vertices.size();
+			}
+
+			const uint64_t cell_key = get_point_key(center, cluster_cell_size).key;
+			uint32_t *cluster_id = cell_clusters.getptr(cell_key);
+			if (!cluster_id) {
+				NavClusterGraph3D::Cluster new_cluster;
+				new_cluster.owner = region.ptr();
+				cluster_id = &cell_clusters.insert(cell_key, cluster_graph.clusters.size())->value;
+				cluster_graph.clusters.push_back(new_cluster);
+				cluster_cell_keys.push_back(cell_key);
+				cluster_polygons.push_back(LocalVector<uint32_t>());
+			}
+
+			polygon_centers[polygon_offset + polygon.id] = center;
+			cluster_graph.polygon_clusters[polygon_offset + polygon.id] = *cluster_id;
+			cluster_polygons[*cluster_id].push_back(polygon.id);
+		}
+
+		polygon_offset += region->navmesh_polygons.size();
+	}
+
+	// Every link is a cluster of its own.
+	for (const Polygon &polygon : map_iteration->navlink_polygons) {
+		navbase_polygon_offsets[polygon.owner] = polygon_offset;
+
+		NavClusterGraph3D::Cluster new_cluster;
+		new_cluster.owner = polygon.owner;
+		cluster_graph.polygon_clusters[polygon_offset] = cluster_graph.clusters.size();
+		cluster_graph.clusters.push_back(new_cluster);
+		cluster_cell_keys.push_back(0);
+		cluster_polygons.push_back(LocalVector<uint32_t>());
+
+		polygon_offset++;
+	}
+
+	ERR_FAIL_COND(polygon_offset != polygon_count);
+
+	// Create a portal for every pair of clusters with a connection from the first to the second.
+	AHashMap<uint64_t, uint32_t> cluster_pair_portals;
+	LocalVector<LocalVector<uint32_t>> portal_exit_polygons;
+	LocalVector<LocalVector<uint32_t>> portal_entry_polygons;
+	LocalVector<uint32_t> portal_connection_counts;
+
+	auto add_portal_connection = [&](uint32_t p_from_cluster_id, uint32_t p_from_polygon_id, const Connection &p_connection) {
+		const uint32_t *to_polygon_offset = navbase_polygon_offsets.getptr(p_connection.polygon->owner);
+		ERR_FAIL_NULL(to_polygon_offset);
+		const uint32_t to_cluster_id = cluster_graph.polygon_clusters[*to_polygon_offset + p_connection.polygon->id];
+		if (to_cluster_id == p_from_cluster_id) {
+			return;
+		}
+
+		const uint64_t cluster_pair_key = ((uint64_t)p_from_cluster_id << 32) | to_cluster_id;
+		uint32_t *portal_id = cluster_pair_portals.getptr(cluster_pair_key);
+		if (!portal_id) {
+			NavClusterGraph3D::Portal new_portal;
+			new_portal.from_cluster = p_from_cluster_id;
+			new_portal.to_cluster = to_cluster_id;
+			new_portal.entry_index = cluster_graph.clusters[to_cluster_id].entry_portals.size();
+
+			portal_id = &cluster_pair_portals.insert(cluster_pair_key, cluster_graph.portals.size())->value;
+			cluster_graph.clusters[p_from_cluster_id].exit_portals.push_back(*portal_id);
+			cluster_graph.clusters[to_cluster_id].entry_portals.push_back(*portal_id);
+			cluster_graph.portals.push_back(new_portal);
+			portal_exit_polygons.push_back(LocalVector<uint32_t>());
+			portal_entry_polygons.push_back(LocalVector<uint32_t>());
+			portal_connection_counts.push_back(0);
+		}
+
+		cluster_graph.portals[*portal_id].position += (p_connection.pathway_start + p_connection.pathway_end) * 0.5;
+		portal_connection_counts[*portal_id] += 1;
+		portal_exit_polygons[*portal_id].push_back(p_from_polygon_id);
+		portal_entry_polygons[*portal_id].push_back(p_connection.polygon->id);
+	};
+
+	const HashMap<const NavBaseIteration3D *, LocalVector<LocalVector<Connection>>> &navbases_polygons_external_connections = map_iteration->navbases_polygons_external_connections;
+
+	for (const Ref<NavRegionIteration3D> &region : map_iteration->region_iterations) {
+		const uint32_t region_polygon_offset = navbase_polygon_offsets[region.ptr()];
+		const LocalVector<LocalVector<Connection>> &internal_connections = region->get_internal_connections();
+		const LocalVector<LocalVector<Connection>> *external_connections = navbases_polygons_external_connections.getptr(region.ptr());
+
+		for (const Polygon &polygon : region->navmesh_polygons) {
+			const uint32_t from_cluster_id = cluster_graph.polygon_clusters[region_polygon_offset + polygon.id];
+
+			if (polygon.id < internal_connections.size()) {
+				for (const Connection &connection : internal_connections[polygon.id]) {
+					add_portal_connection(from_cluster_id, polygon.id, connection);
+				}
+			}
+			if (external_connections && polygon.id < external_connections->size()) {
+				for (const Connection &connection : (*external_connections)[polygon.id]) {
+					add_portal_connection(from_cluster_id, polygon.id, connection);
+				}
+			}
+		}
+	}
+
+	// Links only have the exit connections to the polygons at their ends.
+	for (const Polygon &polygon : map_iteration->navlink_polygons) {
+		const LocalVector<LocalVector<Connection>> *external_connections = navbases_polygons_external_connections.getptr(polygon.owner);
+		if (!external_connections || external_connections->is_empty()) {
+			continue;
+		}
+
+		const uint32_t from_cluster_id = cluster_graph.polygon_clusters[navbase_polygon_offsets[polygon.owner]];
+		for (const Connection &connection : (*external_connections)[polygon.id]) {
+			add_portal_connection(from_cluster_id, polygon.id, connection);
+		}
+	}
+
+	for (uint32_t portal_id = 0; portal_id < cluster_graph.portals.size(); portal_id++) {
+		cluster_graph.portals[portal_id].position /= portal_connection_counts[portal_id];
+	}
+
+	// Compute the entry to exit portal costs of every cluster, reusing the costs of unchanged clusters from the last build.
+	HashMap<const NavBaseIteration3D *, NavMapIterationBuild3D::ClusterCostCache> cluster_cost_cache;
+
+	LocalVector<real_t> polygon_traveled_distances;
+	polygon_traveled_distances.resize(polygon_count);
+	for (real_t &traveled_distance : polygon_traveled_distances) {
+		traveled_distance = FLT_MAX;
+	}
+	LocalVector<uint32_t> touched_polygon_ids;
+	Heap<GraphSearchNode, GraphSearchNodeGreaterThan> traversable_polygons;
+
+	for (uint32_t cluster_id = 0; cluster_id < cluster_graph.clusters.size(); cluster_id++) {
+		NavClusterGraph3D::Cluster &cluster = cluster_graph.clusters[cluster_id];
+		const uint32_t entry_portal_count = cluster.entry_portals.size();
+		const uint32_t exit_portal_count = cluster.exit_portals.size();
+
+		cluster.portal_costs.resize(entry_portal_count * exit_portal_count);
+		if (cluster.portal_costs.is_empty()) {
+			continue;
+		}
+
+		if (cluster.owner->get_type() == NavigationEnums3D::PathSegmentType::PATH_SEGMENT_TYPE_LINK) {
+			// Links have no polygons to search, use the straight distance between their portals.
+			for (uint32_t entry_index = 0; entry_index < entry_portal_count; entry_index++) {
+				const Vector3 &entry_position = cluster_graph.portals[cluster.entry_portals[entry_index]].position;
+				for (uint32_t exit_index = 0; exit_index < exit_portal_count; exit_index++) {
+					const Vector3 &exit_position = cluster_graph.portals[cluster.exit_portals[exit_index]].position;
+					cluster.portal_costs[entry_index * exit_portal_count + exit_index] = entry_position.distance_to(exit_position) * cluster.owner->get_travel_cost();
+				}
+			}
+			continue;
+		}
+
+		LocalVector<uint32_t> portal_polygons;
+		for (uint32_t portal_id : cluster.entry_portals) {
+			portal_polygons.reserve(portal_polygons.size() + portal_entry_polygons[portal_id].size() + 1);
+			for (uint32_t polygon_id : portal_entry_polygons[portal_id]) {
+				portal_polygons.push_back(polygon_id);
+			}
+			portal_polygons.push_back(UINT32_MAX);
+		}
+		for (uint32_t portal_id : cluster.exit_portals) {
+			portal_polygons.reserve(portal_polygons.size() + portal_exit_polygons[portal_id].size() + 1);
+			for (uint32_t polygon_id : portal_exit_polygons[portal_id]) {
+				portal_polygons.push_back(polygon_id);
+			}
+			portal_polygons.push_back(UINT32_MAX);
+		}
+
+		NavMapIterationBuild3D::ClusterCostCache *navbase_cost_cache = cluster_cost_cache.getptr(cluster.owner);
+		if (!navbase_cost_cache) {
+			navbase_cost_cache = &cluster_cost_cache.insert(cluster.owner, NavMapIterationBuild3D::ClusterCostCache())->value;
+			navbase_cost_cache->navbase = Ref<NavBaseIteration3D>(const_cast<NavBaseIteration3D *>(cluster.owner));
+		}
+
+		const NavMapIterationBuild3D::ClusterCostCache *previous_navbase_cost_cache = r_build.cluster_cost_cache.getptr(cluster.owner);
+		const NavMapIterationBuild3D::ClusterCostCache::Cluster *previous_cluster_cost_cache = previous_navbase_cost_cache ? previous_navbase_cost_cache->clusters.getptr(cluster_cell_keys[cluster_id]) : nullptr;
+
+		if (previous_cluster_cost_cache && previous_cluster_cost_cache->portal_polygons.size() == portal_polygons.size() && previous_cluster_cost_cache->portal_costs.size() == cluster.portal_costs.size() &&
+				memcmp(previous_cluster_cost_cache->portal_polygons.ptr(), portal_polygons.ptr(), portal_polygons.size() * sizeof(uint32_t)) == 0) {
+			// Same region iteration with the same portals, the costs are still valid.
+			cluster.portal_costs = previous_cluster_cost_cache->portal_costs;
+		} else {
+			const uint32_t polygon_offset = navbase_polygon_offsets[cluster.owner];
+			const LocalVector<LocalVector<Connection>> &internal_connections = cluster.owner->get_internal_connections();
+			const real_t travel_cost = cluster.owner->get_travel_cost();
+
+			// Dijkstra from every entry portal over the polygons of the cluster, stepping between polygon centers.
+			for (uint32_t entry_index = 0; entry_index < entry_portal_count; entry_index++) {
+				for (uint32_t polygon_id : portal_entry_polygons[cluster.entry_portals[entry_index]]) {
+					if (polygon_traveled_distances[polygon_offset + polygon_id] == FLT_MAX) {
+						touched_polygon_ids.push_back(polygon_offset + polygon_id);
+					}
+					polygon_traveled_distances[polygon_offset + polygon_id] = 0.0;
+					traversable_polygons.push({ polygon_id, 0.0, 0.0 });
+				}
+
+				while (!traversable_polygons.is_empty()) {
+					const GraphSearchNode least_cost_polygon = traversable_polygons.pop();
+					const uint32_t polygon_id = least_cost_polygon.id;
+					if (least_cost_polygon.traveled_distance > polygon_traveled_distances[polygon_offset + polygon_id] || polygon_id >= internal_connections.size()) {
+						continue;
+					}
+
+					const Vector3 &polygon_center = polygon_centers[polygon_offset + polygon_id];
+					for (const Connection &connection : internal_connections[polygon_id]) {
+						const uint32_t neighbor_id = polygon_offset + connection.polygon->id;
+						if (cluster_graph.polygon_clusters[neighbor_id] != cluster_id) {
+							continue;
+						}
+
+						const real_t traveled_distance = least_cost_polygon.traveled_distance + polygon_center.distance_to(polygon_centers[neighbor_id]) * travel_cost;
+						if (traveled_distance < polygon_traveled_distances[neighbor_id]) {
+							if (polygon_traveled_distances[neighbor_id] == FLT_MAX) {
+								touched_polygon_ids.push_back(neighbor_id);
+							}
+							polygon_traveled_distances[neighbor_id] = traveled_distance;
+							traversable_polygons.push({ connection.polygon->id, traveled_distance, traveled_distance });
+						}
+					}
+				}
+
+				for (uint32_t exit_index = 0; exit_index < exit_portal_count; exit_index++) {
+					real_t portal_cost = FLT_MAX;
+					for (uint32_t polygon_id : portal_exit_polygons[cluster.exit_portals[exit_index]]) {
+						portal_cost = MIN(portal_cost, polygon_traveled_distances[polygon_offset + polygon_id]);
+					}
+					cluster.portal_costs[entry_index * exit_portal_count + exit_index] = portal_cost;
+				}
+
+				for (uint32_t touched_polygon_id : touched_polygon_ids) {
+					polygon_traveled_distances[touched_polygon_id] = FLT_MAX;
+				}
+				touched_polygon_ids.clear();
+			}
+		}
+
+		NavMapIterationBuild3D::ClusterCostCache::Cluster &cluster_cost_cache_entry = navbase_cost_cache->clusters[cluster_cell_keys[cluster_id]];
+		cluster_cost_cache_entry.portal_polygons = portal_polygons;
+		cluster_cost_cache_entry.portal_costs = cluster.portal_costs;
+	}
+
+	// Clusters of removed or changed regions are dropped with the previous cache.
+	r_build.cluster_cost_cache = cluster_cost_cache;
+}
+
 void NavMapBuilder3D::_build_update_map_iteration(NavMapIterationBuild3D &r_build) {
 	NavMapIteration3D *map_iteration = r_build.map_iteration;
 
@@ -409,6 +688,10 @@ void NavMapBuilder3D::_build_update_map_iteration(NavMapIterationBuild3D &r_buil
 		p_path_query_slot.path_corridor.clear();
 
 		p_path_query_slot.path_corridor.resize(total_polygon_count);
+		for (NavigationPoly &navigation_poly : p_path_query_slot.path_corridor) {
+			navigation_poly.reset();
+		}
+		p_path_query_slot.touched_poly_ids.clear();
 
 		p_path_query_slot.poly_to_id.clear();
 		p_path_query_slot.poly_to_id.reserve(total_polygon_count);
@@ -427,6 +710,20 @@ void NavMapBuilder3D::_build_update_map_iteration(NavMapIterationBuild3D &r_buil
 		}
 
 		DEV_ASSERT(p_path_query_slot.path_corridor.size() == p_path_query_slot.poly_to_id.size());
+
+		const NavClusterGraph3D &cluster_graph = map_iteration->cluster_graph;
+		p_path_query_slot.portal_traveled_distances.resize(cluster_graph.portals.size());
+		for (real_t &portal_traveled_distance : p_path_query_slot.portal_traveled_distances) {
+			portal_traveled_distance = FLT_MAX;
+		}
+		p_path_query_slot.portal_back_ids.resize(cluster_graph.portals.size());
+		p_path_query_slot.touched_portal_ids.clear();
+		p_path_query_slot.traversable_portals.clear();
+		p_path_query_slot.corridor_clusters.resize(cluster_graph.clusters.size());
+		for (uint8_t &corridor_cluster : p_path_query_slot.corridor_clusters) {
+			corridor_cluster = 0;
+		}
+		p_path_query_slot.corridor_cluster_ids.clear();
 	}
 
 	map_iteration->path_query_slots_mutex.unlock();
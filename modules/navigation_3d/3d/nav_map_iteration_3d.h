@@ -32,6 +32,7 @@
 
 #include "../nav_rid_3d.h"
 #include "../nav_utils_3d.h"
+#include "nav_base_iteration_3d.h"
 #include "nav_mesh_queries_3d.h"
 
 #include "core/math/math_defs.h"
@@ -42,11 +43,46 @@ class NavRegion3D;
 class NavRegionIteration3D;
 struct NavMapIteration3D;
 
+// Abstract graph used by hierarchical pathfinding.
+// Polygons are grouped into clusters by owner and by a grid cell of the cluster size.
+// Every directed crossing from one cluster to another is a portal, and every cluster
+// stores the travel cost from each of its entry portals to each of its exit portals.
+struct NavClusterGraph3D {
+	struct Portal {
+		uint32_t from_cluster = 0;
+		uint32_t to_cluster = 0;
+		// Index of this portal in the `entry_portals` of `to_cluster`.
+		uint32_t entry_index = 0;
+		Vector3 position;
+	};
+
+	struct Cluster {
+		const NavBaseIteration3D *owner = nullptr;
+		LocalVector<uint32_t> entry_portals;
+		LocalVector<uint32_t> exit_portals;
+		// One row per entry portal and one column per exit portal, FLT_MAX when not connected inside the cluster.
+		LocalVector<real_t> portal_costs;
+	};
+
+	LocalVector<Cluster> clusters;
+	LocalVector<Portal> portals;
+	// Cluster of every map polygon, indexed like `NavMeshQueries3D::PathQuerySlot::path_corridor`.
+	LocalVector<uint32_t> polygon_clusters;
+
+	void clear() {
+		clusters.clear();
+		portals.clear();
+		polygon_clusters.clear();
+	}
+};
+
 struct NavMapIterationBuild3D {
 	Vector3 merge_rasterizer_cell_size;
 	bool use_edge_connections = true;
 	real_t edge_connection_margin;
 	real_t link_connection_radius;
+	bool use_hierarchical_pathfinding = false;
+	real_t hierarchical_cluster_size = 0.0;
 	Nav3D::PerformanceData performance_data;
 	int polygon_count = 0;
 	int free_edge_count = 0;
@@ -58,6 +94,19 @@ struct NavMapIterationBuild3D {
 
 	int navmesh_polygon_count = 0;
 
+	// Portal costs of the clusters of the last build, kept across builds so only the clusters
+	// of changed regions, or with changed portals, need their costs computed again.
+	struct ClusterCostCache {
+		Ref<NavBaseIteration3D> navbase;
+		struct Cluster {
+			// Local polygon ids of every entry portal then every exit portal, each list terminated by UINT32_MAX.
+			LocalVector<uint32_t> portal_polygons;
+			LocalVector<real_t> portal_costs;
+		};
+		HashMap<uint64_t, Cluster> clusters;
+	};
+	HashMap<const NavBaseIteration3D *, ClusterCostCache> cluster_cost_cache;
+
 	void reset() {
 		performance_data.reset();
 
@@ -89,6 +138,9 @@ struct NavMapIteration3D {
 
 	HashMap<NavRegion3D *, Ref<NavRegionIteration3D>> region_ptr_to_region_iteration;
 
+	// Empty unless the map uses hierarchical pathfinding.
+	NavClusterGraph3D cluster_graph;
+
 	LocalVector<NavMeshQueries3D::PathQuerySlot> path_query_slots;
 	Mutex path_query_slots_mutex;
 	Semaphore path_query_slots_semaphore;
@@ -103,6 +155,7 @@ struct NavMapIteration3D {
 		navbases_polygons_external_connections.clear();
 		navlink_polygons.clear();
 		region_ptr_to_region_iteration.clear();
+		cluster_graph.clear();
 	}
 };
 
@@ -32,6 +32,7 @@
 
 #include "../nav_base_3d.h"
 #include "../nav_map_3d.h"
+#include "nav_map_iteration_3d.h"
 #include "nav_region_iteration_3d.h"
 
 #include "core/math/geometry_3d.h"
@@ -145,18 +146,12 @@ void NavMeshQueries3D::_query_task_push_back_point_with_metadata(NavMeshPathQuer
 	p_query_task.path_points.push_back(p_point);
 }
 
-void NavMeshQueries3D::map_query_path(NavMap3D *map, const Ref<NavigationPathQueryParameters3D> &p_query_parameters, Ref<NavigationPathQueryResult3D> p_query_result, const Callable &p_callback) {
-	ERR_FAIL_NULL(map);
-	ERR_FAIL_COND(p_query_parameters.is_null());
-	ERR_FAIL_COND(p_query_result.is_null());
-
+void NavMeshQueries3D::query_task_setup(NavMeshPathQueryTask3D &r_query_task, const Ref<NavigationPathQueryParameters3D> &p_query_parameters) {
 	using namespace NavigationDefaults3D;
 
-	NavMeshQueries3D::NavMeshPathQueryTask3D query_task;
-	query_task.start_position = p_query_parameters->get_start_position();
-	query_task.target_position = p_query_parameters->get_target_position();
-	query_task.navigation_layers = p_query_parameters->get_navigation_layers();
-	query_task.callback = p_callback;
+	r_query_task.start_position = p_query_parameters->get_start_position();
+	r_query_task.target_position = p_query_parameters->get_target_position();
+	r_query_task.navigation_layers = p_query_parameters->get_navigation_layers();
 
 	const TypedArray<RID> &_excluded_regions = p_query_parameters->get_excluded_regions();
 	const TypedArray<RID> &_included_regions = p_query_parameters->get_included_regions();
@@ -164,66 +159,80 @@ void NavMeshQueries3D::map_query_path(NavMap3D *map, const Ref<NavigationPathQue
 	uint32_t _excluded_region_count = _excluded_regions.size();
 	uint32_t _included_region_count = _included_regions.size();
 
-	query_task.exclude_regions = _excluded_region_count > 0;
-	query_task.include_regions = _included_region_count > 0;
+	r_query_task.exclude_regions = _excluded_region_count > 0;
+	r_query_task.include_regions = _included_region_count > 0;
 
-	if (query_task.exclude_regions) {
-		query_task.excluded_regions.resize(_excluded_region_count);
+	if (r_query_task.exclude_regions) {
+		r_query_task.excluded_regions.resize(_excluded_region_count);
 		for (uint32_t i = 0; i < _excluded_region_count; i++) {
-			query_task.excluded_regions[i] = _excluded_regions[i];
+			r_query_task.excluded_regions[i] = _excluded_regions[i];
 		}
 	}
 
-	if (query_task.include_regions) {
-		query_task.included_regions.resize(_included_region_count);
+	if (r_query_task.include_regions) {
+		r_query_task.included_regions.resize(_included_region_count);
 		for (uint32_t i = 0; i < _included_region_count; i++) {
-			query_task.included_regions[i] = _included_regions[i];
+			r_query_task.included_regions[i] = _included_regions[i];
 		}
 	}
 
 	switch (p_query_parameters->get_pathfinding_algorithm()) {
 		case NavigationPathQueryParameters3D::PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR: {
-			query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
+			r_query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
 		} break;
 		default: {
 			WARN_PRINT("No match for used PathfindingAlgorithm - fallback to default");
-			query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
+			r_query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
 		} break;
 	}
 
 	switch (p_query_parameters->get_path_postprocessing()) {
 		case NavigationPathQueryParameters3D::PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL: {
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
+			r_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
 		} break;
 		case NavigationPathQueryParameters3D::PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED: {
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED;
+			r_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED;
 		} break;
 		case NavigationPathQueryParameters3D::PathPostProcessing::PATH_POSTPROCESSING_NONE: {
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_NONE;
+			r_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_NONE;
 		} break;
 		default: {
 			WARN_PRINT("No match for used PathPostProcessing - fallback to default");
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
+			r_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
 		} break;
 	}
 
-	query_task.metadata_flags = (int64_t)p_query_parameters->get_metadata_flags();
-	query_task.simplify_path = p_query_parameters->get_simplify_path();
-	query_task.simplify_epsilon = p_query_parameters->get_simplify_epsilon();
-	query_task.path_return_max_length = p_query_parameters->get_path_return_max_length();
-	query_task.path_return_max_radius = p_query_parameters->get_path_return_max_radius();
-	query_task.path_search_max_polygons = p_query_parameters->get_path_search_max_polygons();
-	query_task.path_search_max_distance = p_query_parameters->get_path_search_max_distance();
-	query_task.status = NavMeshPathQueryTask3D::TaskStatus::QUERY_STARTED;
+	r_query_task.metadata_flags = (int64_t)p_query_parameters->get_metadata_flags();
+	r_query_task.simplify_path = p_query_parameters->get_simplify_path();
+	r_query_task.simplify_epsilon = p_query_parameters->get_simplify_epsilon();
+	r_query_task.path_return_max_length = p_query_parameters->get_path_return_max_length();
+	r_query_task.path_return_max_radius = p_query_parameters->get_path_return_max_radius();
+	r_query_task.path_search_max_polygons = p_query_parameters->get_path_search_max_polygons();
+	r_query_task.path_search_max_distance = p_query_parameters->get_path_search_max_distance();
+	r_query_task.status = NavMeshPathQueryTask3D::TaskStatus::QUERY_STARTED;
+}
+
+void NavMeshQueries3D::query_task_write_result(const NavMeshPathQueryTask3D &p_query_task, const Ref<NavigationPathQueryResult3D> &p_query_result) {
+	p_query_result->set_data(
+			p_query_task.path_points,
+			p_query_task.path_meta_point_types,
+			p_query_task.path_meta_point_rids,
+			p_query_task.path_meta_point_owners);
+	p_query_result->set_path_length(p_query_task.path_length);
+}
+
+void NavMeshQueries3D::map_query_path(NavMap3D *map, const Ref<NavigationPathQueryParameters3D> &p_query_parameters, Ref<NavigationPathQueryResult3D> p_query_result, const Callable &p_callback) {
+	ERR_FAIL_NULL(map);
+	ERR_FAIL_COND(p_query_parameters.is_null());
+	ERR_FAIL_COND(p_query_result.is_null());
+
+	NavMeshQueries3D::NavMeshPathQueryTask3D query_task;
+	query_task_setup(query_task, p_query_parameters);
+	query_task.callback = p_callback;
 
 	map->query_path(query_task);
 
-	p_query_result->set_data(
-			query_task.path_points,
-			query_task.path_meta_point_types,
-			query_task.path_meta_point_rids,
-			query_task.path_meta_point_owners);
-	p_query_result->set_path_length(query_task.path_length);
+	query_task_write_result(query_task, p_query_result);
 
 	if (query_task.callback.is_valid()) {
 		if (emit_callback(query_task.callback)) {
@@ -234,6 +243,23 @@ void NavMeshQueries3D::map_query_path(NavMap3D *map, const Ref<NavigationPathQue
 	}
 }
 
+void NavMeshQueries3D::map_query_paths(NavMap3D *map, const LocalVector<Ref<NavigationPathQueryParameters3D>> &p_query_parameters, const LocalVector<Ref<NavigationPathQueryResult3D>> &p_query_results) {
+	ERR_FAIL_NULL(map);
+	ERR_FAIL_COND(p_query_parameters.size() != p_query_results.size());
+
+	LocalVector<NavMeshPathQueryTask3D> query_tasks;
+	query_tasks.resize(p_query_parameters.size());
+	for (uint32_t i = 0; i < query_tasks.size(); i++) {
+		query_task_setup(query_tasks[i], p_query_parameters[i]);
+	}
+
+	map->query_paths(query_tasks);
+
+	for (uint32_t i = 0; i < query_tasks.size(); i++) {
+		query_task_write_result(query_tasks[i], p_query_results[i]);
+	}
+}
+
 void NavMeshQueries3D::_query_task_find_start_end_positions(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration) {
 	real_t begin_d = FLT_MAX;
 	real_t end_d = FLT_MAX;
@@ -294,8 +320,16 @@ void NavMeshQueries3D::_query_task_search_polygon_connections(NavMeshPathQueryTa
 	real_t new_traveled_distance = p_least_cost_poly.entry.distance_to(new_entry) * poly_travel_cost + p_poly_enter_cost + p_least_cost_poly.traveled_distance;
 
 	// Check if the neighbor polygon has already been processed.
-	NavigationPoly &neighbor_poly = navigation_polys[p_query_task.path_query_slot->poly_to_id[p_connection.polygon]];
+	const uint32_t neighbor_poly_id = p_query_task.path_query_slot->poly_to_id[p_connection.polygon];
+	if (p_query_task.cluster_graph && !p_query_task.path_query_slot->corridor_clusters[p_query_task.cluster_graph->polygon_clusters[neighbor_poly_id]]) {
+		// Outside of the cluster corridor found by the hierarchical search.
+		return;
+	}
+	NavigationPoly &neighbor_poly = navigation_polys[neighbor_poly_id];
 	if (new_traveled_distance < neighbor_poly.traveled_distance) {
+		if (neighbor_poly.traveled_distance == FLT_MAX) {
+			p_query_task.path_query_slot->touched_poly_ids.push_back(neighbor_poly_id);
+		}
 		// Add the polygon to the heap of polygons to traverse next.
 		neighbor_poly.back_navigation_poly_id = p_least_cost_id;
 		neighbor_poly.back_navigation_edge = p_connection.edge;
@@ -316,6 +350,144 @@ void NavMeshQueries3D::_query_task_search_polygon_connections(NavMeshPathQueryTa
 	}
 }
 
+bool NavMeshQueries3D::_query_task_build_cluster_corridor(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration) {
+	PathQuerySlot *path_query_slot = p_query_task.path_query_slot;
+
+	for (uint32_t cluster_id : path_query_slot->corridor_cluster_ids) {
+		path_query_slot->corridor_clusters[cluster_id] = 0;
+	}
+	path_query_slot->corridor_cluster_ids.clear();
+	p_query_task.cluster_graph = nullptr;
+
+	const NavClusterGraph3D &cluster_graph = p_map_iteration.cluster_graph;
+	if (cluster_graph.clusters.is_empty()) {
+		return false;
+	}
+
+	const uint32_t begin_cluster_id = cluster_graph.polygon_clusters[path_query_slot->poly_to_id[p_query_task.begin_polygon]];
+	const uint32_t end_cluster_id = cluster_graph.polygon_clusters[path_query_slot->poly_to_id[p_query_task.end_polygon]];
+	if (begin_cluster_id == end_cluster_id) {
+		return false;
+	}
+
+	LocalVector<real_t> &portal_traveled_distances = path_query_slot->portal_traveled_distances;
+	LocalVector<uint32_t> &portal_back_ids = path_query_slot->portal_back_ids;
+	LocalVector<uint32_t> &touched_portal_ids = path_query_slot->touched_portal_ids;
+	Heap<GraphSearchNode, GraphSearchNodeGreaterThan> &traversable_portals = path_query_slot->traversable_portals;
+
+	for (uint32_t touched_portal_id : touched_portal_ids) {
+		portal_traveled_distances[touched_portal_id] = FLT_MAX;
+	}
+	touched_portal_ids.clear();
+	traversable_portals.clear();
+
+	const Vector3 &begin_position = p_query_task.begin_position;
+	const Vector3 &end_position = p_query_task.end_position;
+
+	// Start from every usable exit portal of the begin cluster.
+	const NavClusterGraph3D::Cluster &begin_cluster = cluster_graph.clusters[begin_cluster_id];
+	for (uint32_t portal_id : begin_cluster.exit_portals) {
+		const NavClusterGraph3D::Portal &portal = cluster_graph.portals[portal_id];
+		const NavBaseIteration3D *portal_owner = cluster_graph.clusters[portal.to_cluster].owner;
+		if (!_query_task_is_connection_owner_usable(p_query_task, portal_owner)) {
+			continue;
+		}
+
+		real_t traveled_distance = begin_position.distance_to(portal.position) * begin_cluster.owner->get_travel_cost();
+		if (portal_owner != begin_cluster.owner) {
+			traveled_distance += portal_owner->get_enter_cost();
+		}
+		if (traveled_distance < portal_traveled_distances[portal_id]) {
+			if (portal_traveled_distances[portal_id] == FLT_MAX) {
+				touched_portal_ids.push_back(portal_id);
+			}
+			portal_traveled_distances[portal_id] = traveled_distance;
+			portal_back_ids[portal_id] = UINT32_MAX;
+			traversable_portals.push({ portal_id, traveled_distance, traveled_distance + portal.position.distance_to(end_position) });
+		}
+	}
+
+	// A* over the portals, using the precomputed portal-to-portal costs of every cluster.
+	uint32_t end_portal_id = UINT32_MAX;
+	real_t end_traveled_distance = FLT_MAX;
+
+	while (!traversable_portals.is_empty()) {
+		const GraphSearchNode least_cost_portal = traversable_portals.pop();
+		if (least_cost_portal.traveled_distance > portal_traveled_distances[least_cost_portal.id]) {
+			// Already reached with a lower cost.
+			continue;
+		}
+		if (least_cost_portal.estimated_cost >= end_traveled_distance) {
+			break;
+		}
+
+		p_query_task.searched_node_count += 1;
+
+		const NavClusterGraph3D::Portal &portal = cluster_graph.portals[least_cost_portal.id];
+		const NavClusterGraph3D::Cluster &cluster = cluster_graph.clusters[portal.to_cluster];
+
+		if (portal.to_cluster == end_cluster_id) {
+			const real_t traveled_distance = least_cost_portal.traveled_distance + portal.position.distance_to(end_position) * cluster.owner->get_travel_cost();
+			if (traveled_distance < end_traveled_distance) {
+				end_traveled_distance = traveled_distance;
+				end_portal_id = least_cost_portal.id;
+			}
+			continue;
+		}
+
+		const uint32_t exit_portal_count = cluster.exit_portals.size();
+		const real_t *exit_portal_costs = cluster.portal_costs.ptr() + portal.entry_index * exit_portal_count;
+
+		for (uint32_t exit_index = 0; exit_index < exit_portal_count; exit_index++) {
+			if (exit_portal_costs[exit_index] == FLT_MAX) {
+				continue;
+			}
+
+			const uint32_t exit_portal_id = cluster.exit_portals[exit_index];
+			const NavClusterGraph3D::Portal &exit_portal = cluster_graph.portals[exit_portal_id];
+			const NavBaseIteration3D *exit_portal_owner = cluster_graph.clusters[exit_portal.to_cluster].owner;
+			if (!_query_task_is_connection_owner_usable(p_query_task, exit_portal_owner)) {
+				continue;
+			}
+
+			real_t traveled_distance = least_cost_portal.traveled_distance + exit_portal_costs[exit_index];
+			if (exit_portal_owner != cluster.owner) {
+				traveled_distance += exit_portal_owner->get_enter_cost();
+			}
+			if (traveled_distance < portal_traveled_distances[exit_portal_id]) {
+				if (portal_traveled_distances[exit_portal_id] == FLT_MAX) {
+					touched_portal_ids.push_back(exit_portal_id);
+				}
+				portal_traveled_distances[exit_portal_id] = traveled_distance;
+				portal_back_ids[exit_portal_id] = least_cost_portal.id;
+				traversable_portals.push({ exit_portal_id, traveled_distance, traveled_distance + exit_portal.position.distance_to(end_position) });
+			}
+		}
+	}
+
+	if (end_portal_id == UINT32_MAX) {
+		// Leave it to the polygon search to find the closest reachable polygon.
+		return false;
+	}
+
+	// Restrict the polygon search to the clusters along the portal path.
+	LocalVector<uint8_t> &corridor_clusters = path_query_slot->corridor_clusters;
+	LocalVector<uint32_t> &corridor_cluster_ids = path_query_slot->corridor_cluster_ids;
+
+	corridor_clusters[begin_cluster_id] = 1;
+	corridor_cluster_ids.push_back(begin_cluster_id);
+	for (uint32_t portal_id = end_portal_id; portal_id != UINT32_MAX; portal_id = portal_back_ids[portal_id]) {
+		const uint32_t cluster_id = cluster_graph.portals[portal_id].to_cluster;
+		if (!corridor_clusters[cluster_id]) {
+			corridor_clusters[cluster_id] = 1;
+			corridor_cluster_ids.push_back(cluster_id);
+		}
+	}
+
+	p_query_task.cluster_graph = &cluster_graph;
+	return true;
+}
+
 void NavMeshQueries3D::_query_task_build_path_corridor(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration) {
 	const Vector3 p_target_position = p_query_task.target_position;
 	const Polygon *begin_poly = p_query_task.begin_polygon;
@@ -328,13 +500,17 @@ void NavMeshQueries3D::_query_task_build_path_corridor(NavMeshPathQueryTask3D &p
 			&traversable_polys = p_query_task.path_query_slot->traversable_polys;
 	traversable_polys.clear();
 
+	// Only the polygons touched by the previous search need to be reset, not the whole map.
 	LocalVector<NavigationPoly> &navigation_polys = p_query_task.path_query_slot->path_corridor;
-	for (NavigationPoly &polygon : navigation_polys) {
-		polygon.reset();
+	LocalVector<uint32_t> &touched_poly_ids = p_query_task.path_query_slot->touched_poly_ids;
+	for (uint32_t touched_poly_id : touched_poly_ids) {
+		navigation_polys[touched_poly_id].reset();
 	}
+	touched_poly_ids.clear();
 
 	// Initialize the matching navigation polygon.
-	NavigationPoly &begin_navigation_poly = navigation_polys[p_query_task.path_query_slot->poly_to_id[begin_poly]];
+	touched_poly_ids.push_back(p_query_task.path_query_slot->poly_to_id[begin_poly]);
+	NavigationPoly &begin_navigation_poly = navigation_polys[touched_poly_ids[0]];
 	begin_navigation_poly.poly = begin_poly;
 	begin_navigation_poly.entry = begin_point;
 	begin_navigation_poly.back_navigation_edge_pathway_start = begin_point;
@@ -369,6 +545,7 @@ void NavMeshQueries3D::_query_task_build_path_corridor(NavMeshPathQueryTask3D &p
 		const NavBaseIteration3D *least_cost_navbase = least_cost_poly.poly->owner;
 
 		processed_polygon_count += 1;
+		p_query_task.searched_node_count += 1;
 
 		const uint32_t navbase_local_polygon_id = least_cost_poly.poly->id;
 		const LocalVector<LocalVector<Connection>> &navbase_polygons_to_connections = least_cost_poly.poly->owner->get_internal_connections();
@@ -400,6 +577,29 @@ void NavMeshQueries3D::_query_task_build_path_corridor(NavMeshPathQueryTask3D &p
 		// When the heap of traversable polygons is empty at this point it means the end polygon is
 		// unreachable.
 		if (traversable_polys.is_empty()) {
+			if (p_query_task.cluster_graph && !path_search_max_reached) {
+				// The end polygon is not reachable inside the cluster corridor, search the whole map instead.
+				p_query_task.cluster_graph = nullptr;
+
+				for (uint32_t touched_poly_id : touched_poly_ids) {
+					navigation_polys[touched_poly_id].reset();
+				}
+				touched_poly_ids.clear();
+
+				least_cost_id = p_query_task.path_query_slot->poly_to_id[begin_poly];
+				touched_poly_ids.push_back(least_cost_id);
+				navigation_polys[least_cost_id].poly = begin_poly;
+				navigation_polys[least_cost_id].entry = begin_point;
+				navigation_polys[least_cost_id].back_navigation_edge_pathway_start = begin_point;
+				navigation_polys[least_cost_id].back_navigation_edge_pathway_end = begin_point;
+				navigation_polys[least_cost_id].traveled_distance = 0.f;
+
+				reachable_end = nullptr;
+				distance_to_reachable_end = FLT_MAX;
+				processed_polygon_count = 0;
+				continue;
+			}
+
 			// Thus use the further reachable polygon
 			ERR_BREAK_MSG(is_reachable == false, "It's not expect to not find the most reachable polygons");
 			is_reachable = false;
@@ -446,9 +646,9 @@ void NavMeshQueries3D::_query_task_build_path_corridor(NavMeshPathQueryTask3D &p
 				return;
 			}
 
-			for (NavigationPoly &nav_poly : navigation_polys) {
-				nav_poly.poly = nullptr;
-				nav_poly.traveled_distance = FLT_MAX;
+			for (uint32_t touched_poly_id : touched_poly_ids) {
+				navigation_polys[touched_poly_id].poly = nullptr;
+				navigation_polys[touched_poly_id].traveled_distance = FLT_MAX;
 			}
 			uint32_t _bp_id = p_query_task.path_query_slot->poly_to_id[begin_poly];
 			navigation_polys[_bp_id].poly = begin_poly;
@@ -530,6 +730,8 @@ void NavMeshQueries3D::query_task_map_iteration_get_path(NavMeshPathQueryTask3D
 		return;
 	}
 
+	_query_task_build_cluster_corridor(p_query_task, p_map_iteration);
+
 	_query_task_build_path_corridor(p_query_task, p_map_iteration);
 
 	if (p_query_task.status == NavMeshPathQueryTask3D::TaskStatus::QUERY_FINISHED || p_query_task.status == NavMeshPathQueryTask3D::TaskStatus::QUERY_FAILED) {
@@ -1094,6 +1296,292 @@ Vector3 NavMeshQueries3D::map_iteration_get_random_point(const NavMapIteration3D
 	}
 }
 
+void NavMeshQueries3D::map_iteration_build_flow_field(const NavMapIteration3D &p_map_iteration, const Vector3 &p_target_position, uint32_t p_navigation_layers, FlowField &r_flow_field) {
+	r_flow_field.navigation_layers = p_navigation_layers;
+	r_flow_field.target_poly_id = UINT32_MAX;
+	r_flow_field.flow_field_polys.clear();
+	r_flow_field.poly_grid_cells.clear();
+	r_flow_field.poly_grid_poly_ids.clear();
+
+	// Same poly ids as the path query slots, region polygons first and link polygons last.
+	LocalVector<FlowFieldPoly> &flow_field_polys = r_flow_field.flow_field_polys;
+	flow_field_polys.resize(p_map_iteration.navmesh_polygon_count);
+
+	AHashMap<const NavBaseIteration3D *, uint32_t> navbase_poly_id_offsets;
+	LocalVector<uint32_t> grid_poly_ids;
+	LocalVector<AABB> grid_poly_bounds;
+	real_t grid_poly_size_sum = 0.0;
+	uint32_t poly_id_offset = 0;
+	for (const Ref<NavRegionIteration3D> &region : p_map_iteration.region_iterations) {
+		navbase_poly_id_offsets[region.ptr()] = poly_id_offset;
+		const bool region_usable = region->get_enabled() && (p_navigation_layers & region->get_navigation_layers()) != 0;
+		for (const Polygon &polygon : region->get_navmesh_polygons()) {
+			flow_field_polys[poly_id_offset + polygon.id].poly = &polygon;
+			if (!region_usable || polygon.vertices.size() < 3) {
+				continue;
+			}
+			AABB bounds(polygon.vertices[0], Vector3());
+			for (uint32_t point_id = 1; point_id < polygon.vertices.size(); point_id++) {
+				bounds.expand_to(polygon.vertices[point_id]);
+			}
+			grid_poly_ids.push_back(poly_id_offset + polygon.id);
+			grid_poly_bounds.push_back(bounds);
+			grid_poly_size_sum += bounds.get_longest_axis_size();
+		}
+		poly_id_offset += region->get_navmesh_polygons().size();
+	}
+	for (const Polygon &polygon : p_map_iteration.navlink_polygons) {
+		navbase_poly_id_offsets[polygon.owner] = poly_id_offset;
+		flow_field_polys[poly_id_offset].poly = &polygon;
+		poly_id_offset++;
+	}
+	ERR_FAIL_COND(poly_id_offset != flow_field_polys.size());
+
+	if (grid_poly_ids.is_empty()) {
+		return;
+	}
+
+	// Cells are sized after the average polygon so most polygons only overlap a few cells.
+	r_flow_field.poly_grid_cell_size = MAX(grid_poly_size_sum / grid_poly_ids.size(), (real_t)CMP_EPSILON);
+
+	// Counting sort, first count the polygons of each cell.
+	AHashMap<Vector3i, FlowField::CellRange> &poly_grid_cells = r_flow_field.poly_grid_cells;
+	r_flow_field.poly_grid_min = r_flow_field.get_poly_grid_cell(grid_poly_bounds[0].position);
+	r_flow_field.poly_grid_max = r_flow_field.poly_grid_min;
+	uint32_t grid_entry_count = 0;
+	for (const AABB &bounds : grid_poly_bounds) {
+		const Vector3i cell_min = r_flow_field.get_poly_grid_cell(bounds.position);
+		const Vector3i cell_max = r_flow_field.get_poly_grid_cell(bounds.get_end());
+		r_flow_field.poly_grid_min = r_flow_field.poly_grid_min.min(cell_min);
+		r_flow_field.poly_grid_max = r_flow_field.poly_grid_max.max(cell_max);
+		for (int x = cell_min.x; x <= cell_max.x; x++) {
+			for (int y = cell_min.y; y <= cell_max.y; y++) {
+				for (int z = cell_min.z; z <= cell_max.z; z++) {
+					poly_grid_cells[Vector3i(x, y, z)].end++;
+					grid_entry_count++;
+				}
+			}
+		}
+	}
+
+	uint32_t start = 0;
+	for (KeyValue<Vector3i, FlowField::CellRange> &E : poly_grid_cells) {
+		const uint32_t count = E.value.end;
+		E.value.start = start;
+		E.value.end = start;
+		start += count;
+	}
+
+	r_flow_field.poly_grid_poly_ids.resize(grid_entry_count);
+	for (uint32_t grid_poly_index = 0; grid_poly_index < grid_poly_ids.size(); grid_poly_index++) {
+		const Vector3i cell_min = r_flow_field.get_poly_grid_cell(grid_poly_bounds[grid_poly_index].position);
+		const Vector3i cell_max = r_flow_field.get_poly_grid_cell(grid_poly_bounds[grid_poly_index].get_end());
+		for (int x = cell_min.x; x <= cell_max.x; x++) {
+			for (int y = cell_min.y; y <= cell_max.y; y++) {
+				for (int z = cell_min.z; z <= cell_max.z; z++) {
+					FlowField::CellRange *range = poly_grid_cells.getptr(Vector3i(x, y, z));
+					r_flow_field.poly_grid_poly_ids[range->end++] = grid_poly_ids[grid_poly_index];
+				}
+			}
+		}
+	}
+
+	r_flow_field.target_poly_id = flow_field_get_closest_poly_id(r_flow_field, p_target_position, r_flow_field.target_position);
+	if (r_flow_field.target_poly_id == UINT32_MAX) {
+		return;
+	}
+
+	LocalVector<Vector3> poly_centers;
+	poly_centers.resize(flow_field_polys.size());
+	for (uint32_t poly_id = 0; poly_id < flow_field_polys.size(); poly_id++) {
+		const Polygon *polygon = flow_field_polys[poly_id].poly;
+		Vector3 center;
+		for (const Vector3 &vertex : polygon->vertices) {
+			center += vertex;
+		}
+		if (!polygon->vertices.is_empty()) {
+			center /= polygon->vertices.size();
+		}
+		poly_centers[poly_id] = center;
+	}
+
+	// The integration runs from the target outwards, so every usable connection is needed in reverse.
+	struct ReverseConnection {
+		uint32_t from_poly_id = 0;
+		const Connection *connection = nullptr;
+	};
+	LocalVector<LocalVector<ReverseConnection>> reverse_connections;
+	reverse_connections.resize(flow_field_polys.size());
+
+	const HashMap<const NavBaseIteration3D *, LocalVector<LocalVector<Connection>>> &navbases_polygons_external_connections = p_map_iteration.navbases_polygons_external_connections;
+
+	for (uint32_t poly_id = 0; poly_id < flow_field_polys.size(); poly_id++) {
+		const Polygon *polygon = flow_field_polys[poly_id].poly;
+		const NavBaseIteration3D *owner = polygon->owner;
+		if (!owner->get_enabled() || (p_navigation_layers & owner->get_navigation_layers()) == 0) {
+			continue;
+		}
+
+		const LocalVector<LocalVector<Connection>> &internal_connections = owner->get_internal_connections();
+		const LocalVector<LocalVector<Connection>> *external_connections = navbases_polygons_external_connections.getptr(owner);
+
+		for (uint32_t connection_list = 0; connection_list < 2; connection_list++) {
+			const LocalVector<Connection> *connections = nullptr;
+			if (connection_list == 0 && polygon->id < internal_connections.size()) {
+				connections = &internal_connections[polygon->id];
+			} else if (connection_list == 1 && external_connections && polygon->id < external_connections->size()) {
+				connections = &(*external_connections)[polygon->id];
+			}
+			if (!connections) {
+				continue;
+			}
+
+			for (const Connection &connection : *connections) {
+				const NavBaseIteration3D *connection_owner = connection.polygon->owner;
+				if (!connection_owner->get_enabled() || (p_navigation_layers & connection_owner->get_navigation_layers()) == 0) {
+					continue;
+				}
+				const uint32_t *to_poly_id_offset = navbase_poly_id_offsets.getptr(connection_owner);
+				ERR_CONTINUE(!to_poly_id_offset);
+				reverse_connections[*to_poly_id_offset + connection.polygon->id].push_back({ poly_id, &connection });
+			}
+		}
+	}
+
+	// Dijkstra from the target over the reversed connections.
+	Heap<GraphSearchNode, GraphSearchNodeGreaterThan> traversable_polys;
+
+	FlowFieldPoly &target_flow_field_poly = flow_field_polys[r_flow_field.target_poly_id];
+	target_flow_field_poly.distance_to_target = poly_centers[r_flow_field.target_poly_id].distance_to(r_flow_field.target_position) * target_flow_field_poly.poly->owner->get_travel_cost();
+	traversable_polys.push({ r_flow_field.target_poly_id, target_flow_field_poly.distance_to_target, target_flow_field_poly.distance_to_target });
+
+	while (!traversable_polys.is_empty()) {
+		const GraphSearchNode least_cost_poly = traversable_polys.pop();
+		const FlowFieldPoly &to_flow_field_poly = flow_field_polys[least_cost_poly.id];
+		if (least_cost_poly.traveled_distance > to_flow_field_poly.distance_to_target) {
+			// Already reached with a lower cost.
+			continue;
+		}
+
+		const NavBaseIteration3D *to_owner = to_flow_field_poly.poly->owner;
+		const Vector3 &to_center = poly_centers[least_cost_poly.id];
+
+		for (const ReverseConnection &reverse_connection : reverse_connections[least_cost_poly.id]) {
+			FlowFieldPoly &from_flow_field_poly = flow_field_polys[reverse_connection.from_poly_id];
+			const NavBaseIteration3D *from_owner = from_flow_field_poly.poly->owner;
+			const Connection &connection = *reverse_connection.connection;
+
+			const Vector3 pathway_center = (connection.pathway_start + connection.pathway_end) * 0.5;
+			real_t distance_to_target = least_cost_poly.traveled_distance +
+					poly_centers[reverse_connection.from_poly_id].distance_to(pathway_center) * from_owner->get_travel_cost() +
+					pathway_center.distance_to(to_center) * to_owner->get_travel_cost();
+			if (from_owner != to_owner) {
+				distance_to_target += to_owner->get_enter_cost();
+			}
+
+			if (distance_to_target < from_flow_field_poly.distance_to_target) {
+				from_flow_field_poly.distance_to_target = distance_to_target;
+				from_flow_field_poly.next_poly_id = least_cost_poly.id;
+				from_flow_field_poly.pathway_start = connection.pathway_start;
+				from_flow_field_poly.pathway_end = connection.pathway_end;
+				traversable_polys.push({ reverse_connection.from_poly_id, distance_to_target, distance_to_target });
+			}
+		}
+	}
+}
+
+uint32_t NavMeshQueries3D::flow_field_get_closest_poly_id(const FlowField &p_flow_field, const Vector3 &p_point, Vector3 &r_closest_point) {
+	if (p_flow_field.poly_grid_cells.is_empty()) {
+		return UINT32_MAX;
+	}
+
+	uint32_t closest_poly_id = UINT32_MAX;
+	real_t closest_point_distance_squared = FLT_MAX;
+
+	const Vector3i center_cell = p_flow_field.get_poly_grid_cell(p_point);
+	const Vector3i &grid_min = p_flow_field.poly_grid_min;
+	const Vector3i &grid_max = p_flow_field.poly_grid_max;
+
+	// Search the cells in growing rings around the point. No cell of the next ring can be closer
+	// than the current ring radius, so the search stops once the closest point is within it.
+	const Vector3i gap = (grid_min - center_cell).max(center_cell - grid_max).max(Vector3i());
+	const int first_ring = MAX(gap.x, MAX(gap.y, gap.z));
+	const Vector3i grid_extent = (grid_max - center_cell).max(center_cell - grid_min);
+	const int last_ring = MAX(grid_extent.x, MAX(grid_extent.y, grid_extent.z));
+
+	for (int ring = first_ring; ring <= last_ring; ring++) {
+		const Vector3i ring_min = (center_cell - Vector3i(ring, ring, ring)).max(grid_min);
+		const Vector3i ring_max = (center_cell + Vector3i(ring, ring, ring)).min(grid_max);
+		for (int x = ring_min.x; x <= ring_max.x; x++) {
+			for (int y = ring_min.y; y <= ring_max.y; y++) {
+				for (int z = ring_min.z; z <= ring_max.z; z++) {
+					if (MAX(Math::abs(x - center_cell.x), MAX(Math::abs(y - center_cell.y), Math::abs(z - center_cell.z))) != ring) {
+						// Searched by a smaller ring.
+						continue;
+					}
+					const FlowField::CellRange *range = p_flow_field.poly_grid_cells.getptr(Vector3i(x, y, z));
+					if (!range) {
+						continue;
+					}
+					for (uint32_t grid_index = range->start; grid_index < range->end; grid_index++) {
+						const uint32_t poly_id = p_flow_field.poly_grid_poly_ids[grid_index];
+						const Polygon *polygon = p_flow_field.flow_field_polys[poly_id].poly;
+						for (uint32_t point_id = 2; point_id < polygon->vertices.size(); point_id++) {
+							const Face3 face(polygon->vertices[0], polygon->vertices[point_id - 1], polygon->vertices[point_id]);
+							const Vector3 closest_point_on_face = face.get_closest_point_to(p_point);
+							const real_t distance_squared = closest_point_on_face.distance_squared_to(p_point);
+							if (distance_squared < closest_point_distance_squared) {
+								closest_point_distance_squared = distance_squared;
+								closest_poly_id = poly_id;
+								r_closest_point = closest_point_on_face;
+							}
+						}
+					}
+				}
+			}
+		}
+
+		const real_t ring_distance = ring * p_flow_field.poly_grid_cell_size;
+		if (closest_poly_id != UINT32_MAX && closest_point_distance_squared <= ring_distance * ring_distance) {
+			break;
+		}
+	}
+
+	return closest_poly_id;
+}
+
+Vector3 NavMeshQueries3D::flow_field_get_next_position(const FlowField &p_flow_field, uint32_t p_poly_id, const Vector3 &p_position, real_t p_reach_distance, real_t p_link_reach_distance) {
+	ERR_FAIL_UNSIGNED_INDEX_V(p_poly_id, p_flow_field.flow_field_polys.size(), p_position);
+
+	Vector3 next_position = p_position;
+	uint32_t poly_id = p_poly_id;
+
+	// Skip the pathways that are already reached, e.g. when standing on a polygon edge or at the start of a link.
+	for (uint32_t flow_field_poly_count = 0; flow_field_poly_count < p_flow_field.flow_field_polys.size(); flow_field_poly_count++) {
+		if (poly_id == p_flow_field.target_poly_id) {
+			return p_flow_field.target_position;
+		}
+
+		const FlowFieldPoly &flow_field_poly = p_flow_field.flow_field_polys[poly_id];
+		if (flow_field_poly.next_poly_id == UINT32_MAX) {
+			// The target is not reachable from here.
+			return next_position;
+		}
+
+		next_position = Geometry3D::get_closest_point_to_segment(p_position, flow_field_poly.pathway_start, flow_field_poly.pathway_end);
+
+		const FlowFieldPoly &next_flow_field_poly = p_flow_field.flow_field_polys[flow_field_poly.next_poly_id];
+		const bool next_is_link = next_flow_field_poly.poly->owner->get_type() == NavigationEnums3D::PathSegmentType::PATH_SEGMENT_TYPE_LINK;
+		if (p_position.distance_to(next_position) > (next_is_link ? p_link_reach_distance : p_reach_distance)) {
+			return next_position;
+		}
+
+		poly_id = flow_field_poly.next_poly_id;
+	}
+
+	return next_position;
+}
+
 Vector3 NavMeshQueries3D::polygons_get_closest_point_to_segment(const LocalVector<Polygon> &p_polygons, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) {
 	bool use_collision = p_use_collision;
 	Vector3 closest_point;
@@ -43,6 +43,7 @@ using namespace NavigationDefaults3D;
 using namespace NavigationEnums3D;
 
 class NavMap3D;
+struct NavClusterGraph3D;
 struct NavMapIteration3D;
 
 class NavMeshQueries3D {
@@ -50,9 +51,20 @@ public:
 	struct PathQuerySlot {
 		LocalVector<Nav3D::NavigationPoly> path_corridor;
 		Heap<Nav3D::NavigationPoly *, Nav3D::NavPolyTravelCostGreaterThan, Nav3D::NavPolyHeapIndexer> traversable_polys;
+		// Ids of the `path_corridor` entries modified by the last search, reset before the next one.
+		LocalVector<uint32_t> touched_poly_ids;
 		bool in_use = false;
 		uint32_t slot_index = 0;
 		AHashMap<const Nav3D::Polygon *, uint32_t> poly_to_id;
+
+		// Hierarchical pathfinding search over the cluster graph portals.
+		LocalVector<real_t> portal_traveled_distances;
+		LocalVector<uint32_t> portal_back_ids;
+		LocalVector<uint32_t> touched_portal_ids;
+		Heap<Nav3D::GraphSearchNode, Nav3D::GraphSearchNodeGreaterThan> traversable_portals;
+		// Clusters the polygon search is restricted to, as found by the cluster graph search.
+		LocalVector<uint8_t> corridor_clusters;
+		LocalVector<uint32_t> corridor_cluster_ids;
 	};
 
 	struct NavMeshPathQueryTask3D {
@@ -95,6 +107,10 @@ public:
 		Vector3 map_up;
 		NavMap3D *map = nullptr;
 		PathQuerySlot *path_query_slot = nullptr;
+		// Set while the polygon search is restricted to the `corridor_clusters` of the path query slot.
+		const NavClusterGraph3D *cluster_graph = nullptr;
+		// Number of portals and polygons expanded by the search.
+		uint32_t searched_node_count = 0;
 
 		// Path points.
 		LocalVector<Vector3> path_points;
@@ -123,6 +139,37 @@ public:
 		}
 	};
 
+	// Integration field towards a single target, shared by every agent heading to it.
+	// Read-only once built, so agents can use it without holding the map's flow field lock.
+	class FlowField : public RefCounted {
+		GDCLASS(FlowField, RefCounted);
+
+	public:
+		struct CellRange {
+			uint32_t start = 0;
+			uint32_t end = 0;
+		};
+
+		uint32_t iteration_id = 0;
+		uint32_t navigation_layers = 0;
+		Vector3 target_position;
+		uint32_t target_poly_id = UINT32_MAX;
+		// Indexed like `PathQuerySlot::path_corridor`.
+		LocalVector<Nav3D::FlowFieldPoly> flow_field_polys;
+
+		// Uniform grid over the usable region polygons, for the closest polygon lookups.
+		// A polygon is stored in every cell its bounds overlap.
+		real_t poly_grid_cell_size = 1.0;
+		Vector3i poly_grid_min;
+		Vector3i poly_grid_max;
+		AHashMap<Vector3i, CellRange> poly_grid_cells;
+		LocalVector<uint32_t> poly_grid_poly_ids;
+
+		Vector3i get_poly_grid_cell(const Vector3 &p_point) const {
+			return Vector3i((p_point / poly_grid_cell_size).floor());
+		}
+	};
+
 	static bool emit_callback(const Callable &p_callback);
 
 	static Vector3 polygons_get_random_point(const LocalVector<Nav3D::Polygon> &p_polygons, uint32_t p_navigation_layers, bool p_uniformly);
@@ -140,11 +187,20 @@ public:
 	static Nav3D::ClosestPointQueryResult map_iteration_get_closest_point_info(const NavMapIteration3D &p_map_iteration, const Vector3 &p_point);
 	static Vector3 map_iteration_get_random_point(const NavMapIteration3D &p_map_iteration, uint32_t p_navigation_layers, bool p_uniformly);
 
+	static void map_iteration_build_flow_field(const NavMapIteration3D &p_map_iteration, const Vector3 &p_target_position, uint32_t p_navigation_layers, FlowField &r_flow_field);
+	static uint32_t flow_field_get_closest_poly_id(const FlowField &p_flow_field, const Vector3 &p_point, Vector3 &r_closest_point);
+	static Vector3 flow_field_get_next_position(const FlowField &p_flow_field, uint32_t p_poly_id, const Vector3 &p_position, real_t p_reach_distance, real_t p_link_reach_distance);
+
 	static void map_query_path(NavMap3D *map, const Ref<NavigationPathQueryParameters3D> &p_query_parameters, Ref<NavigationPathQueryResult3D> p_query_result, const Callable &p_callback);
+	static void map_query_paths(NavMap3D *map, const LocalVector<Ref<NavigationPathQueryParameters3D>> &p_query_parameters, const LocalVector<Ref<NavigationPathQueryResult3D>> &p_query_results);
+
+	static void query_task_setup(NavMeshPathQueryTask3D &r_query_task, const Ref<NavigationPathQueryParameters3D> &p_query_parameters);
+	static void query_task_write_result(const NavMeshPathQueryTask3D &p_query_task, const Ref<NavigationPathQueryResult3D> &p_query_result);
 
 	static void query_task_map_iteration_get_path(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
 	static void _query_task_push_back_point_with_metadata(NavMeshPathQueryTask3D &p_query_task, const Vector3 &p_point, const Nav3D::Polygon *p_point_polygon);
 	static void _query_task_find_start_end_positions(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
+	static bool _query_task_build_cluster_corridor(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
 	static void _query_task_build_path_corridor(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
 	static void _query_task_post_process_corridorfunnel(NavMeshPathQueryTask3D &p_query_task);
 	static void _query_task_post_process_edgecentered(NavMeshPathQueryTask3D &p_query_task);
@@ -110,6 +110,14 @@ void NavMap3D::set_use_edge_connections(bool p_enabled) {
 	iteration_dirty = true;
 }
 
+void NavMap3D::set_use_hierarchical_pathfinding(bool p_enabled) {
+	if (use_hierarchical_pathfinding == p_enabled) {
+		return;
+	}
+	use_hierarchical_pathfinding = p_enabled;
+	iteration_dirty = true;
+}
+
 void NavMap3D::set_edge_connection_margin(real_t p_edge_connection_margin) {
 	if (edge_connection_margin == p_edge_connection_margin) {
 		return;
@@ -143,41 +151,163 @@ PointKey NavMap3D::get_point_key(const Vector3 &p_pos) const {
 	return p;
 }
 
-void NavMap3D::query_path(NavMeshQueries3D::NavMeshPathQueryTask3D &p_query_task) {
-	if (iteration_id == 0) {
-		return;
-	}
-
-	GET_MAP_ITERATION();
+NavMeshQueries3D::PathQuerySlot *NavMap3D::_acquire_path_query_slot(NavMapIteration3D &p_map_iteration) {
+	p_map_iteration.path_query_slots_semaphore.wait();
 
-	map_iteration.path_query_slots_semaphore.wait();
+	NavMeshQueries3D::PathQuerySlot *path_query_slot = nullptr;
 
-	map_iteration.path_query_slots_mutex.lock();
-	for (NavMeshQueries3D::PathQuerySlot &p_path_query_slot : map_iteration.path_query_slots) {
+	p_map_iteration.path_query_slots_mutex.lock();
+	for (NavMeshQueries3D::PathQuerySlot &p_path_query_slot : p_map_iteration.path_query_slots) {
 		if (!p_path_query_slot.in_use) {
 			p_path_query_slot.in_use = true;
-			p_query_task.path_query_slot = &p_path_query_slot;
+			path_query_slot = &p_path_query_slot;
 			break;
 		}
 	}
-	map_iteration.path_query_slots_mutex.unlock();
+	p_map_iteration.path_query_slots_mutex.unlock();
+
+	if (path_query_slot == nullptr) {
+		p_map_iteration.path_query_slots_semaphore.post();
+		ERR_FAIL_NULL_V_MSG(path_query_slot, nullptr, "No unused NavMap3D path query slot found! This should never happen :(.");
+	}
+
+	return path_query_slot;
+}
+
+void NavMap3D::_release_path_query_slot(NavMapIteration3D &p_map_iteration, NavMeshQueries3D::PathQuerySlot *p_path_query_slot) {
+	p_map_iteration.path_query_slots_mutex.lock();
+	p_map_iteration.path_query_slots[p_path_query_slot->slot_index].in_use = false;
+	p_map_iteration.path_query_slots_mutex.unlock();
+
+	p_map_iteration.path_query_slots_semaphore.post();
+}
+
+void NavMap3D::query_path(NavMeshQueries3D::NavMeshPathQueryTask3D &p_query_task) {
+	if (iteration_id == 0) {
+		return;
+	}
+
+	GET_MAP_ITERATION();
 
+	p_query_task.path_query_slot = _acquire_path_query_slot(map_iteration);
 	if (p_query_task.path_query_slot == nullptr) {
-		map_iteration.path_query_slots_semaphore.post();
-		ERR_FAIL_NULL_MSG(p_query_task.path_query_slot, "No unused NavMap3D path query slot found! This should never happen :(.");
+		return;
 	}
 
 	p_query_task.map_up = map_iteration.map_up;
 
 	NavMeshQueries3D::query_task_map_iteration_get_path(p_query_task, map_iteration);
+	path_query_searched_nodes.add(p_query_task.searched_node_count);
 
-	map_iteration.path_query_slots_mutex.lock();
-	uint32_t used_slot_index = p_query_task.path_query_slot->slot_index;
-	map_iteration.path_query_slots[used_slot_index].in_use = false;
+	_release_path_query_slot(map_iteration, p_query_task.path_query_slot);
 	p_query_task.path_query_slot = nullptr;
-	map_iteration.path_query_slots_mutex.unlock();
+}
+
+void NavMap3D::_query_paths_worker(uint32_t p_index, PathQueryBatch *p_batch) {
+	// Each worker keeps one slot for its whole share of the batch, so the search scratch is reused between queries.
+	NavMeshQueries3D::PathQuerySlot *path_query_slot = _acquire_path_query_slot(*p_batch->map_iteration);
+	if (path_query_slot == nullptr) {
+		return;
+	}
+
+	const uint32_t query_count = p_batch->query_tasks->size();
+	uint32_t query_index = p_batch->next_query.postincrement();
+	while (query_index < query_count) {
+		NavMeshQueries3D::NavMeshPathQueryTask3D &query_task = (*p_batch->query_tasks)[query_index];
+		query_task.path_query_slot = path_query_slot;
+		query_task.map_up = p_batch->map_iteration->map_up;
+
+		NavMeshQueries3D::query_task_map_iteration_get_path(query_task, *p_batch->map_iteration);
+		path_query_searched_nodes.add(query_task.searched_node_count);
+
+		query_task.path_query_slot = nullptr;
+		query_index = p_batch->next_query.postincrement();
+	}
+
+	_release_path_query_slot(*p_batch->map_iteration, path_query_slot);
+}
+
+void NavMap3D::query_paths(LocalVector<NavMeshQueries3D::NavMeshPathQueryTask3D> &p_query_tasks) {
+	if (iteration_id == 0 || p_query_tasks.is_empty()) {
+		return;
+	}
+
+	GET_MAP_ITERATION();
+
+	PathQueryBatch batch;
+	batch.map_iteration = &map_iteration;
+	batch.query_tasks = &p_query_tasks;
+
+	// There is no point in running more workers than there are slots to give them.
+	const uint32_t worker_count = MIN(p_query_tasks.size(), map_iteration.path_query_slots.size());
+
+	if (use_threads && worker_count > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap3D::_query_paths_worker, &batch, worker_count, -1, true, SNAME("NavMapQueryPaths"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		_query_paths_worker(0, &batch);
+	}
+}
+
+Vector3 NavMap3D::get_flow_field_next_position(const Vector3 &p_target_position, const Vector3 &p_from_position, uint32_t p_navigation_layers) {
+	if (iteration_id == 0) {
+		NAVMAP_ITERATION_ZERO_ERROR_MSG();
+		return Vector3();
+	}
 
-	map_iteration.path_query_slots_semaphore.post();
+	// The iteration id is read with the slot so a flow field is never tagged with the id of another iteration.
+	iteration_slot_rwlock.read_lock();
+	const NavMapIteration3D &map_iteration = iteration_slots[iteration_slot_index];
+	NavMapIterationRead3D iteration_read_lock(map_iteration);
+	const uint32_t map_iteration_id = iteration_id;
+	iteration_slot_rwlock.read_unlock();
+
+	// Every agent heading to the same target shares one flow field until the map changes.
+	FlowFieldKey flow_field_key;
+	flow_field_key.target_position = p_target_position;
+	flow_field_key.navigation_layers = p_navigation_layers;
+
+	Ref<NavMeshQueries3D::FlowField> flow_field;
+	{
+		MutexLock lock(flow_fields_mutex);
+		const Ref<NavMeshQueries3D::FlowField> *cached_flow_field = flow_fields.getptr(flow_field_key);
+		if (cached_flow_field && (*cached_flow_field)->iteration_id == map_iteration_id) {
+			flow_field = *cached_flow_field;
+		}
+	}
+
+	if (flow_field.is_null()) {
+		// Built outside of the lock so agents with other targets are not blocked.
+		flow_field.instantiate();
+		flow_field->iteration_id = map_iteration_id;
+		NavMeshQueries3D::map_iteration_build_flow_field(map_iteration, p_target_position, p_navigation_layers, *flow_field.ptr());
+
+		MutexLock lock(flow_fields_mutex);
+		Ref<NavMeshQueries3D::FlowField> *cached_flow_field = flow_fields.getptr(flow_field_key);
+		if (cached_flow_field && (*cached_flow_field)->iteration_id == map_iteration_id) {
+			// Another thread built the same flow field meanwhile.
+			flow_field = *cached_flow_field;
+		} else if (cached_flow_field) {
+			*cached_flow_field = flow_field;
+		} else {
+			if (flow_fields.size() >= FLOW_FIELDS_MAX) {
+				flow_fields.remove(flow_fields.begin());
+			}
+			flow_fields.insert(flow_field_key, flow_field);
+		}
+	}
+
+	Vector3 from_point;
+	const uint32_t from_poly_id = NavMeshQueries3D::flow_field_get_closest_poly_id(**flow_field, p_from_position, from_point);
+	if (from_poly_id == UINT32_MAX) {
+		return Vector3();
+	}
+
+	if (flow_field->target_poly_id == UINT32_MAX) {
+		return from_point;
+	}
+
+	return NavMeshQueries3D::flow_field_get_next_position(**flow_field, from_poly_id, from_point, cell_size, link_connection_radius);
 }
 
 Vector3 NavMap3D::get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const {
@@ -368,6 +498,8 @@ void NavMap3D::_build_iteration() {
 	iteration_build.use_edge_connections = get_use_edge_connections();
 	iteration_build.edge_connection_margin = get_edge_connection_margin();
 	iteration_build.link_connection_radius = get_link_connection_radius();
+	iteration_build.use_hierarchical_pathfinding = get_use_hierarchical_pathfinding();
+	iteration_build.hierarchical_cluster_size = hierarchical_cluster_size;
 
 	next_map_iteration.clear();
 
@@ -415,14 +547,17 @@ void NavMap3D::_sync_iteration() {
 	performance_data.pm_edge_connection_count = iteration_build.performance_data.pm_edge_connection_count;
 	performance_data.pm_edge_free_count = iteration_build.performance_data.pm_edge_free_count;
 
-	iteration_id = iteration_id % UINT32_MAX + 1;
-
 	// Finally ping-pong switch the iteration slot.
 	iteration_slot_rwlock.write_lock();
+	iteration_id = iteration_id % UINT32_MAX + 1;
 	uint32_t next_iteration_slot_index = (iteration_slot_index + 1) % 2;
 	iteration_slot_index = next_iteration_slot_index;
 	iteration_slot_rwlock.write_unlock();
 
+	flow_fields_mutex.lock();
+	flow_fields.clear();
+	flow_fields_mutex.unlock();
+
 	iteration_ready = false;
 }
 
@@ -433,6 +568,11 @@ void NavMap3D::sync() {
 	performance_data.pm_link_count = links.size();
 	performance_data.pm_obstacle_count = obstacles.size();
 
+	// Nodes searched by path queries since the last sync.
+	const uint32_t searched_node_count = path_query_searched_nodes.get();
+	path_query_searched_nodes.sub(searched_node_count);
+	performance_data.pm_path_query_node_count = searched_node_count;
+
 	_sync_async_tasks();
 
 	_sync_dirty_map_update_requests();
@@ -562,80 +702,84 @@ void NavMap3D::_update_rvo_obstacles_tree_2d() {
 	rvo_simulation_2d.kdTree_->buildObstacleTree(raw_obstacles);
 }
 
-void NavMap3D::_update_rvo_agents_tree_2d() {
-	// Cannot use LocalVector here as RVO library expects std::vector to build KdTree.
-	std::vector<RVO2D::Agent2D *> raw_agents;
-	raw_agents.reserve(active_2d_avoidance_agents.size());
-	for (NavAgent3D *agent : active_2d_avoidance_agents) {
-		raw_agents.push_back(agent->get_rvo_agent_2d());
+void NavMap3D::_update_rvo_simulation() {
+	if (obstacles_dirty) {
+		_update_rvo_obstacles_tree_2d();
+	}
+	if (agents_dirty) {
+		avoidance_grid_2d.set_dirty();
+		avoidance_grid_3d.set_dirty();
 	}
-	rvo_simulation_2d.kdTree_->buildAgentTree(raw_agents);
 }
 
-void NavMap3D::_update_rvo_agents_tree_3d() {
-	// Cannot use LocalVector here as RVO library expects std::vector to build KdTree.
-	std::vector<RVO3D::Agent3D *> raw_agents;
-	raw_agents.reserve(active_3d_avoidance_agents.size());
-	for (NavAgent3D *agent : active_3d_avoidance_agents) {
-		raw_agents.push_back(agent->get_rvo_agent_3d());
+void NavMap3D::compute_avoidance_velocities_2d(uint32_t p_chunk_index, NavAgent3D **p_agents) {
+	const uint32_t chunk_end = MIN((p_chunk_index + 1) * AVOIDANCE_AGENTS_PER_CHUNK, active_2d_avoidance_agents.size());
+	for (uint32_t i = p_chunk_index * AVOIDANCE_AGENTS_PER_CHUNK; i < chunk_end; i++) {
+		RVO2D::Agent2D *rvo_agent = p_agents[i]->get_rvo_agent_2d();
+
+		// Obstacles still use the RVO KdTree, agents use the spatial hash.
+		rvo_agent->obstacleNeighbors_.clear();
+		const float obstacle_range = rvo_agent->timeHorizonObst_ * rvo_agent->maxSpeed_ + rvo_agent->radius_;
+		rvo_simulation_2d.kdTree_->computeObstacleNeighbors(rvo_agent, obstacle_range * obstacle_range);
+
+		avoidance_grid_2d.compute_agent_neighbors_2d(p_agents[i]);
+		rvo_agent->computeNewVelocity(&rvo_simulation_2d);
 	}
-	rvo_simulation_3d.kdTree_->buildAgentTree(raw_agents);
 }
 
-void NavMap3D::_update_rvo_simulation() {
-	if (obstacles_dirty) {
-		_update_rvo_obstacles_tree_2d();
+void NavMap3D::compute_avoidance_velocities_3d(uint32_t p_chunk_index, NavAgent3D **p_agents) {
+	const uint32_t chunk_end = MIN((p_chunk_index + 1) * AVOIDANCE_AGENTS_PER_CHUNK, active_3d_avoidance_agents.size());
+	for (uint32_t i = p_chunk_index * AVOIDANCE_AGENTS_PER_CHUNK; i < chunk_end; i++) {
+		avoidance_grid_3d.compute_agent_neighbors_3d(p_agents[i]);
+		p_agents[i]->get_rvo_agent_3d()->computeNewVelocity(&rvo_simulation_3d);
 	}
-	if (agents_dirty) {
-		_update_rvo_agents_tree_2d();
-		_update_rvo_agents_tree_3d();
+}
+
+void NavMap3D::apply_avoidance_velocities_2d(uint32_t p_chunk_index, NavAgent3D **p_agents) {
+	const uint32_t chunk_end = MIN((p_chunk_index + 1) * AVOIDANCE_AGENTS_PER_CHUNK, active_2d_avoidance_agents.size());
+	for (uint32_t i = p_chunk_index * AVOIDANCE_AGENTS_PER_CHUNK; i < chunk_end; i++) {
+		p_agents[i]->get_rvo_agent_2d()->update(&rvo_simulation_2d);
+		p_agents[i]->update();
 	}
 }
 
-void NavMap3D::compute_single_avoidance_step_2d(uint32_t index, NavAgent3D **agent) {
-	(*(agent + index))->get_rvo_agent_2d()->computeNeighbors(&rvo_simulation_2d);
-	(*(agent + index))->get_rvo_agent_2d()->computeNewVelocity(&rvo_simulation_2d);
-	(*(agent + index))->get_rvo_agent_2d()->update(&rvo_simulation_2d);
-	(*(agent + index))->update();
+void NavMap3D::apply_avoidance_velocities_3d(uint32_t p_chunk_index, NavAgent3D **p_agents) {
+	const uint32_t chunk_end = MIN((p_chunk_index + 1) * AVOIDANCE_AGENTS_PER_CHUNK, active_3d_avoidance_agents.size());
+	for (uint32_t i = p_chunk_index * AVOIDANCE_AGENTS_PER_CHUNK; i < chunk_end; i++) {
+		p_agents[i]->get_rvo_agent_3d()->update(&rvo_simulation_3d);
+		p_agents[i]->update();
+	}
 }
 
-void NavMap3D::compute_single_avoidance_step_3d(uint32_t index, NavAgent3D **agent) {
-	(*(agent + index))->get_rvo_agent_3d()->computeNeighbors(&rvo_simulation_3d);
-	(*(agent + index))->get_rvo_agent_3d()->computeNewVelocity(&rvo_simulation_3d);
-	(*(agent + index))->get_rvo_agent_3d()->update(&rvo_simulation_3d);
-	(*(agent + index))->update();
+void NavMap3D::_run_avoidance_chunks(void (NavMap3D::*p_method)(uint32_t, NavAgent3D **), LocalVector<NavAgent3D *> &p_agents, const StringName &p_task_name) {
+	const uint32_t chunk_count = Math::division_round_up(p_agents.size(), AVOIDANCE_AGENTS_PER_CHUNK);
+
+	if (use_threads && avoidance_use_multiple_threads && chunk_count > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, p_method, p_agents.ptr(), chunk_count, -1, true, p_task_name);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t chunk_index = 0; chunk_index < chunk_count; chunk_index++) {
+			(this->*p_method)(chunk_index, p_agents.ptr());
+		}
+	}
 }
 
 void NavMap3D::step(double p_delta_time) {
 	rvo_simulation_2d.setTimeStep(float(p_delta_time));
 	rvo_simulation_3d.setTimeStep(float(p_delta_time));
 
+	// All agents compute their new velocity before any of them moves, so the neighbor positions and velocities
+	// read by the avoidance stay the same for the whole step.
 	if (active_2d_avoidance_agents.size() > 0) {
-		if (use_threads && avoidance_use_multiple_threads) {
-			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap3D::compute_single_avoidance_step_2d, active_2d_avoidance_agents.ptr(), active_2d_avoidance_agents.size(), -1, true, SNAME("RVOAvoidanceAgents2D"));
-			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
-		} else {
-			for (NavAgent3D *agent : active_2d_avoidance_agents) {
-				agent->get_rvo_agent_2d()->computeNeighbors(&rvo_simulation_2d);
-				agent->get_rvo_agent_2d()->computeNewVelocity(&rvo_simulation_2d);
-				agent->get_rvo_agent_2d()->update(&rvo_simulation_2d);
-				agent->update();
-			}
-		}
+		avoidance_grid_2d.update(active_2d_avoidance_agents, false);
+		_run_avoidance_chunks(&NavMap3D::compute_avoidance_velocities_2d, active_2d_avoidance_agents, SNAME("RVOAvoidanceAgents2D"));
+		_run_avoidance_chunks(&NavMap3D::apply_avoidance_velocities_2d, active_2d_avoidance_agents, SNAME("RVOAvoidanceAgents2D"));
 	}
 
 	if (active_3d_avoidance_agents.size() > 0) {
-		if (use_threads && avoidance_use_multiple_threads) {
-			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap3D::compute_single_avoidance_step_3d, active_3d_avoidance_agents.ptr(), active_3d_avoidance_agents.size(), -1, true, SNAME("RVOAvoidanceAgents3D"));
-			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
-		} else {
-			for (NavAgent3D *agent : active_3d_avoidance_agents) {
-				agent->get_rvo_agent_3d()->computeNeighbors(&rvo_simulation_3d);
-				agent->get_rvo_agent_3d()->computeNewVelocity(&rvo_simulation_3d);
-				agent->get_rvo_agent_3d()->update(&rvo_simulation_3d);
-				agent->update();
-			}
-		}
+		avoidance_grid_3d.update(active_3d_avoidance_agents, true);
+		_run_avoidance_chunks(&NavMap3D::compute_avoidance_velocities_3d, active_3d_avoidance_agents, SNAME("RVOAvoidanceAgents3D"));
+		_run_avoidance_chunks(&NavMap3D::apply_avoidance_velocities_3d, active_3d_avoidance_agents, SNAME("RVOAvoidanceAgents3D"));
 	}
 }
 
@@ -857,6 +1001,7 @@ NavMap3D::NavMap3D() {
 	avoidance_use_high_priority_threads = GLOBAL_GET("navigation/avoidance/thread_model/avoidance_use_high_priority_threads");
 
 	path_query_slots_max = GLOBAL_GET("navigation/pathfinding/max_threads");
+	hierarchical_cluster_size = GLOBAL_GET("navigation/3d/hierarchical_pathfinding_cluster_size");
 
 	int processor_count = OS::get_singleton()->get_processor_count();
 	if (path_query_slots_max < 0) {
@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "3d/nav_avoidance_grid_3d.h"
 #include "3d/nav_map_iteration_3d.h"
 #include "3d/nav_mesh_queries_3d.h"
 #include "nav_rid_3d.h"
@@ -71,6 +72,10 @@ class NavMap3D : public NavRid3D {
 	/// This value is used to limit how far links search to find polygons to connect to.
 	real_t link_connection_radius = NavigationDefaults3D::LINK_CONNECTION_RADIUS;
 
+	/// Path queries first search a graph of polygon clusters, then only the polygons of the clusters on that path.
+	bool use_hierarchical_pathfinding = false;
+	real_t hierarchical_cluster_size = 32.0;
+
 	bool map_settings_dirty = true;
 
 	/// Map regions
@@ -87,6 +92,13 @@ class NavMap3D : public NavRid3D {
 	LocalVector<NavAgent3D *> active_2d_avoidance_agents;
 	LocalVector<NavAgent3D *> active_3d_avoidance_agents;
 
+	/// Spatial hashes used for the avoidance agent neighbor search
+	NavAvoidanceGrid3D avoidance_grid_2d;
+	NavAvoidanceGrid3D avoidance_grid_3d;
+
+	/// Avoidance agents are handed to the worker threads in chunks of this size
+	static constexpr uint32_t AVOIDANCE_AGENTS_PER_CHUNK = 32;
+
 	/// dirty flag when one of the agent's arrays are modified
 	bool agents_dirty = true;
 
@@ -108,6 +120,7 @@ class NavMap3D : public NavRid3D {
 
 	// Performance Monitor
 	Nav3D::PerformanceData performance_data;
+	SafeNumeric<uint32_t> path_query_searched_nodes;
 
 	struct {
 		struct {
@@ -154,6 +167,34 @@ class NavMap3D : public NavRid3D {
 	void _build_iteration();
 	void _sync_iteration();
 
+	struct PathQueryBatch {
+		NavMapIteration3D *map_iteration = nullptr;
+		LocalVector<NavMeshQueries3D::NavMeshPathQueryTask3D> *query_tasks = nullptr;
+		SafeNumeric<uint32_t> next_query;
+	};
+
+	struct FlowFieldKey {
+		Vector3 target_position;
+		uint32_t navigation_layers = 0;
+
+		static uint32_t hash(const FlowFieldKey &p_key) {
+			return hash_murmur3_one_32(p_key.navigation_layers, HashMapHasherDefault::hash(p_key.target_position));
+		}
+
+		bool operator==(const FlowFieldKey &p_key) const {
+			return target_position == p_key.target_position && navigation_layers == p_key.navigation_layers;
+		}
+	};
+
+	/// Flow fields of the current map iteration, the oldest is dropped when over the limit.
+	static constexpr uint32_t FLOW_FIELDS_MAX = 16;
+	HashMap<FlowFieldKey, Ref<NavMeshQueries3D::FlowField>, FlowFieldKey> flow_fields;
+	Mutex flow_fields_mutex;
+
+	NavMeshQueries3D::PathQuerySlot *_acquire_path_query_slot(NavMapIteration3D &p_map_iteration);
+	void _release_path_query_slot(NavMapIteration3D &p_map_iteration, NavMeshQueries3D::PathQuerySlot *p_path_query_slot);
+	void _query_paths_worker(uint32_t p_index, PathQueryBatch *p_batch);
+
 public:
 	NavMap3D();
 	~NavMap3D();
@@ -193,10 +234,18 @@ public:
 		return link_connection_radius;
 	}
 
+	void set_use_hierarchical_pathfinding(bool p_enabled);
+	bool get_use_hierarchical_pathfinding() const {
+		return use_hierarchical_pathfinding;
+	}
+
 	Nav3D::PointKey get_point_key(const Vector3 &p_pos) const;
 	const Vector3 &get_merge_rasterizer_cell_size() const;
 
 	void query_path(NavMeshQueries3D::NavMeshPathQueryTask3D &p_query_task);
+	void query_paths(LocalVector<NavMeshQueries3D::NavMeshPathQueryTask3D> &p_query_tasks);
+
+	Vector3 get_flow_field_next_position(const Vector3 &p_target_position, const Vector3 &p_from_position, uint32_t p_navigation_layers);
 
 	Vector3 get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const;
 	Vector3 get_closest_point(const Vector3 &p_point) const;
@@ -249,6 +298,7 @@ public:
 	int get_pm_edge_connection_count() const { return performance_data.pm_edge_connection_count; }
 	int get_pm_edge_free_count() const { return performance_data.pm_edge_free_count; }
 	int get_pm_obstacle_count() const { return performance_data.pm_obstacle_count; }
+	int get_pm_path_query_node_count() const { return performance_data.pm_path_query_node_count; }
 
 	int get_region_connections_count(NavRegion3D *p_region) const;
 	Vector3 get_region_connection_pathway_start(NavRegion3D *p_region, int p_connection_id) const;
@@ -277,14 +327,15 @@ private:
 
 	void compute_single_step(uint32_t index, NavAgent3D **agent);
 
-	void compute_single_avoidance_step_2d(uint32_t index, NavAgent3D **agent);
-	void compute_single_avoidance_step_3d(uint32_t index, NavAgent3D **agent);
+	void compute_avoidance_velocities_2d(uint32_t p_chunk_index, NavAgent3D **p_agents);
+	void compute_avoidance_velocities_3d(uint32_t p_chunk_index, NavAgent3D **p_agents);
+	void apply_avoidance_velocities_2d(uint32_t p_chunk_index, NavAgent3D **p_agents);
+	void apply_avoidance_velocities_3d(uint32_t p_chunk_index, NavAgent3D **p_agents);
+	void _run_avoidance_chunks(void (NavMap3D::*p_method)(uint32_t, NavAgent3D **), LocalVector<NavAgent3D *> &p_agents, const StringName &p_task_name);
 
 	void _sync_avoidance();
 	void _update_rvo_simulation();
 	void _update_rvo_obstacles_tree_2d();
-	void _update_rvo_agents_tree_2d();
-	void _update_rvo_agents_tree_3d();
 
 	void _update_merge_rasterizer_cell_dimensions();
 };
@@ -171,6 +171,32 @@ struct NavPolyHeapIndexer {
 	}
 };
 
+struct FlowFieldPoly {
+	/// This poly.
+	const Polygon *poly = nullptr;
+
+	/// Travel cost from the center of this poly to the flow field target.
+	real_t distance_to_target = FLT_MAX;
+
+	/// Next poly towards the target and the pathway leading to it.
+	uint32_t next_poly_id = UINT32_MAX;
+	Vector3 pathway_start;
+	Vector3 pathway_end;
+};
+
+/// Open list entry of the searches that do not need a NavigationPoly, e.g. over cluster portals or for flow fields.
+struct GraphSearchNode {
+	uint32_t id = UINT32_MAX;
+	real_t traveled_distance = FLT_MAX;
+	real_t estimated_cost = FLT_MAX;
+};
+
+struct GraphSearchNodeGreaterThan {
+	bool operator()(const GraphSearchNode &p_node_a, const GraphSearchNode &p_node_b) const {
+		return p_node_a.estimated_cost > p_node_b.estimated_cost;
+	}
+};
+
 struct ClosestPointQueryResult {
 	Vector3 point;
 	Vector3 normal;
@@ -192,6 +218,7 @@ struct PerformanceData {
 	int pm_edge_connection_count = 0;
 	int pm_edge_free_count = 0;
 	int pm_obstacle_count = 0;
+	int pm_path_query_node_count = 0;
 
 	void reset() {
 		pm_region_count = 0;
@@ -203,6 +230,7 @@ struct PerformanceData {
 		pm_edge_connection_count = 0;
 		pm_edge_free_count = 0;
 		pm_obstacle_count = 0;
+		pm_path_query_node_count = 0;
 	}
 };
 
@@ -31,6 +31,7 @@
 #include "node_3d.h"
 
 #include "core/math/transform_interpolator.h"
+#include "core/object/worker_thread_pool.h"
 #include "scene/3d/visual_instance_3d.h"
 #include "scene/main/viewport.h"
 #include "scene/property_utils.h"
@@ -671,6 +672,48 @@ Transform3D Node3D::get_global_transform() const {
 	return data.global_transform;
 }
 
+void Node3D::_update_global_transform_task(void *p_userdata, uint32_t p_index) {
+	// The parent was updated in a previous pass, so this only writes to the node itself.
+	Node3D *node = ((Node3D **)p_userdata)[p_index];
+	(void)node->get_global_transform();
+}
+
+void Node3D::update_global_transforms(const LocalVector<Node3D *> &p_nodes) {
+	// Instead of each node lazily walking up to its parent, gather the dirty nodes
+	// and their dirty ancestors by depth and resolve them one level at a time.
+	const uint32_t PARALLEL_MIN_NODES = 256;
+
+	LocalVector<LocalVector<Node3D *>> levels;
+	HashSet<Node3D *> gathered;
+
+	for (Node3D *node : p_nodes) {
+		Node3D *current = node;
+		while (current && current->is_inside_tree() && current->_test_dirty_bits(DIRTY_GLOBAL_TRANSFORM) && !gathered.has(current)) {
+			gathered.insert(current);
+
+			uint32_t depth = current->_get_scene_tree_depth();
+			if (depth >= levels.size()) {
+				levels.resize(depth + 1);
+			}
+			levels[depth].push_back(current);
+
+			current = current->data.top_level ? nullptr : current->data.parent;
+		}
+	}
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	for (LocalVector<Node3D *> &level : levels) {
+		if (level.size() >= PARALLEL_MIN_NODES && pool->get_thread_count() > 1) {
+			WorkerThreadPool::GroupID group = pool->add_native_group_task(&Node3D::_update_global_transform_task, level.ptr(), level.size(), -1, true, SNAME("Node3D global transforms"));
+			pool->wait_for_group_task_completion(group);
+		} else {
+			for (Node3D *node : level) {
+				(void)node->get_global_transform();
+			}
+		}
+	}
+}
+
 #ifdef TOOLS_ENABLED
 Transform3D Node3D::get_global_gizmo_transform() const {
 	return get_global_transform();
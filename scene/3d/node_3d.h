@@ -52,6 +52,7 @@ class Node3D : public Node {
 
 	friend class SceneTreeFTI;
 	friend class SceneTreeFTITests;
+	friend class TestNode3DInternalsAccessor;
 
 public:
 	static constexpr AncestralClass static_ancestral_class = AncestralClass::NODE_3D;
@@ -189,6 +190,8 @@ private:
 	void _update_visibility_parent(bool p_update_root);
 	void _propagate_transform_changed_deferred();
 
+	static void _update_global_transform_task(void *p_userdata, uint32_t p_index);
+
 protected:
 	_FORCE_INLINE_ void set_ignore_transform_notification(bool p_ignore) { data.ignore_notification = p_ignore; }
 
@@ -279,6 +282,7 @@ public:
 	Basis get_basis() const;
 	Quaternion get_quaternion() const;
 	Transform3D get_global_transform() const;
+	static void update_global_transforms(const LocalVector<Node3D *> &p_nodes);
 
 	Transform3D get_global_transform_interpolated();
 	bool update_client_physics_interpolation_data();
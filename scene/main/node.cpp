@@ -57,6 +57,9 @@ SafeNumeric<uint64_t> Node::total_node_count{ 0 };
 
 thread_local Node *Node::current_process_thread_group = nullptr;
 
+// Above this many children, lookups by name go through a hash index instead of scanning the names.
+static constexpr uint32_t CHILDREN_NAME_INDEX_THRESHOLD = 16;
+
 void Node::_notification(int p_notification) {
 	switch (p_notification) {
 		case NOTIFICATION_ACCESSIBILITY_INVALIDATE: {
@@ -124,6 +127,12 @@ void Node::_notification(int p_notification) {
 			}
 
 			{ // Update threaded process mode.
+				if (data.process_thread_group == PROCESS_THREAD_GROUP_INHERIT && _wants_automatic_process_thread_group()) {
+					// Opted in to be processed as a sub-thread group of its own.
+					data.process_thread_group = PROCESS_THREAD_GROUP_SUB_THREAD;
+					data.process_thread_group_automatic = true;
+				}
+
 				if (data.process_thread_group == PROCESS_THREAD_GROUP_INHERIT) {
 					if (data.parent) {
 						data.process_thread_group_owner = data.parent->data.process_thread_group_owner;
@@ -223,6 +232,10 @@ void Node::_notification(int p_notification) {
 			if (data.process_thread_group_owner == this) {
 				_remove_process_group();
 			}
+			if (data.process_thread_group_automatic) {
+				data.process_thread_group = PROCESS_THREAD_GROUP_INHERIT;
+				data.process_thread_group_automatic = false;
+			}
 			data.process_thread_group_owner = nullptr;
 			data.process_owner = nullptr;
 
@@ -301,7 +314,7 @@ void Node::_notification(int p_notification) {
 
 			// kill children as cleanly as possible
 			while (data.children.size()) {
-				Node *child = data.children.last()->value; // begin from the end because its faster and more consistent with creation
+				Node *child = data.children[data.children.size() - 1]; // begin from the end because its faster and more consistent with creation
 				memdelete(child);
 			}
 		} break;
@@ -317,8 +330,8 @@ void Node::_notification(int p_notification) {
 void Node::_propagate_ready() {
 	data.ready_notified = true;
 	data.blocked++;
-	for (KeyValue<StringName, Node *> &K : data.children) {
-		K.value->_propagate_ready();
+	for (Node *child : data.children) {
+		child->_propagate_ready();
 	}
 
 	data.blocked--;
@@ -368,16 +381,18 @@ void Node::_propagate_enter_tree() {
 	data.blocked++;
 	//block while adding children
 
-	for (KeyValue<StringName, Node *> &K : data.children) {
-		if (!K.value->is_inside_tree()) { // could have been added in enter_tree
-			K.value->_propagate_enter_tree();
+	for (Node *child : data.children) {
+		if (!child->is_inside_tree()) { // could have been added in enter_tree
+			child->_propagate_enter_tree();
 		}
 	}
 
 	data.blocked--;
 
 #ifdef DEBUG_ENABLED
-	SceneDebugger::add_to_cache(data.scene_file_path, this);
+	if (data.extra) {
+		SceneDebugger::add_to_cache(data.extra->scene_file_path, this);
+	}
 #endif
 	// enter groups
 }
@@ -392,8 +407,8 @@ void Node::_propagate_after_exit_tree() {
 
 	data.blocked++;
 
-	for (HashMap<StringName, Node *>::Iterator I = data.children.last(); I; --I) {
-		I->value->_propagate_after_exit_tree();
+	for (uint32_t i = data.children.size(); i > 0; i--) {
+		data.children[i - 1]->_propagate_after_exit_tree();
 	}
 
 	data.blocked--;
@@ -405,15 +420,15 @@ void Node::_propagate_exit_tree() {
 	//block while removing children
 
 #ifdef DEBUG_ENABLED
-	if (!data.scene_file_path.is_empty()) {
+	if (data.extra && !data.extra->scene_file_path.is_empty()) {
 		// Only remove if file path is set (optimization).
-		SceneDebugger::remove_from_cache(data.scene_file_path, this);
+		SceneDebugger::remove_from_cache(data.extra->scene_file_path, this);
 	}
 #endif
 	data.blocked++;
 
-	for (HashMap<StringName, Node *>::Iterator I = data.children.last(); I; --I) {
-		I->value->_propagate_exit_tree();
+	for (uint32_t i = data.children.size(); i > 0; i--) {
+		data.children[i - 1]->_propagate_exit_tree();
 	}
 
 	data.blocked--;
@@ -476,8 +491,8 @@ void Node::_propagate_physics_interpolated(bool p_interpolated) {
 	update_configuration_warnings();
 
 	data.blocked++;
-	for (KeyValue<StringName, Node *> &K : data.children) {
-		K.value->_propagate_physics_interpolated(p_interpolated);
+	for (Node *child : data.children) {
+		child->_propagate_physics_interpolated(p_interpolated);
 	}
 	data.blocked--;
 }
@@ -488,8 +503,8 @@ void Node::_propagate_physics_interpolation_reset_requested(bool p_requested) {
 	}
 
 	data.blocked++;
-	for (KeyValue<StringName, Node *> &K : data.children) {
-		K.value->_propagate_physics_interpolation_reset_requested(p_requested);
+	for (Node *child : data.children) {
+		child->_propagate_physics_interpolation_reset_requested(p_requested);
 	}
 	data.blocked--;
 }
@@ -499,26 +514,25 @@ void Node::move_child(RequiredParam<Node> rp_child, int p_index) {
 	EXTRACT_PARAM_OR_FAIL(p_child, rp_child);
 	ERR_FAIL_COND_MSG(p_child->data.parent != this, "Child is not a child of this node.");
 
-	_update_children_cache();
 	// We need to check whether node is internal and move it only in the relevant node range.
 	if (p_child->data.internal_mode == INTERNAL_MODE_FRONT) {
 		if (p_index < 0) {
-			p_index += data.internal_children_front_count_cache;
+			p_index += data.internal_children_front_count;
 		}
-		ERR_FAIL_INDEX_MSG(p_index, data.internal_children_front_count_cache, vformat("Invalid new child index: %d. Child is internal.", p_index));
+		ERR_FAIL_INDEX_MSG(p_index, data.internal_children_front_count, vformat("Invalid new child index: %d. Child is internal.", p_index));
 		_move_child(p_child, p_index);
 	} else if (p_child->data.internal_mode == INTERNAL_MODE_BACK) {
 		if (p_index < 0) {
-			p_index += data.internal_children_back_count_cache;
+			p_index += data.internal_children_back_count;
 		}
-		ERR_FAIL_INDEX_MSG(p_index, data.internal_children_back_count_cache, vformat("Invalid new child index: %d. Child is internal.", p_index));
-		_move_child(p_child, (int)data.children_cache.size() - data.internal_children_back_count_cache + p_index);
+		ERR_FAIL_INDEX_MSG(p_index, data.internal_children_back_count, vformat("Invalid new child index: %d. Child is internal.", p_index));
+		_move_child(p_child, (int)data.children.size() - data.internal_children_back_count + p_index);
 	} else {
 		if (p_index < 0) {
 			p_index += get_child_count(false);
 		}
-		ERR_FAIL_INDEX_MSG(p_index, (int)data.children_cache.size() + 1 - data.internal_children_front_count_cache - data.internal_children_back_count_cache, vformat("Invalid new child index: %d.", p_index));
-		_move_child(p_child, p_index + data.internal_children_front_count_cache);
+		ERR_FAIL_INDEX_MSG(p_index, (int)data.children.size() + 1 - data.internal_children_front_count - data.internal_children_back_count, vformat("Invalid new child index: %d.", p_index));
+		_move_child(p_child, p_index + data.internal_children_front_count);
 	}
 }
 
@@ -529,20 +543,21 @@ void Node::_move_child(Node *p_child, int p_index, bool p_ignore_end) {
 	// means the same as moving to the last index
 	if (!p_ignore_end) { // p_ignore_end is a little hack to make back internal children work properly.
 		if (p_child->data.internal_mode == INTERNAL_MODE_FRONT) {
-			if (p_index == data.internal_children_front_count_cache) {
+			if (p_index == data.internal_children_front_count) {
 				p_index--;
 			}
 		} else if (p_child->data.internal_mode == INTERNAL_MODE_BACK) {
-			if (p_index == (int)data.children_cache.size()) {
+			if (p_index == (int)data.children.size()) {
 				p_index--;
 			}
 		} else {
-			if (p_index == (int)data.children_cache.size() - data.internal_children_back_count_cache) {
+			if (p_index == (int)data.children.size() - data.internal_children_back_count) {
 				p_index--;
 			}
 		}
 	}
 
+	_update_children_indices();
 	int child_index = p_child->get_index();
 
 	if (child_index == p_index) {
@@ -552,8 +567,8 @@ void Node::_move_child(Node *p_child, int p_index, bool p_ignore_end) {
 	int motion_from = MIN(p_index, child_index);
 	int motion_to = MAX(p_index, child_index);
 
-	data.children_cache.remove_at(child_index);
-	data.children_cache.insert(p_index, p_child);
+	data.children.remove_at(child_index);
+	data.children.insert(p_index, p_child);
 
 	if (data.tree) {
 		data.tree->tree_changed();
@@ -562,12 +577,12 @@ void Node::_move_child(Node *p_child, int p_index, bool p_ignore_end) {
 	data.blocked++;
 	//new pos first
 	for (int i = motion_from; i <= motion_to; i++) {
-		if (data.children_cache[i]->data.internal_mode == INTERNAL_MODE_DISABLED) {
-			data.children_cache[i]->data.index = i - data.internal_children_front_count_cache;
-		} else if (data.children_cache[i]->data.internal_mode == INTERNAL_MODE_BACK) {
-			data.children_cache[i]->data.index = i - data.internal_children_front_count_cache - data.external_children_count_cache;
+		if (data.children[i]->data.internal_mode == INTERNAL_MODE_DISABLED) {
+			data.children[i]->data.index = i - data.internal_children_front_count;
+		} else if (data.children[i]->data.internal_mode == INTERNAL_MODE_BACK) {
+			data.children[i]->data.index = i - data.internal_children_front_count - data.external_children_count;
 		} else {
-			data.children_cache[i]->data.index = i;
+			data.children[i]->data.index = i;
 		}
 	}
 	// notification second
@@ -586,8 +601,8 @@ void Node::_propagate_groups_dirty() {
 		}
 	}
 
-	for (KeyValue<StringName, Node *> &K : data.children) {
-		K.value->_propagate_groups_dirty();
+	for (Node *child : data.children) {
+		child->_propagate_groups_dirty();
 	}
 }
 
@@ -729,8 +744,8 @@ void Node::_propagate_pause_notification(bool p_enable) {
 	}
 
 	data.blocked++;
-	for (KeyValue<StringName, Node *> &K : data.children) {
-		K.value->_propagate_pause_notification(p_enable);
+	for (Node *child : data.children) {
+		child->_propagate_pause_notification(p_enable);
 	}
 	data.blocked--;
 }
@@ -739,8 +754,8 @@ void Node::_propagate_suspend_notification(bool p_enable) {
 	notification(p_enable ? NOTIFICATION_SUSPENDED : NOTIFICATION_UNSUSPENDED);
 
 	data.blocked++;
-	for (KeyValue<StringName, Node *> &KV : data.children) {
-		KV.value->_propagate_suspend_notification(p_enable);
+	for (Node *child : data.children) {
+		child->_propagate_suspend_notification(p_enable);
 	}
 	data.blocked--;
 }
@@ -761,10 +776,9 @@ void Node::_propagate_process_owner(Node *p_owner, int p_pause_notification, int
 	}
 
 	data.blocked++;
-	for (KeyValue<StringName, Node *> &K : data.children) {
-		Node *c = K.value;
-		if (c->data.process_mode == PROCESS_MODE_INHERIT) {
-			c->_propagate_process_owner(p_owner, p_pause_notification, p_enabled_notification);
+	for (Node *child : data.children) {
+		if (child->data.process_mode == PROCESS_MODE_INHERIT) {
+			child->_propagate_process_owner(p_owner, p_pause_notification, p_enabled_notification);
 		}
 	}
 	data.blocked--;
@@ -775,8 +789,8 @@ void Node::set_multiplayer_authority(int p_peer_id, bool p_recursive) {
 	data.multiplayer_authority = p_peer_id;
 
 	if (p_recursive) {
-		for (KeyValue<StringName, Node *> &K : data.children) {
-			K.value->set_multiplayer_authority(p_peer_id, true);
+		for (Node *child : data.children) {
+			child->set_multiplayer_authority(p_peer_id, true);
 		}
 	}
 }
@@ -796,10 +810,11 @@ bool Node::is_multiplayer_authority() const {
 
 void Node::rpc_config(const StringName &p_method, const Variant &p_config) {
 	ERR_THREAD_GUARD
-	if (data.rpc_config.get_type() != Variant::DICTIONARY) {
-		data.rpc_config = Dictionary();
+	Variant &config = _get_extra()->rpc_config;
+	if (config.get_type() != Variant::DICTIONARY) {
+		config = Dictionary();
 	}
-	Dictionary node_config = data.rpc_config;
+	Dictionary node_config = config;
 	if (p_config.get_type() == Variant::NIL) {
 		node_config.erase(p_method);
 	} else {
@@ -809,7 +824,7 @@ void Node::rpc_config(const StringName &p_method, const Variant &p_config) {
 }
 
 const Variant Node::get_node_rpc_config() const {
-	return data.rpc_config;
+	return data.extra ? data.extra->rpc_config : Variant();
 }
 
 /***** RPC FUNCTIONS ********/
@@ -1082,12 +1097,12 @@ void Node::_remove_tree_from_process_thread_group() {
 		return; // May not be initialized yet.
 	}
 
-	for (KeyValue<StringName, Node *> &K : data.children) {
-		if (K.value->data.process_thread_group != PROCESS_THREAD_GROUP_INHERIT) {
+	for (Node *child : data.children) {
+		if (child->data.process_thread_group != PROCESS_THREAD_GROUP_INHERIT) {
 			continue;
 		}
 
-		K.value->_remove_tree_from_process_thread_group();
+		child->_remove_tree_from_process_thread_group();
 	}
 
 	if (_is_any_processing()) {
@@ -1107,12 +1122,12 @@ void Node::_add_tree_to_process_thread_group(Node *p_owner) {
 		_add_to_process_thread_group();
 	}
 
-	for (KeyValue<StringName, Node *> &K : data.children) {
-		if (K.value->data.process_thread_group != PROCESS_THREAD_GROUP_INHERIT) {
+	for (Node *child : data.children) {
+		if (child->data.process_thread_group != PROCESS_THREAD_GROUP_INHERIT) {
 			continue;
 		}
 
-		K.value->_add_tree_to_process_thread_group(p_owner);
+		child->_add_tree_to_process_thread_group(p_owner);
 	}
 }
 bool Node::is_processing_internal() const {
@@ -1193,6 +1208,17 @@ int Node::get_physics_process_priority() const {
 
 void Node::set_process_thread_group(ProcessThreadGroup p_mode) {
 	ERR_FAIL_COND_MSG(data.tree && !Thread::is_main_thread(), "Changing the process thread group can only be done from the main thread. Use call_deferred(\"set_process_thread_group\",mode).");
+	if (data.process_thread_group_automatic) {
+		if (p_mode == PROCESS_THREAD_GROUP_INHERIT) {
+			return; // Already reported as inherited, keep the automatic group.
+		}
+		// An explicit mode takes over the automatic sub-thread group.
+		data.process_thread_group_automatic = false;
+	}
+	_set_process_thread_group(p_mode);
+}
+
+void Node::_set_process_thread_group(ProcessThreadGroup p_mode) {
 	if (data.process_thread_group == p_mode) {
 		return;
 	}
@@ -1223,11 +1249,77 @@ void Node::set_process_thread_group(ProcessThreadGroup p_mode) {
 
 	_add_tree_to_process_thread_group(data.process_thread_group_owner);
 
+	if (data.tree->is_using_automatic_process_thread_groups()) {
+		// Flagged nodes below may have gained or lost an ancestor running on a sub-thread.
+		_update_descendant_automatic_process_thread_groups();
+	}
+
 	notify_property_list_changed();
 }
 
+bool Node::_is_in_sub_thread_process_group() const {
+	// Groups can be nested, so look at every group owner up the tree.
+	const Node *owner = data.process_thread_group_owner;
+	while (owner) {
+		if (owner->data.process_thread_group == PROCESS_THREAD_GROUP_SUB_THREAD) {
+			return true;
+		}
+		owner = owner->data.parent ? owner->data.parent->data.process_thread_group_owner : nullptr;
+	}
+	return false;
+}
+
+bool Node::_wants_automatic_process_thread_group() const {
+	// Only the outermost flagged node gets a group, its subtree is already processed on a sub-thread.
+	return data.process_thread_auto_group && data.tree->is_using_automatic_process_thread_groups() && !(data.parent && data.parent->_is_in_sub_thread_process_group());
+}
+
+bool Node::_update_automatic_process_thread_group() {
+	bool wants = _wants_automatic_process_thread_group();
+	if (wants == data.process_thread_group_automatic) {
+		return false;
+	}
+
+	if (wants) {
+		if (data.process_thread_group != PROCESS_THREAD_GROUP_INHERIT) {
+			return false;
+		}
+		data.process_thread_group_automatic = true;
+		_set_process_thread_group(PROCESS_THREAD_GROUP_SUB_THREAD);
+	} else {
+		data.process_thread_group_automatic = false;
+		_set_process_thread_group(PROCESS_THREAD_GROUP_INHERIT);
+	}
+	return true;
+}
+
+void Node::_update_descendant_automatic_process_thread_groups() {
+	for (Node *child : data.children) {
+		// A child whose group changed already went through its own subtree.
+		if (!child->_update_automatic_process_thread_group()) {
+			child->_update_descendant_automatic_process_thread_groups();
+		}
+	}
+}
+
 Node::ProcessThreadGroup Node::get_process_thread_group() const {
-	return data.process_thread_group;
+	return data.process_thread_group_automatic ? PROCESS_THREAD_GROUP_INHERIT : data.process_thread_group;
+}
+
+void Node::set_process_thread_auto_group(bool p_enable) {
+	ERR_FAIL_COND_MSG(data.tree && !Thread::is_main_thread(), "Changing the automatic process thread group can only be done from the main thread. Use call_deferred(\"set_process_thread_auto_group\",enable).");
+	if (data.process_thread_auto_group == p_enable) {
+		return;
+	}
+	data.process_thread_auto_group = p_enable;
+
+	if (is_inside_tree()) {
+		_update_automatic_process_thread_group();
+	}
+}
+
+bool Node::is_process_thread_auto_group() const {
+	return data.process_thread_auto_group;
 }
 
 void Node::set_process_thread_messages(BitField<ProcessThreadMessages> p_flags) {
@@ -1406,8 +1498,7 @@ void Node::set_translation_domain_inherited() {
 }
 
 void Node::_propagate_translation_domain_dirty() {
-	for (KeyValue<StringName, Node *> &K : data.children) {
-		Node *child = K.value;
+	for (Node *child : data.children) {
 		if (child->data.is_translation_domain_inherited) {
 			child->data.is_translation_domain_dirty = true;
 			child->_propagate_translation_domain_dirty();
@@ -1436,6 +1527,9 @@ void Node::set_name(const StringName &p_name) {
 		_release_unique_name_in_owner();
 	}
 
+	// The parent's name index (if it has one) still holds the old name, it is swapped below.
+	AHashMap<StringName, Node *> *siblings_by_name = data.parent ? data.parent->_get_children_name_index() : nullptr;
+
 	{
 		const String input_name_str = String(p_name);
 		const String validated_node_name_string = input_name_str.validate_node_name();
@@ -1448,8 +1542,10 @@ void Node::set_name(const StringName &p_name) {
 
 	if (data.parent) {
 		data.parent->_validate_child_name(this, true);
-		bool success = data.parent->data.children.replace_key(old_name, data.name);
-		ERR_FAIL_COND_MSG(!success, "Renaming child in hashtable failed, this is a bug.");
+		if (siblings_by_name) {
+			bool success = siblings_by_name->replace_key(old_name, data.name);
+			ERR_FAIL_COND_MSG(!success, "Renaming child in hashtable failed, this is a bug.");
+		}
 	}
 
 	if (data.unique_name_in_owner && data.owner) {
@@ -1532,8 +1628,7 @@ void Node::_validate_child_name(Node *p_child, bool p_force_human_readable) {
 			//new unique name must be assigned
 			unique = false;
 		} else {
-			const Node *const *existing = data.children.getptr(p_child->data.name);
-			unique = !existing || *existing == p_child;
+			unique = !_is_child_name_taken(p_child->data.name, p_child);
 		}
 
 		if (!unique) {
@@ -1597,8 +1692,7 @@ void Node::_generate_serial_child_name(const Node *p_child, StringName &name) co
 		name = p_child->get_class();
 	}
 
-	const Node *const *existing = data.children.getptr(name);
-	if (!existing || *existing == p_child) { // Unused, or is current node.
+	if (!_is_child_name_taken(name, p_child)) { // Unused, or is current node.
 		return;
 	}
 
@@ -1627,10 +1721,7 @@ void Node::_generate_serial_child_name(const Node *p_child, StringName &name) co
 	for (;;) {
 		StringName attempt = name_string + nums;
 
-		existing = data.children.getptr(attempt);
-		bool exists = existing != nullptr && *existing != p_child;
-
-		if (!exists) {
+		if (!_is_child_name_taken(attempt, p_child)) {
 			name = attempt;
 			return;
 		} else {
@@ -1653,45 +1744,65 @@ void Node::_add_child_nocheck(Node *p_child, const StringName &p_name, InternalM
 	//add a child node quickly, without name validation
 
 	p_child->data.name = p_name;
-	data.children.insert(p_name, p_child);
+	_insert_child(p_child, p_internal_mode);
+	p_child->data.parent = this;
 
-	p_child->data.internal_mode = p_internal_mode;
+	p_child->notification(NOTIFICATION_PARENTED);
 
-	bool can_push_back = false;
-	switch (p_internal_mode) {
-		case INTERNAL_MODE_FRONT: {
-			p_child->data.index = data.internal_children_front_count_cache++;
-			// Safe to push back when ordinary and back children are empty.
-			can_push_back = (data.external_children_count_cache + data.internal_children_back_count_cache) == 0;
-		} break;
-		case INTERNAL_MODE_BACK: {
-			p_child->data.index = data.internal_children_back_count_cache++;
-			// Safe to push back when cache is valid.
-			can_push_back = true;
-		} break;
-		case INTERNAL_MODE_DISABLED: {
-			p_child->data.index = data.external_children_count_cache++;
-			// Safe to push back when back children are empty.
-			can_push_back = data.internal_children_back_count_cache == 0;
-		} break;
+	if (data.tree) {
+		p_child->_set_tree(data.tree);
 	}
 
-	p_child->data.parent = this;
+	/* Notify */
+	add_child_notify(p_child);
+	notification(NOTIFICATION_CHILD_ORDER_CHANGED);
+	emit_signal(SNAME("child_order_changed"));
+}
 
-	if (!data.children_cache_dirty && can_push_back) {
-		data.children_cache.push_back(p_child);
-	} else {
-		data.children_cache_dirty = true;
+void Node::_add_children(const LocalVector<Node *> &p_children) {
+	// Same as calling add_child() for each node, but the child containers grow once,
+	// the tree is entered in a single pass and the order change is notified once.
+	ERR_FAIL_COND_MSG(data.tree && !Thread::is_main_thread(), "Adding children to a node inside the SceneTree is only allowed from the main thread. Use call_deferred(\"add_child\",node).");
+	ERR_THREAD_GUARD
+	ERR_FAIL_COND_MSG(data.blocked > 0, "Parent node is busy setting up children, `add_child()` failed. Consider using `add_child.call_deferred(child)` instead.");
+
+	if (p_children.is_empty()) {
+		return;
 	}
 
-	p_child->notification(NOTIFICATION_PARENTED);
+	for (Node *child : p_children) {
+		ERR_FAIL_NULL(child);
+		ERR_FAIL_COND_MSG(child == this, vformat("Can't add child '%s' to itself.", child->get_name()));
+		ERR_FAIL_COND_MSG(child->data.parent, vformat("Can't add child '%s' to '%s', already has a parent '%s'.", child->get_name(), get_name(), child->data.parent->get_name()));
+	}
+
+	data.children.reserve(data.children.size() + p_children.size());
+
+	for (Node *child : p_children) {
+		_validate_child_name(child);
+
+		_insert_child(child, INTERNAL_MODE_DISABLED);
+		child->data.parent = this;
+
+		child->notification(NOTIFICATION_PARENTED);
+	}
 
 	if (data.tree) {
-		p_child->_set_tree(data.tree);
+		for (Node *child : p_children) {
+			child->data.tree = data.tree;
+			child->_propagate_enter_tree();
+		}
+		if (data.ready_notified) {
+			for (Node *child : p_children) {
+				child->_propagate_ready();
+			}
+		}
+		data.tree->tree_changed();
 	}
 
-	/* Notify */
-	add_child_notify(p_child);
+	for (Node *child : p_children) {
+		add_child_notify(child);
+	}
 	notification(NOTIFICATION_CHILD_ORDER_CHANGED);
 	emit_signal(SNAME("child_order_changed"));
 }
@@ -1728,7 +1839,6 @@ void Node::add_sibling(RequiredParam<Node> rp_sibling, bool p_force_readable_nam
 	ERR_FAIL_COND_MSG(data.parent->data.blocked > 0, "Parent node is busy setting up children, `add_sibling()` failed. Consider using `add_sibling.call_deferred(sibling)` instead.");
 
 	data.parent->add_child(p_sibling, p_force_readable_name, data.internal_mode);
-	data.parent->_update_children_cache();
 	data.parent->_move_child(p_sibling, get_index() + 1);
 }
 
@@ -1738,16 +1848,6 @@ void Node::remove_child(RequiredParam<Node> rp_child) {
 	ERR_FAIL_COND_MSG(data.blocked > 0, "Parent node is busy adding/removing children, `remove_child()` can't be called at this time. Consider using `remove_child.call_deferred(child)` instead.");
 	ERR_FAIL_COND(p_child->data.parent != this);
 
-	/**
-	 *  Do not change the data.internal_children*cache counters here.
-	 *  Because if nodes are re-added, the indices can remain
-	 *  greater-than-everything indices and children added remain
-	 *  properly ordered.
-	 *
-	 *  All children indices and counters will be updated next time the
-	 *  cache is re-generated.
-	 */
-
 	data.blocked++;
 	p_child->_set_tree(nullptr);
 
@@ -1756,9 +1856,7 @@ void Node::remove_child(RequiredParam<Node> rp_child) {
 
 	data.blocked--;
 
-	data.children_cache_dirty = true;
-	bool success = data.children.erase(p_child->data.name);
-	ERR_FAIL_COND_MSG(!success, "Children name does not match parent name in hashtable, this is a bug.");
+	_erase_child(p_child);
 
 	p_child->data.parent = nullptr;
 	p_child->data.index = -1;
@@ -1771,35 +1869,92 @@ void Node::remove_child(RequiredParam<Node> rp_child) {
 	}
 }
 
-void Node::_update_children_cache_impl() const {
-	// Assign children
-	data.children_cache.resize(data.children.size());
-	int idx = 0;
-	for (const KeyValue<StringName, Node *> &K : data.children) {
-		data.children_cache[idx] = K.value;
-		idx++;
-	}
-	// Sort them
-	data.children_cache.sort_custom<ComparatorByIndex>();
-	// Update indices
-	data.external_children_count_cache = 0;
-	data.internal_children_back_count_cache = 0;
-	data.internal_children_front_count_cache = 0;
-
-	for (uint32_t i = 0; i < data.children_cache.size(); i++) {
-		switch (data.children_cache[i]->data.internal_mode) {
-			case INTERNAL_MODE_DISABLED: {
-				data.children_cache[i]->data.index = data.external_children_count_cache++;
-			} break;
-			case INTERNAL_MODE_FRONT: {
-				data.children_cache[i]->data.index = data.internal_children_front_count_cache++;
-			} break;
-			case INTERNAL_MODE_BACK: {
-				data.children_cache[i]->data.index = data.internal_children_back_count_cache++;
-			} break;
+void Node::_insert_child(Node *p_child, InternalMode p_internal_mode) {
+	_update_children_indices();
+
+	p_child->data.internal_mode = p_internal_mode;
+	switch (p_internal_mode) {
+		case INTERNAL_MODE_FRONT: {
+			p_child->data.index = data.internal_children_front_count++;
+			data.children.insert(p_child->data.index, p_child);
+		} break;
+		case INTERNAL_MODE_DISABLED: {
+			p_child->data.index = data.external_children_count++;
+			data.children.insert(data.internal_children_front_count + p_child->data.index, p_child);
+		} break;
+		case INTERNAL_MODE_BACK: {
+			p_child->data.index = data.internal_children_back_count++;
+			data.children.push_back(p_child);
+		} break;
+	}
+
+	if (data.extra && !data.extra->children_by_name.is_empty()) {
+		data.extra->children_by_name.insert(p_child->data.name, p_child);
+	} else if (data.children.size() > CHILDREN_NAME_INDEX_THRESHOLD) {
+		// Built here rather than on lookup, so lookups never write to the node.
+		AHashMap<StringName, Node *> &children_by_name = _get_extra()->children_by_name;
+		children_by_name.reserve(data.children.size());
+		for (Node *child : data.children) {
+			children_by_name.insert(child->data.name, child);
+		}
+	}
+}
+
+void Node::_erase_child(Node *p_child) {
+	const int position = p_child->get_index();
+	ERR_FAIL_COND_MSG(position < 0 || data.children[position] != p_child, "Child index does not match its position in the parent, this is a bug.");
+	data.children.remove_at(position);
+
+	switch (p_child->data.internal_mode) {
+		case INTERNAL_MODE_FRONT: {
+			data.internal_children_front_count--;
+		} break;
+		case INTERNAL_MODE_DISABLED: {
+			data.external_children_count--;
+		} break;
+		case INTERNAL_MODE_BACK: {
+			data.internal_children_back_count--;
+		} break;
+	}
+
+	// Rather than touching every following sibling now, their indices are fixed
+	// on the next insertion or move. Until then get_index() looks them up.
+	data.children_index_dirty_from = MIN(data.children_index_dirty_from, (uint32_t)position);
+
+	if (data.extra && !data.extra->children_by_name.is_empty()) {
+		if (data.children.size() <= CHILDREN_NAME_INDEX_THRESHOLD / 2) {
+			data.extra->children_by_name.reset();
+		} else {
+			bool success = data.extra->children_by_name.erase(p_child->data.name);
+			ERR_FAIL_COND_MSG(!success, "Children name does not match parent name in hashtable, this is a bug.");
 		}
 	}
-	data.children_cache_dirty = false;
+}
+
+void Node::_update_children_indices() {
+	for (uint32_t i = data.children_index_dirty_from; i < data.children.size(); i++) {
+		Node *child = data.children[i];
+		if (child->data.internal_mode == INTERNAL_MODE_DISABLED) {
+			child->data.index = i - data.internal_children_front_count;
+		} else if (child->data.internal_mode == INTERNAL_MODE_BACK) {
+			child->data.index = i - data.internal_children_front_count - data.external_children_count;
+		} else {
+			child->data.index = i;
+		}
+	}
+	data.children_index_dirty_from = UINT32_MAX;
+}
+
+int Node::_find_child_index(const Node *p_child, int p_range_position) const {
+	// Removals only move children towards the front of their range, so the child
+	// is found at or before the position its outdated index points to.
+	int position = MIN(p_range_position + p_child->data.index, (int)data.children.size() - 1);
+	for (; position >= p_range_position; position--) {
+		if (data.children[position] == p_child) {
+			return position - p_range_position;
+		}
+	}
+	ERR_FAIL_V_MSG(-1, "Child is not found in its parent, this is a bug.");
 }
 
 template <bool p_include_internal>
@@ -1807,15 +1962,14 @@ Iterable<Node::ChildrenIterator> Node::iterate_children() const {
 	// The thread guard is omitted for performance reasons.
 	// ERR_THREAD_GUARD_V(Iterable<ChildrenIterator>(nullptr, nullptr));
 
-	_update_children_cache();
-	const uint32_t size = data.children_cache.size();
+	const uint32_t size = data.children.size();
 	// Might be null, but then size and internal counts are also 0.
-	Node **ptr = data.children_cache.ptr();
+	Node **ptr = const_cast<Node **>(data.children.ptr());
 
 	if constexpr (p_include_internal) {
 		return Iterable(ChildrenIterator(ptr), ChildrenIterator(ptr + size));
 	} else {
-		return Iterable(ChildrenIterator(ptr + data.internal_children_front_count_cache), ChildrenIterator(ptr + size - data.internal_children_back_count_cache));
+		return Iterable(ChildrenIterator(ptr + data.internal_children_front_count), ChildrenIterator(ptr + size - data.internal_children_back_count));
 	}
 }
 
@@ -1828,51 +1982,48 @@ int Node::get_child_count(bool p_include_internal) const {
 		return data.children.size();
 	}
 
-	_update_children_cache();
-	return data.children_cache.size() - data.internal_children_front_count_cache - data.internal_children_back_count_cache;
+	return data.children.size() - data.internal_children_front_count - data.internal_children_back_count;
 }
 
 Node *Node::get_child(int p_index, bool p_include_internal) const {
 	ERR_THREAD_GUARD_V(nullptr);
-	_update_children_cache();
 
 	if (p_include_internal) {
 		if (p_index < 0) {
-			p_index += data.children_cache.size();
+			p_index += data.children.size();
 		}
-		ERR_FAIL_INDEX_V(p_index, (int)data.children_cache.size(), nullptr);
-		return data.children_cache[p_index];
+		ERR_FAIL_INDEX_V(p_index, (int)data.children.size(), nullptr);
+		return data.children[p_index];
 	} else {
 		if (p_index < 0) {
-			p_index += (int)data.children_cache.size() - data.internal_children_front_count_cache - data.internal_children_back_count_cache;
+			p_index += (int)data.children.size() - data.internal_children_front_count - data.internal_children_back_count;
 		}
-		ERR_FAIL_INDEX_V(p_index, (int)data.children_cache.size() - data.internal_children_front_count_cache - data.internal_children_back_count_cache, nullptr);
-		p_index += data.internal_children_front_count_cache;
-		return data.children_cache[p_index];
+		ERR_FAIL_INDEX_V(p_index, (int)data.children.size() - data.internal_children_front_count - data.internal_children_back_count, nullptr);
+		p_index += data.internal_children_front_count;
+		return data.children[p_index];
 	}
 }
 
 TypedArray<Node> Node::get_children(bool p_include_internal) const {
 	ERR_THREAD_GUARD_V(TypedArray<Node>());
-	_update_children_cache();
 
 	TypedArray<Node> children;
 
 	if (p_include_internal) {
-		children.resize(data.children_cache.size());
+		children.resize(data.children.size());
 
 		Array::Iterator itr = children.begin();
-		for (const Node *child : data.children_cache) {
+		for (const Node *child : data.children) {
 			*itr = child;
 			++itr;
 		}
 	} else {
-		const int size = data.children_cache.size() - data.internal_children_back_count_cache;
-		children.resize(size - data.internal_children_front_count_cache);
+		const int size = data.children.size() - data.internal_children_back_count;
+		children.resize(size - data.internal_children_front_count);
 
 		Array::Iterator itr = children.begin();
-		for (int i = data.internal_children_front_count_cache; i < size; i++) {
-			*itr = data.children_cache[i];
+		for (int i = data.internal_children_front_count; i < size; i++) {
+			*itr = data.children[i];
 			++itr;
 		}
 	}
@@ -1880,13 +2031,51 @@ TypedArray<Node> Node::get_children(bool p_include_internal) const {
 	return children;
 }
 
-Node *Node::_get_child_by_name(const StringName &p_name) const {
-	const Node *const *node = data.children.getptr(p_name);
-	if (node) {
-		return const_cast<Node *>(*node);
-	} else {
+Node::ExtraData *Node::_get_extra() const {
+	if (unlikely(!data.extra)) {
+		data.extra = memnew(ExtraData);
+	}
+	return data.extra;
+}
+
+AHashMap<StringName, Node *> *Node::_get_children_name_index() const {
+	// Built by _insert_child() past the threshold, then kept in sync by _erase_child() and set_name().
+	if (!data.extra || data.extra->children_by_name.is_empty()) {
 		return nullptr;
 	}
+	return &data.extra->children_by_name;
+}
+
+Node *Node::_get_child_by_name(const StringName &p_name) const {
+	const AHashMap<StringName, Node *> *children_by_name = _get_children_name_index();
+	if (children_by_name) {
+		Node *const *node = children_by_name->getptr(p_name);
+		return node ? *node : nullptr;
+	}
+
+	for (Node *child : data.children) {
+		if (child->data.name == p_name) {
+			return child;
+		}
+	}
+	return nullptr;
+}
+
+bool Node::_is_child_name_taken(const StringName &p_name, const Node *p_child) const {
+	const AHashMap<StringName, Node *> *children_by_name = _get_children_name_index();
+	if (children_by_name) {
+		// While p_child is renamed, the index still holds it under its previous name.
+		Node *const *node = children_by_name->getptr(p_name);
+		return node && *node != p_child;
+	}
+
+	// p_child may already carry p_name while being renamed, so it must be skipped here.
+	for (const Node *child : data.children) {
+		if (child != p_child && child->data.name == p_name) {
+			return true;
+		}
+	}
+	return false;
 }
 
 Node *Node::get_node_or_null(const NodePath &p_path) const {
@@ -1928,20 +2117,17 @@ Node *Node::get_node_or_null(const NodePath &p_path) const {
 			}
 
 		} else if (name.is_node_unique_name()) {
-			Node **unique = current->data.owned_unique_nodes.getptr(name);
-			if (!unique && current->data.owner) {
-				unique = current->data.owner->data.owned_unique_nodes.getptr(name);
+			Node **unique = current->data.extra ? current->data.extra->owned_unique_nodes.getptr(name) : nullptr;
+			if (!unique && current->data.owner && current->data.owner->data.extra) {
+				unique = current->data.owner->data.extra->owned_unique_nodes.getptr(name);
 			}
 			if (!unique) {
 				return nullptr;
 			}
 			next = *unique;
 		} else {
-			next = nullptr;
-			const Node *const *node = current->data.children.getptr(name);
-			if (node) {
-				next = const_cast<Node *>(*node);
-			} else {
+			next = current->_get_child_by_name(name);
+			if (!next) {
 				return nullptr;
 			}
 		}
@@ -1977,9 +2163,8 @@ bool Node::has_node(const NodePath &p_path) const {
 Node *Node::find_child(const String &p_pattern, bool p_recursive, bool p_owned) const {
 	ERR_THREAD_GUARD_V(nullptr);
 	ERR_FAIL_COND_V(p_pattern.is_empty(), nullptr);
-	_update_children_cache();
-	Node *const *cptr = data.children_cache.ptr();
-	int ccount = data.children_cache.size();
+	Node *const *cptr = data.children.ptr();
+	int ccount = data.children.size();
 	for (int i = 0; i < ccount; i++) {
 		if (p_owned && !cptr[i]->data.owner) {
 			continue;
@@ -2007,9 +2192,8 @@ TypedArray<Node> Node::find_children(const String &p_pattern, const String &p_ty
 	ERR_THREAD_GUARD_V(TypedArray<Node>());
 	TypedArray<Node> ret;
 	ERR_FAIL_COND_V(p_pattern.is_empty() && p_type.is_empty(), ret);
-	_update_children_cache();
-	Node *const *cptr = data.children_cache.ptr();
-	int ccount = data.children_cache.size();
+	Node *const *cptr = data.children.ptr();
+	int ccount = data.children.size();
 	for (int i = 0; i < ccount; i++) {
 		if (p_owned && !cptr[i]->data.owner) {
 			continue;
@@ -2159,8 +2343,6 @@ bool Node::is_greater_than(RequiredParam<const Node> rp_node) const {
 	ERR_FAIL_COND_V(data.depth < 0, false);
 	ERR_FAIL_COND_V(p_node->data.depth < 0, false);
 
-	_update_children_cache();
-
 	bool this_is_deeper = this->data.depth > p_node->data.depth;
 
 	const Node *deep = this;
@@ -2191,8 +2373,8 @@ void Node::get_owned_by(Node *p_by, List<Node *> *p_owned) {
 		p_owned->push_back(this);
 	}
 
-	for (KeyValue<StringName, Node *> &K : data.children) {
-		K.value->get_owned_by(p_by, p_owned);
+	for (Node *child : data.children) {
+		child->get_owned_by(p_by, p_owned);
 	}
 }
 
@@ -2212,17 +2394,18 @@ void Node::_set_owner_nocheck(Node *p_owner) {
 void Node::_release_unique_name_in_owner() {
 	ERR_FAIL_NULL(data.owner); // Safety check.
 	StringName key = StringName(UNIQUE_NODE_PREFIX + data.name.operator String());
-	Node **which = data.owner->data.owned_unique_nodes.getptr(key);
+	Node **which = data.owner->data.extra ? data.owner->data.extra->owned_unique_nodes.getptr(key) : nullptr;
 	if (which == nullptr || *which != this) {
 		return; // Ignore.
 	}
-	data.owner->data.owned_unique_nodes.erase(key);
+	data.owner->data.extra->owned_unique_nodes.erase(key);
 }
 
 void Node::_acquire_unique_name_in_owner() {
 	ERR_FAIL_NULL(data.owner); // Safety check.
 	StringName key = StringName(UNIQUE_NODE_PREFIX + data.name.operator String());
-	Node **which = data.owner->data.owned_unique_nodes.getptr(key);
+	HashMap<StringName, Node *> &owned_unique_nodes = data.owner->_get_extra()->owned_unique_nodes;
+	Node **which = owned_unique_nodes.getptr(key);
 	if (which != nullptr && *which != this) {
 		String which_path = String(is_inside_tree() ? (*which)->get_path() : data.owner->get_path_to(*which));
 		WARN_PRINT(vformat("Setting node name '%s' to be unique within scene for '%s', but it's already claimed by '%s'.\n'%s' is no longer set as having a unique name.",
@@ -2230,7 +2413,7 @@ void Node::_acquire_unique_name_in_owner() {
 		data.unique_name_in_owner = false;
 		return;
 	}
-	data.owner->data.owned_unique_nodes[key] = this;
+	owned_unique_nodes[key] = this;
 }
 
 void Node::set_unique_name_in_owner(bool p_enabled) {
@@ -2536,11 +2719,10 @@ void Node::print_tree() {
 
 String Node::_get_tree_string_pretty(const String &p_prefix, bool p_last) {
 	String new_prefix = p_last ? String::utf8(" ┖╴") : String::utf8(" ┠╴");
-	_update_children_cache();
 	String return_tree = p_prefix + new_prefix + String(get_name()) + "\n";
-	for (uint32_t i = 0; i < data.children_cache.size(); i++) {
+	for (uint32_t i = 0; i < data.children.size(); i++) {
 		new_prefix = p_last ? String::utf8("   ") : String::utf8(" ┃ ");
-		return_tree += data.children_cache[i]->_get_tree_string_pretty(p_prefix + new_prefix, i == data.children_cache.size() - 1);
+		return_tree += data.children[i]->_get_tree_string_pretty(p_prefix + new_prefix, i == data.children.size() - 1);
 	}
 	return return_tree;
 }
@@ -2550,10 +2732,9 @@ String Node::get_tree_string_pretty() {
 }
 
 String Node::_get_tree_string(const Node *p_node) {
-	_update_children_cache();
 	String return_tree = String(p_node->get_path_to(this)) + "\n";
-	for (uint32_t i = 0; i < data.children_cache.size(); i++) {
-		return_tree += data.children_cache[i]->_get_tree_string(p_node);
+	for (uint32_t i = 0; i < data.children.size(); i++) {
+		return_tree += data.children[i]->_get_tree_string(p_node);
 	}
 	return return_tree;
 }
@@ -2567,8 +2748,8 @@ void Node::propagate_notification(int p_notification) {
 	data.blocked++;
 	notification(p_notification);
 
-	for (KeyValue<StringName, Node *> &K : data.children) {
-		K.value->propagate_notification(p_notification);
+	for (Node *child : data.children) {
+		child->propagate_notification(p_notification);
 	}
 	data.blocked--;
 }
@@ -2581,8 +2762,8 @@ void Node::propagate_call(const StringName &p_method, const Array &p_args, const
 		callv(p_method, p_args);
 	}
 
-	for (KeyValue<StringName, Node *> &K : data.children) {
-		K.value->propagate_call(p_method, p_args, p_parent_first);
+	for (Node *child : data.children) {
+		child->propagate_call(p_method, p_args, p_parent_first);
 	}
 
 	if (!p_parent_first && has_method(p_method)) {
@@ -2598,8 +2779,8 @@ void Node::_propagate_replace_owner(Node *p_owner, Node *p_by_owner) {
 	}
 
 	data.blocked++;
-	for (KeyValue<StringName, Node *> &K : data.children) {
-		K.value->_propagate_replace_owner(p_owner, p_by_owner);
+	for (Node *child : data.children) {
+		child->_propagate_replace_owner(p_owner, p_by_owner);
 	}
 	data.blocked--;
 }
@@ -2620,26 +2801,28 @@ RequiredResult<Tween> Node::create_tween() {
 
 void Node::set_scene_file_path(const String &p_scene_file_path) {
 	ERR_THREAD_GUARD
-	data.scene_file_path = p_scene_file_path;
+	if (data.extra || !p_scene_file_path.is_empty()) {
+		_get_extra()->scene_file_path = p_scene_file_path;
+	}
 	_emit_editor_state_changed();
 }
 
 String Node::get_scene_file_path() const {
-	return data.scene_file_path;
+	return data.extra ? data.extra->scene_file_path : String();
 }
 
 void Node::set_editor_description(const String &p_editor_description) {
 	ERR_THREAD_GUARD
-	if (data.editor_description == p_editor_description) {
+	if (get_editor_description() == p_editor_description) {
 		return;
 	}
 
-	data.editor_description = p_editor_description;
+	_get_extra()->editor_description = p_editor_description;
 	emit_signal(SNAME("editor_description_changed"), this);
 }
 
 String Node::get_editor_description() const {
-	return data.editor_description;
+	return data.extra ? data.extra->editor_description : String();
 }
 
 void Node::set_editable_instance(RequiredParam<Node> rp_node, bool p_editable) {
@@ -2737,21 +2920,25 @@ void Node::get_storable_properties(HashSet<StringName> &r_storable_properties) c
 
 void Node::set_scene_instance_state(const Ref<SceneState> &p_state) {
 	ERR_THREAD_GUARD
-	data.instance_state = p_state;
+	if (data.extra || p_state.is_valid()) {
+		_get_extra()->instance_state = p_state;
+	}
 }
 
 Ref<SceneState> Node::get_scene_instance_state() const {
-	return data.instance_state;
+	return data.extra ? data.extra->instance_state : Ref<SceneState>();
 }
 
 void Node::set_scene_inherited_state(const Ref<SceneState> &p_state) {
 	ERR_THREAD_GUARD
-	data.inherited_state = p_state;
+	if (data.extra || p_state.is_valid()) {
+		_get_extra()->inherited_state = p_state;
+	}
 	_emit_editor_state_changed();
 }
 
 Ref<SceneState> Node::get_scene_inherited_state() const {
-	return data.inherited_state;
+	return data.extra ? data.extra->inherited_state : Ref<SceneState>();
 }
 
 void Node::set_scene_instance_load_placeholder(bool p_enable) {
@@ -3479,8 +3666,8 @@ void Node::get_argument_options(const StringName &p_function, int p_idx, List<St
 
 void Node::clear_internal_tree_resource_paths() {
 	clear_internal_resource_paths();
-	for (KeyValue<StringName, Node *> &K : data.children) {
-		K.value->clear_internal_tree_resource_paths();
+	for (Node *child : data.children) {
+		child->clear_internal_tree_resource_paths();
 	}
 }
 
@@ -3579,7 +3766,7 @@ void Node::_call_unhandled_key_input(const Ref<InputEvent> &p_event) {
 }
 
 void Node::_validate_property(PropertyInfo &p_property) const {
-	if ((p_property.name == "process_thread_group_order" || p_property.name == "process_thread_messages") && data.process_thread_group == PROCESS_THREAD_GROUP_INHERIT) {
+	if ((p_property.name == "process_thread_group_order" || p_property.name == "process_thread_messages") && get_process_thread_group() == PROCESS_THREAD_GROUP_INHERIT) {
 		p_property.usage = 0;
 	}
 }
@@ -3793,6 +3980,8 @@ void Node::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("set_process_thread_group", "mode"), &Node::set_process_thread_group);
 	ClassDB::bind_method(D_METHOD("get_process_thread_group"), &Node::get_process_thread_group);
+	ClassDB::bind_method(D_METHOD("set_process_thread_auto_group", "enable"), &Node::set_process_thread_auto_group);
+	ClassDB::bind_method(D_METHOD("is_process_thread_auto_group"), &Node::is_process_thread_auto_group);
 
 	ClassDB::bind_method(D_METHOD("set_process_thread_messages", "flags"), &Node::set_process_thread_messages);
 	ClassDB::bind_method(D_METHOD("get_process_thread_messages"), &Node::get_process_thread_messages);
@@ -4017,6 +4206,7 @@ void Node::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_thread_group", PROPERTY_HINT_ENUM, "Inherit,Main Thread,Sub Thread"), "set_process_thread_group", "get_process_thread_group");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_thread_group_order"), "set_process_thread_group_order", "get_process_thread_group_order");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_thread_messages", PROPERTY_HINT_FLAGS, "Process,Physics Process"), "set_process_thread_messages", "get_process_thread_messages");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "process_thread_auto_group"), "set_process_thread_auto_group", "is_process_thread_auto_group");
 
 	ADD_GROUP("Physics Interpolation", "physics_interpolation_");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "physics_interpolation_mode", PROPERTY_HINT_ENUM, "Inherit,On,Off"), "set_physics_interpolation_mode", "get_physics_interpolation_mode");
@@ -4032,6 +4222,7 @@ void Node::_bind_methods() {
 	GDVIRTUAL_BIND(_enter_tree);
 	GDVIRTUAL_BIND(_exit_tree);
 	GDVIRTUAL_BIND(_ready);
+	GDVIRTUAL_BIND(_pool_reset);
 	GDVIRTUAL_BIND(_get_configuration_warnings);
 	GDVIRTUAL_BIND(_get_accessibility_configuration_warnings);
 	GDVIRTUAL_BIND(_input, "event");
@@ -4101,10 +4292,12 @@ Node::~Node() {
 	data.grouped.clear();
 	data.owned.clear();
 	data.children.clear();
-	data.children_cache.clear();
+	if (data.extra) {
+		memdelete(data.extra);
+		data.extra = nullptr;
+	}
 
 	ERR_FAIL_COND(data.parent);
-	ERR_FAIL_COND(data.children_cache.size());
 
 #ifdef DEBUG_ENABLED
 	total_node_count.decrement();
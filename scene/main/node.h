@@ -33,6 +33,7 @@
 #include "core/input/input_event.h"
 #include "core/io/resource.h"
 #include "core/string/node_path.h"
+#include "core/templates/a_hash_map.h"
 #include "core/templates/iterable.h"
 #include "core/variant/typed_array.h"
 #include "scene/main/scene_tree.h"
@@ -171,18 +172,6 @@ private:
 		SceneTree::Group *group = nullptr;
 	};
 
-	struct ComparatorByIndex {
-		bool operator()(const Node *p_left, const Node *p_right) const {
-			static const uint32_t order[3] = { 1, 0, 2 };
-			uint32_t order_left = order[p_left->data.internal_mode];
-			uint32_t order_right = order[p_right->data.internal_mode];
-			if (order_left == order_right) {
-				return p_left->data.index < p_right->data.index;
-			}
-			return order_left < order_right;
-		}
-	};
-
 	struct ComparatorWithPriority {
 		bool operator()(const Node *p_a, const Node *p_b) const { return p_b->data.process_priority == p_a->data.process_priority ? p_b->is_greater_than(p_a) : p_b->data.process_priority > p_a->data.process_priority; }
 	};
@@ -191,31 +180,36 @@ private:
 		bool operator()(const Node *p_a, const Node *p_b) const { return p_b->data.physics_process_priority == p_a->data.physics_process_priority ? p_b->is_greater_than(p_a) : p_b->data.physics_process_priority > p_a->data.physics_process_priority; }
 	};
 
-	// This Data struct is to avoid namespace pollution in derived classes.
-	struct Data {
+	// Fields most nodes never use, allocated on first write to keep Data small.
+	struct ExtraData {
 		String scene_file_path;
 		Ref<SceneState> instance_state;
 		Ref<SceneState> inherited_state;
+		String editor_description;
+		HashMap<StringName, Node *> owned_unique_nodes;
+		Variant rpc_config;
+		// Only built for nodes with many children, see _get_children_name_index().
+		AHashMap<StringName, Node *> children_by_name;
+	};
 
+	// This Data struct is to avoid namespace pollution in derived classes.
+	struct Data {
 		Node *parent = nullptr;
 		Node *owner = nullptr;
-		HashMap<StringName, Node *> children;
-		mutable bool children_cache_dirty = false;
-		mutable LocalVector<Node *> children_cache;
-		HashMap<StringName, Node *> owned_unique_nodes;
+		LocalVector<Node *> children; // In index order: internal front, external, then internal back.
+		mutable ExtraData *extra = nullptr;
 		bool unique_name_in_owner = false;
 		InternalMode internal_mode = INTERNAL_MODE_DISABLED;
-		mutable int internal_children_front_count_cache = 0;
-		mutable int internal_children_back_count_cache = 0;
-		mutable int external_children_count_cache = 0;
-		mutable int index = -1; // relative to front, normal or back.
+		int internal_children_front_count = 0;
+		int internal_children_back_count = 0;
+		int external_children_count = 0;
+		uint32_t children_index_dirty_from = UINT32_MAX; // Children from this position on may have an outdated index, see _erase_child().
+		int index = -1; // relative to front, normal or back.
 		int32_t depth = -1;
 		int blocked = 0; // Safeguard that throws an error when attempting to modify the tree in a harmful way while being traversed.
 		StringName name;
 		SceneTree *tree = nullptr;
 
-		String editor_description;
-
 		Viewport *viewport = nullptr;
 
 		mutable RID accessibility_element;
@@ -229,10 +223,11 @@ private:
 		Node *process_thread_group_owner = nullptr;
 		int process_thread_group_order = 0;
 		BitField<ProcessThreadMessages> process_thread_messages = {};
+		bool process_thread_auto_group = false; // Opted in to an automatic sub-thread group.
+		bool process_thread_group_automatic = false; // Sub-thread group assigned by the SceneTree, not by the user.
 		void *process_group = nullptr; // to avoid cyclic dependency
 
 		int multiplayer_authority = 1; // Server by default.
-		Variant rpc_config;
 
 		// Variables used to properly sort the node when processing, ignored otherwise.
 		int process_priority = 0;
@@ -297,7 +292,9 @@ private:
 	String _get_tree_string_pretty(const String &p_prefix, bool p_last);
 	String _get_tree_string(const Node *p_node);
 
+	AHashMap<StringName, Node *> *_get_children_name_index() const;
 	Node *_get_child_by_name(const StringName &p_name) const;
+	bool _is_child_name_taken(const StringName &p_name, const Node *p_child) const;
 
 	void _replace_connections_target(Node *p_new_target);
 
@@ -339,13 +336,7 @@ private:
 
 	void _clean_up_owner();
 
-	_FORCE_INLINE_ void _update_children_cache() const {
-		if (unlikely(data.children_cache_dirty)) {
-			_update_children_cache_impl();
-		}
-	}
-
-	void _update_children_cache_impl() const;
+	ExtraData *_get_extra() const;
 
 	// Process group management
 	void _add_process_group();
@@ -354,6 +345,11 @@ private:
 	void _remove_from_process_thread_group();
 	void _remove_tree_from_process_thread_group();
 	void _add_tree_to_process_thread_group(Node *p_owner);
+	void _set_process_thread_group(ProcessThreadGroup p_mode);
+	bool _is_in_sub_thread_process_group() const;
+	bool _wants_automatic_process_thread_group() const;
+	bool _update_automatic_process_thread_group();
+	void _update_descendant_automatic_process_thread_groups();
 
 	static thread_local Node *current_process_thread_group;
 
@@ -386,8 +382,15 @@ protected:
 	static String _get_name_num_separator();
 
 	friend class SceneState;
+	friend class PackedScene;
+	friend class ScenePool;
 
 	void _add_child_nocheck(Node *p_child, const StringName &p_name, InternalMode p_internal_mode = INTERNAL_MODE_DISABLED);
+	void _insert_child(Node *p_child, InternalMode p_internal_mode);
+	void _erase_child(Node *p_child);
+	void _update_children_indices();
+	int _find_child_index(const Node *p_child, int p_range_position) const;
+	void _add_children(const LocalVector<Node *> &p_children);
 	void _set_owner_nocheck(Node *p_owner);
 	void _set_name_nocheck(const StringName &p_name);
 
@@ -427,6 +430,7 @@ protected:
 	GDVIRTUAL0(_enter_tree)
 	GDVIRTUAL0(_exit_tree)
 	GDVIRTUAL0(_ready)
+	GDVIRTUAL0(_pool_reset)
 	GDVIRTUAL0RC(Vector<String>, _get_accessibility_configuration_warnings)
 	GDVIRTUAL0RC(Vector<String>, _get_configuration_warnings)
 
@@ -586,24 +590,23 @@ public:
 		if (!data.parent) {
 			return data.index;
 		}
-		data.parent->_update_children_cache();
-
-		if (!p_include_internal) {
-			return data.index;
-		} else {
-			switch (data.internal_mode) {
-				case INTERNAL_MODE_DISABLED: {
-					return data.parent->data.internal_children_front_count_cache + data.index;
-				} break;
-				case INTERNAL_MODE_FRONT: {
-					return data.index;
-				} break;
-				case INTERNAL_MODE_BACK: {
-					return data.parent->data.internal_children_front_count_cache + data.parent->data.external_children_count_cache + data.index;
-				} break;
-			}
-			return -1;
+		int range_position = 0;
+		switch (data.internal_mode) {
+			case INTERNAL_MODE_DISABLED: {
+				range_position = data.parent->data.internal_children_front_count;
+			} break;
+			case INTERNAL_MODE_FRONT: {
+				range_position = 0;
+			} break;
+			case INTERNAL_MODE_BACK: {
+				range_position = data.parent->data.internal_children_front_count + data.parent->data.external_children_count;
+			} break;
 		}
+		int index = data.index;
+		if (unlikely((uint32_t)(range_position + index) >= data.parent->data.children_index_dirty_from)) {
+			index = data.parent->_find_child_index(this, range_position);
+		}
+		return p_include_internal ? range_position + index : index;
 	}
 
 	RequiredResult<Tween> create_tween();
@@ -761,6 +764,9 @@ public:
 	void set_process_thread_group(ProcessThreadGroup p_mode);
 	ProcessThreadGroup get_process_thread_group() const;
 
+	void set_process_thread_auto_group(bool p_enable);
+	bool is_process_thread_auto_group() const;
+
 	static void print_orphan_nodes();
 	static TypedArray<int> get_orphan_node_ids();
 
@@ -856,7 +862,7 @@ public:
 
 	/* HELPER */
 
-	bool is_instance() const { return !data.scene_file_path.is_empty(); }
+	bool is_instance() const { return data.extra && !data.extra->scene_file_path.is_empty(); }
 
 	// These inherited functions need proper multithread locking when overridden in Node.
 #ifdef DEBUG_ENABLED
@@ -193,6 +193,20 @@ void SceneTree::remove_from_group(const StringName &p_group, Node *p_node) {
 void SceneTree::flush_transform_notifications() {
 	_THREAD_SAFE_METHOD_
 
+#ifndef _3D_DISABLED
+	if (batch_global_transform_updates && xform_change_list.first()) {
+		LocalVector<Node3D *> node3ds;
+		for (SelfList<Node> *n = xform_change_list.first(); n; n = n->next()) {
+			Node3D *node3d = Object::cast_to<Node3D>(n->self());
+			if (node3d) {
+				node3ds.push_back(node3d);
+			}
+		}
+		// Notifications below then only read up to date global transforms.
+		Node3D::update_global_transforms(node3ds);
+	}
+#endif // _3D_DISABLED
+
 	SelfList<Node> *n = xform_change_list.first();
 	while (n) {
 		Node *node = n->self();
@@ -1155,10 +1169,14 @@ void SceneTree::_process_group(ProcessGroup *p_group, bool p_physics) {
 	p_group->call_queue.flush(); // Flush messages before processing.
 
 	Vector<Node *> &nodes = p_physics ? p_group->physics_nodes : p_group->nodes;
+	uint64_t &process_usec = p_physics ? p_group->physics_process_usec : p_group->process_usec;
 	if (nodes.is_empty()) {
+		process_usec = 0;
 		return;
 	}
 
+	const uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+
 	if (p_physics) {
 		if (p_group->physics_node_order_dirty) {
 			nodes.sort_custom<Node::ComparatorWithPhysicsPriority>();
@@ -1207,6 +1225,8 @@ void SceneTree::_process_group(ProcessGroup *p_group, bool p_physics) {
 	}
 
 	p_group->call_queue.flush(); // Flush messages also after processing (for potential deferred calls).
+
+	process_usec = OS::get_singleton()->get_ticks_usec() - begin_usec;
 }
 
 void SceneTree::_process_groups_thread(uint32_t p_index, bool p_physics) {
@@ -1891,6 +1911,7 @@ void SceneTree::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_processed_tweens"), &SceneTree::get_processed_tweens);
 
 	ClassDB::bind_method(D_METHOD("get_node_count"), &SceneTree::get_node_count);
+	ClassDB::bind_method(D_METHOD("get_process_group_stats"), &SceneTree::get_process_group_stats);
 	ClassDB::bind_method(D_METHOD("get_frame"), &SceneTree::get_frame);
 	ClassDB::bind_method(D_METHOD("quit", "exit_code"), &SceneTree::quit, DEFVAL(EXIT_SUCCESS));
 
@@ -2017,10 +2038,50 @@ void SceneTree::get_argument_options(const StringName &p_function, int p_idx, Li
 }
 #endif
 
+TypedArray<Dictionary> SceneTree::get_process_group_stats() const {
+	_THREAD_SAFE_METHOD_
+	TypedArray<Dictionary> ret;
+
+	auto add_group = [&ret](const ProcessGroup *p_group) {
+		Dictionary stats;
+		Node *owner = p_group->owner;
+		stats["owner"] = owner;
+		stats["threaded"] = owner && owner->data.process_thread_group == Node::PROCESS_THREAD_GROUP_SUB_THREAD;
+		stats["automatic"] = owner && owner->data.process_thread_group_automatic;
+		stats["order"] = owner ? owner->data.process_thread_group_order : 0;
+		stats["process_nodes"] = p_group->nodes.size();
+		stats["physics_process_nodes"] = p_group->physics_nodes.size();
+		stats["process_usec"] = p_group->process_usec;
+		stats["physics_process_usec"] = p_group->physics_process_usec;
+		ret.push_back(stats);
+	};
+
+	// The default group (without owner) is part of this list too.
+	for (const ProcessGroup *pg : process_groups) {
+		if (!pg->removed) {
+			add_group(pg);
+		}
+	}
+
+	return ret;
+}
+
 void SceneTree::set_disable_node_threading(bool p_disable) {
 	node_threading_disabled = p_disable;
 }
 
+void SceneTree::set_use_automatic_process_thread_groups(bool p_enable) {
+	if (automatic_process_thread_groups == p_enable) {
+		return;
+	}
+	automatic_process_thread_groups = p_enable;
+
+	if (root) {
+		// Assign or revert the groups of the flagged nodes already in the tree.
+		root->_update_descendant_automatic_process_thread_groups();
+	}
+}
+
 SceneTree::SceneTree() {
 	if (singleton == nullptr) {
 		singleton = this;
@@ -2033,6 +2094,8 @@ SceneTree::SceneTree() {
 	accessibility_upd_per_sec = GLOBAL_GET(SNAME("accessibility/general/updates_per_second"));
 
 	GLOBAL_DEF("debug/shapes/collision/draw_2d_outlines", true);
+	batch_global_transform_updates = GLOBAL_DEF("rendering/3d/transforms/batch_global_transform_updates", false);
+	automatic_process_thread_groups = GLOBAL_DEF("application/run/automatic_process_thread_groups", false) && !Engine::get_singleton()->is_editor_hint();
 
 	process_group_call_queue_allocator = memnew(CallQueue::Allocator(64));
 	Math::randomize();
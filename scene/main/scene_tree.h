@@ -103,6 +103,8 @@ private:
 		bool removed = false;
 		Node *owner = nullptr;
 		uint64_t last_pass = 0;
+		uint64_t process_usec = 0;
+		uint64_t physics_process_usec = 0;
 	};
 
 	struct ProcessGroupSort {
@@ -119,6 +121,7 @@ private:
 	ProcessGroup default_process_group;
 
 	bool node_threading_disabled = false;
+	bool automatic_process_thread_groups = false;
 
 	struct Group {
 		Vector<Node *> nodes;
@@ -258,6 +261,7 @@ private:
 	friend class Viewport;
 
 	SelfList<Node>::List xform_change_list;
+	bool batch_global_transform_updates = false;
 
 #ifdef DEBUG_ENABLED // No live editor in release build.
 	friend class LiveEditor;
@@ -334,6 +338,8 @@ public:
 	}
 
 	void flush_transform_notifications();
+	void set_batch_global_transform_updates(bool p_enabled) { batch_global_transform_updates = p_enabled; }
+	bool is_batching_global_transform_updates() const { return batch_global_transform_updates; }
 
 	bool is_accessibility_enabled() const;
 	bool is_accessibility_supported() const;
@@ -455,6 +461,9 @@ public:
 	static void add_idle_callback(IdleCallback p_callback);
 
 	void set_disable_node_threading(bool p_disable);
+	void set_use_automatic_process_thread_groups(bool p_enable);
+	_FORCE_INLINE_ bool is_using_automatic_process_thread_groups() const { return automatic_process_thread_groups; }
+	TypedArray<Dictionary> get_process_group_stats() const;
 	//default texture settings
 
 	void set_physics_interpolation_enabled(bool p_enabled);
@@ -144,6 +144,7 @@
 #include "scene/resources/placeholder_textures.h"
 #include "scene/resources/portable_compressed_texture.h"
 #include "scene/resources/resource_format_text.h"
+#include "scene/resources/scene_pool.h"
 #include "scene/resources/shader_include.h"
 #include "scene/resources/skeleton_profile.h"
 #include "scene/resources/sky.h"
@@ -1195,6 +1196,7 @@ void register_scene_types() {
 
 	GDREGISTER_ABSTRACT_CLASS(SceneState);
 	GDREGISTER_CLASS(PackedScene);
+	GDREGISTER_ABSTRACT_CLASS(ScenePool);
 
 	GDREGISTER_CLASS(SceneTree);
 	GDREGISTER_ABSTRACT_CLASS(SceneTreeTimer); // sorry, you can't create it
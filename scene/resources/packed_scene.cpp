@@ -42,6 +42,7 @@
 #include "scene/main/instance_placeholder.h"
 #include "scene/main/missing_node.h"
 #include "scene/property_utils.h"
+#include "scene/resources/scene_pool.h"
 
 #ifndef _3D_DISABLED
 #include "scene/3d/node_3d.h"
@@ -150,6 +151,76 @@ static Node *_find_node_by_id(Node *p_owner, Node *p_node, int32_t p_id) {
 	return nullptr;
 }
 
+const SceneState::InstantiationPlan &SceneState::_get_instantiation_plan() const {
+	if (instantiation_plan_built.is_set()) {
+		return instantiation_plan;
+	}
+
+	MutexLock lock(instantiation_plan_mutex);
+	if (instantiation_plan_built.is_set()) {
+		return instantiation_plan;
+	}
+
+	InstantiationPlan &plan = instantiation_plan;
+	const int nc = nodes.size();
+	const int sname_count = names.size();
+
+	plan.child_counts.resize_initialized(nc);
+	plan.setter_offsets.resize(nc + 1);
+	plan.setters.clear();
+
+	for (int i = 0; i < nc; i++) {
+		const NodeData &n = nodes[i];
+		plan.setter_offsets[i] = plan.setters.size();
+
+		if (i > 0 && n.parent >= 0 && n.parent < nc) {
+			plan.child_counts[n.parent]++;
+		}
+
+		// Only nodes of built-in classes created here have setters known in advance,
+		// anything coming from a sub-scene, a script or an extension goes through Object::set().
+		bool resolve = n.instance < 0 && n.type != TYPE_INSTANTIATED && n.type < sname_count && !(i == 0 && base_scene_idx >= 0);
+		if (resolve) {
+			ClassDB::APIType api = ClassDB::get_api_type(names[n.type]);
+			resolve = api == ClassDB::API_CORE || api == ClassDB::API_EDITOR;
+		}
+
+		for (const NodeData::Property &prop : n.properties) {
+			InstantiationPlan::Setter setter;
+			if (resolve && !(prop.name & FLAG_PATH_PROPERTY_IS_NODE) && prop.name < sname_count && names[prop.name] != CoreStringName(script)) {
+				setter.method = ClassDB::get_property_setter_bind(names[n.type], names[prop.name], &setter.index);
+			}
+			plan.setters.push_back(setter);
+		}
+	}
+	plan.setter_offsets[nc] = plan.setters.size();
+
+	instantiation_plan_built.set();
+	return plan;
+}
+
+void SceneState::_clear_instantiation_plan() {
+	MutexLock lock(instantiation_plan_mutex);
+	instantiation_plan_built.clear();
+	instantiation_plan.child_counts.clear();
+	instantiation_plan.setter_offsets.clear();
+	instantiation_plan.setters.clear();
+}
+
+static void _call_property_setter(Object *p_object, MethodBind *p_setter, int p_index, const Variant &p_value, bool &r_valid) {
+	// Same call ClassDB::set_property() would make once Object::set() found no script or extension override.
+	Callable::CallError ce;
+	if (p_index >= 0) {
+		Variant index = p_index;
+		const Variant *args[2] = { &index, &p_value };
+		p_setter->call(p_object, args, 2, ce);
+	} else {
+		const Variant *args[1] = { &p_value };
+		p_setter->call(p_object, args, 1, ce);
+	}
+	r_valid = ce.error == Callable::CallError::CALL_OK;
+}
+
 Node *SceneState::instantiate(GenEditState p_edit_state) const {
 	// Nodes where instantiation failed (because something is missing.)
 	List<Node *> stray_instances;
@@ -191,6 +262,12 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 
 	bool gen_node_path_cache = p_edit_state != GEN_EDIT_STATE_DISABLED && node_path_cache.is_empty();
 
+	// The editor inspects and records every property set, so only plain runtime instantiation uses the plan.
+	const InstantiationPlan *plan = nullptr;
+	if (p_edit_state == GEN_EDIT_STATE_DISABLED && !Engine::get_singleton()->is_editor_hint()) {
+		plan = &_get_instantiation_plan();
+	}
+
 	HashMap<Node *, HashMap<Ref<Resource>, Ref<Resource>>> resources_local_to_scenes; // Record the mappings in sub-scenes.
 
 	LocalVector<DeferredNodePathProperties> deferred_node_paths;
@@ -350,6 +427,10 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 					node = Object::cast_to<Node>(obj);
 				}
 			}
+
+			if (plan && plan->child_counts[i] > 0) {
+				node->data.children.reserve(plan->child_counts[i]);
+			}
 		}
 
 		if (node) {
@@ -489,7 +570,12 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 						}
 
 						if (set_valid) {
-							node->set(snames[nprops[j].name], value, &valid);
+							const InstantiationPlan::Setter *setter = plan ? &plan->setters[plan->setter_offsets[i] + j] : nullptr;
+							if (setter && setter->method && !node->get_script_instance() && node->get_class_name() == snames[n.type]) {
+								_call_property_setter(node, setter->method, setter->index, value, valid);
+							} else {
+								node->set(snames[nprops[j].name], value, &valid);
+							}
 						}
 						if (p_edit_state == GEN_EDIT_STATE_INSTANCE && value.get_type() != Variant::OBJECT) {
 							value = value.duplicate(true); // Duplicate arrays and dictionaries for the editor.
@@ -1433,6 +1519,7 @@ String SceneState::get_path() const {
 }
 
 void SceneState::clear() {
+	_clear_instantiation_plan();
 	names.clear();
 	variants.clear();
 	nodes.clear();
@@ -1667,6 +1754,8 @@ void SceneState::set_bundled_scene(const Dictionary &p_dictionary) {
 
 	ERR_FAIL_COND_MSG(version > PACKED_SCENE_VERSION, "Save format version too new.");
 
+	_clear_instantiation_plan();
+
 	const int node_count = p_dictionary["node_count"];
 	const Vector<int> snodes = p_dictionary["nodes"];
 	ERR_FAIL_COND(snodes.size() < node_count);
@@ -2311,6 +2400,8 @@ int SceneState::add_node_path(const NodePath &p_path, const PackedInt32Array &p_
 }
 
 int SceneState::add_node(int p_parent, int p_owner, int p_type, int p_name, int p_instance, int p_index, int32_t p_unique_id) {
+	_clear_instantiation_plan();
+
 	NodeData nd;
 	nd.parent = p_parent;
 	nd.owner = p_owner;
@@ -2331,6 +2422,8 @@ void SceneState::add_node_property(int p_node, int p_name, int p_value, bool p_d
 	ERR_FAIL_INDEX(p_name, names.size());
 	ERR_FAIL_INDEX(p_value, variants.size());
 
+	_clear_instantiation_plan();
+
 	NodeData::Property prop;
 	prop.name = p_name;
 	if (p_deferred_node_path) {
@@ -2348,6 +2441,7 @@ void SceneState::add_node_group(int p_node, int p_group) {
 
 void SceneState::set_base_scene(int p_idx) {
 	ERR_FAIL_INDEX(p_idx, variants.size());
+	_clear_instantiation_plan();
 	base_scene_idx = p_idx;
 }
 
@@ -2525,6 +2619,44 @@ Node *PackedScene::instantiate(GenEditState p_edit_state) const {
 	return s;
 }
 
+TypedArray<Node> PackedScene::instantiate_many(int p_count, Node *p_parent, GenEditState p_edit_state) const {
+	ERR_FAIL_COND_V(p_count < 0, TypedArray<Node>());
+
+	LocalVector<Node *> instances;
+	instances.reserve(p_count);
+	for (int i = 0; i < p_count; i++) {
+		Node *instance = instantiate(p_edit_state);
+		if (!instance) {
+			for (Node *E : instances) {
+				memdelete(E);
+			}
+			ERR_FAIL_V_MSG(TypedArray<Node>(), vformat("Failed to instantiate scene \"%s\" %d times.", get_path(), p_count));
+		}
+		instances.push_back(instance);
+	}
+
+	if (p_parent) {
+		p_parent->_add_children(instances);
+	}
+
+	TypedArray<Node> ret;
+	ret.resize(instances.size());
+	for (uint32_t i = 0; i < instances.size(); i++) {
+		ret[i] = instances[i];
+	}
+	return ret;
+}
+
+Ref<ScenePool> PackedScene::create_pool(int p_prewarm) const {
+	ERR_FAIL_COND_V(p_prewarm < 0, Ref<ScenePool>());
+
+	Ref<ScenePool> pool;
+	pool.instantiate();
+	pool->setup(Ref<PackedScene>(this));
+	pool->prewarm(p_prewarm);
+	return pool;
+}
+
 void PackedScene::replace_state(Ref<SceneState> p_by) {
 	state = p_by;
 	state->set_path(get_path());
@@ -2611,6 +2743,8 @@ void PackedScene::reset_state() {
 void PackedScene::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("pack", "path"), &PackedScene::pack);
 	ClassDB::bind_method(D_METHOD("instantiate", "edit_state"), &PackedScene::instantiate, DEFVAL(GEN_EDIT_STATE_DISABLED));
+	ClassDB::bind_method(D_METHOD("instantiate_many", "count", "parent", "edit_state"), &PackedScene::instantiate_many, DEFVAL(Variant()), DEFVAL(GEN_EDIT_STATE_DISABLED));
+	ClassDB::bind_method(D_METHOD("create_pool", "prewarm"), &PackedScene::create_pool, DEFVAL(0));
 	ClassDB::bind_method(D_METHOD("can_instantiate"), &PackedScene::can_instantiate);
 	ClassDB::bind_method(D_METHOD("_set_bundled_scene", "scene"), &PackedScene::_set_bundled_scene);
 	ClassDB::bind_method(D_METHOD("_get_bundled_scene"), &PackedScene::_get_bundled_scene);
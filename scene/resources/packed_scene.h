@@ -31,6 +31,9 @@
 #pragma once
 
 #include "core/io/resource.h"
+#include "core/os/mutex.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 #include "scene/main/node.h"
 
 class SceneState : public RefCounted {
@@ -90,6 +93,26 @@ class SceneState : public RefCounted {
 
 	Vector<ConnectionData> connections;
 
+	// Compiled once per state so repeated instantiation skips the per-property
+	// class lookups and grows child containers only once.
+	struct InstantiationPlan {
+		struct Setter {
+			MethodBind *method = nullptr;
+			int index = -1;
+		};
+
+		LocalVector<uint32_t> child_counts;
+		LocalVector<uint32_t> setter_offsets;
+		LocalVector<Setter> setters;
+	};
+
+	mutable InstantiationPlan instantiation_plan;
+	mutable SafeFlag instantiation_plan_built;
+	mutable Mutex instantiation_plan_mutex;
+
+	const InstantiationPlan &_get_instantiation_plan() const;
+	void _clear_instantiation_plan();
+
 	Error _parse_node(Node *p_owner, Node *p_node, int p_parent_idx, HashMap<StringName, int> &name_map, HashMap<Variant, int> &variant_map, HashMap<Node *, int> &node_map, HashMap<Node *, int> &nodepath_map, HashSet<int32_t> &ids_saved);
 	Error _parse_connections(Node *p_owner, Node *p_node, HashMap<StringName, int> &name_map, HashMap<Variant, int> &variant_map, HashMap<Node *, int> &node_map, HashMap<Node *, int> &nodepath_map);
 
@@ -241,6 +264,8 @@ public:
 
 VARIANT_ENUM_CAST(SceneState::GenEditState)
 
+class ScenePool;
+
 class PackedScene : public Resource {
 	GDCLASS(PackedScene, Resource);
 	RES_BASE_EXTENSION("scn");
@@ -269,6 +294,8 @@ public:
 
 	bool can_instantiate() const;
 	Node *instantiate(GenEditState p_edit_state = GEN_EDIT_STATE_DISABLED) const;
+	TypedArray<Node> instantiate_many(int p_count, Node *p_parent = nullptr, GenEditState p_edit_state = GEN_EDIT_STATE_DISABLED) const;
+	Ref<ScenePool> create_pool(int p_prewarm = 0) const;
 
 	void recreate_state();
 	void replace_state(Ref<SceneState> p_by);
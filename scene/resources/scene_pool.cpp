@@ -0,0 +1,448 @@
+/**************************************************************************/
+/*  scene_pool.cpp                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "scene_pool.h"
+
+#include "core/os/os.h"
+#include "core/templates/hash_set.h"
+#include "scene/scene_string_names.h"
+
+void ScenePool::_add_reset_properties(const Ref<SceneState> &p_state, const String &p_prefix, HashMap<String, uint32_t> &r_node_map) {
+	ERR_FAIL_COND(p_state.is_null());
+
+	for (int i = 0; i < p_state->get_node_count(); i++) {
+		String path = String(p_state->get_node_path(i));
+		if (path == ".") {
+			path = p_prefix;
+		} else {
+			path = path.trim_prefix("./");
+			if (!p_prefix.is_empty()) {
+				path = p_prefix + "/" + path;
+			}
+		}
+
+		// Sub-scenes (and the inherited scene for the root) apply their own values first.
+		Ref<PackedScene> sub_scene = p_state->get_node_instance(i);
+		if (sub_scene.is_valid()) {
+			_add_reset_properties(sub_scene->get_state(), path, r_node_map);
+		}
+
+		uint32_t node;
+		HashMap<String, uint32_t>::ConstIterator E = r_node_map.find(path);
+		if (E) {
+			node = E->value;
+		} else {
+			node = reset_node_paths.size();
+			reset_node_paths.push_back(path.is_empty() ? NodePath(".") : NodePath(path));
+			r_node_map.insert(path, node);
+		}
+
+		const Vector<String> deferred_node_paths = p_state->get_node_deferred_nodepath_properties(i);
+		for (int j = 0; j < p_state->get_node_property_count(i); j++) {
+			StringName name = p_state->get_node_property_name(i, j);
+			if (name == CoreStringName(script) || deferred_node_paths.has(name)) {
+				// Nodes are reused along with their instance, so references between them stay valid.
+				continue;
+			}
+
+			Variant value = p_state->get_node_property_value(i, j);
+			Ref<Resource> res = value;
+			if (res.is_valid() && res->is_local_to_scene()) {
+				// Each instance keeps the copy it got when it was instantiated.
+				continue;
+			}
+
+			ResetProperty property;
+			property.node = node;
+			property.name = name;
+			property.value = value;
+			reset_properties.push_back(property);
+		}
+	}
+}
+
+void ScenePool::_capture_default_properties(Node *p_root) {
+	LocalVector<HashSet<StringName>> stored_names;
+	stored_names.resize(reset_node_paths.size());
+	for (const ResetProperty &property : reset_properties) {
+		stored_names[property.node].insert(property.name);
+	}
+
+	for (uint32_t i = 0; i < reset_node_paths.size(); i++) {
+		Node *node = p_root->get_node_or_null(reset_node_paths[i]);
+		if (!node) {
+			continue;
+		}
+
+		List<PropertyInfo> property_list;
+		node->get_property_list(&property_list);
+		for (const PropertyInfo &pi : property_list) {
+			if (!(pi.usage & PROPERTY_USAGE_STORAGE) || (pi.usage & (PROPERTY_USAGE_CATEGORY | PROPERTY_USAGE_GROUP | PROPERTY_USAGE_SUBGROUP))) {
+				continue;
+			}
+			if (pi.name == CoreStringName(script) || stored_names[i].has(pi.name)) {
+				continue;
+			}
+
+			Variant value = node->get(pi.name);
+			if (value.get_type() == Variant::OBJECT && value.get_validated_object() != nullptr) {
+				// Objects created by the node itself belong to this instance and can't be shared with the others.
+				continue;
+			}
+
+			ResetProperty property;
+			property.node = i;
+			property.name = pi.name;
+			property.value = value;
+			default_properties.push_back(property);
+		}
+	}
+}
+
+Node *ScenePool::_create_instance() {
+	ERR_FAIL_COND_V(scene.is_null(), nullptr);
+
+	Node *root = scene->instantiate();
+	ERR_FAIL_NULL_V(root, nullptr);
+
+	if (!default_properties_captured) {
+		// Nothing has touched a freshly instantiated scene yet.
+		_capture_default_properties(root);
+		default_properties_captured = true;
+	}
+
+	if (instances.size() >= sweep_instance_count) {
+		_erase_freed_instances();
+		sweep_instance_count = MAX(sweep_instance_count, instances.size() * 2);
+	}
+
+	Instance instance;
+	instance.nodes.resize(reset_node_paths.size());
+	for (uint32_t i = 0; i < reset_node_paths.size(); i++) {
+		Node *node = root->get_node_or_null(reset_node_paths[i]);
+		instance.nodes[i] = node ? node->get_instance_id() : ObjectID();
+	}
+	ObjectID id = root->get_instance_id();
+	instances.insert(id, instance);
+	_capture_instance_state(id);
+
+	// What the nodes set up in _ready() is part of the state they are reused in.
+	root->connect(SceneStringName(ready), callable_mp(this, &ScenePool::_capture_instance_state).bind(id), CONNECT_ONE_SHOT);
+	root->connect(SceneStringName(tree_exited), callable_mp(this, &ScenePool::_instance_exited_tree).bind(id));
+
+	return root;
+}
+
+int ScenePool::_get_connection_count(const Node *p_node) const {
+	List<Object::Connection> connections;
+	p_node->get_all_signal_connections(&connections);
+	p_node->get_signals_connected_to_this(&connections);
+
+	int count = 0;
+	for (const Object::Connection &connection : connections) {
+		if (connection.callable.get_object_id() != get_instance_id()) {
+			count++;
+		}
+	}
+	return count;
+}
+
+void ScenePool::_capture_node_state(const Node *p_node, NodeState &r_state) const {
+	r_state.child_count = p_node->get_child_count(false);
+	r_state.connection_count = _get_connection_count(p_node);
+
+	List<Node::GroupInfo> groups;
+	p_node->get_groups(&groups);
+	r_state.groups.clear();
+	for (const Node::GroupInfo &group : groups) {
+		if (!String(group.name).begins_with("_")) {
+			// Groups starting with an underscore are managed by the engine.
+			r_state.groups.push_back(group.name);
+		}
+	}
+
+	List<StringName> meta;
+	p_node->get_meta_list(&meta);
+	r_state.meta.clear();
+	for (const StringName &name : meta) {
+		r_state.meta.push_back(name);
+	}
+}
+
+void ScenePool::_capture_instance_state(ObjectID p_id) {
+	HashMap<ObjectID, Instance>::Iterator E = instances.find(p_id);
+	if (!E) {
+		return;
+	}
+
+	Instance &instance = E->value;
+	instance.states.resize(instance.nodes.size());
+	for (uint32_t i = 0; i < instance.nodes.size(); i++) {
+		const Node *node = ObjectDB::get_instance<Node>(instance.nodes[i]);
+		if (node) {
+			_capture_node_state(node, instance.states[i]);
+		}
+	}
+}
+
+void ScenePool::_instance_exited_tree(ObjectID p_id) {
+	const Node *node = ObjectDB::get_instance<Node>(p_id);
+	if (!node || node->is_queued_for_deletion()) {
+		instances.erase(p_id);
+	}
+}
+
+void ScenePool::_erase_freed_instances() {
+	LocalVector<ObjectID> freed;
+	for (const KeyValue<ObjectID, Instance> &E : instances) {
+		if (!ObjectDB::get_instance(E.key)) {
+			freed.push_back(E.key);
+		}
+	}
+	for (const ObjectID &id : freed) {
+		instances.erase(id);
+	}
+}
+
+void ScenePool::_propagate_pool_reset(Node *p_node) {
+	for (int i = 0; i < p_node->get_child_count(); i++) {
+		_propagate_pool_reset(p_node->get_child(i));
+	}
+	GDVIRTUAL_CALL_PTR(p_node, _pool_reset);
+}
+
+bool ScenePool::_reset_instance(Node *p_root, const Instance &p_instance) {
+	LocalVector<Node *> nodes;
+	nodes.resize(p_instance.nodes.size());
+	for (uint32_t i = 0; i < p_instance.nodes.size(); i++) {
+		nodes[i] = nullptr;
+		if (p_instance.nodes[i].is_null()) {
+			continue;
+		}
+		Node *node = ObjectDB::get_instance<Node>(p_instance.nodes[i]);
+		if (!node || (node != p_root && !p_root->is_ancestor_of(node))) {
+			// Part of the instance was freed or moved away, it can't be brought back to its initial state.
+			return false;
+		}
+		nodes[i] = node;
+	}
+
+	for (const ResetProperty &property : default_properties) {
+		Node *node = nodes[property.node];
+		if (!node) {
+			continue;
+		}
+
+		// Most of these are left untouched, skip the setters for those.
+		Variant value = node->get(property.name);
+		if (value == property.value) {
+			continue;
+		}
+
+		if (property.value.get_type() == Variant::ARRAY || property.value.get_type() == Variant::DICTIONARY) {
+			node->set(property.name, property.value.duplicate());
+		} else {
+			node->set(property.name, property.value);
+		}
+	}
+
+	for (const ResetProperty &property : reset_properties) {
+		Node *node = nodes[property.node];
+		if (!node) {
+			continue;
+		}
+
+		if (property.value.get_type() == Variant::ARRAY || property.value.get_type() == Variant::DICTIONARY) {
+			node->set(property.name, property.value.duplicate());
+		} else {
+			node->set(property.name, property.value);
+		}
+	}
+
+	// Metadata added at runtime is removed, the entries the instance was set up with keep their values.
+	for (uint32_t i = 0; i < nodes.size(); i++) {
+		if (!nodes[i]) {
+			continue;
+		}
+		List<StringName> meta;
+		nodes[i]->get_meta_list(&meta);
+		for (const StringName &name : meta) {
+			if (!p_instance.states[i].meta.has(name)) {
+				nodes[i]->remove_meta(name);
+			}
+		}
+	}
+
+	_propagate_pool_reset(p_root);
+
+	// Anything _pool_reset() didn't take back makes the instance differ from a fresh one.
+	NodeState state;
+	for (uint32_t i = 0; i < nodes.size(); i++) {
+		if (!nodes[i]) {
+			continue;
+		}
+		const NodeState &initial = p_instance.states[i];
+		_capture_node_state(nodes[i], state);
+		if (state.child_count != initial.child_count || state.connection_count != initial.connection_count || state.groups.size() != initial.groups.size()) {
+			return false;
+		}
+		for (const StringName &group : initial.groups) {
+			if (!nodes[i]->is_in_group(group)) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+void ScenePool::setup(const Ref<PackedScene> &p_scene) {
+	ERR_FAIL_COND(p_scene.is_null());
+	ERR_FAIL_COND_MSG(scene.is_valid(), "The pool is already set up.");
+
+	scene = p_scene;
+
+	HashMap<String, uint32_t> node_map;
+	_add_reset_properties(scene->get_state(), String(), node_map);
+}
+
+Ref<PackedScene> ScenePool::get_scene() const {
+	return scene;
+}
+
+void ScenePool::prewarm(int p_count) {
+	ERR_FAIL_COND(p_count < 0);
+
+	available.reserve(available.size() + p_count);
+	for (int i = 0; i < p_count; i++) {
+		Node *node = _create_instance();
+		ERR_FAIL_NULL(node);
+		ObjectID id = node->get_instance_id();
+		instances[id].pooled = true;
+		available.push_back(id);
+	}
+}
+
+Node *ScenePool::acquire() {
+	while (!available.is_empty()) {
+		ObjectID id = available[available.size() - 1];
+		available.resize(available.size() - 1);
+
+		Node *node = ObjectDB::get_instance<Node>(id);
+		if (node) {
+			instances[id].pooled = false;
+			hits++;
+			return node;
+		}
+		instances.erase(id);
+	}
+
+	misses++;
+	return _create_instance();
+}
+
+void ScenePool::release(Node *p_node) {
+	ERR_FAIL_NULL(p_node);
+
+	ObjectID id = p_node->get_instance_id();
+	HashMap<ObjectID, Instance>::Iterator E = instances.find(id);
+	ERR_FAIL_COND_MSG(!E, vformat("Node \"%s\" was not acquired from this pool.", p_node->get_name()));
+	ERR_FAIL_COND_MSG(E->value.pooled, vformat("Node \"%s\" was already released to this pool.", p_node->get_name()));
+	if (p_node->is_queued_for_deletion()) {
+		instances.remove(E);
+		ERR_FAIL_MSG(vformat("Node \"%s\" is queued for deletion, so it can't be released.", p_node->get_name()));
+	}
+
+	Node *parent = p_node->get_parent();
+	if (parent) {
+		parent->remove_child(p_node);
+		ERR_FAIL_COND_MSG(p_node->get_parent(), vformat("Node \"%s\" could not be removed from its parent, so it can't be released.", p_node->get_name()));
+	}
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	bool reset = _reset_instance(p_node, E->value);
+	reset_usec += OS::get_singleton()->get_ticks_usec() - begin;
+	releases++;
+
+	if (!reset) {
+		discards++;
+		instances.remove(E);
+		memdelete(p_node);
+		return;
+	}
+
+	E->value.pooled = true;
+	available.push_back(id);
+}
+
+void ScenePool::clear() {
+	for (const ObjectID &id : available) {
+		Node *node = ObjectDB::get_instance<Node>(id);
+		if (node) {
+			memdelete(node);
+		}
+		instances.erase(id);
+	}
+	available.clear();
+
+	// Forget about handed out instances that were freed instead of released.
+	_erase_freed_instances();
+}
+
+int ScenePool::get_available_count() const {
+	return available.size();
+}
+
+Dictionary ScenePool::get_stats() const {
+	Dictionary stats;
+	stats["available"] = available.size();
+	stats["hits"] = hits;
+	stats["misses"] = misses;
+	stats["hit_rate"] = hits + misses > 0 ? double(hits) / double(hits + misses) : 0.0;
+	stats["releases"] = releases;
+	stats["discards"] = discards;
+	stats["reset_usec"] = reset_usec;
+	stats["average_reset_usec"] = releases > 0 ? double(reset_usec) / double(releases) : 0.0;
+	return stats;
+}
+
+void ScenePool::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("get_scene"), &ScenePool::get_scene);
+	ClassDB::bind_method(D_METHOD("prewarm", "count"), &ScenePool::prewarm);
+	ClassDB::bind_method(D_METHOD("acquire"), &ScenePool::acquire);
+	ClassDB::bind_method(D_METHOD("release", "node"), &ScenePool::release);
+	ClassDB::bind_method(D_METHOD("clear"), &ScenePool::clear);
+	ClassDB::bind_method(D_METHOD("get_available_count"), &ScenePool::get_available_count);
+	ClassDB::bind_method(D_METHOD("get_stats"), &ScenePool::get_stats);
+}
+
+ScenePool::~ScenePool() {
+	clear();
+}
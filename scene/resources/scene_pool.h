@@ -0,0 +1,114 @@
+/**************************************************************************/
+/*  scene_pool.h                                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
+#include "scene/resources/packed_scene.h"
+
+class ScenePool : public RefCounted {
+	GDCLASS(ScenePool, RefCounted);
+
+	friend class TestScenePoolInternalsAccessor;
+
+	// A property stored in the scene for one of its nodes, flattened across
+	// inherited and instanced sub-scenes in the order instantiation applies them.
+	struct ResetProperty {
+		uint32_t node = 0;
+		StringName name;
+		Variant value;
+	};
+
+	// What a node of an instance looked like once it was set up. Resetting
+	// properties doesn't undo children, groups or connections added later, so
+	// instances that no longer match are freed on release instead of reused.
+	struct NodeState {
+		int child_count = 0;
+		int connection_count = 0;
+		LocalVector<StringName> groups;
+		LocalVector<StringName> meta;
+	};
+
+	struct Instance {
+		LocalVector<ObjectID> nodes;
+		LocalVector<NodeState> states;
+		bool pooled = false;
+	};
+
+	Ref<PackedScene> scene;
+
+	LocalVector<NodePath> reset_node_paths;
+	LocalVector<ResetProperty> reset_properties;
+	// Storable properties the scene leaves at their defaults, captured from the
+	// first instance so changes made to them at runtime are undone as well.
+	LocalVector<ResetProperty> default_properties;
+	bool default_properties_captured = false;
+
+	HashMap<ObjectID, Instance> instances;
+	LocalVector<ObjectID> available;
+	// Instances freed without being released are only noticed when they leave
+	// the tree, so the others are swept out whenever the map has doubled.
+	uint32_t sweep_instance_count = 64;
+
+	uint64_t hits = 0;
+	uint64_t misses = 0;
+	uint64_t releases = 0;
+	uint64_t discards = 0;
+	uint64_t reset_usec = 0;
+
+	void _add_reset_properties(const Ref<SceneState> &p_state, const String &p_prefix, HashMap<String, uint32_t> &r_node_map);
+	void _capture_default_properties(Node *p_root);
+	Node *_create_instance();
+	int _get_connection_count(const Node *p_node) const;
+	void _capture_node_state(const Node *p_node, NodeState &r_state) const;
+	void _capture_instance_state(ObjectID p_id);
+	void _instance_exited_tree(ObjectID p_id);
+	void _erase_freed_instances();
+	bool _reset_instance(Node *p_root, const Instance &p_instance);
+	static void _propagate_pool_reset(Node *p_node);
+
+protected:
+	static void _bind_methods();
+
+public:
+	void setup(const Ref<PackedScene> &p_scene);
+	Ref<PackedScene> get_scene() const;
+
+	void prewarm(int p_count);
+	Node *acquire();
+	void release(Node *p_node);
+	void clear();
+
+	int get_available_count() const;
+	Dictionary get_stats() const;
+
+	~ScenePool();
+};
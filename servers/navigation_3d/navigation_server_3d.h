@@ -78,6 +78,10 @@ public:
 	virtual void map_set_use_edge_connections(RID p_map, bool p_enabled) = 0;
 	virtual bool map_get_use_edge_connections(RID p_map) const = 0;
 
+	/// Set the map to first search a graph of polygon clusters and then only refine the path inside the clusters found.
+	virtual void map_set_use_hierarchical_pathfinding(RID p_map, bool p_enabled) = 0;
+	virtual bool map_get_use_hierarchical_pathfinding(RID p_map) const = 0;
+
 	virtual void map_set_edge_connection_margin(RID p_map, real_t p_connection_margin) = 0;
 	virtual real_t map_get_edge_connection_margin(RID p_map) const = 0;
 
@@ -86,6 +90,9 @@ public:
 
 	virtual Vector<Vector3> map_get_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers = 1) = 0;
 
+	/// Returns the next position towards the target from a flow field shared by every query with the same target.
+	virtual Vector3 map_get_flow_field_next_position(RID p_map, const Vector3 &p_target_position, const Vector3 &p_from_position, uint32_t p_navigation_layers = 1) = 0;
+
 	virtual Vector3 map_get_closest_point_to_segment(RID p_map, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision = false) const = 0;
 	virtual Vector3 map_get_closest_point(RID p_map, const Vector3 &p_point) const = 0;
 	virtual Vector3 map_get_closest_point_normal(RID p_map, const Vector3 &p_point) const = 0;
@@ -278,6 +285,7 @@ public:
 	/* QUERY API */
 
 	virtual void query_path(const Ref<NavigationPathQueryParameters3D> &p_query_parameters, Ref<NavigationPathQueryResult3D> p_query_result, const Callable &p_callback = Callable()) = 0;
+	virtual void query_paths(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results, const Callable &p_callback = Callable()) = 0;
 
 	/* NAVMESH BAKE API */
 
@@ -331,6 +339,7 @@ public:
 		INFO_EDGE_CONNECTION_COUNT,
 		INFO_EDGE_FREE_COUNT,
 		INFO_OBSTACLE_COUNT,
+		INFO_PATH_QUERY_NODE_COUNT,
 	};
 
 	virtual int get_process_info(ProcessInfo p_info) const = 0;
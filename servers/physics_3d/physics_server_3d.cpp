@@ -694,6 +694,18 @@ RID PhysicsServer3D::shape_create(ShapeType p_shape) {
 	}
 }
 
+PackedByteArray PhysicsServer3D::space_save_state(RID p_space) const {
+	ERR_FAIL_V_MSG(PackedByteArray(), "Space state snapshots are not supported by this physics engine.");
+}
+
+Error PhysicsServer3D::space_restore_state(RID p_space, const PackedByteArray &p_state) {
+	ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "Space state snapshots are not supported by this physics engine.");
+}
+
+uint32_t PhysicsServer3D::space_get_state_hash(RID p_space) const {
+	ERR_FAIL_V_MSG(0, "Space state snapshots are not supported by this physics engine.");
+}
+
 void PhysicsServer3D::_bind_methods() {
 #ifndef _3D_DISABLED
 
@@ -721,6 +733,9 @@ void PhysicsServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("space_set_param", "space", "param", "value"), &PhysicsServer3D::space_set_param);
 	ClassDB::bind_method(D_METHOD("space_get_param", "space", "param"), &PhysicsServer3D::space_get_param);
 	ClassDB::bind_method(D_METHOD("space_get_direct_state", "space"), &PhysicsServer3D::space_get_direct_state);
+	ClassDB::bind_method(D_METHOD("space_save_state", "space"), &PhysicsServer3D::space_save_state);
+	ClassDB::bind_method(D_METHOD("space_restore_state", "space", "state"), &PhysicsServer3D::space_restore_state);
+	ClassDB::bind_method(D_METHOD("space_get_state_hash", "space"), &PhysicsServer3D::space_get_state_hash);
 
 	ClassDB::bind_method(D_METHOD("area_create"), &PhysicsServer3D::area_create);
 	ClassDB::bind_method(D_METHOD("area_set_space", "area", "space"), &PhysicsServer3D::area_set_space);
@@ -1152,6 +1167,7 @@ PhysicsServer3D::PhysicsServer3D() {
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/contact_max_separation", PROPERTY_HINT_RANGE, "0,0.1,0.001,or_greater"), 0.05);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/contact_max_allowed_penetration", PROPERTY_HINT_RANGE, "0.001,0.1,0.001,or_greater"), 0.01);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/default_contact_bias", PROPERTY_HINT_RANGE, "0,1,0.01"), 0.8);
+	GLOBAL_DEF("physics/3d/solver/deterministic", false);
 }
 
 PhysicsServer3D::~PhysicsServer3D() {
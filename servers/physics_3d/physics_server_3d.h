@@ -311,6 +311,10 @@ public:
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const = 0;
 	virtual int space_get_contact_count(RID p_space) const = 0;
 
+	virtual PackedByteArray space_save_state(RID p_space) const;
+	virtual Error space_restore_state(RID p_space, const PackedByteArray &p_state);
+	virtual uint32_t space_get_state_hash(RID p_space) const;
+
 	//missing space parameters
 
 	/* AREA API */
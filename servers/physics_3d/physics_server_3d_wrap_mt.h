@@ -124,6 +124,10 @@ public:
 		return physics_server_3d->space_get_direct_state(p_space);
 	}
 
+	FUNC1RC(PackedByteArray, space_save_state, RID);
+	FUNC2R(Error, space_restore_state, RID, const PackedByteArray &);
+	FUNC1RC(uint32_t, space_get_state_hash, RID);
+
 	FUNC2(space_set_debug_contacts, RID, int);
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const override {
 		ERR_FAIL_COND_V(!Thread::is_main_thread(), Vector<Vector3>());
@@ -31,6 +31,7 @@
 #pragma once
 
 #include "core/io/file_access.h"
+#include "core/io/file_access_memory.h"
 #include "tests/test_macros.h"
 #include "tests/test_utils.h"
 
@@ -295,4 +296,40 @@ TEST_CASE("[FileAccess] Cursor positioning") {
 	}
 }
 
+TEST_CASE("[FileAccess] Buffer views") {
+	Ref<FileAccess> f = FileAccess::open(TestUtils::get_data_path("line_endings_lf.test.txt"), FileAccess::READ);
+	REQUIRE(f.is_valid());
+	const Vector<uint8_t> contents = f->get_buffer(f->get_length());
+
+	SUBCASE("Views of in-memory files don't copy and advance the cursor") {
+		Ref<FileAccessMemory> fm;
+		fm.instantiate();
+		REQUIRE(fm->open_custom(contents.ptr(), contents.size()) == OK);
+
+		Span<uint8_t> view = fm->get_buffer_view(4);
+		CHECK(view.ptr() == contents.ptr());
+		CHECK(view.size() == 4);
+		CHECK(fm->get_position() == 4);
+
+		// Short reads don't return a partial view and leave the cursor in place.
+		view = fm->get_buffer_view(contents.size());
+		CHECK(view.is_empty());
+		CHECK(fm->get_position() == 4);
+		CHECK_FALSE(fm->eof_reached());
+
+		view = fm->get_buffer_view(contents.size() - 4);
+		CHECK(view.ptr() == contents.ptr() + 4);
+		CHECK(view.size() == (uint64_t)contents.size() - 4);
+		CHECK(fm->get_position() == (uint64_t)contents.size());
+	}
+
+	SUBCASE("Mapped files match their contents") {
+		Span<uint8_t> mapping = f->map_read_only();
+		if (!mapping.is_empty()) {
+			REQUIRE(mapping.size() == (uint64_t)contents.size());
+			CHECK(memcmp(mapping.ptr(), contents.ptr(), contents.size()) == 0);
+		}
+	}
+}
+
 } // namespace TestFileAccess
@@ -30,13 +30,29 @@
 
 #pragma once
 
+#include "core/io/file_access_memory.h"
 #include "core/io/file_access_pack.h"
 #include "core/io/pck_packer.h"
+#include "core/io/resource_loader.h"
 #include "core/os/os.h"
 
 #include "tests/test_utils.h"
 #include "thirdparty/doctest/doctest.h"
 
+class TestPackedDataInternalsAccessor {
+public:
+	// Whether the file was handed to the read-ahead thread.
+	static bool is_read_ahead_queued(const String &p_path) {
+		PackedData *packed_data = PackedData::get_singleton();
+		if (!packed_data->read_ahead) {
+			return false;
+		}
+		MutexLock lock(packed_data->read_ahead->mutex);
+		const uint32_t *index = packed_data->read_ahead->indices.getptr(PackedData::PathMD5(p_path.simplify_path().trim_prefix("res://").md5_buffer()));
+		return index && *index < packed_data->read_ahead->queued_until;
+	}
+};
+
 namespace TestPCKPacker {
 
 TEST_CASE("[PCKPacker] Pack an empty PCK file") {
@@ -119,4 +135,219 @@ TEST_CASE("[PCKPacker] Pack a PCK file with some files and directories") {
 			f->get_length() <= 27000,
 			"The generated non-empty PCK file shouldn't be too large.");
 }
+
+TEST_CASE("[PCKPacker] Compressed file entries") {
+	String text;
+	for (int i = 0; i < 8000; i++) {
+		text += vformat("[sub_resource type=\"Resource\" id=\"%d\"]\nvalue = %d\n", i, i * 7);
+	}
+	const Vector<uint8_t> data = text.to_utf8_buffer();
+	REQUIRE(data.size() > FileAccessPackCompressed::DEFAULT_BLOCK_SIZE * FileAccessPackCompressed::PARALLEL_MIN_BLOCKS);
+
+	const Vector<uint8_t> entry = FileAccessPackCompressed::compress_entry(data.ptr(), data.size());
+	CHECK_MESSAGE(entry.size() < data.size() / 2, "Repetitive text should compress well.");
+
+	Ref<FileAccessMemory> entry_file;
+	entry_file.instantiate();
+	REQUIRE(entry_file->open_custom(entry.ptr(), entry.size()) == OK);
+	Ref<FileAccessPackCompressed> compressed;
+	compressed.instantiate();
+	REQUIRE(compressed->open_entry(entry_file) == OK);
+	Ref<FileAccess> f = compressed;
+	CHECK(f->get_length() == uint64_t(data.size()));
+
+	// Whole file, decompressed in parallel.
+	Vector<uint8_t> read = f->get_buffer(data.size());
+	CHECK(read == data);
+	CHECK_FALSE(f->eof_reached());
+
+	// Reads across a block boundary.
+	const uint64_t boundary = FileAccessPackCompressed::DEFAULT_BLOCK_SIZE;
+	f->seek(boundary - 10);
+	read = f->get_buffer(20);
+	CHECK(read == data.slice(boundary - 10, boundary + 10));
+	CHECK(f->get_position() == boundary + 10);
+
+	// Reads past the end.
+	f->seek_end(-5);
+	read = f->get_buffer(10);
+	CHECK(read == data.slice(data.size() - 5));
+	CHECK(f->eof_reached());
+
+	// Small files with a dictionary sharing their content.
+	const Vector<uint8_t> small = String("[gd_resource type=\"Resource\" format=3]\n\n[resource]\nvalue = 42\n").to_utf8_buffer();
+	const Vector<uint8_t> dictionary = String("[gd_resource type=\"Resource\" format=3]\n[resource]\n").to_utf8_buffer();
+	const Vector<uint8_t> small_entry = FileAccessPackCompressed::compress_entry(small.ptr(), small.size(), dictionary);
+
+	Ref<FileAccessMemory> small_entry_file;
+	small_entry_file.instantiate();
+	REQUIRE(small_entry_file->open_custom(small_entry.ptr(), small_entry.size()) == OK);
+	ERR_PRINT_OFF;
+	CHECK_MESSAGE(compressed->open_entry(small_entry_file) == ERR_FILE_CORRUPT, "An entry compressed with a dictionary can't be opened without it.");
+	ERR_PRINT_ON;
+	REQUIRE(compressed->open_entry(small_entry_file, dictionary) == OK);
+	CHECK(f->get_buffer(small.size()) == small);
+}
+
+TEST_CASE("[PCKPacker] Pack a PCK file with compressed files") {
+	PCKPacker pck_packer;
+	const String output_pck_path = TestUtils::get_temp_path("output_compressed.pck");
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	pck_packer.set_compression_enabled(true);
+	CHECK(pck_packer.is_compression_enabled());
+
+	String text;
+	for (int i = 0; i < 4000; i++) {
+		text += vformat("line %d\n", i % 10);
+	}
+	const Vector<uint8_t> large = text.to_utf8_buffer();
+	CHECK(pck_packer.add_file_from_buffer("large.txt", large) == OK);
+	Vector<Vector<uint8_t>> smalls;
+	for (int i = 0; i < 8; i++) {
+		smalls.push_back(vformat("[gd_resource type=\"Resource\" format=3]\n\n[resource]\nvalue = %d\n", i).to_utf8_buffer());
+		CHECK(pck_packer.add_file_from_buffer(vformat("small_%d.tres", i), smalls[i]) == OK);
+	}
+	CHECK(pck_packer.flush() == OK);
+
+	Ref<FileAccess> f = FileAccess::open(output_pck_path, FileAccess::READ);
+	REQUIRE(f.is_valid());
+	CHECK_MESSAGE(
+			f->get_length() < uint64_t(text.length()),
+			"The compressed PCK should be smaller than its largest file.");
+	CHECK(f->get_32() == PACK_HEADER_MAGIC);
+	CHECK_MESSAGE(
+			f->get_32() == PACK_FORMAT_VERSION_COMPRESSED,
+			"PCKs with compressed files should use a version older engines refuse.");
+	f.unref();
+
+	// Read the files back through the pack, the small ones are compressed with a shared dictionary.
+	PackedData *packed_data = PackedData::get_singleton();
+	REQUIRE(packed_data != nullptr);
+	REQUIRE(packed_data->add_pack(output_pck_path, true, 0) == OK);
+
+	CHECK(packed_data->has_path("res://large.txt"));
+	CHECK_FALSE(packed_data->has_path("res://.godot/pck_dictionary.bin"));
+	CHECK(packed_data->get_size("res://large.txt") == large.size());
+	Ref<FileAccess> large_file = packed_data->try_open_path("res://large.txt");
+	REQUIRE(large_file.is_valid());
+	CHECK(large_file->get_length() == uint64_t(large.size()));
+	CHECK(large_file->get_buffer(large.size()) == large);
+
+	for (int i = 0; i < smalls.size(); i++) {
+		const String small_path = vformat("res://small_%d.tres", i);
+		CHECK(packed_data->get_size(small_path) == smalls[i].size());
+		Ref<FileAccess> small_file = packed_data->try_open_path(small_path);
+		REQUIRE(small_file.is_valid());
+		CHECK_MESSAGE(small_file->get_buffer(smalls[i].size()) == smalls[i], vformat("\"%s\" should match the packed data.", small_path));
+	}
+
+	packed_data->clear();
+}
+
+static int64_t find_in_buffer(const Vector<uint8_t> &p_buffer, const String &p_text) {
+	const CharString text = p_text.utf8();
+	for (int64_t i = 0; i + text.length() <= p_buffer.size(); i++) {
+		if (memcmp(p_buffer.ptr() + i, text.get_data(), text.length()) == 0) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+TEST_CASE("[PCKPacker] Pack a PCK file laid out from a load trace") {
+	const String trace_path = TestUtils::get_temp_path("load_trace.txt");
+	{
+		Ref<FileAccess> trace = FileAccess::open(trace_path, FileAccess::WRITE);
+		REQUIRE(trace.is_valid());
+		trace->store_line("res://third.txt\t-1\t0\t10");
+		trace->store_line("res://first.txt\t-1\t10\t5");
+	}
+
+	PCKPacker pck_packer;
+	const String output_pck_path = TestUtils::get_temp_path("output_load_trace.pck");
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	CHECK(pck_packer.set_load_trace(trace_path) == OK);
+	CHECK(pck_packer.add_file_from_buffer("first.txt", String("FIRST FILE").to_utf8_buffer()) == OK);
+	CHECK(pck_packer.add_file_from_buffer("second.txt", String("SECOND FILE").to_utf8_buffer()) == OK);
+	CHECK(pck_packer.add_file_from_buffer("third.txt", String("THIRD FILE").to_utf8_buffer()) == OK);
+	CHECK(pck_packer.flush() == OK);
+
+	const Vector<uint8_t> pck = FileAccess::get_file_as_bytes(output_pck_path);
+	const int64_t first = find_in_buffer(pck, "FIRST FILE");
+	const int64_t second = find_in_buffer(pck, "SECOND FILE");
+	const int64_t third = find_in_buffer(pck, "THIRD FILE");
+	REQUIRE(first >= 0);
+	REQUIRE(second >= 0);
+	REQUIRE(third >= 0);
+	CHECK_MESSAGE(second < third, "Files that aren't in the trace should be written first.");
+	CHECK_MESSAGE(third < first, "Files in the trace should be written in load order.");
+	CHECK_MESSAGE(find_in_buffer(pck, PACK_LOAD_ORDER_PATH) >= 0, "The load order should be stored in the PCK.");
+}
+
+TEST_CASE("[PCKPacker] Load trace of an imported resource") {
+	const String import_path = "data.tracetest.import";
+	const String imported_path = ".godot/imported/data.tracetest-0123456789abcdef.tres";
+	const Vector<uint8_t> import_data = vformat("[remap]\n\nimporter=\"test_trace\"\ntype=\"Resource\"\npath=\"res://%s\"\n", imported_path).to_utf8_buffer();
+	const Vector<uint8_t> imported_data = String("[gd_resource type=\"Resource\" format=3]\n\n[resource]\n").to_utf8_buffer();
+	const Vector<uint8_t> filler_data = String("FILLER FILE").to_utf8_buffer();
+
+	PackedData *packed_data = PackedData::get_singleton();
+	REQUIRE(packed_data != nullptr);
+
+	// Record which files loading the imported resource reads from a pack. Resources with an .import file
+	// next to them are loaded through it, from the path it remaps to.
+	const String source_pck_path = TestUtils::get_temp_path("output_trace_source.pck");
+	{
+		PCKPacker pck_packer;
+		REQUIRE(pck_packer.pck_start(source_pck_path) == OK);
+		CHECK(pck_packer.add_file_from_buffer(import_path, import_data) == OK);
+		CHECK(pck_packer.add_file_from_buffer(imported_path, imported_data) == OK);
+		CHECK(pck_packer.flush() == OK);
+	}
+	REQUIRE(packed_data->add_pack(source_pck_path, true, 0) == OK);
+
+	const String trace_path = TestUtils::get_temp_path("imported_load_trace.txt");
+	ResourceLoader::start_load_trace();
+	Ref<Resource> resource = ResourceLoader::load("res://data.tracetest", "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	CHECK(resource.is_valid());
+	REQUIRE(ResourceLoader::save_load_trace(trace_path) == OK);
+	packed_data->clear();
+
+	const String trace = FileAccess::get_file_as_string(trace_path);
+	CHECK_MESSAGE(trace.contains("res://" + import_path + "\t"), "The .import file read from the pack should be in the trace.");
+	CHECK_MESSAGE(trace.contains("res://" + imported_path + "\t"), "The imported file read from the pack should be in the trace.");
+
+	// Lay out a pack from the trace.
+	const String output_pck_path = TestUtils::get_temp_path("output_trace_imported.pck");
+	{
+		PCKPacker pck_packer;
+		REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+		CHECK(pck_packer.set_load_trace(trace_path) == OK);
+		CHECK(pck_packer.add_file_from_buffer(imported_path, imported_data) == OK);
+		CHECK(pck_packer.add_file_from_buffer("filler.txt", filler_data) == OK);
+		CHECK(pck_packer.add_file_from_buffer(import_path, import_data) == OK);
+		CHECK(pck_packer.flush() == OK);
+	}
+
+	const Vector<uint8_t> pck = FileAccess::get_file_as_bytes(output_pck_path);
+	const int64_t import_ofs = find_in_buffer(pck, "[remap]");
+	const int64_t imported_ofs = find_in_buffer(pck, "[gd_resource");
+	const int64_t filler_ofs = find_in_buffer(pck, "FILLER FILE");
+	REQUIRE(import_ofs >= 0);
+	REQUIRE(imported_ofs >= 0);
+	REQUIRE(filler_ofs >= 0);
+	CHECK_MESSAGE(filler_ofs < import_ofs, "Files that aren't in the trace should be written first.");
+	CHECK_MESSAGE(import_ofs < imported_ofs, "The .import file is read before the imported file, so it should be written before it.");
+
+#ifdef THREADS_ENABLED
+	// Opening the .import file should read the imported file ahead.
+	REQUIRE(packed_data->add_pack(output_pck_path, true, 0) == OK);
+	CHECK_FALSE(TestPackedDataInternalsAccessor::is_read_ahead_queued("res://" + imported_path));
+	Ref<FileAccess> f = FileAccess::open("res://" + import_path, FileAccess::READ);
+	CHECK(f.is_valid());
+	CHECK(TestPackedDataInternalsAccessor::is_read_ahead_queued("res://" + imported_path));
+	f.unref();
+	packed_data->clear();
+#endif
+}
 } // namespace TestPCKPacker
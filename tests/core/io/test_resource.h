@@ -30,7 +30,10 @@
 
 #pragma once
 
+#include "core/config/project_settings.h"
+#include "core/io/file_access.h"
 #include "core/io/resource.h"
+#include "core/io/resource_format_binary.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
 #include "scene/main/node.h"
@@ -41,6 +44,28 @@
 
 #include <functional>
 
+class TestResourceLoaderBinaryAccessor {
+public:
+	// Loads like ResourceFormatLoaderBinary, but decodes in parallel whatever the number of worker threads when it can.
+	static Ref<Resource> load(const String &p_path, Error &r_error, bool &r_loaded_in_parallel) {
+		Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &r_error);
+		if (f.is_null()) {
+			return Ref<Resource>();
+		}
+
+		ResourceLoaderBinary loader;
+		loader.cache_mode = ResourceFormatLoader::CACHE_MODE_IGNORE;
+		loader.use_sub_threads = true;
+		loader.parallel_min_threads = 0;
+		loader.local_path = ProjectSettings::get_singleton()->localize_path(p_path);
+		loader.res_path = loader.local_path;
+		loader.open(f);
+		r_error = loader.load();
+		r_loaded_in_parallel = loader.loaded_in_parallel;
+		return loader.get_resource();
+	}
+};
+
 namespace TestResource {
 
 enum TestDuplicateMode {
@@ -627,4 +652,64 @@ TEST_CASE("[Resource] Breaking circular references on save") {
 	// Break circular reference to avoid memory leak
 	resource_c->remove_meta("next");
 }
+
+TEST_CASE("[Resource] Loading binary sub-resources in parallel") {
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_name("Root");
+	Array children;
+	Ref<Resource> previous;
+	for (int i = 0; i < 64; i++) {
+		Ref<Resource> child = memnew(Resource);
+		child->set_name(vformat("Child %d", i));
+		PackedFloat32Array values;
+		for (int j = 0; j < 256; j++) {
+			values.push_back(i * 1000 + j);
+		}
+		child->set_meta("values", values);
+		if (previous.is_valid()) {
+			child->set_meta("previous", previous);
+		}
+		children.push_back(child);
+		previous = child;
+	}
+	resource->set_meta("children", children);
+
+	const String save_path = TestUtils::get_temp_path("resource_parallel.res");
+	REQUIRE(ResourceSaver::save(resource, save_path) == OK);
+
+	Error err = FAILED;
+	bool loaded_in_parallel = false;
+	const Ref<Resource> loaded = TestResourceLoaderBinaryAccessor::load(save_path, err, loaded_in_parallel);
+	REQUIRE(err == OK);
+	REQUIRE(loaded.is_valid());
+	CHECK(loaded_in_parallel);
+	CHECK(loaded->get_name() == "Root");
+
+	const Array loaded_children = loaded->get_meta("children");
+	REQUIRE(loaded_children.size() == 64);
+	for (int i = 0; i < 64; i++) {
+		const Ref<Resource> child = loaded_children[i];
+		REQUIRE(child.is_valid());
+		CHECK(child->get_name() == vformat("Child %d", i));
+		const PackedFloat32Array values = child->get_meta("values");
+		REQUIRE(values.size() == 256);
+		CHECK(values[255] == i * 1000 + 255);
+		if (i > 0) {
+			CHECK_MESSAGE(
+					Ref<Resource>(child->get_meta("previous")) == Ref<Resource>(loaded_children[i - 1]),
+					"References between sub-resources should point to the loaded sub-resources.");
+		}
+	}
+
+	// Compressed files can't be viewed in memory, so they are loaded sequentially instead.
+	const String compressed_path = TestUtils::get_temp_path("resource_parallel_compressed.res");
+	REQUIRE(ResourceSaver::save(resource, compressed_path, ResourceSaver::FLAG_COMPRESS) == OK);
+	const Ref<Resource> loaded_compressed = TestResourceLoaderBinaryAccessor::load(compressed_path, err, loaded_in_parallel);
+	REQUIRE(err == OK);
+	REQUIRE(loaded_compressed.is_valid());
+	CHECK_FALSE(loaded_in_parallel);
+	const Array compressed_children = loaded_compressed->get_meta("children");
+	REQUIRE(compressed_children.size() == 64);
+	CHECK(Ref<Resource>(compressed_children[63])->get_name() == "Child 63");
+}
 } // namespace TestResource
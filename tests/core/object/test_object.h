@@ -33,6 +33,7 @@
 #include "core/object/class_db.h"
 #include "core/object/object.h"
 #include "core/object/script_language.h"
+#include "core/os/thread.h"
 
 #include "tests/test_macros.h"
 
@@ -329,6 +330,28 @@ public:
 	}
 };
 
+class SignalMutator : public Object {
+	GDCLASS(SignalMutator, Object);
+
+public:
+	Object *source = nullptr;
+	Callable connect_callable;
+	Callable disconnect_callable;
+	int calls = 0;
+
+	void callback() {
+		calls++;
+		if (connect_callable.is_valid()) {
+			source->connect("my_custom_signal", connect_callable);
+			connect_callable = Callable();
+		}
+		if (disconnect_callable.is_valid()) {
+			source->disconnect("my_custom_signal", disconnect_callable);
+			disconnect_callable = Callable();
+		}
+	}
+};
+
 TEST_CASE("[Object] Signals") {
 	Object object;
 
@@ -513,6 +536,83 @@ TEST_CASE("[Object] Signals") {
 		CHECK_EQ(target.received_args, Vector<Variant>{ "emit_arg", &object });
 		object.disconnect("my_custom_signal", callable_mp(&target, &SignalReceiver::callback2));
 	}
+
+	SUBCASE("Connecting and disconnecting while emitting should only affect the next emission") {
+		SignalMutator first;
+		SignalMutator second;
+		SignalMutator third;
+		first.source = &object;
+		first.connect_callable = callable_mp(&third, &SignalMutator::callback);
+		first.disconnect_callable = callable_mp(&second, &SignalMutator::callback);
+
+		object.connect("my_custom_signal", callable_mp(&first, &SignalMutator::callback));
+		object.connect("my_custom_signal", callable_mp(&second, &SignalMutator::callback));
+
+		object.emit_signal("my_custom_signal");
+		CHECK(first.calls == 1);
+		CHECK(second.calls == 1);
+		CHECK(third.calls == 0);
+
+		object.emit_signal("my_custom_signal");
+		CHECK(first.calls == 2);
+		CHECK(second.calls == 1);
+		CHECK(third.calls == 1);
+
+		List<Object::Connection> signal_connections;
+		object.get_all_signal_connections(&signal_connections);
+		CHECK(signal_connections.size() == 2);
+
+		object.disconnect("my_custom_signal", callable_mp(&first, &SignalMutator::callback));
+		object.disconnect("my_custom_signal", callable_mp(&third, &SignalMutator::callback));
+	}
+
+	SUBCASE("Disconnecting many targets should keep the emission order of the others") {
+		SignalMutator targets[20];
+		for (SignalMutator &target : targets) {
+			object.connect("my_custom_signal", callable_mp(&target, &SignalMutator::callback));
+		}
+		for (int i = 0; i < 20; i += 2) {
+			object.disconnect("my_custom_signal", callable_mp(&targets[i], &SignalMutator::callback));
+		}
+
+		object.emit_signal("my_custom_signal");
+		List<Object::Connection> signal_connections;
+		object.get_all_signal_connections(&signal_connections);
+		CHECK(signal_connections.size() == 10);
+		int index = 1;
+		for (const Object::Connection &connection : signal_connections) {
+			CHECK(connection.callable.get_object() == &targets[index]);
+			index += 2;
+		}
+		for (int i = 0; i < 20; i++) {
+			CHECK(targets[i].calls == i % 2);
+		}
+
+		for (int i = 1; i < 20; i += 2) {
+			object.disconnect("my_custom_signal", callable_mp(&targets[i], &SignalMutator::callback));
+		}
+	}
+
+	SUBCASE("Emitting to a native method resolved on connect") {
+		Object target;
+		object.connect("my_custom_signal", Callable(&target, "set_meta"));
+
+		// Exact argument types take the validated call path.
+		object.emit_signal("my_custom_signal", StringName("exact"), 1);
+		CHECK(target.get_meta("exact") == Variant(1));
+
+		// Convertible argument types are converted like a regular call.
+		object.emit_signal("my_custom_signal", String("converted"), 2);
+		CHECK(target.get_meta("converted") == Variant(2));
+
+		// Wrong argument count is still reported.
+		ERR_PRINT_OFF;
+		CHECK(object.emit_signal("my_custom_signal", StringName("missing")) == ERR_METHOD_NOT_FOUND);
+		ERR_PRINT_ON;
+		CHECK_FALSE(target.has_meta("missing"));
+
+		object.disconnect("my_custom_signal", Callable(&target, "set_meta"));
+	}
 }
 
 class NotificationObjectSuperclass : public Object {
@@ -692,4 +792,156 @@ TEST_CASE("[Object] RequiredResult") {
 	CHECK_EQ(ref, var);
 }
 
+struct ObjectDBThreadTester {
+	static constexpr int OBJECTS_PER_THREAD = 2000;
+
+	SafeNumeric<uint32_t> errors;
+
+	static void thread_func(void *p_userdata) {
+		ObjectDBThreadTester *tester = (ObjectDBThreadTester *)p_userdata;
+
+		LocalVector<Object *> objects;
+		LocalVector<ObjectID> ids;
+		for (int i = 0; i < OBJECTS_PER_THREAD; i++) {
+			Object *object = memnew(Object);
+			objects.push_back(object);
+			ids.push_back(object->get_instance_id());
+		}
+
+		// Free every other object, its slot may be reused right away by another one.
+		for (int i = 0; i < OBJECTS_PER_THREAD; i += 2) {
+			memdelete(objects[i]);
+			objects[i] = memnew(Object);
+		}
+
+		for (int i = 0; i < OBJECTS_PER_THREAD; i++) {
+			Object *expected = i % 2 ? objects[i] : nullptr;
+			if (ObjectDB::get_instance(ids[i]) != expected) {
+				tester->errors.increment();
+			}
+			if (ObjectDB::get_instance(objects[i]->get_instance_id()) != objects[i]) {
+				tester->errors.increment();
+			}
+		}
+
+		for (Object *object : objects) {
+			memdelete(object);
+		}
+	}
+};
+
+TEST_CASE("[Object] ObjectDB from multiple threads") {
+	const int thread_count = 16;
+	const int object_count = ObjectDB::get_object_count();
+
+	ObjectDBThreadTester tester;
+	Thread threads[thread_count];
+	for (Thread &thread : threads) {
+		thread.start(&ObjectDBThreadTester::thread_func, &tester);
+	}
+	for (Thread &thread : threads) {
+		thread.wait_to_finish();
+	}
+
+	CHECK(tester.errors.get() == 0);
+	CHECK(ObjectDB::get_object_count() == object_count);
+}
+
+class SignalCounter : public Object {
+	GDCLASS(SignalCounter, Object);
+
+public:
+	int64_t total = 0;
+
+	void add(int64_t p_value) {
+		total += p_value;
+	}
+};
+
+inline void benchmark_signal_emission() {
+	// Emits a signal connected to an increasing number of targets and reports the best of several passes.
+	const StringName signal_name = "benchmark_signal";
+	const int connection_counts[] = { 1, 10, 1000 };
+	const int calls_per_pass = 1000000;
+	const int passes = 5;
+
+	for (int connection_count : connection_counts) {
+		Object source;
+		source.add_user_signal(MethodInfo(signal_name, PropertyInfo(Variant::INT, "value")));
+
+		LocalVector<SignalCounter *> targets;
+		for (int i = 0; i < connection_count; i++) {
+			targets.push_back(memnew(SignalCounter));
+			source.connect(signal_name, callable_mp(targets[i], &SignalCounter::add));
+		}
+
+		const int emissions = calls_per_pass / connection_count;
+		uint64_t best_usec = UINT64_MAX;
+		for (int pass = 0; pass < passes; pass++) {
+			const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			for (int i = 0; i < emissions; i++) {
+				source.emit_signal(signal_name, 1);
+			}
+			best_usec = MIN(best_usec, OS::get_singleton()->get_ticks_usec() - begin);
+		}
+
+		print_line(vformat("%d connection(s): %.1f ns per emission, %.1f ns per call, best of %d passes.", connection_count, best_usec * 1000.0 / emissions, best_usec * 1000.0 / (emissions * (double)connection_count), passes));
+
+		for (SignalCounter *target : targets) {
+			memdelete(target);
+		}
+	}
+}
+
+REGISTER_TEST_COMMAND("object-signal-benchmark", &benchmark_signal_emission);
+
+struct ObjectDBBenchmark {
+	static constexpr int BATCH_SIZE = 64;
+	static constexpr int BATCHES = 20000;
+
+	static void thread_func(void *p_userdata) {
+		// Creates and frees objects in batches, resolving each one's ID in between.
+		SafeNumeric<uint64_t> *lookups = (SafeNumeric<uint64_t> *)p_userdata;
+		Object *objects[BATCH_SIZE];
+		uint64_t found = 0;
+		for (int batch = 0; batch < BATCHES; batch++) {
+			for (int i = 0; i < BATCH_SIZE; i++) {
+				objects[i] = memnew(Object);
+			}
+			for (int i = 0; i < BATCH_SIZE; i++) {
+				found += ObjectDB::get_instance(objects[i]->get_instance_id()) != nullptr;
+			}
+			for (int i = 0; i < BATCH_SIZE; i++) {
+				memdelete(objects[i]);
+			}
+		}
+		lookups->add(found);
+	}
+};
+
+inline void benchmark_object_db() {
+	const int thread_counts[] = { 1, 4, 16, 32 };
+
+	for (int thread_count : thread_counts) {
+		SafeNumeric<uint64_t> lookups;
+		LocalVector<Thread> threads;
+		threads.resize(thread_count);
+
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (Thread &thread : threads) {
+			thread.start(&ObjectDBBenchmark::thread_func, &lookups);
+		}
+		for (Thread &thread : threads) {
+			thread.wait_to_finish();
+		}
+		const uint64_t usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		const uint64_t objects = uint64_t(thread_count) * ObjectDBBenchmark::BATCHES * ObjectDBBenchmark::BATCH_SIZE;
+		print_line(vformat("%d thread(s): %d objects created, looked up and freed in %.1f ms, %.1f ns per object per thread.", thread_count, objects, usec / 1000.0, usec * 1000.0 * thread_count / objects));
+		ERR_FAIL_COND(lookups.get() != objects);
+	}
+}
+
+REGISTER_TEST_COMMAND("object-db-benchmark", &benchmark_object_db);
+
 } // namespace TestObject
@@ -913,4 +913,214 @@ TEST_CASE("[SceneTree][Node] Test the process priority") {
 	memdelete(node4);
 }
 
+TEST_CASE("[SceneTree][Node] Process thread groups") {
+	Node *group = memnew(Node);
+	Node *child = memnew(Node);
+	group->add_child(child);
+	child->set_process(true);
+
+	group->set_process_thread_auto_group(true);
+	CHECK(group->is_process_thread_auto_group());
+	CHECK_EQ(group->get_process_thread_group(), Node::PROCESS_THREAD_GROUP_INHERIT);
+
+	SceneTree::get_singleton()->get_root()->add_child(group);
+
+	SUBCASE("Automatic group flag keeps the inherited group while automatic groups are disabled") {
+		REQUIRE_FALSE(SceneTree::get_singleton()->is_using_automatic_process_thread_groups());
+		CHECK_EQ(group->get_process_thread_group(), Node::PROCESS_THREAD_GROUP_INHERIT);
+
+		TypedArray<Dictionary> stats = SceneTree::get_singleton()->get_process_group_stats();
+		CHECK_EQ(stats.size(), 1);
+		Dictionary default_group = stats[0];
+		CHECK(Object::cast_to<Node>(default_group["owner"]) == nullptr);
+		CHECK_FALSE(bool(default_group["threaded"]));
+	}
+
+	SUBCASE("Explicit groups are reported with their nodes") {
+		group->set_process_thread_group(Node::PROCESS_THREAD_GROUP_SUB_THREAD);
+		SceneTree::get_singleton()->process(0);
+
+		TypedArray<Dictionary> stats = SceneTree::get_singleton()->get_process_group_stats();
+		CHECK_EQ(stats.size(), 2);
+
+		bool found = false;
+		for (int i = 0; i < stats.size(); i++) {
+			Dictionary info = stats[i];
+			if (Object::cast_to<Node>(info["owner"]) == group) {
+				found = true;
+				CHECK(bool(info["threaded"]));
+				CHECK_FALSE(bool(info["automatic"]));
+				CHECK_EQ(int(info["process_nodes"]), 1);
+				CHECK_EQ(int(info["physics_process_nodes"]), 0);
+			}
+		}
+		CHECK(found);
+	}
+
+	SUBCASE("Automatic groups are given to the outermost flagged node only") {
+		SceneTree *tree = SceneTree::get_singleton();
+		child->set_process_thread_auto_group(true);
+
+		auto get_automatic_owners = [tree]() {
+			LocalVector<Node *> owners;
+			TypedArray<Dictionary> stats = tree->get_process_group_stats();
+			for (int i = 0; i < stats.size(); i++) {
+				Dictionary info = stats[i];
+				if (bool(info["automatic"])) {
+					CHECK(bool(info["threaded"]));
+					owners.push_back(Object::cast_to<Node>(info["owner"]));
+				}
+			}
+			return owners;
+		};
+
+		tree->set_use_automatic_process_thread_groups(true);
+		LocalVector<Node *> owners = get_automatic_owners();
+		CHECK_EQ(owners.size(), 1u);
+		CHECK(owners.has(group));
+		// The automatic group is not reported as the node's own setting.
+		CHECK_EQ(group->get_process_thread_group(), Node::PROCESS_THREAD_GROUP_INHERIT);
+
+		// Once the outer node no longer qualifies, the group moves to the flagged child.
+		group->set_process_thread_auto_group(false);
+		owners = get_automatic_owners();
+		CHECK_EQ(owners.size(), 1u);
+		CHECK(owners.has(child));
+
+		// An explicit sub-thread group above takes over again.
+		group->set_process_thread_group(Node::PROCESS_THREAD_GROUP_SUB_THREAD);
+		CHECK(get_automatic_owners().is_empty());
+		group->set_process_thread_group(Node::PROCESS_THREAD_GROUP_INHERIT);
+		owners = get_automatic_owners();
+		CHECK_EQ(owners.size(), 1u);
+		CHECK(owners.has(child));
+
+		tree->set_use_automatic_process_thread_groups(false);
+		CHECK(get_automatic_owners().is_empty());
+		CHECK_EQ(tree->get_process_group_stats().size(), 1);
+	}
+
+	memdelete(group);
+}
+
+TEST_CASE("[SceneTree][Node] Children storage") {
+	// More children than the threshold above which names are looked up through a hash index.
+	const int count = 40;
+
+	Node *parent = memnew(Node);
+	SceneTree::get_singleton()->get_root()->add_child(parent);
+
+	LocalVector<Node *> children;
+	for (int i = 0; i < count; i++) {
+		Node *child = memnew(Node);
+		child->set_name(vformat("Child%d", i));
+		parent->add_child(child);
+		children.push_back(child);
+	}
+	Node *front = memnew(Node);
+	front->set_name("Front");
+	parent->add_child(front, false, Node::INTERNAL_MODE_FRONT);
+	Node *back = memnew(Node);
+	back->set_name("Back");
+	parent->add_child(back, false, Node::INTERNAL_MODE_BACK);
+
+	SUBCASE("Children can be found by index and by name") {
+		CHECK_EQ(parent->get_child_count(), count + 2);
+		CHECK_EQ(parent->get_child_count(false), count);
+		CHECK_EQ(parent->get_child(0), front);
+		CHECK_EQ(parent->get_child(-1), back);
+		for (int i = 0; i < count; i++) {
+			CHECK_EQ(children[i]->get_index(false), i);
+			CHECK_EQ(parent->get_node_or_null(NodePath(vformat("Child%d", i))), children[i]);
+		}
+		CHECK_EQ(parent->get_node_or_null(NodePath("Back")), back);
+	}
+
+	SUBCASE("Removing and renaming children keeps indices and names in sync") {
+		REQUIRE_EQ(parent->get_node_or_null(NodePath("Child5")), children[5]);
+
+		parent->remove_child(children[5]);
+		CHECK_EQ(children[6]->get_index(false), 5);
+		CHECK_EQ(back->get_index(), count);
+		CHECK(parent->get_node_or_null(NodePath("Child5")) == nullptr);
+
+		children[7]->set_name("Renamed");
+		CHECK_EQ(parent->get_node_or_null(NodePath("Renamed")), children[7]);
+		CHECK(parent->get_node_or_null(NodePath("Child7")) == nullptr);
+
+		Node *duplicate = memnew(Node);
+		duplicate->set_name("Renamed");
+		parent->add_child(duplicate);
+		CHECK_NE(duplicate->get_name(), StringName("Renamed"));
+		CHECK_EQ(parent->get_child(-1, false), duplicate);
+		CHECK_EQ(parent->get_node_or_null(NodePath(duplicate->get_name())), duplicate);
+
+		memdelete(children[5]);
+	}
+
+	SUBCASE("Removing most children still finds the remaining ones") {
+		REQUIRE_EQ(parent->get_node_or_null(NodePath("Child0")), children[0]);
+
+		for (int i = count - 1; i >= 2; i--) {
+			memdelete(children[i]);
+		}
+		CHECK_EQ(parent->get_child_count(false), 2);
+		CHECK_EQ(parent->get_node_or_null(NodePath("Child1")), children[1]);
+		CHECK_EQ(parent->get_node_or_null(NodePath("Front")), front);
+		CHECK_EQ(back->get_index(), 3);
+	}
+
+	SUBCASE("Indices stay correct while removing children from the front") {
+		for (int i = 0; i < count / 2; i++) {
+			parent->remove_child(children[i]);
+			CHECK_EQ(children[i + 1]->get_index(false), 0);
+			CHECK_EQ(children[count - 1]->get_index(false), count - i - 2);
+			CHECK_EQ(back->get_index(), count - i);
+		}
+		CHECK_EQ(parent->get_node_or_null(NodePath(vformat("Child%d", count / 2))), children[count / 2]);
+
+		parent->move_child(children[count - 1], 0);
+		for (int i = count / 2; i < count - 1; i++) {
+			CHECK_EQ(children[i]->get_index(false), i - count / 2 + 1);
+		}
+		CHECK_EQ(children[count - 1]->get_index(false), 0);
+
+		for (int i = 0; i < count / 2; i++) {
+			memdelete(children[i]);
+		}
+	}
+
+	memdelete(parent);
+}
+
+inline void benchmark_node_memory() {
+	// Builds a tree where most nodes have 0 to 3 children and reports the memory used per node.
+	const uint32_t node_count = 100000;
+
+	const uint64_t mem_begin = Memory::get_mem_usage();
+	LocalVector<Node *> nodes;
+	nodes.reserve(node_count);
+	nodes.push_back(memnew(Node));
+	for (uint32_t i = 0; i < nodes.size() && nodes.size() < node_count; i++) {
+		const int child_count = (i % 4) == 0 ? 3 : (i % 4) - 1;
+		for (int j = 0; j < child_count && nodes.size() < node_count; j++) {
+			Node *child = memnew(Node);
+			nodes[i]->add_child(child);
+			nodes.push_back(child);
+		}
+	}
+	// The node list itself is not part of the tree.
+	const uint64_t mem_used = Memory::get_mem_usage() - mem_begin - nodes.size() * sizeof(Node *);
+
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	nodes[0]->propagate_notification(Node::NOTIFICATION_PATH_RENAMED);
+	const uint64_t usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	print_line(vformat("%d nodes: sizeof(Node) is %d bytes, %.1f bytes used per node (debug builds only), notification propagated in %.2f ms.", nodes.size(), (int64_t)sizeof(Node), mem_used / (double)nodes.size(), usec / 1000.0));
+
+	memdelete(nodes[0]);
+}
+
+REGISTER_TEST_COMMAND("node-memory-benchmark", &benchmark_node_memory);
+
 } // namespace TestNode
@@ -0,0 +1,114 @@
+/**************************************************************************/
+/*  test_node_3d.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "scene/3d/node_3d.h"
+#include "scene/main/window.h"
+
+#include "tests/test_macros.h"
+
+class TestNode3DInternalsAccessor {
+public:
+	static bool is_global_transform_dirty(const Node3D *p_node) {
+		return p_node->_test_dirty_bits(Node3D::DIRTY_GLOBAL_TRANSFORM);
+	}
+};
+
+namespace TestNode3D {
+
+TEST_CASE("[SceneTree][Node3D] Batched global transform updates") {
+	Node3D *root = memnew(Node3D);
+	SceneTree::get_singleton()->get_root()->add_child(root);
+
+	// Wide enough for the level of children to be resolved in parallel.
+	const int count = 300;
+	LocalVector<Node3D *> children;
+	LocalVector<Node3D *> leaves;
+	for (int i = 0; i < count; i++) {
+		Node3D *child = memnew(Node3D);
+		child->set_position(Vector3(0, i, 0));
+		root->add_child(child);
+		children.push_back(child);
+
+		Node3D *leaf = memnew(Node3D);
+		leaf->set_position(Vector3(0, 0, 1));
+		if (i % 2) {
+			// Set before entering the tree, so the local position is also the global one.
+			leaf->set_as_top_level(true);
+		}
+		leaf->set_notify_transform(true);
+		child->add_child(leaf);
+		leaves.push_back(leaf);
+	}
+
+	SUBCASE("Update global transforms") {
+		// Dirty the whole hierarchy, top level leaves keep the global transform they had.
+		root->set_position(Vector3(1, 0, 0));
+		Node3D::update_global_transforms(leaves);
+
+		CHECK_FALSE(TestNode3DInternalsAccessor::is_global_transform_dirty(root));
+		for (int i = 0; i < count; i++) {
+			CHECK_FALSE(TestNode3DInternalsAccessor::is_global_transform_dirty(children[i]));
+			CHECK_FALSE(TestNode3DInternalsAccessor::is_global_transform_dirty(leaves[i]));
+		}
+	}
+
+	SUBCASE("Flush transform notifications") {
+		SceneTree *tree = SceneTree::get_singleton();
+		bool was_batching = tree->is_batching_global_transform_updates();
+		tree->set_batch_global_transform_updates(true);
+		tree->flush_transform_notifications();
+
+		root->set_position(Vector3(1, 0, 0));
+		tree->flush_transform_notifications();
+		tree->set_batch_global_transform_updates(was_batching);
+
+		// The children don't listen for transform changes, they were resolved on the way to the leaves.
+		for (int i = 0; i < count; i++) {
+			CHECK_FALSE(TestNode3DInternalsAccessor::is_global_transform_dirty(children[i]));
+			CHECK_FALSE(TestNode3DInternalsAccessor::is_global_transform_dirty(leaves[i]));
+		}
+	}
+
+	for (int i = 0; i < count; i++) {
+		CHECK(children[i]->get_global_position().is_equal_approx(Vector3(1, i, 0)));
+		if (i % 2) {
+			CHECK(leaves[i]->get_global_position().is_equal_approx(Vector3(0, 0, 1)));
+		} else {
+			CHECK(leaves[i]->get_global_position().is_equal_approx(Vector3(1, i, 1)));
+		}
+	}
+	CHECK(root->get_global_position().is_equal_approx(Vector3(1, 0, 0)));
+
+	memdelete(root);
+}
+
+} // namespace TestNode3D
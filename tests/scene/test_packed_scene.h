@@ -30,10 +30,19 @@
 
 #pragma once
 
+#include "scene/main/window.h"
 #include "scene/resources/packed_scene.h"
+#include "scene/resources/scene_pool.h"
 
 #include "tests/test_macros.h"
 
+class TestScenePoolInternalsAccessor {
+public:
+	static int get_tracked_instance_count(const Ref<ScenePool> &p_pool) {
+		return p_pool->instances.size();
+	}
+};
+
 namespace TestPackedScene {
 
 TEST_CASE("[PackedScene] Pack Scene and Retrieve State") {
@@ -215,6 +224,220 @@ TEST_CASE("[PackedScene] Instantiate Packed Scene With Children") {
 	memdelete(instance);
 }
 
+TEST_CASE("[SceneTree][PackedScene] Instantiate Many") {
+	// Create a scene to pack.
+	Node *scene = memnew(Node);
+	scene->set_name("TestScene");
+	scene->set_process_priority(5);
+
+	Node *child = memnew(Node);
+	child->set_name("Child");
+	child->set_process_priority(7);
+	scene->add_child(child);
+	child->set_owner(scene);
+
+	PackedScene packed_scene;
+	packed_scene.pack(scene);
+	memdelete(scene);
+
+	SUBCASE("Without parent") {
+		TypedArray<Node> instances = packed_scene.instantiate_many(3);
+		CHECK(instances.size() == 3);
+		for (int i = 0; i < instances.size(); i++) {
+			Node *instance = Object::cast_to<Node>(instances[i]);
+			REQUIRE(instance != nullptr);
+			CHECK(instance->get_parent() == nullptr);
+			CHECK(instance->get_name() == "TestScene");
+			CHECK(instance->get_process_priority() == 5);
+			CHECK(instance->get_child_count() == 1);
+			CHECK(instance->get_child(0)->get_process_priority() == 7);
+			memdelete(instance);
+		}
+	}
+
+	SUBCASE("Added to a parent inside the tree") {
+		Node *parent = memnew(Node);
+		SceneTree::get_singleton()->get_root()->add_child(parent);
+
+		SIGNAL_WATCH(parent, "child_order_changed");
+		TypedArray<Node> instances = packed_scene.instantiate_many(4, parent);
+		Array empty_signal_args = { {} };
+		SIGNAL_CHECK("child_order_changed", empty_signal_args);
+		SIGNAL_UNWATCH(parent, "child_order_changed");
+
+		CHECK(instances.size() == 4);
+		CHECK(parent->get_child_count() == 4);
+
+		HashSet<StringName> names;
+		for (int i = 0; i < instances.size(); i++) {
+			Node *instance = Object::cast_to<Node>(instances[i]);
+			REQUIRE(instance != nullptr);
+			CHECK(parent->get_child(i) == instance);
+			CHECK(instance->get_index() == i);
+			CHECK(instance->is_inside_tree());
+			CHECK(instance->is_ready());
+			CHECK(instance->get_child(0)->is_inside_tree());
+			names.insert(instance->get_name());
+		}
+		// Clashing names are made unique like add_child() does.
+		CHECK(names.size() == 4);
+
+		memdelete(parent);
+	}
+
+	SUBCASE("Zero instances") {
+		Node *parent = memnew(Node);
+		CHECK(packed_scene.instantiate_many(0, parent).is_empty());
+		CHECK(parent->get_child_count() == 0);
+		memdelete(parent);
+	}
+}
+
+TEST_CASE("[SceneTree][PackedScene] Scene Pool") {
+	Node *scene = memnew(Node);
+	scene->set_name("TestScene");
+	scene->set_process_priority(5);
+
+	Node *child = memnew(Node);
+	child->set_name("Child");
+	child->set_process_priority(7);
+	scene->add_child(child);
+	child->set_owner(scene);
+
+	Ref<PackedScene> packed_scene;
+	packed_scene.instantiate();
+	packed_scene->pack(scene);
+	memdelete(scene);
+
+	Ref<ScenePool> pool = packed_scene->create_pool(1);
+	CHECK(pool->get_scene() == packed_scene);
+	CHECK(pool->get_available_count() == 1);
+
+	SUBCASE("Released instances are reset and reused") {
+		Node *instance = pool->acquire();
+		REQUIRE(instance != nullptr);
+		CHECK(pool->get_available_count() == 0);
+		CHECK(instance->get_parent() == nullptr);
+
+		SceneTree::get_singleton()->get_root()->add_child(instance);
+		instance->set_process_priority(1);
+		instance->get_child(0)->set_process_priority(2);
+
+		pool->release(instance);
+		CHECK(instance->get_parent() == nullptr);
+		CHECK(instance->get_process_priority() == 5);
+		CHECK(instance->get_child(0)->get_process_priority() == 7);
+		CHECK(pool->get_available_count() == 1);
+
+		CHECK(pool->acquire() == instance);
+		Node *other = pool->acquire();
+		CHECK(other != instance);
+
+		Dictionary stats = pool->get_stats();
+		CHECK(int(stats["hits"]) == 2);
+		CHECK(int(stats["misses"]) == 1);
+		CHECK(double(stats["hit_rate"]) == doctest::Approx(2.0 / 3.0));
+		CHECK(int(stats["releases"]) == 1);
+
+		memdelete(instance);
+		memdelete(other);
+	}
+
+	SUBCASE("Properties the scene doesn't store are reset too") {
+		Node *instance = pool->acquire();
+		REQUIRE(instance != nullptr);
+		instance->set_physics_process_priority(3);
+		instance->get_child(0)->set_editor_description("Changed");
+
+		pool->release(instance);
+		CHECK(instance->get_physics_process_priority() == 0);
+		CHECK(instance->get_child(0)->get_editor_description().is_empty());
+		CHECK(instance->get_child(0)->get_process_priority() == 7);
+
+		memdelete(pool->acquire());
+	}
+
+	SUBCASE("Instances missing nodes are discarded") {
+		Node *instance = pool->acquire();
+		REQUIRE(instance != nullptr);
+		memdelete(instance->get_child(0));
+
+		ObjectID id = instance->get_instance_id();
+		pool->release(instance);
+		CHECK(ObjectDB::get_instance(id) == nullptr);
+		CHECK(pool->get_available_count() == 0);
+		CHECK(int(pool->get_stats()["discards"]) == 1);
+	}
+
+	SUBCASE("Metadata added at runtime is removed") {
+		Node *instance = pool->acquire();
+		REQUIRE(instance != nullptr);
+		instance->set_meta("hit", true);
+		instance->get_child(0)->set_meta("hit", true);
+
+		pool->release(instance);
+		CHECK_FALSE(instance->has_meta("hit"));
+		CHECK_FALSE(instance->get_child(0)->has_meta("hit"));
+		CHECK(pool->get_available_count() == 1);
+
+		memdelete(pool->acquire());
+	}
+
+	SUBCASE("Instances with children, groups or connections added at runtime are discarded") {
+		Node *instance = pool->acquire();
+		REQUIRE(instance != nullptr);
+		instance->add_child(memnew(Node));
+		ObjectID id = instance->get_instance_id();
+		pool->release(instance);
+		CHECK(ObjectDB::get_instance(id) == nullptr);
+
+		instance = pool->acquire();
+		REQUIRE(instance != nullptr);
+		instance->get_child(0)->add_to_group("enemies");
+		id = instance->get_instance_id();
+		pool->release(instance);
+		CHECK(ObjectDB::get_instance(id) == nullptr);
+
+		Node *target = memnew(Node);
+		instance = pool->acquire();
+		REQUIRE(instance != nullptr);
+		instance->connect(SceneStringName(tree_exited), Callable(target, "queue_free"));
+		id = instance->get_instance_id();
+		pool->release(instance);
+		CHECK(ObjectDB::get_instance(id) == nullptr);
+		memdelete(target);
+
+		CHECK(pool->get_available_count() == 0);
+		CHECK(int(pool->get_stats()["discards"]) == 3);
+		CHECK(TestScenePoolInternalsAccessor::get_tracked_instance_count(pool) == 0);
+	}
+
+	SUBCASE("Instances freed instead of released are forgotten") {
+		Node *instance = pool->acquire();
+		REQUIRE(instance != nullptr);
+		CHECK(TestScenePoolInternalsAccessor::get_tracked_instance_count(pool) == 1);
+
+		SceneTree::get_singleton()->get_root()->add_child(instance);
+		instance->queue_free();
+		SceneTree::get_singleton()->get_root()->remove_child(instance);
+		CHECK(TestScenePoolInternalsAccessor::get_tracked_instance_count(pool) == 0);
+		memdelete(instance);
+
+		// Freed outside of the tree, they are only noticed by a later sweep.
+		memdelete(pool->acquire());
+		CHECK(TestScenePoolInternalsAccessor::get_tracked_instance_count(pool) == 1);
+		pool->clear();
+		CHECK(TestScenePoolInternalsAccessor::get_tracked_instance_count(pool) == 0);
+	}
+
+	SUBCASE("Clear frees pooled instances") {
+		pool->prewarm(2);
+		CHECK(pool->get_available_count() == 3);
+		pool->clear();
+		CHECK(pool->get_available_count() == 0);
+	}
+}
+
 TEST_CASE("[PackedScene] Set Path") {
 	// Create a scene to pack.
 	Node *scene = memnew(Node);
@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "core/config/project_settings.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/resources/3d/primitive_meshes.h"
 #include "servers/navigation_3d/navigation_server_3d.h"
@@ -41,11 +42,16 @@ class CallableMock : public Object {
 	GDCLASS(CallableMock, Object);
 
 public:
+	void function0() {
+		function0_calls++;
+	}
+
 	void function1(Variant arg0) {
 		function1_calls++;
 		function1_latest_arg0 = arg0;
 	}
 
+	unsigned function0_calls{ 0 };
 	unsigned function1_calls{ 0 };
 	Variant function1_latest_arg0;
 };
@@ -416,6 +422,52 @@ TEST_SUITE("[Navigation3D]") {
 		navigation_server->free_rid(map);
 	}
 
+	TEST_CASE("[NavigationServer3D] Server should only make agents avoid agents within their neighbor distance") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+
+		// Enough agents to be split over several avoidance chunks, spaced further apart than their neighbor distance.
+		constexpr int agent_count = 100;
+		LocalVector<RID> agents;
+		CallableMock agent_avoidance_callback_mocks[agent_count];
+		for (int i = 0; i < agent_count; i++) {
+			RID agent = navigation_server->agent_create();
+			navigation_server->agent_set_map(agent, map);
+			navigation_server->agent_set_avoidance_enabled(agent, true);
+			navigation_server->agent_set_neighbor_distance(agent, 10);
+			navigation_server->agent_set_position(agent, Vector3(i * 100.0, 0, 0));
+			navigation_server->agent_set_radius(agent, 1);
+			navigation_server->agent_set_velocity(agent, Vector3(1, 0, 0));
+			navigation_server->agent_set_avoidance_callback(agent, callable_mp(&agent_avoidance_callback_mocks[i], &CallableMock::function1));
+			agents.push_back(agent);
+		}
+
+		// Puts a head-on agent in front of the last one.
+		RID blocking_agent = navigation_server->agent_create();
+		navigation_server->agent_set_map(blocking_agent, map);
+		navigation_server->agent_set_avoidance_enabled(blocking_agent, true);
+		navigation_server->agent_set_position(blocking_agent, Vector3((agent_count - 1) * 100.0 + 2.5, 0, 0.5));
+		navigation_server->agent_set_radius(blocking_agent, 1);
+		navigation_server->agent_set_velocity(blocking_agent, Vector3(-1, 0, 0));
+
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+		for (int i = 0; i < agent_count - 1; i++) {
+			CHECK_EQ(agent_avoidance_callback_mocks[i].function1_calls, 1);
+			CHECK_EQ(Vector3(agent_avoidance_callback_mocks[i].function1_latest_arg0), Vector3(1, 0, 0));
+		}
+		Vector3 last_agent_safe_velocity = agent_avoidance_callback_mocks[agent_count - 1].function1_latest_arg0;
+		CHECK_MESSAGE(last_agent_safe_velocity.z < 0, "last agent should move a bit to the side so that it avoids the blocking agent");
+
+		navigation_server->free_rid(blocking_agent);
+		for (const RID &agent : agents) {
+			navigation_server->free_rid(agent);
+		}
+		navigation_server->free_rid(map);
+	}
+
 	TEST_CASE("[NavigationServer3D] Server should make agents avoid dynamic obstacles when avoidance enabled") {
 		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
 
@@ -798,6 +850,200 @@ TEST_SUITE("[Navigation3D]") {
 			CHECK_EQ(query_result->get_path().size(), 0);
 		}
 
+		SUBCASE("Batched queries should yield the same paths as individual queries") {
+			TypedArray<NavigationPathQueryParameters3D> batch_parameters;
+			TypedArray<NavigationPathQueryResult3D> batch_results;
+			for (int i = 0; i < 16; i++) {
+				Ref<NavigationPathQueryParameters3D> query_parameters;
+				query_parameters.instantiate();
+				query_parameters->set_map(map);
+				query_parameters->set_start_position(Vector3(i % 4, 0, 0));
+				query_parameters->set_target_position(Vector3(10, 0, 10 - i % 3));
+				batch_parameters.push_back(query_parameters);
+				Ref<NavigationPathQueryResult3D> query_result;
+				query_result.instantiate();
+				batch_results.push_back(query_result);
+			}
+			CallableMock callback_mock;
+			navigation_server->query_paths(batch_parameters, batch_results, callable_mp(&callback_mock, &CallableMock::function0));
+			CHECK_EQ(callback_mock.function0_calls, 1);
+
+			for (int i = 0; i < batch_parameters.size(); i++) {
+				Ref<NavigationPathQueryResult3D> query_result;
+				query_result.instantiate();
+				navigation_server->query_path(batch_parameters[i], query_result);
+				Ref<NavigationPathQueryResult3D> batch_result = batch_results[i];
+				CHECK_NE(batch_result->get_path().size(), 0);
+				CHECK_EQ(batch_result->get_path(), query_result->get_path());
+				CHECK_EQ(batch_result->get_path_length(), query_result->get_path_length());
+			}
+		}
+
+		SUBCASE("Flow field should lead towards the target") {
+			const Vector3 target_position = Vector3(10, 0, 10);
+			const Vector3 next_position = navigation_server->map_get_flow_field_next_position(map, target_position, Vector3(0, 0, 0));
+			CHECK_LT(next_position.distance_to(target_position), Vector3(0, 0, 0).distance_to(target_position));
+			CHECK_EQ(navigation_server->map_get_flow_field_next_position(map, target_position, Vector3(0, 0, 0)), next_position);
+			CHECK_EQ(navigation_server->map_get_flow_field_next_position(map, target_position, Vector3(0, 0, 0), 2), Vector3());
+		}
+
+		navigation_server->free_rid(region);
+		navigation_server->free_rid(map);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Flow field should steer several agents around a wall") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// An 8x8 grid of 1x1 polygons with a wall at 4 < x < 5 that is open for z > 6.
+		const int grid_size = 8;
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		Vector<Vector3> vertices;
+		for (int z = 0; z <= grid_size; z++) {
+			for (int x = 0; x <= grid_size; x++) {
+				vertices.push_back(Vector3(x, 0, z));
+			}
+		}
+		navigation_mesh->set_vertices(vertices);
+		for (int z = 0; z < grid_size; z++) {
+			for (int x = 0; x < grid_size; x++) {
+				if (x == 4 && z < 6) {
+					continue;
+				}
+				const int index = z * (grid_size + 1) + x;
+				Vector<int> polygon;
+				polygon.push_back(index);
+				polygon.push_back(index + 1);
+				polygon.push_back(index + grid_size + 2);
+				polygon.push_back(index + grid_size + 1);
+				navigation_mesh->add_polygon(polygon);
+			}
+		}
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->map_set_use_async_iterations(map, false);
+		navigation_server->region_set_use_async_iterations(region, false);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+		const Vector3 target_position = Vector3(6.5, 0, 0.5);
+		Vector<Vector3> agent_positions;
+		agent_positions.push_back(Vector3(0.5, 0, 0.5));
+		agent_positions.push_back(Vector3(2.5, 0, 3.5));
+		agent_positions.push_back(Vector3(3.5, 0, 5.5));
+		agent_positions.push_back(Vector3(7.5, 0, 7.5));
+
+		for (int agent_index = 0; agent_index < agent_positions.size(); agent_index++) {
+			Vector3 position = agent_positions[agent_index];
+			real_t max_z = position.z;
+			for (int step = 0; step < 100 && !position.is_equal_approx(target_position); step++) {
+				const Vector3 next_position = navigation_server->map_get_flow_field_next_position(map, target_position, position);
+				// The next position stays on the navigation mesh, agents never cut through the wall.
+				CHECK_FALSE((next_position.x > 4.0 && next_position.x < 5.0 && next_position.z < 6.0));
+				position = position.move_toward(next_position, 0.5);
+				max_z = MAX(max_z, position.z);
+			}
+			CHECK_MESSAGE(position.is_equal_approx(target_position), vformat("Agent %d should reach the target.", agent_index));
+			if (agent_positions[agent_index].x < 4.0) {
+				// Agents left of the wall have to go around it through the opening.
+				CHECK_GT(max_z, 5.9);
+			}
+		}
+
+		navigation_server->free_rid(region);
+		navigation_server->free_rid(map);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Hierarchical pathfinding should search fewer nodes for an equivalent path") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// A 32x32 grid of 1x1 polygons, split into 8x8 clusters of 4x4 polygons. A dead end opening towards
+		// the start lies between the start and the target: a full search floods it, while the cluster graph
+		// already knows it leads nowhere.
+		const int grid_size = 32;
+		auto is_wall = [](int p_x, int p_z) {
+			return ((p_z == 3 || p_z == 28) && p_x >= 4 && p_x <= 28) || (p_x == 28 && p_z >= 3 && p_z <= 28);
+		};
+
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		Vector<Vector3> vertices;
+		for (int z = 0; z <= grid_size; z++) {
+			for (int x = 0; x <= grid_size; x++) {
+				vertices.push_back(Vector3(x, 0, z));
+			}
+		}
+		navigation_mesh->set_vertices(vertices);
+		for (int z = 0; z < grid_size; z++) {
+			for (int x = 0; x < grid_size; x++) {
+				if (is_wall(x, z)) {
+					continue;
+				}
+				const int index = z * (grid_size + 1) + x;
+				Vector<int> polygon;
+				polygon.push_back(index);
+				polygon.push_back(index + 1);
+				polygon.push_back(index + grid_size + 2);
+				polygon.push_back(index + grid_size + 1);
+				navigation_mesh->add_polygon(polygon);
+			}
+		}
+
+		// The cluster size is read when the map is created.
+		const Variant cluster_size = GLOBAL_GET("navigation/3d/hierarchical_pathfinding_cluster_size");
+		ProjectSettings::get_singleton()->set_setting("navigation/3d/hierarchical_pathfinding_cluster_size", 4.0);
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->map_set_use_async_iterations(map, false);
+		navigation_server->region_set_use_async_iterations(region, false);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+		ProjectSettings::get_singleton()->set_setting("navigation/3d/hierarchical_pathfinding_cluster_size", cluster_size);
+
+		const Vector3 start_position = Vector3(0.5, 0, 16.5);
+		const Vector3 target_position = Vector3(31.5, 0, 16.5);
+
+		Ref<NavigationPathQueryParameters3D> query_parameters = memnew(NavigationPathQueryParameters3D);
+		query_parameters->set_map(map);
+		query_parameters->set_start_position(start_position);
+		query_parameters->set_target_position(target_position);
+
+		// The searched node count covers the queries made since the previous sync.
+		Ref<NavigationPathQueryResult3D> full_result = memnew(NavigationPathQueryResult3D);
+		navigation_server->query_path(query_parameters, full_result);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+		const int full_node_count = navigation_server->get_process_info(NavigationServer3D::INFO_PATH_QUERY_NODE_COUNT);
+		const Vector<Vector3> full_path = full_result->get_path();
+		REQUIRE_NE(full_path.size(), 0);
+		CHECK(full_path[full_path.size() - 1].is_equal_approx(target_position));
+
+		navigation_server->map_set_use_hierarchical_pathfinding(map, true);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+		CHECK(navigation_server->map_get_use_hierarchical_pathfinding(map));
+
+		Ref<NavigationPathQueryResult3D> hierarchical_result = memnew(NavigationPathQueryResult3D);
+		navigation_server->query_path(query_parameters, hierarchical_result);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+		const int hierarchical_node_count = navigation_server->get_process_info(NavigationServer3D::INFO_PATH_QUERY_NODE_COUNT);
+		const Vector<Vector3> hierarchical_path = hierarchical_result->get_path();
+		REQUIRE_NE(hierarchical_path.size(), 0);
+		CHECK(hierarchical_path[0].is_equal_approx(full_path[0]));
+		CHECK(hierarchical_path[hierarchical_path.size() - 1].is_equal_approx(full_path[full_path.size() - 1]));
+
+		// The result is near-optimal: the two ways around the dead end differ by less than 5%.
+		CHECK_GE(hierarchical_result->get_path_length(), full_result->get_path_length() - (real_t)CMP_EPSILON);
+		CHECK_LE(hierarchical_result->get_path_length(), full_result->get_path_length() * 1.1);
+
+		CHECK_GT(hierarchical_node_count, 0);
+		CHECK_LT(hierarchical_node_count, full_node_count);
+
 		navigation_server->free_rid(region);
 		navigation_server->free_rid(map);
 		navigation_server->physics_process(0.0); // Give server some cycles to commit.